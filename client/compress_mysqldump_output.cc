@@ -16,9 +16,13 @@
 */
 
 #include "my_attribute.h"
+#include <atomic>
 #include <cassert>
+#include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -174,11 +178,12 @@ struct compress_context {
   std::string fifo_filename;
   std::string tablename;
   unsigned int chunk_size;
+  std::atomic<bool> done;
 
   compress_context(const char *_filename, unsigned int _chunk_size,
                    const char *_tablename)
       : fifo_filename(_filename), tablename(_tablename),
-        chunk_size(_chunk_size) {}
+        chunk_size(_chunk_size), done(false) {}
 
   void make_fifo_or_die() {
     int rc = mkfifo(fifo_filename.c_str(), 0666);
@@ -196,6 +201,25 @@ struct compress_context {
     compress_thread.join();
     std::remove(fifo_filename.c_str());
   }
+  // The server may never have opened the fifo, leaving the compress
+  // thread blocked in its open. Open and close the write end so that
+  // it reads end of file, unless the thread is already done.
+  void abort() {
+    while (!done) {
+      int fd = open(fifo_filename.c_str(), O_WRONLY | O_NONBLOCK);
+      if (fd >= 0) {
+        ::close(fd);
+        break;
+      }
+      if (errno != ENXIO) {
+        print_sys_error();
+        exit(1);
+      }
+      // The compress thread has not opened the fifo yet.
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    finish();
+  }
   void read_pipe_and_compress() {
     std::ifstream fifo(fifo_filename);
     if (!fifo.is_open()) {
@@ -215,6 +239,7 @@ struct compress_context {
 
     verbose_msg("end table %s\n", tablename.c_str());
     fifo.close();
+    done = true;
   }
 };
 
@@ -230,3 +255,8 @@ extern "C" void finish_pipe_and_compress_output(struct compress_context *ctx) {
   std::unique_ptr<compress_context> context(ctx);
   context->finish();
 }
+
+extern "C" void abort_pipe_and_compress_output(struct compress_context *ctx) {
+  std::unique_ptr<compress_context> context(ctx);
+  context->abort();
+}
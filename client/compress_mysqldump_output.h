@@ -24,5 +24,6 @@ struct compress_context *start_pipe_and_compress_output(
     unsigned int chunk_size,
     const char *tablename);
 void finish_pipe_and_compress_output(struct compress_context *ctx);
+void abort_pipe_and_compress_output(struct compress_context *ctx);
 
 #endif /* CLIENT_COMPRESS_MYSQLDUMP_OUTPUT_H_ */
@@ -81,6 +81,10 @@
 /* Size of comment buffer. */
 #define COMMENT_LENGTH 2048
 
+/* Limits of --parallel */
+#define MAX_PARALLEL_THREADS 256
+#define MAX_PARALLEL_CHUNKS 4096
+
 /* ignore table flags */
 #define IGNORE_NONE 0x00 /* no ignore */
 #define IGNORE_DATA 0x01 /* don't dump data for this table */
@@ -160,6 +164,10 @@ static uint opt_mysql_port= 0, opt_master_data;
 static uint opt_slave_data;
 static uint opt_compression_chunk_size = 0;
 static my_bool do_compress = 0;
+static uint opt_parallel= 0;
+static ulonglong opt_parallel_chunk_rows= 0;
+/* Id of the shared RocksDB snapshot the --parallel connections attach to */
+static ulonglong parallel_snapshot_id= 0;
 static uint my_end_arg;
 static char * opt_mysql_unix_port=0;
 static char *opt_bind_addr = NULL;
@@ -706,6 +714,20 @@ static struct my_option my_long_options[] =
    "Sets the minimum HLC in the output file based on the snapshot HLC",
    &opt_set_minimum_hlc, &opt_set_minimum_hlc, 0,
    GET_BOOL, NO_ARG,  0, 0, 0, 0, 0, 0},
+  {"parallel", OPT_PARALLEL,
+   "Dump table data with this many threads, each on its own connection. "
+   "All connections read from the snapshot of the main connection. "
+   "Must be used with --tab and with --single-transaction or "
+   "--lock-all-tables.",
+   &opt_parallel, &opt_parallel, 0,
+   GET_UINT, REQUIRED_ARG, 0, 0, MAX_PARALLEL_THREADS, 0, 0, 0},
+  {"parallel-chunk-rows", OPT_PARALLEL_CHUNK_ROWS,
+   "With --parallel, split the data of a table with an integer primary key "
+   "and more than this many rows into chunks of about this many rows by "
+   "primary key ranges. Chunk N of table t is written to t.N.txt. "
+   "0 dumps every table to a single file.",
+   &opt_parallel_chunk_rows, &opt_parallel_chunk_rows, 0,
+   GET_ULL, REQUIRED_ARG, 1000000, 0, ULONGLONG_MAX, 0, 0, 0},
   {0, 0, 0, 0, 0, 0, GET_NO_ARG, NO_ARG, 0, 0, 0, 0, 0, 0}
 };
 
@@ -1289,6 +1311,20 @@ static int get_options(int *argc, char ***argv)
     return(EX_USAGE);
   }
 
+  if (opt_parallel && !path)
+  {
+    fprintf(stderr, "%s: --parallel must be used with --tab.\n",
+            my_progname);
+    return(EX_USAGE);
+  }
+  if (opt_parallel && !opt_single_transaction && !opt_lock_all_tables)
+  {
+    fprintf(stderr,
+            "%s: --parallel requires --single-transaction or "
+            "--lock-all-tables.\n", my_progname);
+    return(EX_USAGE);
+  }
+
   return(0);
 } /* get_options */
 
@@ -1759,105 +1795,102 @@ static void maybe_exit(int error)
 
 
 /*
-  db_connect -- connects to the host and selects DB.
+  connect_to_server -- opens a connection with the connection options
+  given on the command line.
+
+  RETURN VALUES
+    the connection, or 0 on error
 */
 
-static int connect_to_db(char *host, char *user,char *passwd)
+static MYSQL *connect_to_server(MYSQL *mysql_con, char *host, char *user,
+                                char *passwd)
 {
-  char buff[20+FN_REFLEN];
-  DBUG_ENTER("connect_to_db");
+  MYSQL *con;
+  DBUG_ENTER("connect_to_server");
 
   verbose_msg("-- Connecting to %s...\n", host ? host : "localhost");
-  mysql_init(&mysql_connection);
+  mysql_init(mysql_con);
   if (opt_compress)
-    mysql_options(&mysql_connection,MYSQL_OPT_COMPRESS,NullS);
+    mysql_options(mysql_con,MYSQL_OPT_COMPRESS,NullS);
 #ifdef HAVE_OPENSSL
   if (opt_use_ssl)
   {
-    mysql_ssl_set(&mysql_connection, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
+    mysql_ssl_set(mysql_con, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
                   opt_ssl_capath, opt_ssl_cipher);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
+    mysql_options(mysql_con, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
+    mysql_options(mysql_con, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
   }
-  mysql_options(&mysql_connection,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
+  mysql_options(mysql_con,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
                 (char*)&opt_ssl_verify_server_cert);
 #endif
   if (opt_protocol)
-    mysql_options(&mysql_connection,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
+    mysql_options(mysql_con,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
   if (opt_bind_addr)
-    mysql_options(&mysql_connection,MYSQL_OPT_BIND,opt_bind_addr);
+    mysql_options(mysql_con,MYSQL_OPT_BIND,opt_bind_addr);
   if (!opt_secure_auth)
-    mysql_options(&mysql_connection,MYSQL_SECURE_AUTH,(char*)&opt_secure_auth);
+    mysql_options(mysql_con,MYSQL_SECURE_AUTH,(char*)&opt_secure_auth);
 #ifdef HAVE_SMEM
   if (shared_memory_base_name)
-    mysql_options(&mysql_connection,MYSQL_SHARED_MEMORY_BASE_NAME,shared_memory_base_name);
+    mysql_options(mysql_con,MYSQL_SHARED_MEMORY_BASE_NAME,shared_memory_base_name);
 #endif
-  mysql_options(&mysql_connection, MYSQL_SET_CHARSET_NAME, default_charset);
+  mysql_options(mysql_con, MYSQL_SET_CHARSET_NAME, default_charset);
 
   if (opt_plugin_dir && *opt_plugin_dir)
-    mysql_options(&mysql_connection, MYSQL_PLUGIN_DIR, opt_plugin_dir);
+    mysql_options(mysql_con, MYSQL_PLUGIN_DIR, opt_plugin_dir);
 
   if (opt_default_auth && *opt_default_auth)
-    mysql_options(&mysql_connection, MYSQL_DEFAULT_AUTH, opt_default_auth);
+    mysql_options(mysql_con, MYSQL_DEFAULT_AUTH, opt_default_auth);
 
   if (using_opt_enable_cleartext_plugin)
-    mysql_options(&mysql_connection, MYSQL_ENABLE_CLEARTEXT_PLUGIN,
+    mysql_options(mysql_con, MYSQL_ENABLE_CLEARTEXT_PLUGIN,
                   (char *) &opt_enable_cleartext_plugin);
 
-  mysql_options(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
-  mysql_options4(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_ADD,
+  mysql_options(mysql_con, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
+  mysql_options4(mysql_con, MYSQL_OPT_CONNECT_ATTR_ADD,
                  "program_name", "mysqldump");
-  if (!(mysql= mysql_connect_ssl_check(&mysql_connection, host, user,
-                                       passwd, NULL, opt_mysql_port,
-                                       opt_mysql_unix_port, 0,
-                                       opt_ssl_required)))
+  if (!(con= mysql_connect_ssl_check(mysql_con, host, user,
+                                     passwd, NULL, opt_mysql_port,
+                                     opt_mysql_unix_port, 0,
+                                     opt_ssl_required)))
   {
-    DB_error(&mysql_connection, "when trying to connect");
-    DBUG_RETURN(1);
+    DB_error(mysql_con, "when trying to connect");
+    DBUG_RETURN(0);
   }
-  if ((mysql_get_server_version(&mysql_connection) < 40100) ||
-      (opt_compatible_mode & 3))
-  {
-    /* Don't dump SET NAMES with a pre-4.1 server (bug#7997).  */
-    opt_set_charset= 0;
+  DBUG_RETURN(con);
+} /* connect_to_server */
 
-    /* Don't switch charsets for 4.1 and earlier.  (bug#34192). */
-    server_supports_switching_charsets= FALSE;
-  } 
 
-  /* Check to see if we support SQL_NO_FCACHE on this server. */
-  if (mysql_query(mysql, "SELECT SQL_NO_FCACHE NOW()") == 0)
-  {
-    MYSQL_RES *res = mysql_store_result(mysql);
-    if (res)
-    {
-      mysql_free_result(res);
-    }
-    server_supports_sql_no_fcache= TRUE;
-  }
+/*
+  init_session -- sets up a session for dumping.
+*/
+
+static int init_session(MYSQL *mysql_con)
+{
+  char buff[20+FN_REFLEN];
+  DBUG_ENTER("init_session");
 
   /*
     As we're going to set SQL_MODE, it would be lost on reconnect, so we
     cannot reconnect.
   */
-  mysql->reconnect= 0;
+  mysql_con->reconnect= 0;
   my_snprintf(buff, sizeof(buff), "/*!40100 SET @@SQL_MODE='%s' */",
               compatible_mode_normal_str);
-  if (mysql_query_with_error_report(mysql, 0, buff))
+  if (mysql_query_with_error_report(mysql_con, 0, buff))
     DBUG_RETURN(1);
 
   if (opt_timeout)
   {
     my_snprintf(buff, sizeof(buff), "SET wait_timeout=%lu, "
                 "net_write_timeout=%lu", opt_timeout, opt_timeout);
-    if (mysql_query_with_error_report(mysql, 0, buff))
+    if (mysql_query_with_error_report(mysql_con, 0, buff))
       DBUG_RETURN(1);
   }
 
   if (opt_lra_size)
   {
     my_snprintf(buff, sizeof(buff), "SET innodb_lra_size=%lu", opt_lra_size);
-    if (mysql_query(mysql, buff))
+    if (mysql_query(mysql_con, buff))
     {
       fprintf(stderr,
               "%s: Warning: Server does not support logical read ahead. "
@@ -1869,7 +1902,7 @@ static int connect_to_db(char *host, char *user,char *passwd)
       {
         my_snprintf(buff, sizeof(buff), "SET innodb_lra_sleep=%lu",
                     opt_lra_sleep);
-        if (mysql_query_with_error_report(mysql, 0, buff))
+        if (mysql_query_with_error_report(mysql_con, 0, buff))
           DBUG_RETURN(1);
       }
       if (opt_lra_pages_before_sleep)
@@ -1877,13 +1910,13 @@ static int connect_to_db(char *host, char *user,char *passwd)
         my_snprintf(buff, sizeof(buff),
                     "SET innodb_lra_pages_before_sleep=%lu",
                     opt_lra_pages_before_sleep);
-        if (mysql_query(mysql, buff))
+        if (mysql_query(mysql_con, buff))
         {
           // Older mysql uses innodb_lra_n_node_recs_before_sleep.
           my_snprintf(buff, sizeof(buff),
                       "SET innodb_lra_n_node_recs_before_sleep=%lu",
                       opt_lra_pages_before_sleep);
-        if (mysql_query_with_error_report(mysql, 0, buff))
+        if (mysql_query_with_error_report(mysql_con, 0, buff))
           DBUG_RETURN(1);
         }
       }
@@ -1897,7 +1930,7 @@ static int connect_to_db(char *host, char *user,char *passwd)
   if (opt_tz_utc)
   {
     my_snprintf(buff, sizeof(buff), "/*!40103 SET TIME_ZONE='+00:00' */");
-    if (mysql_query_with_error_report(mysql, 0, buff))
+    if (mysql_query_with_error_report(mysql_con, 0, buff))
       DBUG_RETURN(1);
   }
 
@@ -1905,20 +1938,56 @@ static int connect_to_db(char *host, char *user,char *passwd)
   {
     my_snprintf(buff, sizeof(buff), "SET session long_query_time=%lu",
         opt_long_query_time);
-    if (mysql_query_with_error_report(mysql, 0, buff))
+    if (mysql_query_with_error_report(mysql_con, 0, buff))
       DBUG_RETURN(1);
   }
 
   /* set innodb_stats_on_metadata if the default engine is InnoDB */
-  if (opt_innodb_stats_on_metadata && default_engine(mysql, "InnoDB"))
+  if (opt_innodb_stats_on_metadata && default_engine(mysql_con, "InnoDB"))
   {
     my_snprintf(buff, sizeof(buff), "SET session innodb_stats_on_metadata=%u",
         opt_innodb_stats_on_metadata);
-    if (mysql_query_with_error_report(mysql, 0, buff))
+    if (mysql_query_with_error_report(mysql_con, 0, buff))
       DBUG_RETURN(1);
   }
 
   DBUG_RETURN(0);
+} /* init_session */
+
+
+/*
+  db_connect -- connects to the host and selects DB.
+*/
+
+static int connect_to_db(char *host, char *user,char *passwd)
+{
+  DBUG_ENTER("connect_to_db");
+
+  if (!(mysql= connect_to_server(&mysql_connection, host, user, passwd)))
+    DBUG_RETURN(1);
+
+  if ((mysql_get_server_version(mysql) < 40100) ||
+      (opt_compatible_mode & 3))
+  {
+    /* Don't dump SET NAMES with a pre-4.1 server (bug#7997).  */
+    opt_set_charset= 0;
+
+    /* Don't switch charsets for 4.1 and earlier.  (bug#34192). */
+    server_supports_switching_charsets= FALSE;
+  } 
+
+  /* Check to see if we support SQL_NO_FCACHE on this server. */
+  if (mysql_query(mysql, "SELECT SQL_NO_FCACHE NOW()") == 0)
+  {
+    MYSQL_RES *res = mysql_store_result(mysql);
+    if (res)
+    {
+      mysql_free_result(res);
+    }
+    server_supports_sql_no_fcache= TRUE;
+  }
+
+  DBUG_RETURN(init_session(mysql));
 } /* connect_to_db */
 
 
@@ -4023,6 +4092,569 @@ static void restore_secondary_keys(char *table)
 
 
 
+/*
+  Parallel dump of table data (--parallel).
+
+  The main connection writes the table structure files as usual, but
+  instead of running SELECT ... INTO OUTFILE itself it queues one job per
+  data file. Jobs are executed by opt_parallel worker threads, each with
+  its own connection. The worker connections start their transactions
+  while the snapshot of the main connection is protected by FLUSH TABLES
+  WITH READ LOCK, or attach to the shared snapshot of the main connection
+  for RocksDB, so all data files are consistent with each other and with
+  the binlog position of the dump.
+
+  Large tables with an integer primary key are split into chunks of about
+  --parallel-chunk-rows rows by primary key ranges, so that one big table
+  does not serialize the dump. Chunk N of table t is written to t.N.txt.
+*/
+
+typedef struct st_parallel_job
+{
+  struct st_parallel_job *next;
+  char *query;                          /* SELECT ... INTO OUTFILE */
+  char *filename;                       /* data file written by the query */
+  char *table;                          /* table name for messages */
+} PARALLEL_JOB;
+
+typedef struct st_parallel_worker
+{
+  MYSQL mysql_connection;
+  MYSQL *mysql;
+  pthread_t thread;
+} PARALLEL_WORKER;
+
+static PARALLEL_WORKER *parallel_workers= NULL;
+static uint parallel_worker_count= 0;
+static PARALLEL_JOB *parallel_queue_head= NULL, *parallel_queue_tail= NULL;
+static pthread_mutex_t parallel_mutex;
+static pthread_cond_t parallel_cond;
+/* No more jobs will be queued */
+static my_bool parallel_done= FALSE;
+/* A worker failed and --force was not given */
+static my_bool parallel_abort= FALSE;
+
+
+/*
+  Computes the name of the data file for a table or a chunk of it, and
+  removes any old file of that name as 'INTO OUTFILE' refuses to
+  overwrite it.
+*/
+
+static void data_file_name(char *filename, const char *name)
+{
+  char tmp_path[FN_REFLEN];
+
+  /*
+    Convert the path to native os format
+    and resolve to the full filepath.
+  */
+  convert_dirname(tmp_path,path,NullS);
+  my_load_path(tmp_path, tmp_path, NULL);
+  fn_format(filename, name, tmp_path, ".txt",
+            MYF(MY_UNPACK_FILENAME | MY_APPEND_EXT));
+
+  /* Must delete the file that 'INTO OUTFILE' will write to */
+  my_delete(filename, MYF(0));
+
+  /* convert to a unix path name to stick into the query */
+  to_unix_path(filename);
+}
+
+
+/*
+  Builds the SELECT ... INTO OUTFILE statement dumping the rows of
+  from_table that match --where and, if given, the condition range.
+*/
+
+static void select_into_outfile_query(DYNAMIC_STRING *query_string,
+                                      const char *filename,
+                                      const char *from_table,
+                                      const char *range)
+{
+  dynstr_append_checked(query_string, "SELECT /*!40001 SQL_NO_CACHE */ ");
+  if (server_supports_sql_no_fcache)
+  {
+    dynstr_append_checked(query_string, "/*!50084 SQL_NO_FCACHE */ ");
+  }
+  dynstr_append_checked(query_string, "* INTO OUTFILE '");
+  dynstr_append_checked(query_string, filename);
+  dynstr_append_checked(query_string, "'");
+
+  dynstr_append_checked(query_string, " /*!50138 CHARACTER SET ");
+  dynstr_append_checked(query_string, default_charset == mysql_universal_client_charset ?
+                                      my_charset_bin.name : /* backward compatibility */
+                                      default_charset);
+  dynstr_append_checked(query_string, " */");
+
+  if (fields_terminated || enclosed || opt_enclosed || escaped)
+    dynstr_append_checked(query_string, " FIELDS");
+
+  add_load_option(query_string, " TERMINATED BY ", fields_terminated);
+  add_load_option(query_string, " ENCLOSED BY ", enclosed);
+  add_load_option(query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
+  add_load_option(query_string, " ESCAPED BY ", escaped);
+  add_load_option(query_string, " LINES TERMINATED BY ", lines_terminated);
+
+  dynstr_append_checked(query_string, " FROM ");
+  dynstr_append_checked(query_string, from_table);
+
+  if (where && range)
+  {
+    dynstr_append_checked(query_string, " WHERE (");
+    dynstr_append_checked(query_string, where);
+    dynstr_append_checked(query_string, ") AND ");
+    dynstr_append_checked(query_string, range);
+  }
+  else if (where || range)
+  {
+    dynstr_append_checked(query_string, " WHERE ");
+    dynstr_append_checked(query_string, where ? where : range);
+  }
+
+  if (order_by)
+  {
+    dynstr_append_checked(query_string, " ORDER BY ");
+    dynstr_append_checked(query_string, order_by);
+  }
+}
+
+
+/*
+  Reports an error of a worker connection. Unlike DB_error() this never
+  exits, as the main thread is still using its connection; the main
+  thread stops queueing jobs and exits once the workers have finished.
+*/
+
+static void parallel_error(MYSQL *mysql_con, const char *table)
+{
+  pthread_mutex_lock(&parallel_mutex);
+  fprintf(stderr, "%s: Got error: %d: %s when dumping data of table %s\n",
+          my_progname, mysql_errno(mysql_con), mysql_error(mysql_con),
+          table);
+  fflush(stderr);
+  if (!first_error)
+    first_error= EX_MYSQLERR;
+  if (!ignore_errors)
+    parallel_abort= TRUE;
+  pthread_cond_broadcast(&parallel_cond);
+  pthread_mutex_unlock(&parallel_mutex);
+}
+
+
+pthread_handler_t parallel_worker_thread(void *arg)
+{
+  PARALLEL_WORKER *worker= (PARALLEL_WORKER*) arg;
+
+  if (mysql_thread_init())
+  {
+    pthread_mutex_lock(&parallel_mutex);
+    fprintf(stderr, "%s: Could not initialize thread\n", my_progname);
+    first_error= EX_MYSQLERR;
+    parallel_abort= TRUE;
+    pthread_cond_broadcast(&parallel_cond);
+    pthread_mutex_unlock(&parallel_mutex);
+    return 0;
+  }
+
+  for (;;)
+  {
+    PARALLEL_JOB *job;
+    struct compress_context *compress_ctx= NULL;
+
+    pthread_mutex_lock(&parallel_mutex);
+    while (!parallel_queue_head && !parallel_done && !parallel_abort)
+      pthread_cond_wait(&parallel_cond, &parallel_mutex);
+    if (parallel_abort || !parallel_queue_head)
+    {
+      pthread_mutex_unlock(&parallel_mutex);
+      break;
+    }
+    job= parallel_queue_head;
+    if (!(parallel_queue_head= job->next))
+      parallel_queue_tail= NULL;
+    pthread_mutex_unlock(&parallel_mutex);
+
+    verbose_msg("-- Dumping data to %s...\n", job->filename);
+
+    if (do_compress)
+      compress_ctx= start_pipe_and_compress_output(
+          job->filename, opt_compression_chunk_size, job->table);
+
+    if (mysql_real_query(worker->mysql, job->query, strlen(job->query)))
+    {
+      parallel_error(worker->mysql, job->table);
+      if (compress_ctx)
+        abort_pipe_and_compress_output(compress_ctx);
+    }
+    else if (compress_ctx)
+      finish_pipe_and_compress_output(compress_ctx);
+
+    my_free(job->query);
+    my_free(job->filename);
+    my_free(job->table);
+    my_free(job);
+  }
+
+  mysql_thread_end();
+  return 0;
+}
+
+
+/*
+  Queues a SELECT ... INTO OUTFILE job for the workers.
+*/
+
+static void parallel_queue_job(const char *query, const char *filename,
+                               const char *table)
+{
+  PARALLEL_JOB *job;
+
+  if (!(job= (PARALLEL_JOB*) my_malloc(sizeof(PARALLEL_JOB),
+                                       MYF(MY_WME | MY_ZEROFILL))) ||
+      !(job->query= my_strdup(query, MYF(MY_WME))) ||
+      !(job->filename= my_strdup(filename, MYF(MY_WME))) ||
+      !(job->table= my_strdup(table, MYF(MY_WME))))
+    die(EX_EOM, "Couldn't allocate memory");
+
+  pthread_mutex_lock(&parallel_mutex);
+  if (parallel_queue_tail)
+    parallel_queue_tail->next= job;
+  else
+    parallel_queue_head= job;
+  parallel_queue_tail= job;
+  pthread_cond_signal(&parallel_cond);
+  pthread_mutex_unlock(&parallel_mutex);
+}
+
+
+/*
+  Returns the quoted name of the primary key column of a table if the
+  primary key is a single integer column, or 0 otherwise.
+*/
+
+static char *parallel_chunk_key(const char *result_table, char *buff,
+                                my_bool *is_unsigned)
+{
+  char query[QUERY_LENGTH];
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  MYSQL_FIELD *field;
+  char *key= 0;
+
+  my_snprintf(query, sizeof(query), "SHOW KEYS FROM %s", result_table);
+  if (mysql_query_with_error_report(mysql, &res, query))
+    return 0;
+
+  /* The primary key is always the first row */
+  if ((row= mysql_fetch_row(res)) && !strcmp(row[2], "PRIMARY") &&
+      (!(row= mysql_fetch_row(res)) || strcmp(row[2], "PRIMARY")))
+  {
+    mysql_data_seek(res, 0);
+    row= mysql_fetch_row(res);
+    key= quote_name(row[4], buff, 0);
+  }
+  mysql_free_result(res);
+
+  if (!key)
+    return 0;
+
+  /* Check the type of the column from the metadata of an empty result */
+  my_snprintf(query, sizeof(query), "SELECT %s FROM %s LIMIT 0",
+              key, result_table);
+  if (mysql_query_with_error_report(mysql, &res, query))
+    return 0;
+
+  field= mysql_fetch_field(res);
+  switch (field->type) {
+  case MYSQL_TYPE_TINY:
+  case MYSQL_TYPE_SHORT:
+  case MYSQL_TYPE_INT24:
+  case MYSQL_TYPE_LONG:
+  case MYSQL_TYPE_LONGLONG:
+    *is_unsigned= MY_TEST(field->flags & UNSIGNED_FLAG);
+    break;
+  default:
+    key= 0;
+  }
+  mysql_free_result(res);
+  return key;
+}
+
+
+/*
+  Maps signed key values to unsigned ones of the same order, so that
+  the chunk boundaries can be computed with unsigned arithmetic.
+*/
+
+static ulonglong parallel_key_to_ulonglong(const char *value,
+                                           my_bool is_unsigned)
+{
+  if (is_unsigned)
+    return strtoull(value, NULL, 10);
+  return ((ulonglong) strtoll(value, NULL, 10)) ^ (1ULL << 63);
+}
+
+
+static void parallel_key_to_str(char *buff, ulonglong value,
+                                my_bool is_unsigned)
+{
+  if (is_unsigned)
+    longlong10_to_str((longlong) value, buff, 10);
+  else
+    longlong10_to_str((longlong) (value ^ (1ULL << 63)), buff, -10);
+}
+
+
+/*
+  Returns the number of chunks the data of a table should be dumped in,
+  and the primary key and its smallest and largest value if more than
+  one. Runs on the main connection, inside the snapshot of the dump.
+*/
+
+static uint parallel_plan_chunks(const char *table, const char *result_table,
+                                 char *key_buff, char **key,
+                                 my_bool *is_unsigned,
+                                 ulonglong *min_key, ulonglong *max_key)
+{
+  char query[QUERY_LENGTH], show_name_buff[FN_REFLEN];
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  ulonglong rows= 0;
+  ulonglong chunks;
+
+  if (!opt_parallel_chunk_rows)
+    return 1;
+
+  my_snprintf(query, sizeof(query), "SHOW TABLE STATUS LIKE %s",
+              quote_for_like(table, show_name_buff));
+  if (mysql_query_with_error_report(mysql, &res, query))
+    return 1;
+  if ((row= mysql_fetch_row(res)) && row[4])
+    rows= strtoull(row[4], NULL, 10);
+  mysql_free_result(res);
+
+  if (rows <= opt_parallel_chunk_rows ||
+      !(*key= parallel_chunk_key(result_table, key_buff, is_unsigned)))
+    return 1;
+
+  my_snprintf(query, sizeof(query), "SELECT MIN(%s), MAX(%s) FROM %s",
+              *key, *key, result_table);
+  if (mysql_query_with_error_report(mysql, &res, query))
+    return 1;
+  row= mysql_fetch_row(res);
+  if (!row || !row[0] || !row[1])
+  {
+    mysql_free_result(res);
+    return 1;
+  }
+  *min_key= parallel_key_to_ulonglong(row[0], *is_unsigned);
+  *max_key= parallel_key_to_ulonglong(row[1], *is_unsigned);
+  mysql_free_result(res);
+
+  chunks= (rows + opt_parallel_chunk_rows - 1) / opt_parallel_chunk_rows;
+  chunks= MY_MIN(chunks, MAX_PARALLEL_CHUNKS);
+  /* Every chunk must cover at least one key value */
+  if (*max_key - *min_key < chunks)
+    chunks= *max_key - *min_key + 1;
+  return (uint) chunks;
+}
+
+
+/*
+  Queues the jobs dumping the data of a table.
+*/
+
+static void parallel_dump_table_data(char *table, char *db,
+                                     char *result_table)
+{
+  char filename[FN_REFLEN], name[NAME_LEN + 12];
+  char db_buff[NAME_LEN*2+3], key_buff[NAME_LEN*2+3];
+  char from_table[NAME_LEN*4+8];
+  char range[NAME_LEN*2+80], from_str[22], to_str[22];
+  DYNAMIC_STRING query_string;
+  char *key= 0;
+  my_bool is_unsigned= FALSE;
+  ulonglong min_key= 0, max_key= 0, step= 0, rest= 0;
+  uint chunks, chunk;
+  DBUG_ENTER("parallel_dump_table_data");
+
+  if (parallel_abort)
+    DBUG_VOID_RETURN;
+
+  /* Workers don't switch databases, so qualify the table name */
+  strxmov(from_table, quote_name(db, db_buff, 1), ".", result_table, NullS);
+
+  chunks= parallel_plan_chunks(table, result_table, key_buff, &key,
+                               &is_unsigned, &min_key, &max_key);
+  if (chunks > 1)
+  {
+    /* Chunk N starts at min_key + step * N + MY_MIN(N, rest) */
+    step= (max_key - min_key) / chunks;
+    rest= (max_key - min_key) % chunks;
+    verbose_msg("-- Dumping data of table %s in %u chunks by %s\n",
+                table, chunks, key);
+  }
+
+  init_dynamic_string_checked(&query_string, "", 1024, 1024);
+  for (chunk= 1; chunk <= chunks; chunk++)
+  {
+    const char *chunk_range= 0;
+
+    if (chunks == 1)
+      data_file_name(filename, table);
+    else
+    {
+      my_snprintf(name, sizeof(name), "%s.%u", table, chunk);
+      data_file_name(filename, name);
+
+      /*
+        The first and the last chunk are open ended, so that no row is
+        lost whatever the boundaries are.
+      */
+      parallel_key_to_str(from_str, min_key + step * (chunk - 1) +
+                          MY_MIN(chunk - 1, rest), is_unsigned);
+      parallel_key_to_str(to_str,
+                          min_key + step * chunk + MY_MIN(chunk, rest),
+                          is_unsigned);
+      if (chunk == 1)
+        my_snprintf(range, sizeof(range), "%s < %s", key, to_str);
+      else if (chunk == chunks)
+        my_snprintf(range, sizeof(range), "%s >= %s", key, from_str);
+      else
+        my_snprintf(range, sizeof(range), "%s >= %s AND %s < %s",
+                    key, from_str, key, to_str);
+      chunk_range= range;
+    }
+
+    dynstr_set_checked(&query_string, "");
+    select_into_outfile_query(&query_string, filename, from_table,
+                              chunk_range);
+    parallel_queue_job(query_string.str, filename, table);
+  }
+  dynstr_free(&query_string);
+  DBUG_VOID_RETURN;
+}
+
+
+/*
+  Opens the worker connections, starts their transactions and the
+  worker threads. Must be called by the main thread after it has started
+  its own transaction and while FLUSH TABLES WITH READ LOCK is held,
+  unless the workers can attach to a shared RocksDB snapshot.
+*/
+
+static int parallel_start(void)
+{
+  uint i;
+  char buff[100];
+  DBUG_ENTER("parallel_start");
+
+  pthread_mutex_init(&parallel_mutex, NULL);
+  pthread_cond_init(&parallel_cond, NULL);
+
+  if (!(parallel_workers= (PARALLEL_WORKER*)
+        my_malloc(opt_parallel * sizeof(PARALLEL_WORKER),
+                  MYF(MY_WME | MY_ZEROFILL))))
+    DBUG_RETURN(1);
+
+  for (i= 0; i < opt_parallel; i++)
+  {
+    PARALLEL_WORKER *worker= &parallel_workers[i];
+
+    if (!(worker->mysql= connect_to_server(&worker->mysql_connection,
+                                           current_host, current_user,
+                                           opt_password)) ||
+        init_session(worker->mysql) ||
+        mysql_query_with_error_report(worker->mysql, 0,
+                                      "SET SESSION TRANSACTION ISOLATION "
+                                      "LEVEL REPEATABLE READ"))
+      DBUG_RETURN(1);
+
+    if (parallel_snapshot_id)
+    {
+      my_snprintf(buff, sizeof(buff),
+                  "START TRANSACTION WITH EXISTING ROCKSDB SNAPSHOT %llu",
+                  parallel_snapshot_id);
+      /* The statement returns the binlog position of the snapshot */
+      if (mysql_query(worker->mysql, buff))
+      {
+        DB_error(worker->mysql, "when attaching to the shared snapshot");
+        DBUG_RETURN(1);
+      }
+      mysql_free_result(mysql_store_result(worker->mysql));
+    }
+    else if (mysql_query_with_error_report(
+               worker->mysql, 0,
+               "START TRANSACTION /*!40100 WITH CONSISTENT SNAPSHOT */"))
+      DBUG_RETURN(1);
+  }
+
+  for (i= 0; i < opt_parallel; i++)
+  {
+    if (pthread_create(&parallel_workers[i].thread, NULL,
+                       parallel_worker_thread, &parallel_workers[i]))
+    {
+      fprintf(stderr, "%s: Could not create thread\n", my_progname);
+      DBUG_RETURN(1);
+    }
+    parallel_worker_count++;
+  }
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Waits until all queued jobs are done, stops the worker threads and
+  closes their connections.
+
+  RETURN VALUES
+    0 all data was dumped
+    1 a worker failed
+*/
+
+static int parallel_end(void)
+{
+  uint i;
+  DBUG_ENTER("parallel_end");
+
+  if (!parallel_workers)
+    DBUG_RETURN(0);
+
+  pthread_mutex_lock(&parallel_mutex);
+  parallel_done= TRUE;
+  pthread_cond_broadcast(&parallel_cond);
+  pthread_mutex_unlock(&parallel_mutex);
+
+  for (i= 0; i < parallel_worker_count; i++)
+    pthread_join(parallel_workers[i].thread, NULL);
+
+  for (i= 0; i < opt_parallel; i++)
+  {
+    if (parallel_workers[i].mysql)
+      mysql_close(parallel_workers[i].mysql);
+  }
+
+  /* Jobs left over after a failure */
+  while (parallel_queue_head)
+  {
+    PARALLEL_JOB *job= parallel_queue_head;
+    parallel_queue_head= job->next;
+    my_free(job->query);
+    my_free(job->filename);
+    my_free(job->table);
+    my_free(job);
+  }
+  parallel_queue_tail= NULL;
+
+  my_free(parallel_workers);
+  parallel_workers= NULL;
+  pthread_mutex_destroy(&parallel_mutex);
+  pthread_cond_destroy(&parallel_cond);
+  DBUG_RETURN(parallel_abort);
+}
+
+
 /*
 
  SYNOPSIS
@@ -4147,6 +4779,12 @@ static void dump_table(char *table, char *db)
   result_table= quote_name(table,table_buff, 1);
   opt_quoted_table= quote_name(table, table_buff2, 0);
 
+  if (path && opt_parallel)
+  {
+    parallel_dump_table_data(table, db, result_table);
+    DBUG_VOID_RETURN;
+  }
+
   verbose_msg("-- Sending SELECT query...\n");
 
   init_dynamic_string_checked(&query_string, "", 1024, 1024);
@@ -4155,62 +4793,10 @@ static void dump_table(char *table, char *db)
 
   if (path)
   {
-    char filename[FN_REFLEN], tmp_path[FN_REFLEN];
-
-    /*
-      Convert the path to native os format
-      and resolve to the full filepath.
-    */
-    convert_dirname(tmp_path,path,NullS);    
-    my_load_path(tmp_path, tmp_path, NULL);
-    fn_format(filename, table, tmp_path, ".txt", MYF(MY_UNPACK_FILENAME | MY_APPEND_EXT));
-
-    /* Must delete the file that 'INTO OUTFILE' will write to */
-    my_delete(filename, MYF(0));
-
-    /* convert to a unix path name to stick into the query */
-    to_unix_path(filename);
-
-    /* now build the query string */
-
-    dynstr_append_checked(&query_string, "SELECT /*!40001 SQL_NO_CACHE */ ");
-    if (server_supports_sql_no_fcache)
-    {
-      dynstr_append_checked(&query_string, "/*!50084 SQL_NO_FCACHE */ ");
-    }
-    dynstr_append_checked(&query_string, "* INTO OUTFILE '");
-    dynstr_append_checked(&query_string, filename);
-    dynstr_append_checked(&query_string, "'");
-
-    dynstr_append_checked(&query_string, " /*!50138 CHARACTER SET ");
-    dynstr_append_checked(&query_string, default_charset == mysql_universal_client_charset ?
-                                         my_charset_bin.name : /* backward compatibility */
-                                         default_charset);
-    dynstr_append_checked(&query_string, " */");
-
-    if (fields_terminated || enclosed || opt_enclosed || escaped)
-      dynstr_append_checked(&query_string, " FIELDS");
-    
-    add_load_option(&query_string, " TERMINATED BY ", fields_terminated);
-    add_load_option(&query_string, " ENCLOSED BY ", enclosed);
-    add_load_option(&query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
-    add_load_option(&query_string, " ESCAPED BY ", escaped);
-    add_load_option(&query_string, " LINES TERMINATED BY ", lines_terminated);
-
-    dynstr_append_checked(&query_string, " FROM ");
-    dynstr_append_checked(&query_string, result_table);
+    char filename[FN_REFLEN];
 
-    if (where)
-    {
-      dynstr_append_checked(&query_string, " WHERE ");
-      dynstr_append_checked(&query_string, where);
-    }
-
-    if (order_by)
-    {
-      dynstr_append_checked(&query_string, " ORDER BY ");
-      dynstr_append_checked(&query_string, order_by);
-    }
+    data_file_name(filename, table);
+    select_into_outfile_query(&query_string, filename, result_table, 0);
 
     struct compress_context *compress_ctx = NULL;
     if (do_compress)
@@ -5920,20 +6506,26 @@ static int start_transaction(MYSQL *mysql_con, char* filename_out,
     MYSQL_RES *res = NULL;
     const char* command_innodb=  "START TRANSACTION WITH CONSISTENT INNODB SNAPSHOT";
     const char* command_rocksdb= "START TRANSACTION WITH CONSISTENT ROCKSDB SNAPSHOT";
+    /* The --parallel connections attach to a shared snapshot */
+    const char* command_rocksdb_shared=
+      "START TRANSACTION WITH SHARED ROCKSDB SNAPSHOT";
 
     if (mysql_query_with_error_report(
         mysql_con, &res,
-        use_rocksdb? command_rocksdb : command_innodb) || !res)
+        use_rocksdb? (opt_parallel ? command_rocksdb_shared : command_rocksdb)
+                   : command_innodb) || !res)
       return 1;
 
     // get the column indexes for all necessary columns
     MYSQL_FIELD *field = NULL;
     int snapshot_hlc_col = -1, gtid_executed_col = -1;
-    int file_col = -1, position_col = -1;
+    int file_col = -1, position_col = -1, snapshot_id_col = -1;
     for (int i = 0; (field = mysql_fetch_field(res)); i++)
     {
       if (strcmp("Snapshot_HLC", field->name) == 0)
         snapshot_hlc_col = i;
+      else if (strcmp("Snapshot_ID", field->name) == 0)
+        snapshot_id_col = i;
       else if (strcmp("Gtid_executed", field->name) == 0)
         gtid_executed_col = i;
       else if (strcmp("File", field->name) == 0)
@@ -5961,6 +6553,9 @@ static int start_transaction(MYSQL *mysql_con, char* filename_out,
 
       if (snapshot_hlc_col != -1)
         strcpy(snapshot_hlc, row[snapshot_hlc_col]);
+
+      if (snapshot_id_col != -1)
+        parallel_snapshot_id= strtoull(row[snapshot_id_col], NULL, 10);
     }
     if (res)
       mysql_free_result(res);
@@ -6733,6 +7328,7 @@ int main(int argc, char **argv)
   char snapshot_hlc[21]= ""; // 20 digits plus trailing null byte
   char* gtid_executed_set = NULL;
   int exit_code, md_result_fd;
+  my_bool unlock_after_parallel_start;
   MY_INIT("mysqldump");
 
   compatible_mode_normal_str[0]= 0;
@@ -6772,10 +7368,16 @@ int main(int argc, char **argv)
   if (opt_slave_data && do_stop_slave_sql(mysql))
     goto err;
 
+  /*
+    With --parallel the read lock also keeps the data from changing until
+    the worker connections have started their transactions.
+  */
   if ((opt_lock_all_tables ||
-       (opt_single_transaction && flush_logs)) &&
+       (opt_single_transaction && (flush_logs || opt_parallel))) &&
       do_flush_tables_read_lock(mysql))
     goto err;
+  unlock_after_parallel_start= opt_single_transaction && opt_parallel &&
+                               !flush_logs;
 
   /*
     Flush logs before starting transaction since
@@ -6809,6 +7411,15 @@ int main(int argc, char **argv)
       start_transaction(
         mysql, bin_log_name, bin_log_pos, &gtid_executed_set, snapshot_hlc))
     goto err;
+
+  if (opt_parallel)
+  {
+    if (parallel_start())
+      goto err;
+    if (unlock_after_parallel_start &&
+        mysql_query_with_error_report(mysql, 0, "UNLOCK TABLES"))
+      goto err;
+  }
   /* Add 'STOP SLAVE to beginning of dump */
   if (opt_slave_apply && add_stop_slave())
     goto err;
@@ -6883,6 +7494,9 @@ int main(int argc, char **argv)
     }
   }
 
+  if (parallel_end())
+    goto err;
+
   /* if --dump-slave , start the slave sql thread */
   if (opt_slave_data && do_start_slave_sql(mysql))
     goto err;
@@ -6934,6 +7548,7 @@ int main(int argc, char **argv)
     server.
   */
 err:
+  parallel_end();
   dbDisconnect(current_host);
   if (!path)
     write_footer(md_result_file);
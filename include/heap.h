@@ -108,6 +108,42 @@ typedef struct st_heap_block
   ulong last_allocated; /* number of records there is allocated space for */
 } HP_BLOCK;
 
+/*
+  BLOB/TEXT columns of internal temporary tables. The record keeps the
+  length and a pointer to the value like in TABLE::record; the value itself
+  is copied into the blob arena of the table when the record is written.
+*/
+
+typedef struct st_hp_blob_desc
+{
+  uint offset;				/* Offset of the column in record */
+  uint packlength;			/* Number of bytes of the length */
+} HP_BLOB_DESC;
+
+/*
+  A page of the blob arena. The values of a record are stored together in
+  one chunk, which is carved from the first page of the list; a chunk larger
+  than the default page size gets a page of its own. The chunk of a deleted
+  record, or of an updated record that needed more space, is put on a free
+  list and reused by later records.
+*/
+
+typedef struct st_hp_blob_page
+{
+  struct st_hp_blob_page *next;
+  size_t size;				/* Bytes of data after the header */
+  size_t used;
+} HP_BLOB_PAGE;
+
+typedef struct st_hp_blob_chunk
+{
+  size_t size;				/* Bytes of data after the header */
+  struct st_hp_blob_chunk *next_free;
+} HP_BLOB_CHUNK;
+
+/* Free chunks of 2^n to 2^(n+1)-1 bytes are kept on free list n */
+#define HP_BLOB_FREE_LISTS (sizeof(size_t) * 8)
+
 struct st_heap_info;			/* For referense */
 
 typedef struct st_hp_keydef		/* Key definition with open */
@@ -156,6 +192,10 @@ typedef struct st_heap_share
   uint auto_key;
   uint auto_key_type;			/* real type of the auto key segment */
   ulonglong auto_increment;
+  HP_BLOB_DESC *blob_descs;
+  uint blobs;				/* Number of BLOB/TEXT columns */
+  HP_BLOB_PAGE *blob_pages;		/* Blob arena, current page first */
+  HP_BLOB_CHUNK *blob_free[HP_BLOB_FREE_LISTS];
 } HP_SHARE;
 
 struct st_hp_hash_info;
@@ -190,6 +230,8 @@ typedef struct st_heap_create_info
   uint auto_key_type;
   uint keys;
   uint reclength;
+  HP_BLOB_DESC *blob_descs;
+  uint blobs;
   ulonglong max_table_size;
   ulonglong auto_increment;
   my_bool with_auto_increment;
@@ -994,6 +994,8 @@ extern size_t escape_quotes_for_mysql(CHARSET_INFO *charset_info,
 
 extern void thd_increment_bytes_sent(ulong length);
 extern void thd_increment_bytes_received(ulong length);
+extern void thd_increment_net_compression(ulong input_length,
+                                          ulong output_length);
 
 #ifdef __WIN__
 extern my_bool have_tcpip;		/* Is set if tcpip is used */
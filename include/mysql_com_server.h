@@ -34,6 +34,19 @@ struct st_net_server
   before_header_callback_fn m_before_header;
   after_header_callback_fn m_after_header;
   void *m_user_data;
+
+  /* Compression level the zstd/lz4f stream context was started with */
+  int m_compress_stream_level;
+  /*
+    State of the adaptive compression: whether m_compress_level replaces
+    the configured level, and the uncompressed bytes and the nanoseconds
+    spent compressing and writing them since the level was last adjusted.
+  */
+  my_bool m_compress_adaptive;
+  int m_compress_level;
+  unsigned long m_compress_window_bytes;
+  unsigned long long m_compress_window_time;
+  unsigned long long m_compress_window_write_time;
 };
 
 typedef struct st_net_server NET_SERVER;
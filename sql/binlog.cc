@@ -97,6 +97,10 @@ char *histogram_step_size_binlog_fsync = NULL;
 int opt_histogram_step_size_binlog_group_commit = 1;
 latency_histogram histogram_binlog_fsync;
 counter_histogram histogram_binlog_group_commit;
+char *histogram_step_size_binlog_stage = NULL;
+latency_histogram histogram_binlog_flush_stage;
+latency_histogram histogram_binlog_sync_stage;
+latency_histogram histogram_binlog_commit_stage;
 
 extern my_bool opt_core_file;
 
@@ -1020,6 +1024,12 @@ static int binlog_init(void *p)
                          histogram_step_size_binlog_fsync);
   counter_histogram_init(&histogram_binlog_group_commit,
                          opt_histogram_step_size_binlog_group_commit);
+  latency_histogram_init(&histogram_binlog_flush_stage,
+                         histogram_step_size_binlog_stage);
+  latency_histogram_init(&histogram_binlog_sync_stage,
+                         histogram_step_size_binlog_stage);
+  latency_histogram_init(&histogram_binlog_commit_stage,
+                         histogram_step_size_binlog_stage);
   return 0;
 }
 
@@ -3733,7 +3743,7 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
   :bytes_written(0), file_id(1), open_count(1),
    sync_period_ptr(sync_period), sync_counter(0),
    m_prep_xids(0),
-   binlog_end_pos(0),
+   binlog_end_pos(0), binlog_flushed_pos(0),
    non_xid_trxs(0),
    is_relay_log(0), signal_cnt(0),
    checksum_alg_reset(BINLOG_CHECKSUM_ALG_UNDEF),
@@ -3748,6 +3758,7 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
     before main().
   */
   index_file_name[0] = 0;
+  binlog_flushed_file_name[0] = 0;
   engine_binlog_file[0] = 0;
   engine_binlog_max_gtid.clear();
   last_master_timestamp.store(0);
@@ -9161,6 +9172,76 @@ void MYSQL_BIN_LOG::update_binlog_end_pos(bool need_lock)
     unlock_binlog_end_pos();
 }
 
+/*
+  Remember the position the flush stage has written the binary log up to.
+  Caller must hold LOCK_log.
+*/
+void MYSQL_BIN_LOG::update_binlog_flushed_pos()
+{
+  mysql_mutex_assert_owner(&LOCK_log);
+  lock_binlog_end_pos();
+  strmake(binlog_flushed_file_name, log_file_name,
+          sizeof(binlog_flushed_file_name)-1);
+  binlog_flushed_pos=
+    is_relay_log ? my_b_append_tell(&log_file) : my_b_tell(&log_file);
+  unlock_binlog_end_pos();
+}
+
+/**
+  Sync the binary log up to the position recorded by the flush stage
+  and publish that position as the binlog end position.
+
+  This is executed by the leader of the sync stage without holding
+  LOCK_log, so the next group can be flushed while this one is synced.
+  Everything that was flushed before the sync is made durable by it, so
+  the position read before calling fsync() covers all groups in the
+  sync stage queue. Nothing is done if another sync has already
+  published that position or if the binary log was rotated meanwhile,
+  as closing the old file has synced it.
+
+  @param async  Same as for sync_binlog_file().
+
+  @return The result of sync_binlog_file().
+*/
+std::pair<bool, bool> MYSQL_BIN_LOG::sync_flushed_binlog(bool async)
+{
+  char file_name[FN_REFLEN];
+  my_off_t pos;
+  bool pending;
+
+  mysql_mutex_assert_owner(&LOCK_sync);
+  mysql_mutex_assert_not_owner(&LOCK_log);
+
+  lock_binlog_end_pos();
+  strmake(file_name, binlog_flushed_file_name, sizeof(file_name)-1);
+  pos= binlog_flushed_pos;
+  pending= !strcmp(file_name, binlog_file_name) && pos > binlog_end_pos;
+  unlock_binlog_end_pos();
+
+  if (!pending)
+    return std::make_pair(false, false);
+
+  DEBUG_SYNC(current_thd, "before_sync_binlog_file");
+  std::pair<bool, bool> result= sync_binlog_file(false, async);
+  if (!result.first)
+  {
+    /*
+      Update the binlog end position only after binlog fsync. Doing so
+      guarantees that slaves don't end up with some transactions that
+      haven't made it to the disk on master because of an os crash or
+      power failure just before binlog fsync.
+    */
+    lock_binlog_end_pos();
+    if (!strcmp(file_name, binlog_file_name) && pos > binlog_end_pos)
+    {
+      binlog_end_pos= pos;
+      signal_update();
+    }
+    unlock_binlog_end_pos();
+  }
+  return result;
+}
+
 /****** transaction coordinator log for 2pc - binlog() based solution ******/
 
 /**
@@ -10597,13 +10678,17 @@ int ask_server_to_register_with_raft(Raft_Registration_Item item)
 
   This will execute an ordered flush and commit of all outstanding
   transactions and is the main function for the binary log group
-  commit logic. The function performs the ordered commit in two
+  commit logic. The function performs the ordered commit in three
   phases.
 
   The first phase flushes the caches to the binary log and under
   LOCK_log and marks all threads that were flushed as not pending.
 
-  The second phase executes under LOCK_commit and commits all
+  The second phase executes under LOCK_sync and syncs the binary log.
+  Since LOCK_log is not held, the next group can be flushed while
+  this one is synced.
+
+  The third phase executes under LOCK_commit and commits all
   transactions in order.
 
   The procedure is:
@@ -10616,9 +10701,11 @@ int ask_server_to_register_with_raft(Raft_Registration_Item item)
      2. For each thread in the queue:
         a. Attach to it
         b. Flush the caches, saving any error code
-     3. Flush and sync (depending on the value of sync_binlog).
-     4. Signal that the binary log was updated
-  4. Release the log lock
+     3. Flush and remember the position flushed up to.
+  4. Queue for syncing, release the log lock and grab the sync lock
+     1. Fetch the queue
+     2. Sync (depending on the value of sync_binlog).
+     3. Signal that the binary log was updated
   5. Grab the commit lock
      1. For each thread in the queue:
         a. If there were no error when flushing and the transaction shall be committed:
@@ -10726,6 +10813,7 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
 
   check_and_register_log_entities(thd);
 
+  ulonglong stage_start_time= my_timer_now();
   THD *final_queue= NULL;
   mysql_mutex_t *leave_mutex_before_commit_stage= NULL;
   my_off_t flush_end_pos= 0;
@@ -10773,32 +10861,17 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
       sql_print_error("Failed to run 'after_flush' hooks");
       flush_error= ER_ERROR_ON_WRITE;
     }
-
-    /*
-      Stage #2: Syncing binary log file to disk
-    */
-    if (total_bytes > 0)
+    else
     {
-      DEBUG_SYNC(thd, "before_sync_binlog_file");
-      std::pair<bool, bool> result = sync_binlog_file(false, async);
-      flush_error = result.first;
+      /*
+        Record the flushed position only after the after_flush hook has
+        executed. Doing so guarantees that the hook is executed before
+        the before/after_send_hooks on the dump thread, preventing race
+        conditions between the group_commit here and the dump threads.
+        The position is published to the dump threads by the sync stage.
+      */
+      update_binlog_flushed_pos();
     }
-
-    /*
-      Update the last valid position after the after_flush hook has
-      executed. Doing so guarantees that the hook is executed before
-      the before/after_send_hooks on the dump thread, preventing race
-      conditions between the group_commit here and the dump threads.
-    */
-    /*
-      Update the binlog end position only after binlog fsync. Doing so
-      guarantees that slave's don't up with some transactions
-      that haven't made it to the disk on master because of a os
-      crash or power failure just before binlog fsync.
-    */
-    update_binlog_end_pos();
-
-    DBUG_EXECUTE_IF("crash_commit_after_log", DBUG_SUICIDE(););
   }
 
   /* simulate a write failure during commit - needed for unit test */
@@ -10816,9 +10889,38 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
     handle_binlog_flush_or_sync_error(thd, false /* need_lock_log */);
   }
 
+  if (histogram_step_size_binlog_stage)
+    latency_histogram_increment(&histogram_binlog_flush_stage,
+                                my_timer_since(stage_start_time), 1);
+
+  /*
+    Stage #2: Syncing binary log file to disk
+
+    LOCK_log is released when entering this stage, so the next group
+    can be flushed while this one is synced. The leader syncs the file
+    for all groups that were flushed before it got LOCK_sync.
+  */
+  if (change_stage(thd, Stage_manager::SYNC_STAGE, final_queue,
+                   &LOCK_log, &LOCK_sync))
+  {
+    DBUG_PRINT("return", ("Thread ID: %u, commit_error: %d",
+                          thd->thread_id(), thd->commit_error));
+    DBUG_RETURN(finish_commit(thd, async));
+  }
+  final_queue= stage_manager.fetch_queue_for(Stage_manager::SYNC_STAGE);
+  leave_mutex_before_commit_stage= &LOCK_sync;
+
+  stage_start_time= my_timer_now();
+  sync_error= sync_flushed_binlog(async).first;
+  if (histogram_step_size_binlog_stage)
+    latency_histogram_increment(&histogram_binlog_sync_stage,
+                                my_timer_since(stage_start_time), 1);
+
+  DBUG_EXECUTE_IF("crash_commit_after_log", DBUG_SUICIDE(););
+
 commit_stage:
   if (change_stage(thd, Stage_manager::SEMISYNC_STAGE, final_queue,
-                   &LOCK_log, &LOCK_semisync))
+                   leave_mutex_before_commit_stage, &LOCK_semisync))
   {
     DBUG_PRINT("return", ("Thread ID: %u, commit_error: %d",
                           thd->thread_id(), thd->commit_error));
@@ -10866,6 +10968,9 @@ commit_stage:
     process_commit_stage_queue(thd, commit_queue, async);
     thd->engine_commit_time = my_timer_since(start_time);
     mysql_mutex_unlock(&LOCK_commit);
+    if (histogram_step_size_binlog_stage)
+      latency_histogram_increment(&histogram_binlog_commit_stage,
+                                  thd->engine_commit_time, 1);
     /*
       Process after_commit after LOCK_commit is released for avoiding
       3-way deadlock among user thread, rotate thread and dump thread.
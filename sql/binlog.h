@@ -29,6 +29,10 @@ extern char *histogram_step_size_binlog_fsync;
 extern int opt_histogram_step_size_binlog_group_commit;
 extern latency_histogram histogram_binlog_fsync;
 extern counter_histogram histogram_binlog_group_commit;
+extern char *histogram_step_size_binlog_stage;
+extern latency_histogram histogram_binlog_flush_stage;
+extern latency_histogram histogram_binlog_sync_stage;
+extern latency_histogram histogram_binlog_commit_stage;
 extern Slow_log_throttle log_throttle_sbr_unsafe_query;
 class Relay_log_info;
 class Master_info;
@@ -536,7 +540,11 @@ public:
      sync_relay_log_period
   */
   uint *sync_period_ptr;
-  uint sync_counter;
+  /*
+    Updated by sync_binlog_file(), which is called under LOCK_log by
+    flush_and_sync() and under LOCK_sync alone by the sync stage.
+  */
+  std::atomic<uint> sync_counter;
 
   my_atomic_rwlock_t m_prep_xids_lock;
   mysql_cond_t m_prep_xids_cond;
@@ -550,6 +558,12 @@ public:
   // binlog_file_name is protected by LOCK_binlog_end_pos mutex where as
   // log_file_name is protected by LOCK_log mutex.
   char binlog_file_name[FN_REFLEN];
+  // End position and file of the last group written by the flush stage.
+  // They are updated under LOCK_log and LOCK_binlog_end_pos, and become
+  // binlog_end_pos once the sync stage has synced the file up to there,
+  // so that the next group can be flushed while this one is synced.
+  my_off_t binlog_flushed_pos;
+  char binlog_flushed_file_name[FN_REFLEN];
 
   /**
     Increment the prepared XID counter.
@@ -977,6 +991,8 @@ public:
   void set_max_size(ulong max_size_arg);
   void signal_update();
   void update_binlog_end_pos(bool need_lock= true);
+  void update_binlog_flushed_pos();
+  std::pair<bool, bool> sync_flushed_binlog(bool async);
   int wait_for_update_relay_log(THD* thd, const struct timespec * timeout);
   int  wait_for_update_bin_log(THD* thd, const struct timespec * timeout);
 public:
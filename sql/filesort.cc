@@ -66,6 +66,8 @@ static int merge_index(Sort_param *param,uchar *sort_buffer,
                        IO_CACHE *outfile);
 static bool save_index(Sort_param *param, uint count,
                        Filesort_info *table_sort);
+static void sort_keys_buffer(THD *thd, Sort_param *param,
+                             Filesort_info *fs_info, uint count);
 static uint suffix_length(ulong string_length);
 static SORT_ADDON_FIELD *get_addon_fields(ulong max_length_for_sort_data,
                                           Field **ptabfield,
@@ -110,6 +112,20 @@ void Sort_param::init_for_filesort(uint sortlen, TABLE *table,
 }
 
 
+/**
+  Memory taken per key while sorting a buffer, besides the record and its
+  pointer: the prefix arrays of prefix_radix_sort(), if it is used, and the
+  merge array of a sort in several threads, if one may be used. This is
+  allocated on the side but counted against sort_buffer_size.
+*/
+
+static size_t sort_bytes_per_key(const Sort_param *param)
+{
+  return (param->use_radix_sort ? PREFIX_RADIX_SORT_BYTES_PER_KEY : 0) +
+    (param->max_sort_threads > 1 ? PARALLEL_SORT_BYTES_PER_KEY : 0);
+}
+
+
 static void trace_filesort_information(Opt_trace_context *trace,
                                        const SORT_FIELD *sortorder,
                                        uint s_length)
@@ -294,6 +310,8 @@ ha_rows filesort(THD *thd, TABLE *table, Filesort *filesort,
                           table,
                           thd->variables.max_length_for_sort_data,
                           max_rows, sort_positions);
+  param.max_sort_threads= thd->variables.filesort_threads;
+  param.use_radix_sort= thd->variables.filesort_radix_sort;
 
   table_sort.addon_buf= 0;
   table_sort.addon_length= param.addon_length;
@@ -351,12 +369,14 @@ ha_rows filesort(THD *thd, TABLE *table, Filesort *filesort,
       See merge_buffers()),
       memory_available must be large enough for
         param->max_keys_per_buffer * (record + record pointer) bytes
-      (the main sort buffer, see alloc_sort_buffer()).
+      (the main sort buffer, see alloc_sort_buffer()), plus the memory
+      sort_bytes_per_key() counts for sorting it.
       Hence this minimum:
     */
     const ulong min_sort_memory=
       max<ulong>(MIN_SORT_MEMORY,
-                 ALIGN_SIZE(MERGEBUFF2 * (param.rec_length + sizeof(uchar*))));
+                 ALIGN_SIZE(MERGEBUFF2 * (param.rec_length + sizeof(uchar*) +
+                                          sort_bytes_per_key(&param))));
     /*
       Cannot depend on num_rows. For external sort, space for upto MERGEBUFF2
       rows is required.
@@ -366,7 +386,8 @@ ha_rows filesort(THD *thd, TABLE *table, Filesort *filesort,
 
     while (memory_available >= min_sort_memory)
     {
-      ha_rows keys= memory_available / (param.rec_length + sizeof(char*));
+      ha_rows keys= memory_available / (param.rec_length + sizeof(char*) +
+                                        sort_bytes_per_key(&param));
       param.max_keys_per_buffer= (uint) min(num_rows, keys);
 
       table_sort.alloc_sort_buffer(param.max_keys_per_buffer, param.rec_length);
@@ -965,7 +986,7 @@ write_keys(Sort_param *param, Filesort_info *fs_info, uint count,
   rec_length= param->rec_length;
   uchar **sort_keys= fs_info->get_sort_keys();
 
-  fs_info->sort_buffer(param, count);
+  sort_keys_buffer(thd, param, fs_info, count);
 
   /*
     Pass fs_info to open to indicate that filesize is to be checked
@@ -1338,13 +1359,30 @@ static void register_used_fields(Sort_param *param)
   }
 }
 
+/**
+  Sort the keys in the sort buffer, in parallel if filesort_threads allows
+  it, and account for parallel sorts in the status variables.
+*/
+
+static void sort_keys_buffer(THD *thd, Sort_param *param,
+                             Filesort_info *fs_info, uint count)
+{
+  const uint threads= fs_info->sort_buffer(param, count);
+  if (threads > 1)
+  {
+    status_var_increment(thd->status_var.filesort_parallel_buffers);
+    thd->status_var.filesort_parallel_threads+= threads;
+  }
+}
+
+
 static bool save_index(Sort_param *param, uint count, Filesort_info *table_sort)
 {
   uint offset,res_length;
   uchar *to;
   DBUG_ENTER("save_index");
 
-  table_sort->sort_buffer(param, count);
+  sort_keys_buffer(current_thd, param, table_sort, count);
   res_length= param->res_length;
   offset= param->rec_length-res_length;
   if (!(to= table_sort->record_pointers= 
@@ -1427,7 +1465,8 @@ bool check_if_pq_applicable(Opt_trace_context *trace,
   }
 
   ulong num_available_keys=
-    memory_available / (param->rec_length + sizeof(char*));
+    memory_available / (param->rec_length + sizeof(char*) +
+                        sort_bytes_per_key(param));
   // We need 1 extra record in the buffer, when using PQ.
   param->max_keys_per_buffer= (uint) param->max_rows + 1;
 
@@ -1464,7 +1503,8 @@ bool check_if_pq_applicable(Opt_trace_context *trace,
   {
     const ulong row_length=
       param->sort_length + param->ref_length + sizeof(char*);
-    num_available_keys= memory_available / row_length;
+    num_available_keys=
+      memory_available / (row_length + sort_bytes_per_key(param));
 
     Opt_trace_object trace_addon(trace, "strip_additional_fields");
     trace_addon.add("row_size", row_length);
@@ -14,14 +14,20 @@
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
 
 #include "filesort_utils.h"
+#include "mysqld.h"                             // filesort_max_threads
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
+#include "myisampack.h"
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <vector>
 
+pthread_handler_t filesort_worker(void *arg);
+
 namespace {
 /**
   A local helper function. See comments for get_merge_buffers_cost().
@@ -183,21 +189,53 @@ size_t try_reserve(std::pair<type*, ptrdiff_t> *buf, ptrdiff_t size)
   return buf->second;
 }
 
-} // namespace
+/* Buffers with fewer keys per thread than this are sorted by one thread */
+const uint MIN_KEYS_PER_SORT_THREAD= 10000;
+
+/* Buffers with fewer keys than this are not sorted by prefix_radix_sort() */
+const uint MIN_KEYS_FOR_RADIX_SORT= 1000;
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+/* Worker threads sorting for all sessions, limited by filesort_max_threads */
+std::atomic<ulong> sort_worker_threads(0);
+
+/*
+  Reserve up to 'wanted' worker threads without exceeding
+  filesort_max_threads, and return how many were reserved.
+*/
+uint reserve_sort_workers(uint wanted)
 {
-  if (count <= 1)
-    return;
-  if (param->sort_length == 0)
+  ulong used= sort_worker_threads.load();
+  for (;;)
+  {
+    const ulong limit= filesort_max_threads;
+    if (used >= limit)
+      return 0;
+    const ulong reserved= std::min<ulong>(wanted, limit - used);
+    if (sort_worker_threads.compare_exchange_weak(used, used + reserved))
+      return (uint) reserved;
+  }
+}
+
+void release_sort_workers(uint reserved)
+{
+  sort_worker_threads-= reserved;
+}
+
+/*
+  Sort an array of pointers to keys of 'sort_length' bytes in the
+  calling thread.
+*/
+void sort_keys(uchar **keys, uint count, size_t sort_length, bool radix_sort)
+{
+  if (radix_sort && count >= MIN_KEYS_FOR_RADIX_SORT &&
+      !prefix_radix_sort(keys, count, sort_length))
     return;
 
-  uchar **keys= get_sort_keys();
   std::pair<uchar**, ptrdiff_t> buffer;
-  if (radixsort_is_appliccable(count, param->sort_length) &&
+  if (radixsort_is_appliccable(count, sort_length) &&
       try_reserve(&buffer, count))
   {
-    radixsort_for_str_ptr(keys, count, param->sort_length, buffer.first);
+    radixsort_for_str_ptr(keys, count, sort_length, buffer.first);
     std::return_temporary_buffer(buffer.first);
     return;
   }
@@ -209,9 +247,396 @@ void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
   */
   if (count < 100)
   {
-    size_t size= param->sort_length;
+    size_t size= sort_length;
     my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
     return;
   }
-  std::stable_sort(keys, keys + count, Mem_compare(param->sort_length));
+  std::stable_sort(keys, keys + count, Mem_compare(sort_length));
+}
+
+
+/*
+  A run of keys for a sort worker to sort, or two adjacent sorted runs of
+  'from' to merge into 'to'.
+*/
+struct Sort_task
+{
+  uchar **from;
+  uchar **to;                   // NULL: sort [begin, end) of 'from'
+  uint begin, middle, end;
+  size_t sort_length;
+  bool radix_sort;
+  uint *pending;                // Tasks of the sort that are not done yet
+};
+
+/*
+  The sort workers are started when they are first needed and then wait for
+  tasks of any session until the server shuts down, so that no thread is
+  created per sorted buffer or merge round. There are at most as many of
+  them as the largest filesort_max_threads since startup.
+*/
+mysql_mutex_t LOCK_sort_workers;
+mysql_cond_t COND_sort_task;            // A task was queued or stop is set
+mysql_cond_t COND_sort_done;            // A task is done
+std::deque<Sort_task> sort_tasks;
+std::vector<pthread_t> sort_workers;
+bool sort_workers_inited= false;
+bool sort_workers_stop= false;
+
+void run_sort_task(const Sort_task &task)
+{
+  if (task.to == NULL)
+    sort_keys(task.from + task.begin, task.end - task.begin,
+              task.sort_length, task.radix_sort);
+  else
+    std::merge(task.from + task.begin, task.from + task.middle,
+               task.from + task.middle, task.from + task.end,
+               task.to + task.begin, Mem_compare(task.sort_length));
+}
+
+/*
+  Start sort workers until there are 'wanted' of them, and return how many
+  there are.
+*/
+size_t start_sort_workers(ulong wanted)
+{
+  if (!sort_workers_inited)
+    return 0;
+
+  mysql_mutex_lock(&LOCK_sort_workers);
+  while (sort_workers.size() < wanted)
+  {
+    pthread_t thread;
+    if (mysql_thread_create(key_thread_filesort_worker, &thread, NULL,
+                            filesort_worker, NULL))
+      break;
+    sort_workers.push_back(thread);
+  }
+  const size_t started= sort_workers.size();
+  mysql_mutex_unlock(&LOCK_sort_workers);
+  return started;
+}
+
+/*
+  Run the first of 'tasks' in the calling thread and queue the others for
+  the sort workers, then wait until all of them are done.
+*/
+void run_sort_tasks(std::vector<Sort_task> *tasks)
+{
+  uint pending= tasks->size() - 1;
+
+  if (pending)
+  {
+    mysql_mutex_lock(&LOCK_sort_workers);
+    for (size_t i= 1; i < tasks->size(); i++)
+    {
+      (*tasks)[i].pending= &pending;
+      sort_tasks.push_back((*tasks)[i]);
+    }
+    mysql_cond_broadcast(&COND_sort_task);
+    mysql_mutex_unlock(&LOCK_sort_workers);
+  }
+
+  run_sort_task((*tasks)[0]);
+
+  if (pending)
+  {
+    mysql_mutex_lock(&LOCK_sort_workers);
+    while (pending)
+      mysql_cond_wait(&COND_sort_done, &LOCK_sort_workers);
+    mysql_mutex_unlock(&LOCK_sort_workers);
+  }
+}
+
+
+/*
+  Merge the sorted runs [bounds[i], bounds[i+1]) of 'from' pairwise into
+  'to', runs 2*k and 2*k+1 into run k, and return the number of runs in
+  'to'. The bounds are updated to describe the merged runs.
+*/
+uint merge_runs(uchar **from, uchar **to, std::vector<uint> *bounds,
+                size_t sort_length)
+{
+  const uint runs= bounds->size() - 1;
+  std::vector<Sort_task> tasks;
+  std::vector<uint> merged;
+  merged.push_back(0);
+
+  for (uint i= 0; i < runs; i+= 2)
+  {
+    const uint begin= (*bounds)[i];
+    const uint middle= (*bounds)[i + 1];
+    const uint end= (*bounds)[std::min(i + 2, runs)];
+    merged.push_back(end);
+
+    if (middle == end)
+    {
+      std::copy(from + begin, from + end, to + begin);
+      continue;
+    }
+    const Sort_task task= { from, to, begin, middle, end, sort_length,
+                            false, NULL };
+    tasks.push_back(task);
+  }
+  if (!tasks.empty())
+    run_sort_tasks(&tasks);
+
+  bounds->swap(merged);
+  return bounds->size() - 1;
+}
+
+/*
+  Keys are sorted by prefix_radix_sort() as an array of these, so that
+  most comparisons and all radix passes only touch this array.
+  'prefix' holds the first PREFIX_BYTES bytes of the key, big-endian and
+  zero-padded, so that comparing prefixes as integers orders them like
+  memcmp() of the keys.
+*/
+struct Sort_prefix
+{
+  ulonglong prefix;
+  uchar *key;
+};
+
+const uint PREFIX_BYTES= sizeof(ulonglong);
+
+/* Buckets with fewer keys than this are sorted by comparison */
+const uint MIN_KEYS_PER_RADIX_BUCKET= 64;
+
+
+class Prefix_compare :
+  public std::binary_function<const Sort_prefix&, const Sort_prefix&, bool>
+{
+public:
+  Prefix_compare(size_t sort_length)
+    : m_suffix_length(sort_length > PREFIX_BYTES ?
+                      sort_length - PREFIX_BYTES : 0)
+  {}
+  bool operator()(const Sort_prefix &s1, const Sort_prefix &s2) const
+  {
+    if (s1.prefix != s2.prefix)
+      return s1.prefix < s2.prefix;
+    return m_suffix_length != 0 &&
+      my_mem_compare(s1.key + PREFIX_BYTES, s2.key + PREFIX_BYTES,
+                     m_suffix_length);
+  }
+  bool has_suffix() const { return m_suffix_length != 0; }
+private:
+  size_t m_suffix_length;
+};
+
+
+inline ulonglong load_prefix(const uchar *key, size_t sort_length)
+{
+  if (sort_length >= PREFIX_BYTES)
+    return mi_uint8korr(key);
+  ulonglong prefix= 0;
+  for (size_t i= 0; i < PREFIX_BYTES; i++)
+    prefix= (prefix << 8) | (i < sort_length ? key[i] : 0);
+  return prefix;
+}
+
+
+/*
+  Stable MSD radix sort of 'entries' on byte 'byte' and the following
+  bytes of the prefixes, using 'tmp' for scattering. Small buckets, and
+  buckets whose prefixes are all equal, are finished with std::stable_sort,
+  which compares the rest of the keys.
+*/
+void radix_sort_prefixes(Sort_prefix *entries, Sort_prefix *tmp, size_t count,
+                         uint byte, uint prefix_bytes,
+                         const Prefix_compare &compare)
+{
+  size_t buckets[256];
+
+  for (;; byte++)
+  {
+    if (byte == prefix_bytes || count < MIN_KEYS_PER_RADIX_BUCKET)
+    {
+      if (byte < prefix_bytes || compare.has_suffix())
+        std::stable_sort(entries, entries + count, compare);
+      return;
+    }
+
+    const uint shift= 8 * (PREFIX_BYTES - 1 - byte);
+    memset(buckets, 0, sizeof(buckets));
+    for (size_t i= 0; i < count; i++)
+      buckets[(entries[i].prefix >> shift) & 0xff]++;
+    if (buckets[(entries[0].prefix >> shift) & 0xff] != count)
+      break;
+    // All keys have the same byte here, try the next one.
+  }
+
+  size_t offset= 0;
+  for (uint b= 0; b < 256; b++)
+  {
+    const size_t size= buckets[b];
+    buckets[b]= offset;
+    offset+= size;
+  }
+  const uint shift= 8 * (PREFIX_BYTES - 1 - byte);
+  for (size_t i= 0; i < count; i++)
+    tmp[buckets[(entries[i].prefix >> shift) & 0xff]++]= entries[i];
+  memcpy(entries, tmp, count * sizeof(Sort_prefix));
+
+  // buckets[b] is now the end of bucket b.
+  size_t start= 0;
+  for (uint b= 0; b < 256; b++)
+  {
+    const size_t end= buckets[b];
+    if (end - start > 1)
+      radix_sort_prefixes(entries + start, tmp + start, end - start,
+                          byte + 1, prefix_bytes, compare);
+    start= end;
+  }
+}
+
+} // namespace
+
+
+bool prefix_radix_sort(uchar **keys, uint count, size_t sort_length)
+{
+  compile_time_assert(PREFIX_RADIX_SORT_BYTES_PER_KEY ==
+                      2 * sizeof(Sort_prefix));
+  Sort_prefix *entries=
+    (Sort_prefix*) my_malloc(2 * (size_t) count * sizeof(Sort_prefix),
+                             MYF(0));
+  if (!entries)
+    return true;
+
+  for (uint i= 0; i < count; i++)
+  {
+    entries[i].prefix= load_prefix(keys[i], sort_length);
+    entries[i].key= keys[i];
+  }
+  radix_sort_prefixes(entries, entries + count, count, 0,
+                      (uint) std::min<size_t>(sort_length, PREFIX_BYTES),
+                      Prefix_compare(sort_length));
+  for (uint i= 0; i < count; i++)
+    keys[i]= entries[i].key;
+
+  my_free(entries);
+  return false;
+}
+
+
+uint Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+{
+  if (count <= 1)
+    return 1;
+  if (param->sort_length == 0)
+    return 1;
+
+  uchar **keys= get_sort_keys();
+  const size_t sort_length= param->sort_length;
+  uint threads= std::min<uint>(param->max_sort_threads,
+                               count / MIN_KEYS_PER_SORT_THREAD);
+  /*
+    The calling thread sorts one run itself. The other runs are sorted,
+    and later merged, by the reserved worker threads.
+  */
+  const uint workers_reserved=
+    threads > 1 ? reserve_sort_workers(threads - 1) : 0;
+  threads= workers_reserved + 1;
+  uchar **tmp;
+  const bool radix_sort= param->use_radix_sort;
+  if (threads <= 1 ||
+      !start_sort_workers(sort_worker_threads.load()) ||
+      !(tmp= (uchar**) my_malloc(count * sizeof(uchar*), MYF(0))))
+  {
+    release_sort_workers(workers_reserved);
+    sort_keys(keys, count, sort_length, radix_sort);
+    return 1;
+  }
+
+  /*
+    Sort one run of keys per thread, the first one in the calling thread,
+    then merge the runs pairwise in parallel until one run is left.
+  */
+  std::vector<uint> bounds;
+  for (uint i= 0; i <= threads; i++)
+    bounds.push_back((uint) ((ulonglong) count * i / threads));
+
+  std::vector<Sort_task> tasks;
+  for (uint i= 0; i < threads; i++)
+  {
+    const Sort_task task= { keys, NULL, bounds[i], bounds[i], bounds[i + 1],
+                            sort_length, radix_sort, NULL };
+    tasks.push_back(task);
+  }
+  run_sort_tasks(&tasks);
+
+  uchar **from= keys;
+  uchar **to= tmp;
+  while (merge_runs(from, to, &bounds, sort_length) > 1)
+    std::swap(from, to);
+  if (to != keys)
+    memcpy(keys, to, count * sizeof(uchar*));
+  my_free(tmp);
+  release_sort_workers(workers_reserved);
+
+  return threads;
+}
+
+
+/*
+  Wait for the tasks of the sorts and run them, until filesort_workers_free()
+  sets sort_workers_stop.
+*/
+pthread_handler_t filesort_worker(void *arg MY_ATTRIBUTE((unused)))
+{
+  my_thread_init();
+  mysql_mutex_lock(&LOCK_sort_workers);
+  for (;;)
+  {
+    while (sort_tasks.empty() && !sort_workers_stop)
+      mysql_cond_wait(&COND_sort_task, &LOCK_sort_workers);
+    if (sort_tasks.empty())
+      break;
+
+    const Sort_task task= sort_tasks.front();
+    sort_tasks.pop_front();
+    mysql_mutex_unlock(&LOCK_sort_workers);
+
+    run_sort_task(task);
+
+    mysql_mutex_lock(&LOCK_sort_workers);
+    if (--*task.pending == 0)
+      mysql_cond_broadcast(&COND_sort_done);
+  }
+  mysql_mutex_unlock(&LOCK_sort_workers);
+  my_thread_end();
+  return 0;
+}
+
+
+void filesort_workers_init()
+{
+  mysql_mutex_init(key_LOCK_sort_workers, &LOCK_sort_workers,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_sort_task, &COND_sort_task, NULL);
+  mysql_cond_init(key_COND_sort_done, &COND_sort_done, NULL);
+  sort_workers_stop= false;
+  sort_workers_inited= true;
+}
+
+
+void filesort_workers_free()
+{
+  if (!sort_workers_inited)
+    return;
+
+  mysql_mutex_lock(&LOCK_sort_workers);
+  sort_workers_stop= true;
+  mysql_cond_broadcast(&COND_sort_task);
+  mysql_mutex_unlock(&LOCK_sort_workers);
+
+  for (size_t i= 0; i < sort_workers.size(); i++)
+    pthread_join(sort_workers[i], NULL);
+  sort_workers.clear();
+
+  sort_workers_inited= false;
+  mysql_cond_destroy(&COND_sort_done);
+  mysql_cond_destroy(&COND_sort_task);
+  mysql_mutex_destroy(&LOCK_sort_workers);
 }
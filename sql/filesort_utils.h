@@ -47,6 +47,47 @@ double get_merge_many_buffs_cost_fast(ha_rows num_rows,
                                       uint    elem_size);
 
 
+/**
+  Sort an array of pointers to keys of 'sort_length' bytes, like memcmp()
+  would order the keys.
+
+  The first 8 bytes of every key are copied into an array next to the key
+  pointer and sorted with a stable MSD radix sort. Keys with equal prefixes
+  are then ordered by comparing the rest of the keys. Most of the work thus
+  touches one sequential array rather than following a pointer per
+  comparison.
+
+  @note
+    Declared here in order to be able to unit test it.
+
+  @retval false  The keys are sorted.
+  @retval true   Out of memory; the keys are untouched.
+*/
+
+bool prefix_radix_sort(uchar **keys, uint count, size_t sort_length);
+
+/**
+  Memory prefix_radix_sort() allocates per key: two arrays of a key pointer
+  and its 8-byte prefix. filesort() counts it against sort_buffer_size.
+*/
+const size_t PREFIX_RADIX_SORT_BYTES_PER_KEY=
+  2 * (sizeof(ulonglong) + sizeof(uchar*));
+
+/**
+  Memory a sort in several threads allocates per key: the array the sorted
+  runs are merged into. filesort() counts it against sort_buffer_size.
+*/
+const size_t PARALLEL_SORT_BYTES_PER_KEY= sizeof(uchar*);
+
+/**
+  Set up and shut down the worker threads that sort and merge the runs of
+  Filesort_buffer::sort_buffer(). The workers are started as they are
+  needed and are shared by all sessions.
+*/
+void filesort_workers_init();
+void filesort_workers_free();
+
+
 /**
   A wrapper class around the buffer used by filesort().
   The buffer is a contiguous chunk of memory,
@@ -66,8 +107,12 @@ public:
     m_idx_array(), m_record_length(0), m_start_of_data(NULL)
   {}
 
-  /** Sort me... */
-  void sort_buffer(const Sort_param *param, uint count);
+  /**
+    Sort me... using up to param->max_sort_threads threads, as far as
+    filesort_max_threads leaves worker threads free.
+    @return the number of threads that sorted the buffer
+  */
+  uint sort_buffer(const Sort_param *param, uint count);
 
   /// Initializes a record pointer.
   uchar *get_record_buffer(uint idx)
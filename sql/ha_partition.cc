@@ -397,6 +397,12 @@ void ha_partition::init_handler_variables()
   part_share= NULL;
   m_new_partitions_share_refs.empty();
   m_sec_sort_by_rowid= false;
+  m_lazy_open= FALSE;
+  m_table_path= NULL;
+  m_part_names= NULL;
+  m_rec_per_key= NULL;
+  m_const_info_pending= FALSE;
+  m_lazy_open_error= 0;
 
 #ifdef DONT_HAVE_TO_BE_INITALIZED
   m_start_key.flag= 0;
@@ -1492,6 +1498,9 @@ int ha_partition::handle_opt_partitions(THD *thd, HA_CHECK_OPT *check_opt,
   DBUG_ENTER("ha_partition::handle_opt_partitions");
   DBUG_PRINT("enter", ("flag= %u", flag));
 
+  if ((error= open_all_partitions()))
+    DBUG_RETURN(error);
+
   do
   {
     partition_element *part_elem= part_it++;
@@ -2269,7 +2278,10 @@ void ha_partition::update_create_info(HA_CREATE_INFO *create_info)
   Since update_create_info() can be called from mysql_prepare_alter_table()
   when not all handlers are set up, we look for that condition first.
   If all handlers are not available, do not call update_create_info for any.
+  The same goes for partitions that cannot be opened.
   */
+  if (open_all_partitions())
+    DBUG_VOID_RETURN;
   uint i, j, part;
   for (i= 0; i < num_parts; i++)
   {
@@ -3310,6 +3322,7 @@ void ha_partition::free_partition_bitmaps()
   bitmap_free(&m_locked_partitions);
   bitmap_free(&m_partitions_to_reset);
   bitmap_free(&m_key_not_found_partitions);
+  bitmap_free(&m_opened_partitions);
 }
 
 
@@ -3358,6 +3371,18 @@ bool ha_partition::init_partition_bitmaps()
   }
   bitmap_clear_all(&m_key_not_found_partitions);
   m_key_not_found= false;
+
+  /* Initialize the bitmap we use to keep track of opened partitions */
+  if (bitmap_init(&m_opened_partitions, NULL, m_tot_parts, FALSE))
+  {
+    bitmap_free(&m_bulk_insert_started);
+    bitmap_free(&m_locked_partitions);
+    bitmap_free(&m_partitions_to_reset);
+    bitmap_free(&m_key_not_found_partitions);
+    DBUG_RETURN(true);
+  }
+  bitmap_clear_all(&m_opened_partitions);
+
   /* Initialize the bitmap for read/lock_partitions */
   if (!m_is_clone_of)
   {
@@ -3456,6 +3481,44 @@ int ha_partition::open(const char *name, int mode, uint test_if_locked)
       name_buffer_ptr+= strlen(name_buffer_ptr) + 1;
     }
   }
+  else if (opt_part_open_lazily && m_innodb && m_tot_parts > 1)
+  {
+    /*
+      Only open the first partition here. The others are opened by
+      open_partitions() once a statement has pruned the partitions it
+      locks or reads. This is limited to InnoDB, where all partitions
+      have the same ref_length, table flags and lock count, so the
+      first partition can stand in for the rest.
+    */
+    uint i, n_key_parts= 0;
+    for (i= 0; i < table->s->keys; i++)
+      n_key_parts+= table->key_info[i].actual_key_parts;
+    if (!(m_table_path= strdup_root(&table->mem_root, name)) ||
+        !(m_part_names= (const char **) alloc_root(&table->mem_root,
+                                                   m_tot_parts *
+                                                   sizeof(char*))) ||
+        !(m_rec_per_key= (ulong *) alloc_root(&table->mem_root,
+                                              (n_key_parts + 1) *
+                                              sizeof(ulong))))
+    {
+      error= HA_ERR_INITIALIZATION;
+      goto err_alloc;
+    }
+    for (i= 0; i < m_tot_parts; i++)
+    {
+      m_part_names[i]= name_buffer_ptr;
+      name_buffer_ptr+= strlen(name_buffer_ptr) + 1;
+    }
+    m_lazy_open= TRUE;
+    m_const_info_pending= FALSE;
+    m_ref_length= 0;
+    if ((error= open_partition(0)))
+    {
+      m_lazy_open= FALSE;
+      goto err_alloc;
+    }
+    m_num_locks= m_file[0]->lock_count();
+  }
   else
   {
    file= m_file;
@@ -3478,7 +3541,8 @@ int ha_partition::open(const char *name, int mode, uint test_if_locked)
   check_table_flags= (((*file)->ha_table_flags() &
                        ~(PARTITION_DISABLED_TABLE_FLAGS)) |
                       (PARTITION_ENABLED_TABLE_FLAGS));
-  while (*(++file))
+  /* Lazily opened partitions are checked by open_partition() */
+  while (!m_lazy_open && *(++file))
   {
     /* MyISAM can have smaller ref_length for partitions with MAX_ROWS set */
     set_if_bigger(ref_length, ((*file)->ref_length));
@@ -3507,9 +3571,11 @@ int ha_partition::open(const char *name, int mode, uint test_if_locked)
 
   /*
     Release buffer read from .par file. It will not be reused again after
-    being opened once.
+    being opened once, unless the partition names in it are needed for
+    opening the remaining partitions lazily.
   */
-  clear_handler_file();
+  if (!m_lazy_open)
+    clear_handler_file();
 
   /*
     Some handlers update statistics as part of the open call. This will in
@@ -3523,7 +3589,8 @@ int ha_partition::open(const char *name, int mode, uint test_if_locked)
                             m_part_info->part_expr->get_monotonicity_info();
   else if (m_part_info->list_of_part_fields)
     m_part_func_monotonicity_info= MONOTONIC_STRICT_INCREASING;
-  info(HA_STATUS_VARIABLE | HA_STATUS_CONST);
+  /* HA_STATUS_VARIABLE would open all partitions in read_partitions */
+  info(m_lazy_open ? HA_STATUS_CONST : HA_STATUS_VARIABLE | HA_STATUS_CONST);
   DBUG_RETURN(0);
 
 err_handler:
@@ -3537,6 +3604,136 @@ err_alloc:
 }
 
 
+/**
+  Open a partition that was left unopened by open().
+
+  @param part_id  Partition to open
+
+  @return Operation status
+    @retval 0     Success
+    @retval != 0  Error code
+*/
+
+int ha_partition::open_partition(uint part_id)
+{
+  int error;
+  handler *file= m_file[part_id];
+  char name_buff[FN_REFLEN];
+  DBUG_ENTER("ha_partition::open_partition");
+  DBUG_PRINT("info", ("open partition %u", part_id));
+  DBUG_ASSERT(m_lazy_open && !bitmap_is_set(&m_opened_partitions, part_id));
+
+  create_partition_name(name_buff, m_table_path, m_part_names[part_id],
+                        NORMAL_PART_NAME, FALSE);
+  /*
+    InnoDB sets rec_per_key from the statistics of the partition alone
+    when it is opened. Keep the values the table had, info() recomputes
+    them from the largest partition once all partitions are open.
+  */
+  copy_rec_per_key(TRUE);
+  error= file->ha_open(table, name_buff, m_mode,
+                       m_open_test_lock | HA_OPEN_NO_PSI_CALL);
+  copy_rec_per_key(FALSE);
+  if (error)
+    DBUG_RETURN(error);
+  /*
+    The first partition was opened in open() and decided ref_length and
+    the table flags, the others must fit in with it.
+  */
+  if (m_ref_length &&
+      (file->ref_length + PARTITION_BYTES_IN_POS > m_ref_length ||
+       file->lock_count() != m_num_locks ||
+       (file->ha_table_flags() & ~(PARTITION_DISABLED_TABLE_FLAGS)) !=
+       (m_file[0]->ha_table_flags() & ~(PARTITION_DISABLED_TABLE_FLAGS))))
+  {
+    file->ha_close();
+    DBUG_RETURN(HA_ERR_INITIALIZATION);
+  }
+  bitmap_set_bit(&m_opened_partitions, part_id);
+  DBUG_RETURN(0);
+}
+
+
+/**
+  Save rec_per_key of all indexes of the table, or restore the saved
+  values.
+
+  @param save  TRUE to save rec_per_key, FALSE to restore it
+*/
+
+void ha_partition::copy_rec_per_key(bool save)
+{
+  ulong *saved= m_rec_per_key;
+  uint i;
+  for (i= 0; i < table->s->keys; i++)
+  {
+    KEY *key= table->key_info + i;
+    size_t size= key->actual_key_parts * sizeof(ulong);
+    if (save)
+      memcpy(saved, key->rec_per_key, size);
+    else
+      memcpy(key->rec_per_key, saved, size);
+    saved+= key->actual_key_parts;
+  }
+}
+
+
+/**
+  Open the partitions in a set that are not opened yet.
+
+  @param parts  Partitions to open
+
+  @return Operation status
+    @retval 0     Success
+    @retval != 0  Error code
+*/
+
+int ha_partition::open_partitions(const MY_BITMAP *parts)
+{
+  int error;
+  uint i;
+  DBUG_ENTER("ha_partition::open_partitions");
+
+  if (!m_lazy_open || bitmap_is_subset(parts, &m_opened_partitions))
+    DBUG_RETURN(0);
+  for (i= bitmap_get_first_set(parts);
+       i < m_tot_parts;
+       i= bitmap_get_next_set(parts, i))
+  {
+    if (!bitmap_is_set(&m_opened_partitions, i) &&
+        (error= open_partition(i)))
+      DBUG_RETURN(error);
+  }
+  DBUG_RETURN(0);
+}
+
+
+/**
+  Open all partitions not opened yet, for operations on the whole table.
+
+  @return Operation status
+    @retval 0     Success
+    @retval != 0  Error code
+*/
+
+int ha_partition::open_all_partitions()
+{
+  int error;
+  uint i;
+  DBUG_ENTER("ha_partition::open_all_partitions");
+
+  if (!m_lazy_open || bitmap_is_set_all(&m_opened_partitions))
+    DBUG_RETURN(0);
+  for (i= 0; i < m_tot_parts; i++)
+  {
+    if (!bitmap_is_set(&m_opened_partitions, i) &&
+        (error= open_partition(i)))
+      DBUG_RETURN(error);
+  }
+  DBUG_RETURN(0);
+}
+
+
 /*
   Disabled since it is not possible to prune yet.
   without pruning, it need to rebind/unbind every partition in every
@@ -3600,6 +3797,10 @@ handler *ha_partition::clone(const char *name, MEM_ROOT *mem_root)
   if (!new_handler)
     DBUG_RETURN(NULL);
 
+  /* The clone is opened from all partitions of the original */
+  if (open_all_partitions())
+    DBUG_RETURN(NULL);
+
   /*
     We will not clone each partition's handler here, it will be done in
     ha_partition::open() for clones. Also set_ha_share_ref is not needed
@@ -3655,14 +3856,14 @@ int ha_partition::close(void)
 
   DBUG_ASSERT(table->s == table_share);
   destroy_record_priority_queue();
-  free_partition_bitmaps();
   DBUG_ASSERT(m_part_info);
   file= m_file;
 
 repeat:
   do
   {
-    (*file)->ha_close();
+    if (!first || is_partition_open(file - m_file))
+      (*file)->ha_close();
   } while (*(++file));
 
   if (first && m_added_file && m_added_file[0])
@@ -3672,6 +3873,12 @@ repeat:
     goto repeat;
   }
 
+  free_partition_bitmaps();
+  if (m_lazy_open)
+  {
+    m_lazy_open= FALSE;
+    clear_handler_file();
+  }
   m_handler_status= handler_closed;
   DBUG_RETURN(0);
 }
@@ -3728,7 +3935,16 @@ int ha_partition::external_lock(THD *thd, int lock_type)
   if (lock_type == F_UNLCK)
     used_partitions= &m_locked_partitions;
   else
+  {
     used_partitions= &(m_part_info->lock_partitions);
+    /* Report failures to open partitions in store_lock() */
+    if ((error= m_lazy_open_error) ||
+        (error= open_partitions(used_partitions)))
+    {
+      m_lazy_open_error= 0;
+      DBUG_RETURN(error);
+    }
+  }
 
   first_used_partition= bitmap_get_first_set(used_partitions);
 
@@ -3842,16 +4058,26 @@ THR_LOCK_DATA **ha_partition::store_lock(THD *thd,
   if (thd != table->in_use)
   {
     for (i= 0; i < m_tot_parts; i++)
-      to= m_file[i]->store_lock(thd, to, lock_type);
+    {
+      if (is_partition_open(i))
+        to= m_file[i]->store_lock(thd, to, lock_type);
+    }
   }
   else
   {
+    /*
+      lock_partitions is pruned at this point, so this is where partitions
+      are opened lazily. An error can not be returned from here, it is
+      returned by external_lock() instead.
+    */
+    m_lazy_open_error= open_partitions(&m_part_info->lock_partitions);
     for (i= bitmap_get_first_set(&(m_part_info->lock_partitions));
          i < m_tot_parts;
          i= bitmap_get_next_set(&m_part_info->lock_partitions, i))
     {
       DBUG_PRINT("info", ("store lock %d iteration", i));
-      to= m_file[i]->store_lock(thd, to, lock_type);
+      if (is_partition_open(i))
+        to= m_file[i]->store_lock(thd, to, lock_type);
     }
   }
   DBUG_RETURN(to);
@@ -4439,6 +4665,9 @@ int ha_partition::truncate()
   handler **file;
   DBUG_ENTER("ha_partition::truncate");
 
+  if ((error= open_all_partitions()))
+    DBUG_RETURN(error);
+
   /*
     TRUNCATE also means resetting auto_increment. Hence, reset
     it so that it will be initialized again at the next use.
@@ -6676,6 +6905,12 @@ int ha_partition::info(uint flag)
         */
         handler *file, **file_array;
         ulonglong auto_increment_value= 0;
+        int error;
+        if ((error= open_all_partitions()))
+        {
+          unlock_auto_increment();
+          DBUG_RETURN(error);
+        }
         file_array= m_file;
         DBUG_PRINT("info",
                    ("checking all partitions for auto_increment_value"));
@@ -6751,6 +6986,9 @@ int ha_partition::info(uint flag)
       We report last time of all underlying handlers
     */
     handler *file;
+    int error;
+    if ((error= open_partitions(&m_part_info->read_partitions)))
+      DBUG_RETURN(error);
     stats.records= 0;
     stats.deleted= 0;
     stats.data_file_length= 0;
@@ -6779,6 +7017,29 @@ int ha_partition::info(uint flag)
     else
       stats.mean_rec_length= 0;
   }
+  if (m_lazy_open && !bitmap_is_set_all(&m_opened_partitions))
+  {
+    if (flag & HA_STATUS_CONST)
+    {
+      /*
+        Which partition holds most rows is not known before all partitions
+        are open. Only take the values that are the same for all
+        partitions from the first one and leave rec_per_key unchanged,
+        it is set below once the last partition has been opened.
+      */
+      DBUG_PRINT("info", ("HA_STATUS_CONST deferred"));
+      stats.block_size= m_file[0]->stats.block_size;
+      stats.create_time= m_file[0]->stats.create_time;
+      ref_length= m_ref_length;
+      m_const_info_pending= TRUE;
+      flag&= ~HA_STATUS_CONST;
+    }
+  }
+  else if (m_const_info_pending)
+  {
+    m_const_info_pending= FALSE;
+    flag|= HA_STATUS_CONST;
+  }
   if (flag & HA_STATUS_CONST)
   {
     DBUG_PRINT("info", ("HA_STATUS_CONST"));
@@ -6891,6 +7152,8 @@ int ha_partition::info(uint flag)
     do
     {
       file= *file_array;
+      if (!is_partition_open(file_array - m_file))
+        continue;
       file->info(HA_STATUS_TIME | no_lock_flag);
       if (file->stats.update_time > stats.update_time)
 	stats.update_time= file->stats.update_time;
@@ -6905,6 +7168,11 @@ void ha_partition::get_dynamic_partition_info(PARTITION_STATS *stat_info,
 {
   handler *file= m_file[part_id];
   DBUG_ASSERT(bitmap_is_set(&(m_part_info->read_partitions), part_id));
+  if (!is_partition_open(part_id) && open_partition(part_id))
+  {
+    memset(stat_info, 0, sizeof(*stat_info));
+    return;
+  }
   file->info(HA_STATUS_TIME | HA_STATUS_VARIABLE |
              HA_STATUS_VARIABLE_EXTRA | HA_STATUS_NO_LOCK);
 
@@ -7442,10 +7710,17 @@ int ha_partition::reset(void)
        i < m_tot_parts;
        i= bitmap_get_next_set(&m_partitions_to_reset, i))
   {
+    /*
+      loop_extra() adds the locked partitions, which include partitions
+      that external_lock() failed to open lazily.
+    */
+    if (!is_partition_open(i))
+      continue;
     if ((tmp= m_file[i]->ha_reset()))
       result= tmp;
   }
   bitmap_clear_all(&m_partitions_to_reset);
+  m_lazy_open_error= 0;
   DBUG_RETURN(result);
 }
 
@@ -7558,6 +7833,9 @@ int ha_partition::loop_extra(enum ha_extra_function operation)
        i < m_tot_parts;
        i= bitmap_get_next_set(&m_part_info->lock_partitions, i))
   {
+    /* Can be called before the partitions are locked and opened */
+    if (!is_partition_open(i))
+      continue;
     if ((tmp= m_file[i]->extra(operation)))
       result= tmp;
   }
@@ -7890,6 +8168,8 @@ bool ha_partition::can_switch_engines()
   handler **file;
   DBUG_ENTER("ha_partition::can_switch_engines");
  
+  if (open_all_partitions())
+    DBUG_RETURN(FALSE);
   file= m_file;
   do
   {
@@ -8266,6 +8546,8 @@ bool ha_partition::check_if_incompatible_data(HA_CREATE_INFO *create_info,
     in mysql_alter_table (by fix_partition_func), so it is only up to
     the underlying handlers.
   */
+  if (open_all_partitions())
+    return COMPATIBLE_DATA_NO;
   for (file= m_file; *file; file++)
     if ((ret=  (*file)->check_if_incompatible_data(create_info,
                                                    table_changes)) !=
@@ -8347,6 +8629,9 @@ ha_partition::check_if_supported_inplace_alter(TABLE *altered_table,
     }
   }
 
+  if (open_all_partitions())
+    DBUG_RETURN(HA_ALTER_ERROR);
+
   part_inplace_ctx=
     new (thd->mem_root) ha_partition_inplace_ctx(thd, m_tot_parts);
   if (!part_inplace_ctx)
@@ -8546,7 +8831,10 @@ void ha_partition::notify_table_changed()
   DBUG_ENTER("ha_partition::notify_table_changed");
 
   for (file= m_file; *file; file++)
-    (*file)->ha_notify_table_changed();
+  {
+    if (is_partition_open(file - m_file))
+      (*file)->ha_notify_table_changed();
+  }
 
   DBUG_VOID_RETURN;
 }
@@ -8712,6 +9000,8 @@ int ha_partition::reset_auto_increment(ulonglong value)
   handler **file= m_file;
   int res;
   DBUG_ENTER("ha_partition::reset_auto_increment");
+  if ((res= open_all_partitions()))
+    DBUG_RETURN(res);
   lock_auto_increment();
   part_share->auto_inc_initialized= false;
   part_share->next_auto_inc_val= 0;
@@ -8756,6 +9046,11 @@ void ha_partition::get_auto_increment(ulonglong offset, ulonglong increment,
     ulonglong first_value_part, max_first_value;
     handler **file= m_file;
     first_value_part= max_first_value= *first_value;
+    if (open_all_partitions())
+    {
+      *first_value= ULONGLONG_MAX;
+      DBUG_VOID_RETURN;
+    }
     /* Must lock and find highest value among all partitions. */
     lock_auto_increment();
     do
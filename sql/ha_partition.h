@@ -265,6 +265,22 @@ private:
   bool m_key_not_found;
   /** Need to sort by ref (rowid) too. */
   bool m_sec_sort_by_rowid;
+  /**
+    Partitions are opened on first use instead of in open(),
+    see part_open_lazily.
+  */
+  bool m_lazy_open;
+  /** keep track of opened partitions when opening them lazily */
+  MY_BITMAP m_opened_partitions;
+  /** Table path and partition names, used when opening lazily */
+  const char *m_table_path;
+  const char **m_part_names;
+  /** rec_per_key of the table saved while a partition is opened lazily */
+  ulong *m_rec_per_key;
+  /** HA_STATUS_CONST is computed by info() once all partitions are open */
+  bool m_const_info_pending;
+  /** Error from opening partitions in store_lock(), see external_lock() */
+  int m_lazy_open_error;
 public:
   Partition_share *get_part_share() { return part_share; }
   handler *clone(const char *name, MEM_ROOT *mem_root);
@@ -388,6 +404,14 @@ private:
   void fix_data_dir(char* path);
   bool init_partition_bitmaps();
   void free_partition_bitmaps();
+  int open_partition(uint part_id);
+  void copy_rec_per_key(bool save);
+  int open_partitions(const MY_BITMAP *parts);
+  int open_all_partitions();
+  bool is_partition_open(uint part_id) const
+  {
+    return !m_lazy_open || bitmap_is_set(&m_opened_partitions, part_id);
+  }
 
 public:
 
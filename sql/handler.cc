@@ -2940,6 +2940,7 @@ int handler::ha_open(TABLE *table_arg, const char *name, int mode,
   }
   stats.reset_table_stats();
   table_stats = NULL;
+  clear_table_stats_delta();
   DBUG_RETURN(error);
 }
 
@@ -2984,6 +2985,7 @@ int handler::ha_close(void)
   DBUG_ASSERT(m_psi == NULL);
   DBUG_ASSERT(m_lock_type == F_UNLCK);
   DBUG_ASSERT(inited == NONE);
+  flush_table_stats_delta();
   DBUG_RETURN(close());
 }
 
@@ -7573,77 +7575,116 @@ void update_shared_table_stats(
 
   NOTES
     Should be called at the end of a statement.
-    TODO(mcallaghan): support more concurrency on update, shard the hash table
+
+    The work is first added to table_stats_delta, which is private to this
+    instance, and merged into the shared counters by
+    flush_table_stats_delta() once table_stats_flush_interval_ms has passed,
+    when another index is used, when TABLE_STATISTICS or INDEX_STATISTICS
+    is read while the handler is unused, or when the handler is closed.
+
+    Unless use_cached_table_stats_ptr is set, table_stats is looked up for
+    every statement. When it is set, the cached table_stats is used until a
+    table is renamed or dropped, so the hot path takes neither
+    LOCK_global_table_stats nor the name map locks.
 */
 void handler::update_global_table_stats(THD *thd)
 {
   if (!stats.has_table_stats() || !thd)
     return;
 
-  if (!table_stats || !use_cached_table_stats_ptr)
-    table_stats = get_table_stats(table, ht);
+  longlong version = my_atomic_load64(&global_table_stats_version);
+
+  if (!table_stats || !use_cached_table_stats_ptr ||
+      table_stats_version != version)
+  {
+    TABLE_STATS *found = get_table_stats(table, ht);
+
+    if (found != table_stats)
+    {
+      /* The buffered work may belong to a freed object: drop it then */
+      if (table_stats_version == version)
+        flush_table_stats_delta();
+      else
+        clear_table_stats_delta();
+      table_stats = found;
+    }
+    table_stats_version = version;
+  }
 
   if (table_stats)
   {
-    /* update the shared table statistics */
-    update_shared_table_stats(thd, &(table_stats->shared_stats), &stats);
+    TABLE_STATS_DELTA *delta = &table_stats_delta;
+    ulonglong now_ms = 0;
+
+    /*
+     * Assume all activity was done for the last active index.
+     */
+    uint ix = MAX_KEY;
+    if (last_active_index < table_stats->indexes->size() &&
+        last_active_index != MAX_KEY)
+      ix = last_active_index;
+
+    if (delta->queries_used && delta->index != ix)
+      flush_table_stats_delta();
+
+    if (table_stats_flush_interval_ms || UTS_LEVEL_BASIC())
+      now_ms = my_getsystime() / 10000;
+
+    if (!delta->queries_used)
+    {
+      delta->index = ix;
+      delta->start_time = now_ms;
+    }
+
+    /* Queries statistics */
+    delta->queries_used++;
+
+    if (thd->lex != NULL &&
+        thd->lex->sql_command == SQLCOM_SELECT &&
+        thd->get_sent_row_count() == 0)
+    {
+      delta->queries_empty++;
+    }
+
+    /* Rows statistics */
+    delta->rows_inserted += stats.rows_inserted;
+    delta->rows_updated += stats.rows_updated;
+    delta->rows_deleted += stats.rows_deleted;
+    delta->rows_read += stats.rows_read;
+    delta->rows_requested += stats.rows_requested;
 
     /* Record the most recent access by admin or non admin user*/
     if (UTS_LEVEL_BASIC())
     {
 #ifndef EMBEDDED_LIBRARY
       /* update usage time statistics (recorded as seconds since epoch) */
-      ulonglong now = my_getsystime() / 10000000;
+      ulonglong now = now_ms / 1000;
 
       USER_CONN *user_conn = get_user_conn_for_stats(thd);
 
       if (user_conn)
       {
         if (check_admin_users_list(user_conn))
-          table_stats->last_admin.set_max_maybe(now);
+          delta->last_admin = now;
         else
-          table_stats->last_non_admin.set_max_maybe(now);
+          delta->last_non_admin = now;
       }
 #endif
     }
-    else
-    {
-      table_stats->last_admin.clear();
-      table_stats->last_non_admin.clear();
-    }
 
     /* update the remaining table statistics, specific to TABLE_STATISTICS */
-    table_stats->index_inserts.inc(stats.index_inserts);
-    table_stats->rows_index_first.inc(stats.rows_index_first);
-    table_stats->rows_index_next.inc(stats.rows_index_next);
+    delta->index_inserts += stats.index_inserts;
+    delta->rows_index_first += stats.rows_index_first;
+    delta->rows_index_next += stats.rows_index_next;
 
-    if (thd && thd->open_tables)
+    if (thd->open_tables)
     {
-      table_stats->comment_bytes.inc(table->count_comment_bytes);
+      delta->comment_bytes += table->count_comment_bytes;
       table->count_comment_bytes = 0;
     }
 
-
-    if (table_stats->indexes->size() > 0 &&
-        last_active_index < table_stats->indexes->size() &&
-        last_active_index != MAX_KEY)
-    {
-      /*
-       * Assume all activity was done for the last active index.
-       */
-      uint ix = last_active_index;
-
-      (*table_stats->indexes)[ix].rows_inserted.inc(stats.rows_inserted);
-      (*table_stats->indexes)[ix].rows_updated.inc(stats.rows_updated);
-      (*table_stats->indexes)[ix].rows_deleted.inc(stats.rows_deleted);
-      (*table_stats->indexes)[ix].rows_read.inc(stats.rows_read);
-      (*table_stats->indexes)[ix].rows_requested.inc(stats.rows_requested);
-
-      (*table_stats->indexes)[ix].io_perf_read.sum(stats.table_io_perf_read);
-
-      (*table_stats->indexes)[ix].rows_index_first.inc(stats.rows_index_first);
-      (*table_stats->indexes)[ix].rows_index_next.inc(stats.rows_index_next);
-    }
+    if (ix != MAX_KEY)
+      delta->io_perf_read.sum(stats.table_io_perf_read);
 
     /*
      * If this instance is used for a table scan next
@@ -7651,6 +7692,8 @@ void handler::update_global_table_stats(THD *thd)
      */
     last_active_index = MAX_KEY;
 
+    if (now_ms - delta->start_time >= table_stats_flush_interval_ms)
+      flush_table_stats_delta();
   }
 
   if (thd)
@@ -7678,6 +7721,84 @@ void handler::update_global_table_stats(THD *thd)
   stats.reset_table_stats();
 }
 
+/*
+  Merges the work buffered in table_stats_delta into table_stats
+
+  SYNOPSIS
+    flush_table_stats_delta
+
+  NOTES
+    Only the thread using this instance changes table_stats_delta, so the
+    merge needs nothing but the atomic increments of the shared counters.
+*/
+void handler::flush_table_stats_delta()
+{
+  TABLE_STATS_DELTA *delta = &table_stats_delta;
+
+  if (!delta->queries_used)
+    return;
+
+  if (!table_stats ||
+      table_stats_version != my_atomic_load64(&global_table_stats_version))
+  {
+    clear_table_stats_delta();
+    return;
+  }
+
+  SHARED_TABLE_STATS *shared_stats = &(table_stats->shared_stats);
+
+  shared_stats->queries_used.inc(delta->queries_used);
+  shared_stats->queries_empty.inc(delta->queries_empty);
+
+  shared_stats->rows_inserted.inc(delta->rows_inserted);
+  shared_stats->rows_updated.inc(delta->rows_updated);
+  shared_stats->rows_deleted.inc(delta->rows_deleted);
+  shared_stats->rows_read.inc(delta->rows_read);
+  shared_stats->rows_requested.inc(delta->rows_requested);
+
+  if (UTS_LEVEL_BASIC())
+  {
+    if (delta->last_admin)
+      table_stats->last_admin.set_max_maybe(delta->last_admin);
+    if (delta->last_non_admin)
+      table_stats->last_non_admin.set_max_maybe(delta->last_non_admin);
+  }
+  else
+  {
+    table_stats->last_admin.clear();
+    table_stats->last_non_admin.clear();
+  }
+
+  table_stats->index_inserts.inc(delta->index_inserts);
+  table_stats->rows_index_first.inc(delta->rows_index_first);
+  table_stats->rows_index_next.inc(delta->rows_index_next);
+  table_stats->comment_bytes.inc(delta->comment_bytes);
+
+  if (delta->index != MAX_KEY && delta->index < table_stats->indexes->size())
+  {
+    INDEX_STATS *index_stats = &(*table_stats->indexes)[delta->index];
+
+    index_stats->rows_inserted.inc(delta->rows_inserted);
+    index_stats->rows_updated.inc(delta->rows_updated);
+    index_stats->rows_deleted.inc(delta->rows_deleted);
+    index_stats->rows_read.inc(delta->rows_read);
+    index_stats->rows_requested.inc(delta->rows_requested);
+
+    index_stats->io_perf_read.sum(delta->io_perf_read);
+
+    index_stats->rows_index_first.inc(delta->rows_index_first);
+    index_stats->rows_index_next.inc(delta->rows_index_next);
+  }
+
+  clear_table_stats_delta();
+}
+
+void handler::clear_table_stats_delta()
+{
+  memset(&table_stats_delta, 0, sizeof(table_stats_delta));
+  table_stats_delta.index = MAX_KEY;
+}
+
 /*
   Updates per-user and per-table counters with work done by this instance
 
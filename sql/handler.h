@@ -2065,6 +2065,10 @@ protected:
   Table_flags cached_table_flags;       /* Set on init() and open() */
   /* table_stats saves a hash table search when set. */
   TABLE_STATS *table_stats;
+  /* global_table_stats_version when table_stats was looked up */
+  longlong table_stats_version;
+  /* Work done by this handler that is not in table_stats yet */
+  TABLE_STATS_DELTA table_stats_delta;
 
   ha_rows estimation_rows_to_insert;
 public:
@@ -2210,7 +2214,7 @@ private:
 public:
   handler(handlerton *ht_arg, TABLE_SHARE *share_arg)
     :table_share(share_arg), table(0),
-    table_stats(NULL),
+    table_stats(NULL), table_stats_version(0),
     estimation_rows_to_insert(0), ht(ht_arg),
     ref(0), range_scan_direction(RANGE_SCAN_ASC),
     in_range_check_pushed_down(false), end_range(NULL),
@@ -2226,6 +2230,7 @@ public:
       DBUG_PRINT("info",
                  ("handler created F_UNLCK %d F_RDLCK %d F_WRLCK %d",
                   F_UNLCK, F_RDLCK, F_WRLCK));
+      clear_table_stats_delta();
     }
   virtual ~handler(void)
   {
@@ -2360,6 +2365,7 @@ public:
   {
     table= table_arg;
     table_share= share;
+    flush_table_stats_delta();
     table_stats= NULL;
     // TODO: Assert that stats have been saved.
     stats.reset_table_stats();
@@ -3335,6 +3341,12 @@ public:
   */
   void update_global_table_stats(THD *thd);
 
+  /* Merge the work buffered by update_global_table_stats() into the global
+     per-table counters.
+  */
+  void flush_table_stats_delta();
+  void clear_table_stats_delta();
+
   /* Update per- user and per-table counters for work done by this handler.
   ** Should be called at the end of a statement.
   */
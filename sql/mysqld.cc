@@ -57,6 +57,8 @@
 #include "derror.h"       // init_errmessage
 #include "des_key_file.h" // load_des_key_file
 #include "sql_manager.h"  // stop_handle_manager, start_handle_manager
+#include "filesort_utils.h" // filesort_workers_init
+#include "opt_range.h"    // range_scan_workers_init
 #include <m_ctype.h>
 #include <my_dir.h>
 #include <my_bit.h>
@@ -73,6 +75,7 @@
 #include "sql_audit.h"
 #include "probes_mysql.h"
 #include "scheduler.h"
+#include "threadpool.h"
 #include "debug_sync.h"
 #include "sql_callback.h"
 #include "opt_trace_context.h"
@@ -507,6 +510,9 @@ my_bool async_query_counter_enabled = 0;
 ulong opt_commit_consensus_error_action= 0;
 my_bool enable_acl_fast_lookup= 0;
 my_bool use_cached_table_stats_ptr;
+ulong table_stats_flush_interval_ms= 0;
+ulong filesort_max_threads= 32;
+ulong range_scan_max_threads= 32;
 longlong max_digest_sample_age;
 ulonglong max_tmp_disk_usage;
 ulonglong tmp_table_disk_usage_period_peak = 0;
@@ -657,6 +663,14 @@ ulonglong repl_semi_sync_master_ack_waits= 0;
 SHOW_VAR latency_histogram_binlog_fsync[NUMBER_OF_HISTOGRAM_BINS + 1];
 ulonglong histogram_binlog_fsync_values[NUMBER_OF_HISTOGRAM_BINS];
 
+/* status variables for binlog group commit stage histograms */
+SHOW_VAR latency_histogram_binlog_flush_stage[NUMBER_OF_HISTOGRAM_BINS + 1];
+ulonglong histogram_binlog_flush_stage_values[NUMBER_OF_HISTOGRAM_BINS];
+SHOW_VAR latency_histogram_binlog_sync_stage[NUMBER_OF_HISTOGRAM_BINS + 1];
+ulonglong histogram_binlog_sync_stage_values[NUMBER_OF_HISTOGRAM_BINS];
+SHOW_VAR latency_histogram_binlog_commit_stage[NUMBER_OF_HISTOGRAM_BINS + 1];
+ulonglong histogram_binlog_commit_stage_values[NUMBER_OF_HISTOGRAM_BINS];
+
 SHOW_VAR
   histogram_binlog_group_commit_var[NUMBER_OF_COUNTER_HISTOGRAM_BINS + 1];
 ulonglong
@@ -666,6 +680,7 @@ uint net_compression_level = 6;
 /* 0 is means default for zstd/lz4. */
 long zstd_net_compression_level = ZSTD_CLEVEL_DEFAULT;
 long lz4f_net_compression_level = 0;
+my_bool net_compression_adaptive= FALSE;
 extern ulonglong compress_ctx_reset;
 extern ulonglong compress_input_bytes;
 extern ulonglong compress_output_bytes;
@@ -852,6 +867,7 @@ ulong delayed_insert_timeout, delayed_insert_limit, delayed_queue_size;
 ulong delayed_insert_threads, delayed_insert_writes, delayed_rows_in_use;
 ulong delayed_insert_errors,flush_time;
 bool flush_only_old_table_cache_entries = false;
+my_bool opt_part_open_lazily= FALSE;
 ulong specialflag=0;
 ulong binlog_cache_use= 0, binlog_cache_disk_use= 0;
 ulong binlog_stmt_cache_use= 0, binlog_stmt_cache_disk_use= 0;
@@ -1543,11 +1559,16 @@ void init_net_server_extension(THD *thd)
   thd->m_net_server_extension.m_user_data= thd;
   thd->m_net_server_extension.m_before_header= net_before_header_psi;
   thd->m_net_server_extension.m_after_header= net_after_header_psi;
-  /* Activate this private extension for the mysqld server. */
-  thd->get_net()->extension= & thd->m_net_server_extension;
 #else
-  thd->get_net()->extension= NULL;
+  thd->m_net_server_extension.m_user_data= NULL;
+  thd->m_net_server_extension.m_before_header= NULL;
+  thd->m_net_server_extension.m_after_header= NULL;
 #endif
+  /* Start the adaptive compression from the configured level. */
+  thd->m_net_server_extension.m_compress_stream_level= 0;
+  thd->m_net_server_extension.m_compress_adaptive= FALSE;
+  /* Activate this private extension for the mysqld server. */
+  thd->get_net()->extension= & thd->m_net_server_extension;
 }
 #endif /* EMBEDDED_LIBRARY */
 
@@ -1791,7 +1812,8 @@ int deny_severity = LOG_WARNING;
 #endif /* HAVE_LIBWRAP */
 #ifdef HAVE_QUERY_CACHE
 ulong query_cache_min_res_unit= QUERY_CACHE_MIN_RESULT_DATA_SIZE;
-Query_cache query_cache;
+ulong query_cache_instances= 1;
+Query_cache_manager query_cache;
 #endif
 #ifdef HAVE_SMEM
 char *shared_memory_base_name= default_shared_memory_base_name;
@@ -2553,6 +2575,9 @@ void clean_up(bool print_message)
   memcached_shutdown();
 
   free_latency_histogram_sysvars(latency_histogram_binlog_fsync);
+  free_latency_histogram_sysvars(latency_histogram_binlog_flush_stage);
+  free_latency_histogram_sysvars(latency_histogram_binlog_sync_stage);
+  free_latency_histogram_sysvars(latency_histogram_binlog_commit_stage);
   free_counter_histogram_sysvars(histogram_binlog_group_commit_var);
 
   /*
@@ -2593,6 +2618,7 @@ void clean_up(bool print_message)
 #endif
   }
   native_procedure_destroy();
+  range_scan_workers_free();
   table_def_start_shutdown();
   plugin_shutdown();
   ha_end();
@@ -2602,6 +2628,7 @@ void clean_up(bool print_message)
   xid_cache_free();
   table_def_free();
   mdl_destroy();
+  filesort_workers_free();
   key_caches.delete_elements(free_key_cache);
   multi_keycache_free();
   free_status_vars();
@@ -3480,6 +3507,15 @@ void destroy_thd(THD *thd)
   delete thd;
 }
 
+/**
+  Account for a connection thread created outside of
+  create_thread_to_handle_connection(), e.g. a thread pool worker.
+*/
+void inc_thread_created(void)
+{
+  thread_created++;
+}
+
 #ifndef EMBEDDED_LIBRARY
 
 static void mysql_pause() {
@@ -6221,6 +6257,8 @@ static int init_server_components()
   randominit(&sql_rand,(ulong) server_start_time,(ulong) server_start_time/2);
   setup_fpu();
   init_thr_lock();
+  filesort_workers_init();
+  range_scan_workers_init();
 #ifdef HAVE_REPLICATION
   init_slave_list();
   init_compressed_event_cache();
@@ -10277,6 +10315,50 @@ static int show_thread_created(THD *thd, SHOW_VAR *var, char *buff)
   return 0;
 }
 
+#ifdef HAVE_POOL_OF_THREADS
+static int show_threadpool_threads(THD *thd, SHOW_VAR *var, char *buff)
+{
+  var->type= SHOW_INT;
+  var->value= buff;
+  *((int *)buff)= tp_thread_count.load();
+  return 0;
+}
+
+static int show_threadpool_idle_threads(THD *thd, SHOW_VAR *var, char *buff)
+{
+  var->type= SHOW_INT;
+  var->value= buff;
+  *((int *)buff)= tp_get_idle_thread_count();
+  return 0;
+}
+
+static int show_threadpool_stalls(THD *thd, SHOW_VAR *var, char *buff)
+{
+  var->type= SHOW_LONGLONG;
+  var->value= buff;
+  *((longlong *)buff)= tp_stall_count.load();
+  return 0;
+}
+
+static int show_threadpool_high_prio_queued(THD *thd, SHOW_VAR *var,
+                                            char *buff)
+{
+  var->type= SHOW_LONGLONG;
+  var->value= buff;
+  *((longlong *)buff)= tp_high_prio_queued.load();
+  return 0;
+}
+
+static int show_threadpool_low_prio_queued(THD *thd, SHOW_VAR *var,
+                                           char *buff)
+{
+  var->type= SHOW_LONGLONG;
+  var->value= buff;
+  *((longlong *)buff)= tp_low_prio_queued.load();
+  return 0;
+}
+#endif
+
 static int show_stmt_time(THD *thd, SHOW_VAR *var, char *buff)
 {
   var->type = SHOW_TIMER;
@@ -10535,6 +10617,31 @@ static int show_prepared_stmt_count(THD *thd, SHOW_VAR *var, char *buff)
   return 0;
 }
 
+#ifdef HAVE_QUERY_CACHE
+/*
+  The query cache counters are kept per instance and summed up here.
+  FLUSH STATUS resets the ones that were flushable through
+  Query_cache_manager::reset_counters().
+*/
+#define SHOW_QCACHE_COUNTER(name, member)                               \
+static int show_qcache_ ## name(THD *thd, SHOW_VAR *var, char *buff)    \
+{                                                                       \
+  var->type= SHOW_LONG;                                                 \
+  var->value= buff;                                                     \
+  *((long *)buff)= (long) query_cache.sum(&Query_cache::member);        \
+  return 0;                                                             \
+}
+
+SHOW_QCACHE_COUNTER(free_blocks, free_memory_blocks)
+SHOW_QCACHE_COUNTER(free_memory, free_memory)
+SHOW_QCACHE_COUNTER(hits, hits)
+SHOW_QCACHE_COUNTER(inserts, inserts)
+SHOW_QCACHE_COUNTER(lowmem_prunes, lowmem_prunes)
+SHOW_QCACHE_COUNTER(not_cached, refused)
+SHOW_QCACHE_COUNTER(queries_in_cache, queries_in_cache)
+SHOW_QCACHE_COUNTER(total_blocks, total_blocks)
+#endif /* HAVE_QUERY_CACHE */
+
 static int show_table_definitions(THD *thd, SHOW_VAR *var, char *buff)
 {
   var->type= SHOW_LONG;
@@ -10559,6 +10666,49 @@ static int show_latency_histogram_binlog_fsync(THD *thd, SHOW_VAR *var,
   return 0;
 }
 
+static void show_latency_histogram_binlog_stage(latency_histogram *histogram,
+                                                SHOW_VAR *histogram_data,
+                                                ulonglong *histogram_values,
+                                                SHOW_VAR *var)
+{
+  for (size_t i = 0; i < NUMBER_OF_HISTOGRAM_BINS; ++i)
+    histogram_values[i] = latency_histogram_get_count(histogram, i);
+
+  prepare_latency_histogram_vars(histogram, histogram_data, histogram_values);
+  var->type= SHOW_ARRAY;
+  var->value = (char*) histogram_data;
+}
+
+static int show_latency_histogram_binlog_flush_stage(THD *thd, SHOW_VAR *var,
+                                                     char *buff)
+{
+  show_latency_histogram_binlog_stage(&histogram_binlog_flush_stage,
+                                      latency_histogram_binlog_flush_stage,
+                                      histogram_binlog_flush_stage_values,
+                                      var);
+  return 0;
+}
+
+static int show_latency_histogram_binlog_sync_stage(THD *thd, SHOW_VAR *var,
+                                                    char *buff)
+{
+  show_latency_histogram_binlog_stage(&histogram_binlog_sync_stage,
+                                      latency_histogram_binlog_sync_stage,
+                                      histogram_binlog_sync_stage_values,
+                                      var);
+  return 0;
+}
+
+static int show_latency_histogram_binlog_commit_stage(THD *thd, SHOW_VAR *var,
+                                                      char *buff)
+{
+  show_latency_histogram_binlog_stage(&histogram_binlog_commit_stage,
+                                      latency_histogram_binlog_commit_stage,
+                                      histogram_binlog_commit_stage_values,
+                                      var);
+  return 0;
+}
+
 static int show_histogram_binlog_group_commit(THD *thd, SHOW_VAR* var,
                                               char *buff)
 {
@@ -11060,6 +11210,8 @@ SHOW_VAR status_vars[]= {
   {"Compression",              (char*) &show_net_compression, SHOW_FUNC},
   {"Compression_context_reset", (char*) &compress_ctx_reset, SHOW_LONGLONG},
   {"Compression_input_bytes",  (char*) &compress_input_bytes, SHOW_LONGLONG},
+  {"Compression_net_input_bytes", (char*) offsetof(STATUS_VAR, net_compress_input_bytes), SHOW_LONGLONG_STATUS},
+  {"Compression_net_output_bytes", (char*) offsetof(STATUS_VAR, net_compress_output_bytes), SHOW_LONGLONG_STATUS},
   {"Compression_output_bytes", (char*) &compress_output_bytes, SHOW_LONGLONG},
   {"Connections",              (char*) &total_thread_ids,              SHOW_LONG_NOFLUSH},
   {"Connection_errors_accept", (char*) &connection_errors_accept, SHOW_LONG},
@@ -11106,6 +11258,8 @@ SHOW_VAR status_vars[]= {
   {"Filesort_disk_usage",      (char*) offsetof(STATUS_VAR, filesort_disk_usage), SHOW_LONGLONG_STATUS},
   {"Filesort_disk_usage_peak", (char*) offsetof(STATUS_VAR, filesort_disk_usage_peak), SHOW_LONGLONG_STATUS},
   {"Filesort_disk_usage_period_peak", (char*) show_filesort_disk_usage_period_peak, SHOW_FUNC},
+  {"Filesort_parallel_buffers", (char*) offsetof(STATUS_VAR, filesort_parallel_buffers), SHOW_LONGLONG_STATUS},
+  {"Filesort_parallel_threads", (char*) offsetof(STATUS_VAR, filesort_parallel_threads), SHOW_LONGLONG_STATUS},
   {"Flashcache_enabled",       (char*) &cachedev_enabled,       SHOW_BOOL },
   {"Flush_commands",           (char*) &refresh_version,        SHOW_LONG_NOFLUSH},
   {"git_hash",                 (char*) git_hash, SHOW_CHAR },
@@ -11155,8 +11309,14 @@ SHOW_VAR status_vars[]= {
   {"Key_writes",               (char*) offsetof(KEY_CACHE, global_cache_write), SHOW_KEY_CACHE_LONGLONG},
   {"Last_query_cost",          (char*) offsetof(STATUS_VAR, last_query_cost), SHOW_DOUBLE_STATUS},
   {"Last_query_partial_plans", (char*) offsetof(STATUS_VAR, last_query_partial_plans), SHOW_LONGLONG_STATUS},
+  {"Latency_histogram_binlog_commit_stage",
+   (char*) &show_latency_histogram_binlog_commit_stage, SHOW_FUNC},
+  {"Latency_histogram_binlog_flush_stage",
+   (char*) &show_latency_histogram_binlog_flush_stage, SHOW_FUNC},
   {"Latency_histogram_binlog_fsync",
    (char*) &show_latency_histogram_binlog_fsync, SHOW_FUNC},
+  {"Latency_histogram_binlog_sync_stage",
+   (char*) &show_latency_histogram_binlog_sync_stage, SHOW_FUNC},
   {"histogram_binlog_group_commit",
    (char*) &show_histogram_binlog_group_commit, SHOW_FUNC},
   {"Max_used_connections",     (char*) &max_used_connections,  SHOW_LONG},
@@ -11178,14 +11338,14 @@ SHOW_VAR status_vars[]= {
   {"Pre_exec_seconds",         (char*) offsetof(STATUS_VAR, pre_exec_time), SHOW_TIMER_STATUS},
   {"Prepared_stmt_count",      (char*) &show_prepared_stmt_count, SHOW_FUNC},
 #ifdef HAVE_QUERY_CACHE
-  {"Qcache_free_blocks",       (char*) &query_cache.free_memory_blocks, SHOW_LONG_NOFLUSH},
-  {"Qcache_free_memory",       (char*) &query_cache.free_memory, SHOW_LONG_NOFLUSH},
-  {"Qcache_hits",              (char*) &query_cache.hits,       SHOW_LONG},
-  {"Qcache_inserts",           (char*) &query_cache.inserts,    SHOW_LONG},
-  {"Qcache_lowmem_prunes",     (char*) &query_cache.lowmem_prunes, SHOW_LONG},
-  {"Qcache_not_cached",        (char*) &query_cache.refused,    SHOW_LONG},
-  {"Qcache_queries_in_cache",  (char*) &query_cache.queries_in_cache, SHOW_LONG_NOFLUSH},
-  {"Qcache_total_blocks",      (char*) &query_cache.total_blocks, SHOW_LONG_NOFLUSH},
+  {"Qcache_free_blocks",       (char*) &show_qcache_free_blocks, SHOW_FUNC},
+  {"Qcache_free_memory",       (char*) &show_qcache_free_memory, SHOW_FUNC},
+  {"Qcache_hits",              (char*) &show_qcache_hits,       SHOW_FUNC},
+  {"Qcache_inserts",           (char*) &show_qcache_inserts,    SHOW_FUNC},
+  {"Qcache_lowmem_prunes",     (char*) &show_qcache_lowmem_prunes, SHOW_FUNC},
+  {"Qcache_not_cached",        (char*) &show_qcache_not_cached, SHOW_FUNC},
+  {"Qcache_queries_in_cache",  (char*) &show_qcache_queries_in_cache, SHOW_FUNC},
+  {"Qcache_total_blocks",      (char*) &show_qcache_total_blocks, SHOW_FUNC},
 #endif /*HAVE_QUERY_CACHE*/
   {"Queries",                  (char*) &show_queries,            SHOW_FUNC},
   {"Questions",                (char*) offsetof(STATUS_VAR, questions), SHOW_LONGLONG_STATUS},
@@ -11270,6 +11430,7 @@ SHOW_VAR status_vars[]= {
   {"Select_full_range_join",   (char*) offsetof(STATUS_VAR, select_full_range_join_count), SHOW_LONGLONG_STATUS},
   {"Select_range",             (char*) offsetof(STATUS_VAR, select_range_count), SHOW_LONGLONG_STATUS},
   {"Select_range_check",       (char*) offsetof(STATUS_VAR, select_range_check_count), SHOW_LONGLONG_STATUS},
+  {"Select_range_parallel",    (char*) offsetof(STATUS_VAR, select_range_parallel_count), SHOW_LONGLONG_STATUS},
   {"Select_scan",	       (char*) offsetof(STATUS_VAR, select_scan_count), SHOW_LONGLONG_STATUS},
 #ifdef HAVE_REPLICATION
   {"Skip_unique_check",        (char*) &show_skip_unique_check, SHOW_FUNC},
@@ -11345,6 +11506,13 @@ SHOW_VAR status_vars[]= {
   {"Tc_log_max_pages_used",    (char*) &tc_log_max_pages_used,  SHOW_LONG},
   {"Tc_log_page_size",         (char*) &tc_log_page_size,       SHOW_LONG_NOFLUSH},
   {"Tc_log_page_waits",        (char*) &tc_log_page_waits,      SHOW_LONG},
+#endif
+#ifdef HAVE_POOL_OF_THREADS
+  {"Threadpool_high_prio_queued", (char*) &show_threadpool_high_prio_queued, SHOW_FUNC},
+  {"Threadpool_idle_threads",  (char*) &show_threadpool_idle_threads, SHOW_FUNC},
+  {"Threadpool_low_prio_queued", (char*) &show_threadpool_low_prio_queued, SHOW_FUNC},
+  {"Threadpool_stalls",        (char*) &show_threadpool_stalls, SHOW_FUNC},
+  {"Threadpool_threads",       (char*) &show_threadpool_threads, SHOW_FUNC},
 #endif
   {"Threads_binlog_client",    (char*) &thread_binlog_client,   SHOW_INT},
   {"Threads_binlog_comp_event_client", (char*) &thread_binlog_comp_event_client, SHOW_INT},
@@ -12495,6 +12663,17 @@ static int get_options(int *argc_ptr, char ***argv_ptr, my_bool logging)
 #else
   if (thread_handling <= SCHEDULER_ONE_THREAD_PER_CONNECTION)
     one_thread_per_connection_scheduler();
+  else if (thread_handling == SCHEDULER_POOL_OF_THREADS)
+  {
+#ifdef HAVE_POOL_OF_THREADS
+    pool_of_threads_scheduler();
+#else
+    sql_print_warning("thread_handling=pool-of-threads is not supported on "
+                      "this platform, using one-thread-per-connection");
+    thread_handling= SCHEDULER_ONE_THREAD_PER_CONNECTION;
+    one_thread_per_connection_scheduler();
+#endif
+  }
   else                  /* thread_handling == SCHEDULER_NO_THREADS) */
     one_thread_scheduler();
 #endif
@@ -13141,6 +13320,9 @@ void refresh_status(THD *thd)
 
   /* Reset the counters of all key caches (default and named). */
   process_key_caches(reset_key_cache_counters);
+#ifdef HAVE_QUERY_CACHE
+  query_cache.reset_counters();
+#endif
   flush_status_time= time((time_t*) 0);
   mysql_mutex_unlock(&LOCK_status);
 
@@ -13251,6 +13433,9 @@ PSI_mutex_key key_LOCK_thread_created;
 PSI_mutex_key key_LOCK_log_throttle_sbr_unsafe;
 PSI_mutex_key key_LOCK_ac_node;
 PSI_mutex_key key_LOCK_ac_info;
+PSI_mutex_key key_LOCK_parallel_range_scan;
+PSI_mutex_key key_LOCK_sort_workers;
+PSI_mutex_key key_LOCK_range_scan_workers;
 
 #ifdef HAVE_MY_TIMER
 PSI_mutex_key key_thd_timer_mutex;
@@ -13371,6 +13556,9 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_USER_CONN_LOCK_user_table_stats, "USER_CONN::LOCK_user_table_stats", 0},
   { &key_LOCK_ac_node, "st_ac_node::lock", 0},
   { &key_LOCK_ac_info, "Ac_info::lock", 0},
+  { &key_LOCK_parallel_range_scan, "QUICK_PARALLEL_RANGE_SELECT::lock", 0},
+  { &key_LOCK_sort_workers, "LOCK_sort_workers", PSI_FLAG_GLOBAL},
+  { &key_LOCK_range_scan_workers, "LOCK_range_scan_workers", PSI_FLAG_GLOBAL},
 };
 
 PSI_rwlock_key key_rwlock_LOCK_column_statistics, key_rwlock_LOCK_grant,
@@ -13458,6 +13646,11 @@ PSI_cond_key key_gtid_ensure_index_cond;
 PSI_cond_key key_hlc_wait_cond;
 PSI_cond_key key_commit_order_manager_cond;
 PSI_cond_key key_COND_ac_node;
+PSI_cond_key key_COND_parallel_range_scan_full;
+PSI_cond_key key_COND_parallel_range_scan_free;
+PSI_cond_key key_COND_sort_task;
+PSI_cond_key key_COND_sort_done;
+PSI_cond_key key_COND_range_scan_task;
 
 static PSI_cond_info all_server_conds[]=
 {
@@ -13512,11 +13705,18 @@ static PSI_cond_info all_server_conds[]=
   { &key_gtid_info_sleep_cond, "Gtid_info::sleep_cond", 0},
   { &key_commit_order_manager_cond, "Commit_order_manager::m_workers.cond", 0},
   { &key_COND_ac_node, "st_ac_node::cond", 0},
+  { &key_COND_parallel_range_scan_full, "QUICK_PARALLEL_RANGE_SELECT::cond_full", 0},
+  { &key_COND_parallel_range_scan_free, "QUICK_PARALLEL_RANGE_SELECT::cond_free", 0},
+  { &key_COND_sort_task, "COND_sort_task", PSI_FLAG_GLOBAL},
+  { &key_COND_sort_done, "COND_sort_done", PSI_FLAG_GLOBAL},
+  { &key_COND_range_scan_task, "COND_range_scan_task", PSI_FLAG_GLOBAL},
 };
 
 PSI_thread_key key_thread_bootstrap, key_thread_delayed_insert,
+  key_thread_filesort_worker,
   key_thread_handle_manager, key_thread_handle_slave_stats_daemon, key_thread_main,
-  key_thread_one_connection, key_thread_signal_hand;
+  key_thread_one_connection, key_thread_parallel_range_scan,
+  key_thread_signal_hand;
 
 #ifdef HAVE_MY_TIMER
 PSI_thread_key key_thread_timer_notifier;
@@ -13546,10 +13746,12 @@ static PSI_thread_info all_server_threads[]=
 
   { &key_thread_bootstrap, "bootstrap", PSI_FLAG_GLOBAL},
   { &key_thread_delayed_insert, "delayed_insert", 0},
+  { &key_thread_filesort_worker, "filesort_worker", PSI_FLAG_GLOBAL},
   { &key_thread_handle_manager, "manager", PSI_FLAG_GLOBAL},
   { &key_thread_handle_slave_stats_daemon, "slave_stats_daemon", PSI_FLAG_GLOBAL},
   { &key_thread_main, "main", PSI_FLAG_GLOBAL},
   { &key_thread_one_connection, "one_connection", 0},
+  { &key_thread_parallel_range_scan, "parallel_range_scan", PSI_FLAG_GLOBAL},
   { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL}
 };
 
@@ -267,6 +267,7 @@ void close_connection(THD *thd, uint sql_errno= 0);
 void handle_connection_in_main_thread(THD *thd);
 void create_thread_to_handle_connection(THD *thd);
 void destroy_thd(THD *thd);
+void inc_thread_created(void);
 bool one_thread_per_connection_end(THD *thd, bool block_pthread);
 void kill_blocked_pthreads();
 void refresh_status(THD *thd);
@@ -430,6 +431,7 @@ extern ulonglong binlog_fsync_count;
 extern uint net_compression_level;
 extern long zstd_net_compression_level;
 extern long lz4f_net_compression_level;
+extern my_bool net_compression_adaptive;
 
 extern ulong relay_io_connected;
 
@@ -451,6 +453,9 @@ extern double wait_for_hlc_sleep_scaling_factor;
 extern my_bool async_query_counter_enabled;
 extern my_bool enable_acl_fast_lookup;
 extern my_bool use_cached_table_stats_ptr;
+extern ulong table_stats_flush_interval_ms;
+extern ulong filesort_max_threads;
+extern ulong range_scan_max_threads;
 extern longlong max_digest_sample_age;
 
 /* Minimum HLC value for this instance. It is ensured that the next 'event' will
@@ -958,7 +963,7 @@ extern ulong delayed_insert_limit, delayed_queue_size;
 extern ulong delayed_insert_threads, delayed_insert_writes;
 extern ulong delayed_rows_in_use,delayed_insert_errors;
 extern int32 slave_open_temp_tables;
-extern ulong query_cache_size, query_cache_min_res_unit;
+extern ulong query_cache_size, query_cache_min_res_unit, query_cache_instances;
 extern ulong slow_launch_threads, slow_launch_time;
 extern ulong table_cache_size, table_def_size;
 extern ulong table_cache_size_per_instance, table_cache_instances;
@@ -993,6 +998,7 @@ extern my_bool rpl_skip_tx_api;
 extern my_bool log_bin_use_v1_row_events;
 extern ulong what_to_log,flush_time;
 extern bool flush_only_old_table_cache_entries;
+extern my_bool opt_part_open_lazily;
 extern ulong max_prepared_stmt_count, prepared_stmt_count;
 extern ulong open_files_limit;
 extern ulong binlog_cache_size, binlog_stmt_cache_size;
@@ -1468,6 +1474,9 @@ extern PSI_mutex_key key_LOCK_thread_created;
 extern PSI_mutex_key key_LOCK_log_throttle_sbr_unsafe;
 extern PSI_mutex_key key_LOCK_ac_node;
 extern PSI_mutex_key key_LOCK_ac_info;
+extern PSI_mutex_key key_LOCK_parallel_range_scan;
+extern PSI_mutex_key key_LOCK_sort_workers;
+extern PSI_mutex_key key_LOCK_range_scan_workers;
 
 extern PSI_rwlock_key key_rwlock_LOCK_column_statistics, key_rwlock_LOCK_grant,
   key_rwlock_LOCK_logger, key_rwlock_LOCK_sys_init_connect,
@@ -1512,11 +1521,16 @@ extern PSI_cond_key key_gtid_ensure_index_cond;
 extern PSI_cond_key key_hlc_wait_cond;
 extern PSI_cond_key key_commit_order_manager_cond;
 extern PSI_cond_key key_COND_ac_node;
+extern PSI_cond_key key_COND_parallel_range_scan_full;
+extern PSI_cond_key key_COND_parallel_range_scan_free;
+extern PSI_cond_key key_COND_sort_task;
+extern PSI_cond_key key_COND_sort_done;
+extern PSI_cond_key key_COND_range_scan_task;
 
 extern PSI_thread_key key_thread_bootstrap, key_thread_delayed_insert,
-  key_thread_handle_manager, key_thread_handle_slave_stats_daemon,
+  key_thread_filesort_worker, key_thread_handle_manager, key_thread_handle_slave_stats_daemon,
   key_thread_kill_server, key_thread_main, key_thread_one_connection,
-  key_thread_signal_hand;
+  key_thread_parallel_range_scan, key_thread_signal_hand;
 
 #ifdef HAVE_MMAP
 extern PSI_file_key key_file_map;
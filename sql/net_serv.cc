@@ -45,6 +45,7 @@
 #include <errno.h>
 #include <sys/uio.h>
 #include "probes_mysql.h"
+#include <my_rdtsc.h>
 #include <openssl/ssl.h>
 #include <mysql/plugin.h>
 
@@ -81,6 +82,7 @@ using std::max;
 extern uint net_compression_level;
 extern long zstd_net_compression_level;
 extern long lz4f_net_compression_level;
+extern my_bool net_compression_adaptive;
 #ifdef HAVE_QUERY_CACHE
 #define USE_QUERY_CACHE
 extern void query_cache_insert(const char *packet, ulong length,
@@ -91,8 +93,10 @@ extern void query_cache_insert(const char *packet, ulong length,
 #define net_compression_level 6
 #define zstd_net_compression_level 0
 #define lz4f_net_compression_level 0
+#define net_compression_adaptive 0
 #define update_statistics(A)
 #define thd_increment_bytes_sent(N)
+#define thd_increment_net_compression(I, O)
 #define thd_wait_begin(A, B)
 #define thd_wait_end(A)
 #endif
@@ -975,6 +979,184 @@ net_write_raw_loop(NET *net, const uchar *buf, size_t count)
 }
 
 
+/**
+  Get the level to compress the next packet of a connection with.
+*/
+
+static int get_compression_level(NET *net)
+{
+  int level = 0;
+
+  switch(net->comp_lib) {
+    case MYSQL_COMPRESSION_ZLIB:
+      level = net_compression_level;
+      break;
+    case MYSQL_COMPRESSION_ZSTD:
+    case MYSQL_COMPRESSION_ZSTD_STREAM:
+      level = zstd_net_compression_level;
+      break;
+    case MYSQL_COMPRESSION_LZ4F_STREAM:
+      level = lz4f_net_compression_level;
+      break;
+    case MYSQL_COMPRESSION_NONE:
+      DBUG_ASSERT(0);
+      break;
+  }
+
+#ifdef MYSQL_SERVER
+  NET_SERVER *ext= static_cast<NET_SERVER *>(net->extension);
+  if (ext != NULL && ext->m_compress_adaptive)
+  {
+    if (net_compression_adaptive)
+      return ext->m_compress_level;
+    ext->m_compress_adaptive= FALSE;
+  }
+#endif
+  return level;
+}
+
+
+#ifdef MYSQL_SERVER
+/* Uncompressed bytes sent between two adjustments of the level */
+#define NET_COMPRESSION_WINDOW (1024 * 1024)
+
+/**
+  Adjust the compression level of a connection to where the time to send
+  its packets goes.
+
+  @param  net          NET handler.
+  @param  length       Length of the packet before compression.
+  @param  comp_time    Nanoseconds spent compressing the packet.
+  @param  write_time   Nanoseconds spent writing the packet.
+
+  Whenever NET_COMPRESSION_WINDOW bytes have been sent, the time spent
+  compressing them is compared to the time spent writing them. If
+  compressing took more than twice as long, the network takes the data
+  faster than it is compressed and the level is lowered. If writing took
+  more than twice as long, the network is the bottleneck and the level is
+  raised to send fewer bytes. Changing the level of a zstd or lz4f stream
+  restarts the stream, see net_restart_compress_stream().
+
+  The state is kept in the NET_SERVER extension, so only the connections
+  of clients are adapted.
+*/
+
+static void net_adapt_compression_level(NET *net, size_t length,
+                                        ulonglong comp_time,
+                                        ulonglong write_time)
+{
+  NET_SERVER *ext= static_cast<NET_SERVER *>(net->extension);
+  int min_level, max_level;
+
+  if (ext == NULL)
+    return;
+
+  switch (net->comp_lib) {
+  case MYSQL_COMPRESSION_ZLIB:
+    min_level= 1;
+    max_level= 9;
+    break;
+  case MYSQL_COMPRESSION_ZSTD:
+  case MYSQL_COMPRESSION_ZSTD_STREAM:
+    min_level= 1;
+    max_level= 19;
+    break;
+  case MYSQL_COMPRESSION_LZ4F_STREAM:
+    /* Levels below 3 select the fast mode, the others LZ4 HC */
+    min_level= 2;
+    max_level= 12;
+    break;
+  default:
+    return;
+  }
+
+  if (!ext->m_compress_adaptive)
+  {
+    /* Start from the configured level */
+    ext->m_compress_level= std::min(std::max(get_compression_level(net),
+                                           min_level), max_level);
+    ext->m_compress_window_bytes= 0;
+    ext->m_compress_window_time= 0;
+    ext->m_compress_window_write_time= 0;
+    ext->m_compress_adaptive= TRUE;
+  }
+
+  ext->m_compress_window_bytes+= length;
+  ext->m_compress_window_time+= comp_time;
+  ext->m_compress_window_write_time+= write_time;
+  if (ext->m_compress_window_bytes < NET_COMPRESSION_WINDOW)
+    return;
+
+  if (ext->m_compress_window_time > 2 * ext->m_compress_window_write_time &&
+      ext->m_compress_level > min_level)
+    ext->m_compress_level--;
+  else if (ext->m_compress_window_write_time >
+             2 * ext->m_compress_window_time &&
+           ext->m_compress_level < max_level)
+    ext->m_compress_level++;
+
+  ext->m_compress_window_bytes= 0;
+  ext->m_compress_window_time= 0;
+  ext->m_compress_window_write_time= 0;
+}
+
+
+/**
+  Restart the zstd or lz4f stream of a connection when the level to
+  compress with changed since the stream was started.
+
+  @param  net    NET handler.
+  @param  level  Level to compress the next packet with.
+
+  The context is dropped or marked for reset, so that the next packet
+  starts a new stream with the new level.
+
+  @retval TRUE   The stream was restarted. The packet must be sent
+                 uncompressed, which resets the stream of the receiver.
+  @retval FALSE  The packet can be compressed.
+*/
+
+static my_bool net_restart_compress_stream(NET *net, int level)
+{
+  NET_SERVER *ext= static_cast<NET_SERVER *>(net->extension);
+
+  if (ext == NULL)
+    return FALSE;
+
+  switch (net->comp_lib) {
+  case MYSQL_COMPRESSION_ZSTD_STREAM:
+    if (net->cctx == NULL)
+    {
+      /* my_compress() starts the stream with this level */
+      ext->m_compress_stream_level= level;
+      return FALSE;
+    }
+    if (level == ext->m_compress_stream_level)
+      return FALSE;
+    ZSTD_freeCCtx(net->cctx);
+    net->cctx= NULL;
+    break;
+  case MYSQL_COMPRESSION_LZ4F_STREAM:
+    if (net->lz4f_cctx == NULL || net->reset_cctx)
+    {
+      ext->m_compress_stream_level= level;
+      return FALSE;
+    }
+    if (level == ext->m_compress_stream_level)
+      return FALSE;
+    net->reset_cctx= TRUE;
+    break;
+  default:
+    return FALSE;
+  }
+
+  DBUG_PRINT("note", ("compression stream level %d -> %d",
+                      ext->m_compress_stream_level, level));
+  return TRUE;
+}
+#endif /* MYSQL_SERVER */
+
+
 /**
   Compress and encapsulate a packet into a compressed packet.
 
@@ -1003,36 +1185,27 @@ compress_packet(NET *net, const uchar *packet, size_t *length)
 
   memcpy(compr_packet + header_length, packet, *length);
 
-  int level = 0;
-
-  switch(net->comp_lib) {
-    case MYSQL_COMPRESSION_ZLIB:
-      level = net_compression_level;
-      break;
-    case MYSQL_COMPRESSION_ZSTD:
-    case MYSQL_COMPRESSION_ZSTD_STREAM:
-      level = zstd_net_compression_level;
-      break;
-    case MYSQL_COMPRESSION_LZ4F_STREAM:
-      level = lz4f_net_compression_level;
-      break;
-    case MYSQL_COMPRESSION_NONE:
-      DBUG_ASSERT(0);
-      break;
-  }
+  const int level= get_compression_level(net);
 
   /* Compress the encapsulated packet. */
-  if (my_compress(net, compr_packet + header_length,
-                  length, &compr_length,
-                  level))
+  if (
+#ifdef MYSQL_SERVER
+      net_restart_compress_stream(net, level) ||
+#endif
+      my_compress(net, compr_packet + header_length,
+                  length, &compr_length, level))
   {
     /*
       If the length of the compressed packet is larger than the
-      original packet, the original packet is sent uncompressed.
+      original packet, or the stream was restarted with a new level,
+      the original packet is sent uncompressed.
     */
     compr_length= 0;
   }
 
+  update_statistics(thd_increment_net_compression(
+                      compr_length ? compr_length : *length, *length));
+
   /* Length of the compressed (original) packet. */
   int3store(&compr_packet[NET_HEADER_SIZE], compr_length);
   /* Length of this packet. */
@@ -1076,6 +1249,14 @@ net_write_packet(NET *net, const uchar *packet, size_t length)
 
 #ifdef HAVE_COMPRESS
   const bool do_compress= net->compress;
+#ifdef MYSQL_SERVER
+  /* Time the compression and the write to adapt the level */
+  const bool adapt_level= do_compress && net_compression_adaptive;
+  const size_t uncompressed_length= length;
+  ulonglong start_time= 0, write_start_time= 0;
+  if (adapt_level)
+    start_time= my_timer_nanoseconds();
+#endif
   if (do_compress)
   {
     if ((packet= compress_packet(net, packet, &length)) == NULL)
@@ -1087,6 +1268,10 @@ net_write_packet(NET *net, const uchar *packet, size_t length)
       DBUG_RETURN(TRUE);
     }
   }
+#ifdef MYSQL_SERVER
+  if (adapt_level)
+    write_start_time= my_timer_nanoseconds();
+#endif
 #endif /* HAVE_COMPRESS */
 
 #ifdef DEBUG_DATA_PACKETS
@@ -1098,6 +1283,12 @@ net_write_packet(NET *net, const uchar *packet, size_t length)
 #ifdef HAVE_COMPRESS
   if (do_compress)
     my_free((void *) packet);
+#ifdef MYSQL_SERVER
+  if (adapt_level && !res)
+    net_adapt_compression_level(net, uncompressed_length,
+                                write_start_time - start_time,
+                                my_timer_nanoseconds() - write_start_time);
+#endif
 #endif
 
   net->reading_or_writing= 0;
@@ -1288,10 +1479,10 @@ static my_bool net_read_packet_header(NET *net)
 
   server_extension= static_cast<st_net_server*> (net->extension);
 
-  if (server_extension != NULL)
+  if (server_extension != NULL &&
+      server_extension->m_before_header != NULL)
   {
     void *user_data= server_extension->m_user_data;
-    DBUG_ASSERT(server_extension->m_before_header != NULL);
     DBUG_ASSERT(server_extension->m_after_header != NULL);
 
     server_extension->m_before_header(net, user_data, count);
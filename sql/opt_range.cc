@@ -120,6 +120,11 @@
 
 #include "blind_fwrite.h"
 #include "mysys_err.h"           // EE_CAPACITY_EXCEEDED
+#include "transaction.h"         // trans_commit_stmt
+
+#include <atomic>
+#include <deque>
+#include <vector>
 
 using std::min;
 using std::max;
@@ -11316,6 +11321,763 @@ QUICK_SELECT_I *QUICK_RANGE_SELECT::make_reverse(uint used_key_parts_arg)
 }
 
 
+/*
+  Create a quick select that reads the ranges of this one in several
+  worker threads.
+
+  @param thd      The session
+  @param threads  Maximum number of worker threads
+
+  @retval NULL in case of errors (OOM etc)
+  @retval pointer to a newly created QUICK_PARALLEL_RANGE_SELECT if success
+*/
+
+QUICK_SELECT_I *QUICK_RANGE_SELECT::make_parallel(THD *thd, uint threads)
+{
+  bool error= FALSE;
+  QUICK_PARALLEL_RANGE_SELECT *new_quick=
+    new QUICK_PARALLEL_RANGE_SELECT(this, thd, threads, &error);
+  if (new_quick == NULL || error)
+  {
+    delete new_quick;
+    return NULL;
+  }
+  return new_quick;
+}
+
+
+/* Size of the batches of rows passed from the workers to the session */
+static const uint parallel_range_batch_size= 64 * 1024;
+
+/* Number of batches allocated for each worker */
+static const uint parallel_range_batches_per_worker= 2;
+
+
+QUICK_PARALLEL_RANGE_SELECT::QUICK_PARALLEL_RANGE_SELECT(QUICK_RANGE_SELECT *q,
+                                                         THD *thd_arg,
+                                                         uint threads_arg,
+                                                         bool *create_err)
+ :QUICK_RANGE_SELECT(*q), thd(thd_arg), hton(q->head->file->ht),
+  n_threads(threads_arg), read_view(NULL), serial(false), keyread(false),
+  next_range(0), started_threads(0), batch_buffer(NULL),
+  batches(NULL), rows_per_batch(0), free_batches(NULL), full_batches(NULL),
+  cur_batch(NULL), running_threads(0), scan_error(0), abort_scan(false)
+{
+  const uint n_batches= n_threads * parallel_range_batches_per_worker;
+  const ulong reclength= head->s->reclength;
+  QUICK_RANGE **pr= (QUICK_RANGE**) ranges.buffer;
+  QUICK_RANGE **end_range= pr + ranges.elements;
+
+  /*
+    The workers use the default MRR implementation, and so does the
+    session thread if it has to read the ranges itself.
+  */
+  mrr_buf_desc= NULL;
+  mrr_flags|= HA_MRR_USE_DEFAULT_IMPL;
+  mrr_buf_size= 0;
+
+  mysql_mutex_init(key_LOCK_parallel_range_scan, &lock, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_parallel_range_scan_full, &cond_full, NULL);
+  mysql_cond_init(key_COND_parallel_range_scan_free, &cond_free, NULL);
+
+  /* A single range is split so that all workers have something to read */
+  my_init_dynamic_array(&scan_ranges, sizeof(QUICK_RANGE*),
+                        max<uint>(ranges.elements, n_threads), 16);
+  if (ranges.elements != 1 || split_range(*pr, n_threads))
+  {
+    scan_ranges.elements= 0;
+    for (; pr != end_range; pr++)
+    {
+      if (insert_dynamic(&scan_ranges, pr))
+        *create_err= true;
+    }
+  }
+
+  rows_per_batch= max<ulong>(1, parallel_range_batch_size / reclength);
+  if (!(batches= (Batch*) my_malloc(n_batches * sizeof(Batch),
+                                    MYF(MY_WME))) ||
+      !(batch_buffer= (uchar*) my_malloc(n_batches * rows_per_batch *
+                                         reclength, MYF(MY_WME))))
+    *create_err= true;
+
+  if (*create_err)
+    dont_free= 1;                               // q keeps the shared memory
+  else
+    q->dont_free= 1;                            // Don't free shared mem
+}
+
+
+QUICK_PARALLEL_RANGE_SELECT::~QUICK_PARALLEL_RANGE_SELECT()
+{
+  DBUG_ENTER("QUICK_PARALLEL_RANGE_SELECT::~QUICK_PARALLEL_RANGE_SELECT");
+  stop_workers();
+  delete_dynamic(&scan_ranges);
+  my_free(batch_buffer);
+  my_free(batches);
+  mysql_cond_destroy(&cond_free);
+  mysql_cond_destroy(&cond_full);
+  mysql_mutex_destroy(&lock);
+  DBUG_VOID_RETURN;
+}
+
+
+/*
+  Split a range over an integer key part into pieces of about the same
+  width.
+
+  SYNOPSIS
+    split_range()
+      range   The range to split
+      pieces  Number of pieces
+
+  DESCRIPTION
+    Only a range that is bounded on both ends by non-NULL values of the
+    first key part, and that does not use the other key parts, is split.
+    The pieces are added to scan_ranges.
+
+  RETURN
+    FALSE  The range was split
+    TRUE   The range cannot be split, or out of memory
+*/
+
+bool QUICK_PARALLEL_RANGE_SELECT::split_range(QUICK_RANGE *range, uint pieces)
+{
+  KEY_PART_INFO *key_part= key_part_info;
+  Field *field= key_part->field;
+  const uint null_bytes= field->real_maybe_null() ? 1 : 0;
+  uchar min_key[sizeof(longlong) + 2], max_key[sizeof(longlong) + 2];
+  my_bitmap_map *old_sets[2];
+  ulonglong low, high, step;
+  bool error= false;
+
+  if ((range->flag & (NO_MIN_RANGE | NO_MAX_RANGE | EQ_RANGE | NULL_RANGE)) ||
+      range->min_keypart_map != 1 || range->max_keypart_map != 1 ||
+      range->min_length != key_part->store_length ||
+      range->max_length != key_part->store_length)
+    return true;
+
+  switch (field->real_type()) {
+  case MYSQL_TYPE_TINY:
+  case MYSQL_TYPE_SHORT:
+  case MYSQL_TYPE_INT24:
+  case MYSQL_TYPE_LONG:
+  case MYSQL_TYPE_LONGLONG:
+    break;
+  default:
+    return true;
+  }
+
+  if (null_bytes && (range->min_key[0] || range->max_key[0]))
+    return true;
+
+  const bool unsigned_flag= MY_TEST(field->flags & UNSIGNED_FLAG);
+  /* Maps signed values to unsigned ones in the same order */
+  const ulonglong sign= unsigned_flag ? 0 : (1ULL << 63);
+
+  dbug_tmp_use_all_columns(head, old_sets, head->read_set, head->write_set);
+  field->set_key_image(range->min_key + null_bytes, key_part->length);
+  low= ((ulonglong) field->val_int()) ^ sign;
+  field->set_key_image(range->max_key + null_bytes, key_part->length);
+  high= ((ulonglong) field->val_int()) ^ sign;
+
+  if (high < low || high - low < pieces)
+    error= true;
+  else
+  {
+    step= (high - low) / pieces;
+    max_key[0]= 0;                              // NULL byte, if any
+    for (uint i= 0; i < pieces && !error; i++)
+    {
+      uint flag= 0;
+      QUICK_RANGE *piece;
+
+      if (i == 0)
+      {
+        memcpy(min_key, range->min_key, range->min_length);
+        flag|= range->flag & NEAR_MIN;
+      }
+      else
+        memcpy(min_key, max_key, range->max_length);
+
+      if (i == pieces - 1)
+      {
+        memcpy(max_key, range->max_key, range->max_length);
+        flag|= range->flag & NEAR_MAX;
+      }
+      else
+      {
+        field->store((longlong) ((low + (i + 1) * step) ^ sign),
+                     unsigned_flag);
+        field->get_key_image(max_key + null_bytes, key_part->length,
+                             Field::itRAW);
+        flag|= NEAR_MAX;
+      }
+
+      error= (!(piece= new (&alloc) QUICK_RANGE(&alloc,
+                                                min_key, range->min_length, 1,
+                                                max_key, range->max_length, 1,
+                                                flag)) ||
+              insert_dynamic(&scan_ranges, &piece));
+    }
+  }
+
+  dbug_tmp_restore_column_maps(head->read_set, head->write_set, old_sets);
+  return error;
+}
+
+
+int QUICK_PARALLEL_RANGE_SELECT::reset()
+{
+  DBUG_ENTER("QUICK_PARALLEL_RANGE_SELECT::reset");
+  stop_workers();
+
+  /* set keyread to TRUE if index is covering */
+  keyread= !head->no_keyread && head->covering_keys.is_set(index);
+  head->set_keyread(keyread);
+  bitmap_copy(&column_bitmap, head->read_set);
+
+  if (!(serial= start_workers()))
+    DBUG_RETURN(0);
+  DBUG_RETURN(QUICK_RANGE_SELECT::reset());
+}
+
+
+/* Pool workers reading ranges for all sessions */
+static std::atomic<ulong> range_scan_worker_threads(0);
+
+/*
+  Reserve up to 'wanted' workers without exceeding range_scan_max_threads,
+  and return how many were reserved.
+*/
+
+static uint reserve_range_scan_workers(uint wanted)
+{
+  ulong used= range_scan_worker_threads.load();
+  for (;;)
+  {
+    const ulong limit= range_scan_max_threads;
+    if (used >= limit)
+      return 0;
+    const ulong reserved= min<ulong>(wanted, limit - used);
+    if (range_scan_worker_threads.compare_exchange_weak(used,
+                                                        used + reserved))
+      return (uint) reserved;
+  }
+}
+
+
+static void release_range_scan_workers(uint reserved)
+{
+  range_scan_worker_threads-= reserved;
+}
+
+
+/*
+  The pool threads are started when they are first needed and then wait
+  for scans of any session until the server shuts down, so that no thread
+  or THD is created per scan. There are at most as many of them as the
+  largest range_scan_max_threads since startup. A scan queues itself once
+  for every worker it has reserved.
+*/
+static mysql_mutex_t LOCK_range_scan_workers;
+static mysql_cond_t COND_range_scan_task;   // A scan was queued or stop set
+static std::deque<QUICK_PARALLEL_RANGE_SELECT*> range_scan_tasks;
+static std::vector<pthread_t> range_scan_workers;
+static bool range_scan_workers_inited= false;
+static bool range_scan_workers_stop= false;
+
+pthread_handler_t parallel_range_scan_worker(void *arg);
+
+
+/*
+  Start pool threads until there are 'wanted' of them, and return how
+  many there are.
+*/
+
+static size_t start_range_scan_workers(ulong wanted)
+{
+  if (!range_scan_workers_inited)
+    return 0;
+
+  mysql_mutex_lock(&LOCK_range_scan_workers);
+  while (range_scan_workers.size() < wanted)
+  {
+    pthread_t thread;
+    if (mysql_thread_create(key_thread_parallel_range_scan, &thread, NULL,
+                            parallel_range_scan_worker, NULL))
+      break;
+    range_scan_workers.push_back(thread);
+  }
+  const size_t started= range_scan_workers.size();
+  mysql_mutex_unlock(&LOCK_range_scan_workers);
+  return started;
+}
+
+
+/*
+  Create the read view and queue the scan for the workers.
+
+  RETURN
+    FALSE  At least one worker was reserved
+    TRUE   The ranges have to be read by the session thread
+*/
+
+bool QUICK_PARALLEL_RANGE_SELECT::start_workers()
+{
+  const uint n_batches= n_threads * parallel_range_batches_per_worker;
+  const ulong reclength= head->s->reclength;
+  DBUG_ENTER("QUICK_PARALLEL_RANGE_SELECT::start_workers");
+
+  next_range= 0;
+  scan_error= 0;
+  abort_scan= false;
+  full_batches= cur_batch= NULL;
+  free_batches= NULL;
+  for (uint i= 0; i < n_batches; i++)
+  {
+    batches[i].rows= batch_buffer + i * rows_per_batch * reclength;
+    batches[i].count= batches[i].pos= 0;
+    batches[i].next= free_batches;
+    free_batches= &batches[i];
+  }
+  memset(&worker_status, 0, sizeof(worker_status));
+
+  /*
+    Every reserved worker has a pool thread, so that a queued scan is
+    taken at once by an idle thread.
+  */
+  const uint reserved= reserve_range_scan_workers(n_threads);
+  const ulong wanted= range_scan_worker_threads.load();
+  if (!reserved || start_range_scan_workers(wanted) < wanted)
+  {
+    release_range_scan_workers(reserved);
+    DBUG_RETURN(true);
+  }
+
+  if (!(read_view= hton->create_cursor_read_view(hton, thd)))
+  {
+    release_range_scan_workers(reserved);
+    DBUG_RETURN(true);
+  }
+
+  started_threads= running_threads= reserved;
+
+  mysql_mutex_lock(&LOCK_range_scan_workers);
+  for (uint i= 0; i < reserved; i++)
+    range_scan_tasks.push_back(this);
+  mysql_cond_broadcast(&COND_range_scan_task);
+  mysql_mutex_unlock(&LOCK_range_scan_workers);
+
+  thd->status_var.select_range_parallel_count++;
+  DBUG_RETURN(false);
+}
+
+
+/*
+  Stop the workers, if any, and close the read view.
+
+  NOTES
+    The read view must be closed before the session unlocks the table,
+    as InnoDB keeps the table count of the session transaction in it.
+*/
+
+void QUICK_PARALLEL_RANGE_SELECT::stop_workers()
+{
+  uint not_taken= 0;
+
+  if (!started_threads)
+    return;
+
+  /* Take back the queued entries of this scan no worker has taken yet */
+  mysql_mutex_lock(&LOCK_range_scan_workers);
+  for (std::deque<QUICK_PARALLEL_RANGE_SELECT*>::iterator it=
+         range_scan_tasks.begin(); it != range_scan_tasks.end(); )
+  {
+    if (*it == this)
+    {
+      it= range_scan_tasks.erase(it);
+      not_taken++;
+    }
+    else
+      ++it;
+  }
+  mysql_mutex_unlock(&LOCK_range_scan_workers);
+
+  mysql_mutex_lock(&lock);
+  abort_scan= true;
+  mysql_cond_broadcast(&cond_free);
+  running_threads-= not_taken;
+  while (running_threads)
+    mysql_cond_wait(&cond_full, &lock);
+  mysql_mutex_unlock(&lock);
+
+  release_range_scan_workers(started_threads);
+  started_threads= 0;
+  cur_batch= NULL;
+
+  add_to_status(&thd->status_var, &worker_status);
+  hton->close_cursor_read_view(hton, thd, read_view);
+  read_view= NULL;
+}
+
+
+void QUICK_PARALLEL_RANGE_SELECT::range_end()
+{
+  stop_workers();
+  QUICK_RANGE_SELECT::range_end();
+}
+
+
+/*
+  Get the next row read by the workers.
+
+  NOTES
+    The rows are returned in no particular order.
+
+  RETURN
+    0                   Found row
+    HA_ERR_END_OF_FILE  No (more) rows in the ranges
+    #                   Error code
+*/
+
+int QUICK_PARALLEL_RANGE_SELECT::get_next()
+{
+  const ulong reclength= head->s->reclength;
+  int error;
+  DBUG_ENTER("QUICK_PARALLEL_RANGE_SELECT::get_next");
+
+  if (serial)
+    DBUG_RETURN(QUICK_RANGE_SELECT::get_next());
+
+  while (!cur_batch || cur_batch->pos == cur_batch->count)
+  {
+    if (!started_threads)
+      DBUG_RETURN(HA_ERR_END_OF_FILE);
+
+    mysql_mutex_lock(&lock);
+    if (cur_batch)
+    {
+      cur_batch->next= free_batches;
+      free_batches= cur_batch;
+      cur_batch= NULL;
+      mysql_cond_signal(&cond_free);
+    }
+    while (!full_batches && running_threads && !scan_error)
+      mysql_cond_wait(&cond_full, &lock);
+    if (!(error= scan_error) && full_batches)
+    {
+      cur_batch= full_batches;
+      full_batches= cur_batch->next;
+      cur_batch->pos= 0;
+    }
+    mysql_mutex_unlock(&lock);
+
+    if (!cur_batch)
+    {
+      /* All workers have ended, or one of them failed */
+      stop_workers();
+      head->status= STATUS_NOT_FOUND;
+      DBUG_RETURN(error ? error : HA_ERR_END_OF_FILE);
+    }
+  }
+
+  memcpy(record, cur_batch->rows + cur_batch->pos++ * reclength, reclength);
+  head->status= 0;
+  DBUG_RETURN(0);
+}
+
+
+/* Take the next range to be read by a worker */
+
+QUICK_RANGE *QUICK_PARALLEL_RANGE_SELECT::next_scan_range()
+{
+  QUICK_RANGE *range= NULL;
+  mysql_mutex_lock(&lock);
+  if (!abort_scan && next_range < scan_ranges.elements)
+    range= *dynamic_element(&scan_ranges, next_range++, QUICK_RANGE**);
+  mysql_mutex_unlock(&lock);
+  return range;
+}
+
+
+/*
+  Range sequence interface implementation for the ranges of a parallel
+  range scan: every call takes the next range not read by any worker.
+*/
+
+static range_seq_t parallel_range_seq_init(void *init_param, uint n_ranges,
+                                           uint flags)
+{
+  return init_param;
+}
+
+
+uint parallel_range_seq_next(range_seq_t rseq, KEY_MULTI_RANGE *range)
+{
+  QUICK_RANGE *cur=
+    ((QUICK_PARALLEL_RANGE_SELECT*) rseq)->next_scan_range();
+
+  if (!cur)
+    return 1; /* no more ranges */
+
+  cur->make_min_endpoint(&range->start_key);
+  cur->make_max_endpoint(&range->end_key);
+  range->range_flag= cur->flag;
+  range->ptr= NULL;
+  return 0;
+}
+
+
+/*
+  Add a row read by a worker to its batch.
+
+  SYNOPSIS
+    put_row()
+      batch  IN/OUT  Batch of the worker, NULL if it has none
+      row            The row to add
+
+  DESCRIPTION
+    A full batch is passed to the session thread, and the worker waits
+    for a free one if there is none.
+
+  RETURN
+    0                         OK
+    HA_ERR_QUERY_INTERRUPTED  The scan was aborted
+*/
+
+int QUICK_PARALLEL_RANGE_SELECT::put_row(Batch **batch, const uchar *row)
+{
+  const ulong reclength= head->s->reclength;
+
+  if (!*batch || (*batch)->count == rows_per_batch)
+  {
+    mysql_mutex_lock(&lock);
+    if (*batch)
+    {
+      (*batch)->next= full_batches;
+      full_batches= *batch;
+      *batch= NULL;
+      mysql_cond_signal(&cond_full);
+    }
+    while (!free_batches && !abort_scan)
+      mysql_cond_wait(&cond_free, &lock);
+    if (!abort_scan)
+    {
+      *batch= free_batches;
+      free_batches= (*batch)->next;
+      (*batch)->count= 0;
+    }
+    mysql_mutex_unlock(&lock);
+    if (!*batch)
+      return HA_ERR_QUERY_INTERRUPTED;
+  }
+
+  memcpy((*batch)->rows + (*batch)->count++ * reclength, row, reclength);
+  return 0;
+}
+
+
+/*
+  Read ranges in a worker thread until there are none left.
+
+  SYNOPSIS
+    read_ranges()
+      worker_thd  THD of the worker
+      batch       IN/OUT  Batch of the worker, see put_row()
+
+  DESCRIPTION
+    The worker opens its own instance of the table, reads through the
+    read view of the session and commits its transaction at the end.
+
+  RETURN
+    HA_ERR_END_OF_FILE  All ranges were read
+    #                   Error code
+*/
+
+int QUICK_PARALLEL_RANGE_SELECT::read_ranges(THD *worker_thd, Batch **batch)
+{
+  TABLE table;
+  HANDLER_BUFFER empty_buf;
+  RANGE_SEQ_IF seq_funcs= {parallel_range_seq_init, parallel_range_seq_next,
+                           0, 0};
+  char *dummy;
+  int error;
+  DBUG_ENTER("QUICK_PARALLEL_RANGE_SELECT::read_ranges");
+
+  if (open_table_from_share(worker_thd, head->s, head->alias,
+                            (uint) (HA_OPEN_KEYFILE | HA_OPEN_RNDFILE |
+                                    HA_GET_INDEX | HA_TRY_READ_ONLY),
+                            (READ_KEYINFO | COMPUTE_TYPES | EXTRA_RECORD),
+                            worker_thd->open_options, &table, FALSE))
+    DBUG_RETURN(HA_ERR_INTERNAL_ERROR);
+
+  bitmap_copy(table.read_set, &column_bitmap);
+  if (keyread)
+    table.set_keyread(true);
+
+  if (!(error= table.file->ha_external_lock(worker_thd, F_RDLCK)))
+  {
+    hton->set_cursor_read_view(hton, worker_thd, read_view);
+    if (!(error= table.file->ha_index_init(index, false)))
+    {
+      empty_buf.buffer= empty_buf.buffer_end= empty_buf.end_of_used_area=
+        NULL;
+      error= table.file->multi_range_read_init(&seq_funcs, (void*) this,
+                                               scan_ranges.elements,
+                                               HA_MRR_USE_DEFAULT_IMPL |
+                                               HA_MRR_NO_ASSOCIATION,
+                                               &empty_buf);
+      while (!error)
+      {
+        if (!(error= table.file->multi_range_read_next(&dummy)))
+        {
+          if (thd->killed)
+            error= HA_ERR_QUERY_INTERRUPTED;
+          else
+            error= put_row(batch, table.record[0]);
+        }
+        else if (error == HA_ERR_RECORD_DELETED)
+          error= 0;
+      }
+      table.file->ha_index_end();
+    }
+    hton->set_cursor_read_view(hton, worker_thd, NULL);
+    trans_commit_stmt(worker_thd);
+    table.file->ha_external_lock(worker_thd, F_UNLCK);
+  }
+  closefrm(&table, false);
+  DBUG_RETURN(error);
+}
+
+
+/*
+  Read ranges in a pool thread with its THD, then pass the last batch,
+  the error if any and the status of the worker to the session.
+  worker_thd is NULL if the pool thread could not create its THD.
+*/
+
+void QUICK_PARALLEL_RANGE_SELECT::run_worker(THD *worker_thd)
+{
+  Batch *batch= NULL;
+  int error= HA_ERR_OUT_OF_MEM;
+
+  if (worker_thd)
+  {
+    worker_thd->lex->sql_command= SQLCOM_SELECT;
+    worker_thd->tx_isolation= thd->tx_isolation;
+    worker_thd->tx_read_only= thd->tx_read_only;
+    error= read_ranges(worker_thd, &batch);
+  }
+
+  mysql_mutex_lock(&lock);
+  if (batch)
+  {
+    if (batch->count)
+    {
+      batch->next= full_batches;
+      full_batches= batch;
+    }
+    else
+    {
+      batch->next= free_batches;
+      free_batches= batch;
+    }
+  }
+  if (error != HA_ERR_END_OF_FILE && !abort_scan)
+  {
+    scan_error= error;
+    abort_scan= true;
+    mysql_cond_broadcast(&cond_free);
+  }
+  if (worker_thd)
+    add_to_status(&worker_status, &worker_thd->status_var);
+  running_threads--;
+  /* The session may free the scan as soon as the lock is released */
+  mysql_cond_signal(&cond_full);
+  mysql_mutex_unlock(&lock);
+
+  if (worker_thd)
+  {
+    worker_thd->set_status_var_init();
+    worker_thd->clear_error();
+    worker_thd->get_stmt_da()->reset_diagnostics_area();
+    free_root(worker_thd->mem_root, MYF(MY_KEEP_PREALLOC));
+  }
+}
+
+
+/*
+  Wait for scans and read ranges for them, until range_scan_workers_free()
+  sets range_scan_workers_stop. The THD of the thread is kept for all the
+  scans it reads for.
+*/
+
+pthread_handler_t
+parallel_range_scan_worker(void *arg MY_ATTRIBUTE((unused)))
+{
+  THD *worker_thd;
+
+  my_thread_init();
+  if ((worker_thd= new THD))
+  {
+    worker_thd->thread_stack= (char*) &worker_thd;
+    worker_thd->store_globals();
+  }
+
+  mysql_mutex_lock(&LOCK_range_scan_workers);
+  for (;;)
+  {
+    while (range_scan_tasks.empty() && !range_scan_workers_stop)
+      mysql_cond_wait(&COND_range_scan_task, &LOCK_range_scan_workers);
+    if (range_scan_tasks.empty())
+      break;
+
+    QUICK_PARALLEL_RANGE_SELECT *scan= range_scan_tasks.front();
+    range_scan_tasks.pop_front();
+    mysql_mutex_unlock(&LOCK_range_scan_workers);
+
+    scan->run_worker(worker_thd);
+
+    mysql_mutex_lock(&LOCK_range_scan_workers);
+  }
+  mysql_mutex_unlock(&LOCK_range_scan_workers);
+
+  delete worker_thd;
+  my_thread_end();
+  return 0;
+}
+
+
+void range_scan_workers_init()
+{
+  mysql_mutex_init(key_LOCK_range_scan_workers, &LOCK_range_scan_workers,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_range_scan_task, &COND_range_scan_task, NULL);
+  range_scan_workers_stop= false;
+  range_scan_workers_inited= true;
+}
+
+
+void range_scan_workers_free()
+{
+  if (!range_scan_workers_inited)
+    return;
+
+  mysql_mutex_lock(&LOCK_range_scan_workers);
+  range_scan_workers_stop= true;
+  mysql_cond_broadcast(&COND_range_scan_task);
+  mysql_mutex_unlock(&LOCK_range_scan_workers);
+
+  for (size_t i= 0; i < range_scan_workers.size(); i++)
+    pthread_join(range_scan_workers[i], NULL);
+  range_scan_workers.clear();
+
+  range_scan_workers_inited= false;
+  mysql_cond_destroy(&COND_range_scan_task);
+  mysql_mutex_destroy(&LOCK_range_scan_workers);
+}
+
+
 /*
   Compare if found key is over max-value
   Returns 0 if key <= range->max_key
@@ -428,6 +428,7 @@ protected:
   friend range_seq_t quick_range_seq_init(void *init_param,
                                           uint n_ranges, uint flags);
   friend class QUICK_SELECT_DESC;
+  friend class QUICK_PARALLEL_RANGE_SELECT;
   friend class QUICK_INDEX_MERGE_SELECT;
   friend class QUICK_ROR_INTERSECT_SELECT;
   friend class QUICK_GROUP_MIN_MAX_SELECT;
@@ -483,6 +484,7 @@ public:
   void dbug_dump(int indent, bool verbose);
 #endif
   QUICK_SELECT_I *make_reverse(uint used_key_parts_arg);
+  QUICK_SELECT_I *make_parallel(THD *thd, uint threads);
   void set_handler(handler *file_arg) { file= file_arg; }
 private:
   /* Default copy ctor used by QUICK_SELECT_DESC */
@@ -1022,6 +1024,97 @@ private:
 };
 
 
+/*
+  QUICK_PARALLEL_RANGE_SELECT - range scan whose ranges are read by
+  several worker threads.
+
+  The workers are taken from a pool of threads shared by all sessions,
+  see range_scan_workers_init(), and range_scan_max_threads limits how
+  many of them read at once. Each worker opens its own instance of the
+  table, with its own handler and engine transaction, and reads the
+  ranges it takes from a shared list through the default MRR
+  implementation. All workers read through
+  one consistent read view of the engine, created in the session
+  transaction by handlerton::create_cursor_read_view(). The rows are
+  handed to the session thread in batches and are returned by get_next()
+  in no particular order, so this is only used for queries that do not
+  depend on the order of the rows, see JOIN::optimize_parallel_range_scan().
+
+  If no worker thread can be started, the ranges are read by the session
+  thread like a QUICK_RANGE_SELECT does.
+*/
+
+class QUICK_PARALLEL_RANGE_SELECT: public QUICK_RANGE_SELECT
+{
+public:
+  QUICK_PARALLEL_RANGE_SELECT(QUICK_RANGE_SELECT *q, THD *thd, uint threads,
+                              bool *create_err);
+  ~QUICK_PARALLEL_RANGE_SELECT();
+  int reset(void);
+  int get_next();
+  void range_end();
+  bool reverse_sort_possible() const { return false; }
+  QUICK_SELECT_I *make_reverse(uint used_key_parts_arg) { return NULL; }
+
+  /* Read ranges in a worker thread of the pool */
+  void run_worker(THD *worker_thd);
+
+private:
+  /* A batch of rows passed from a worker to the session thread */
+  struct Batch
+  {
+    uchar *rows;
+    uint count;                   /* Rows stored in the batch */
+    uint pos;                     /* Next row to return from the batch */
+    Batch *next;
+  };
+
+  THD *thd;                       /* The session */
+  handlerton *hton;
+  uint n_threads;
+  void *read_view;                /* Shared by all workers */
+  bool serial;                    /* Read by the session thread */
+  bool keyread;
+
+  DYNAMIC_ARRAY scan_ranges;      /* Ranges to be taken by the workers */
+  uint next_range;
+
+  uint started_threads;            /* Workers reserved and queued */
+
+  uchar *batch_buffer;
+  Batch *batches;
+  uint rows_per_batch;
+  Batch *free_batches;
+  Batch *full_batches;
+  Batch *cur_batch;               /* Batch being returned by get_next() */
+
+  /*
+    Protects the members below, next_range and the lists of batches while
+    the workers run
+  */
+  mysql_mutex_t lock;
+  mysql_cond_t cond_full;         /* A batch was filled or a worker ended */
+  mysql_cond_t cond_free;         /* A batch was freed or the scan aborted */
+  uint running_threads;
+  int scan_error;
+  bool abort_scan;
+  STATUS_VAR worker_status;       /* Status of the workers that ended */
+
+  bool split_range(QUICK_RANGE *range, uint pieces);
+  bool start_workers();
+  void stop_workers();
+  int read_ranges(THD *worker_thd, Batch **batch);
+  int put_row(Batch **batch, const uchar *row);
+  QUICK_RANGE *next_scan_range();
+
+  friend uint parallel_range_seq_next(range_seq_t rseq,
+                                      KEY_MULTI_RANGE *range);
+};
+
+void range_scan_workers_init();
+void range_scan_workers_free();
+
+
 class SQL_SELECT :public Sql_alloc {
  public:
   QUICK_SELECT_I *quick;	// If quick-select used
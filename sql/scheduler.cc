@@ -25,6 +25,7 @@
 #include "scheduler.h"
 #include "sql_callback.h"
 #include "global_threads.h"
+#include "threadpool.h"
 #include "mysql/thread_pool_priv.h"
 
 /*
@@ -74,6 +75,25 @@ static scheduler_functions one_thread_per_connection_scheduler_functions=
 };
 #endif  // EMBEDDED_LIBRARY
 
+#ifdef HAVE_POOL_OF_THREADS
+/*
+  Connections accepted on admin_port are still served by a dedicated
+  thread, hence the thread-per-connection init/end callbacks.
+*/
+static scheduler_functions pool_of_threads_scheduler_functions=
+{
+  0,                                     // max_threads
+  tp_init,                               // init
+  init_new_connection_handler_thread,    // init_new_connection_thread
+  tp_add_connection,                     // add_connection
+  tp_wait_begin,                         // thd_wait_begin
+  tp_wait_end,                           // thd_wait_end
+  tp_post_kill_notification,             // post_kill_notification
+  one_thread_per_connection_end,         // end_thread
+  tp_end,                                // end
+};
+#endif  // HAVE_POOL_OF_THREADS
+
 
 scheduler_functions *thread_scheduler= NULL;
 
@@ -96,7 +116,7 @@ static void scheduler_wait_lock_end(void) {
 
 static void scheduler_wait_sync_begin(void) {
   MYSQL_CALLBACK(thread_scheduler,
-                 thd_wait_begin, (current_thd, THD_WAIT_TABLE_LOCK));
+                 thd_wait_begin, (current_thd, THD_WAIT_SYNC));
 }
 
 static void scheduler_wait_sync_end(void) {
@@ -132,6 +152,19 @@ void one_thread_per_connection_scheduler()
 }
 #endif
 
+/*
+  Initialize scheduler for --thread-handling=pool-of-threads
+*/
+
+#ifdef HAVE_POOL_OF_THREADS
+void pool_of_threads_scheduler()
+{
+  scheduler_init();
+  pool_of_threads_scheduler_functions.max_threads= threadpool_max_threads;
+  thread_scheduler= &pool_of_threads_scheduler_functions;
+}
+#endif
+
 /*
   Initailize scheduler for --thread-handling=no-threads
 */
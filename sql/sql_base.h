@@ -323,6 +323,7 @@ const char *get_name(ID_NAME_MAP *id_map, uint id);
 /* for information_schema.table_statistics and index_statistics */
 void update_table_stats(THD* thd, TABLE *table_ptr, bool follow_next);
 extern HASH global_table_stats;
+extern longlong global_table_stats_version;
 extern mysql_mutex_t LOCK_global_table_stats;
 void init_global_table_stats(void);
 void free_global_table_stats(void);
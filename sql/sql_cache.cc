@@ -346,6 +346,7 @@ TODO list:
 #include "../storage/myisammrg/myrg_def.h"
 #include "probes_mysql.h"
 #include "transaction.h"
+#include "my_atomic.h"
 
 #ifdef EMBEDDED_LIBRARY
 #include "emb_qcache.h"
@@ -944,8 +945,8 @@ Query_cache::insert(Query_cache_tls *query_cache_tls,
     header->result(result);
     DBUG_PRINT("qcache", ("free query 0x%lx", (ulong) query_block));
     // The following call will remove the lock on query_block
-    query_cache.free_query(query_block);
-    query_cache.refused++;
+    free_query(query_block);
+    refused++;
     // append_result_data no success => we need unlock
     unlock();
     DBUG_VOID_RETURN;
@@ -1055,9 +1056,9 @@ void Query_cache::end_of_result(THD *thd)
     }
     last_result_block= header->result()->prev;
     allign_size= ALIGN_SIZE(last_result_block->used);
-    len= max(query_cache.min_allocation_unit, allign_size);
-    if (last_result_block->length >= query_cache.min_allocation_unit + len)
-      query_cache.split_block(last_result_block,len);
+    len= max(min_allocation_unit, allign_size);
+    if (last_result_block->length >= min_allocation_unit + len)
+      split_block(last_result_block,len);
 
     header->found_rows(limit_found_rows);
     header->result()->type= Query_cache_block::RESULT;
@@ -1096,6 +1097,18 @@ void mysql_query_cache_invalidate4(THD *thd,
    Query_cache methods
 *****************************************************************************/
 
+/**
+  Slot of the table presence counters (Query_cache::m_table_refs) which
+  counts the cached tables with this key.
+*/
+
+static uint table_ref_slot(const uchar *key, uint32 key_length)
+{
+  ulong nr1= 1, nr2= 4;
+  my_charset_bin.coll->hash_sort(&my_charset_bin, key, key_length, &nr1, &nr2);
+  return (uint) (nr1 % QUERY_CACHE_TABLE_REF_SLOTS);
+}
+
 Query_cache::Query_cache(ulong query_cache_limit_arg,
 			 ulong min_allocation_unit_arg,
 			 ulong min_result_data_size_arg,
@@ -1117,6 +1130,7 @@ Query_cache::Query_cache(ulong query_cache_limit_arg,
   set_if_bigger(min_allocation_unit,min_needed);
   this->min_allocation_unit= ALIGN_SIZE(min_allocation_unit);
   set_if_bigger(this->min_result_data_size,min_allocation_unit);
+  memset(m_table_refs, 0, sizeof(m_table_refs));
 }
 
 
@@ -1380,6 +1394,7 @@ void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
 	double_linked_list_simple_include(query_block, &queries_blocks);
 	inserts++;
 	queries_in_cache++;
+	thd->query_cache_tls.cache= this;
 	thd->query_cache_tls.first_query_block= query_block;
 	header->writer(&thd->query_cache_tls);
 	header->tables_type(tables_type);
@@ -1834,10 +1849,10 @@ err:
   Remove all cached queries that uses any of the tables in the list
 */
 
-void Query_cache::invalidate(THD *thd, TABLE_LIST *tables_used,
-			     my_bool using_transactions)
+void Query_cache_manager::invalidate(THD *thd, TABLE_LIST *tables_used,
+                                     my_bool using_transactions)
 {
-  DBUG_ENTER("Query_cache::invalidate (table list)");
+  DBUG_ENTER("Query_cache_manager::invalidate (table list)");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -1865,10 +1880,10 @@ void Query_cache::invalidate(THD *thd, TABLE_LIST *tables_used,
   DBUG_VOID_RETURN;
 }
 
-void Query_cache::invalidate(CHANGED_TABLE_LIST *tables_used)
+void Query_cache_manager::invalidate(CHANGED_TABLE_LIST *tables_used)
 {
   const char *prev_info;
-  DBUG_ENTER("Query_cache::invalidate (changed table list)");
+  DBUG_ENTER("Query_cache_manager::invalidate (changed table list)");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -1891,16 +1906,16 @@ void Query_cache::invalidate(CHANGED_TABLE_LIST *tables_used)
   Invalidate locked for write
 
   SYNOPSIS
-    Query_cache::invalidate_locked_for_write()
+    Query_cache_manager::invalidate_locked_for_write()
     tables_used - table list
 
   NOTE
     can be used only for opened tables
 */
-void Query_cache::invalidate_locked_for_write(TABLE_LIST *tables_used)
+void Query_cache_manager::invalidate_locked_for_write(TABLE_LIST *tables_used)
 {
   const char *prev_info;
-  DBUG_ENTER("Query_cache::invalidate_locked_for_write");
+  DBUG_ENTER("Query_cache_manager::invalidate_locked_for_write");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -1923,10 +1938,10 @@ void Query_cache::invalidate_locked_for_write(TABLE_LIST *tables_used)
   Remove all cached queries that uses the given table
 */
 
-void Query_cache::invalidate(THD *thd, TABLE *table,
-			     my_bool using_transactions)
+void Query_cache_manager::invalidate(THD *thd, TABLE *table,
+                                     my_bool using_transactions)
 {
-  DBUG_ENTER("Query_cache::invalidate (table)");
+  DBUG_ENTER("Query_cache_manager::invalidate (table)");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -1941,10 +1956,11 @@ void Query_cache::invalidate(THD *thd, TABLE *table,
   DBUG_VOID_RETURN;
 }
 
-void Query_cache::invalidate(THD *thd, const char *key, uint32  key_length,
-			     my_bool using_transactions)
+void Query_cache_manager::invalidate(THD *thd, const char *key,
+                                     uint32 key_length,
+                                     my_bool using_transactions)
 {
-  DBUG_ENTER("Query_cache::invalidate (key)");
+  DBUG_ENTER("Query_cache_manager::invalidate (key)");
   if (is_disabled())
    DBUG_VOID_RETURN;
 
@@ -2036,14 +2052,15 @@ void Query_cache::invalidate(char *db)
 }
 
 
-void Query_cache::invalidate_by_MyISAM_filename(const char *filename)
+void Query_cache_manager::invalidate_by_MyISAM_filename(const char *filename)
 {
-  DBUG_ENTER("Query_cache::invalidate_by_MyISAM_filename");
+  DBUG_ENTER("Query_cache_manager::invalidate_by_MyISAM_filename");
 
   /* Calculate the key outside the lock to make the lock shorter */
   char key[MAX_DBKEY_LENGTH];
   uint32 db_length;
-  uint key_length= filename_2_table_key(key, filename, &db_length);
+  uint key_length= Query_cache::filename_2_table_key(key, filename,
+                                                     &db_length);
   THD *thd= current_thd;
   invalidate_table(thd,(uchar *)key, key_length);
   DBUG_VOID_RETURN;
@@ -2067,7 +2084,7 @@ void Query_cache::flush()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   unlock();
   DBUG_VOID_RETURN;
 }
@@ -2156,7 +2173,7 @@ void Query_cache::init()
     be used.
   */
   if (global_system_variables.query_cache_type == 0)
-    query_cache.disable_query_cache();
+    disable_query_cache();
 
   DBUG_VOID_RETURN;
 }
@@ -2353,6 +2370,7 @@ void Query_cache::make_disabled()
   first_block= 0;
   total_blocks= 0;
   tables_blocks= 0;
+  memset(m_table_refs, 0, sizeof(m_table_refs));
   DBUG_VOID_RETURN;
 }
 
@@ -2818,7 +2836,7 @@ my_bool Query_cache::allocate_data_chain(Query_cache_block **result_block,
   Invalidate the first table in the table_list
 */
 
-void Query_cache::invalidate_table(THD *thd, TABLE_LIST *table_list)
+void Query_cache_manager::invalidate_table(THD *thd, TABLE_LIST *table_list)
 {
   if (table_list->table != 0)
     invalidate_table(thd, table_list->table);	// Table is open
@@ -2833,7 +2851,7 @@ void Query_cache::invalidate_table(THD *thd, TABLE_LIST *table_list)
   }
 }
 
-void Query_cache::invalidate_table(THD *thd, TABLE *table)
+void Query_cache_manager::invalidate_table(THD *thd, TABLE *table)
 {
   invalidate_table(thd, (uchar*) table->s->table_cache_key.str,
                    table->s->table_cache_key.length);
@@ -2858,6 +2876,38 @@ void Query_cache::invalidate_table(THD *thd, uchar * key, uint32  key_length)
 }
 
 
+/*
+  Invalidate the table in the query cache instances
+
+  With several instances only the ones whose presence counter for the
+  table key is non-zero are locked. Queries using the table are registered
+  under the structure mutex while the table is open, so an instance whose
+  counter reads zero holds no query to invalidate.
+
+  The counters only choose the instances to lock. There are no per-table
+  generations: each locked instance still frees every query using the
+  table by walking its block list, as a single query cache does.
+*/
+
+void Query_cache_manager::invalidate_table(THD *thd, uchar *key,
+                                           uint32 key_length)
+{
+  if (query_cache_instances == 1)
+  {
+    m_query_cache[0].invalidate_table(thd, key, key_length);
+    return;
+  }
+
+  uint slot= table_ref_slot(key, key_length);
+  for (uint i= 0; i < query_cache_instances; i++)
+  {
+    Query_cache *cache= &m_query_cache[i];
+    if (my_atomic_load32(&cache->m_table_refs[slot]) > 0)
+      cache->invalidate_table(thd, key, key_length);
+  }
+}
+
+
 /**
   Try to locate and invalidate a table by name.
   The caller must ensure that no other thread is trying to work with
@@ -3123,6 +3173,7 @@ Query_cache::insert_table(uint key_len, const char *key,
       free_memory_block(table_block);
       DBUG_RETURN(0);
     }
+    my_atomic_add32(&m_table_refs[table_ref_slot((uchar*) key, key_len)], 1);
     char *db= header->db();
     header->table(db + db_length + 1);
     header->key_length(key_len);
@@ -3183,6 +3234,9 @@ void Query_cache::unlink_table(Query_cache_block_table *node)
     double_linked_list_exclude(table_block,
                                &tables_blocks);
     my_hash_delete(&tables,(uchar *) table_block);
+    uint slot= table_ref_slot((uchar*) table_block_data->db(),
+                              table_block_data->key_length());
+    my_atomic_add32(&m_table_refs[slot], -1);
     free_memory_block(table_block);
   }
   DBUG_VOID_RETURN;
@@ -3811,7 +3865,7 @@ void Query_cache::pack_cache()
 {
   DBUG_ENTER("Query_cache::pack_cache");
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
 
   uchar *border = 0;
   Query_cache_block *before = 0;
@@ -3843,7 +3897,7 @@ void Query_cache::pack_cache()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   DBUG_VOID_RETURN;
 }
 
@@ -4207,6 +4261,168 @@ uint Query_cache::filename_2_table_key (char *key, const char *path,
                                 filename, NAME_LEN) - key) + 1);
 }
 
+/*****************************************************************************
+  Query_cache_manager methods
+*****************************************************************************/
+
+/**
+  Get the instance which caches the query with the given text.
+*/
+
+Query_cache *Query_cache_manager::get_cache(const char *query,
+                                            size_t query_length)
+{
+  if (query_cache_instances == 1)
+    return &m_query_cache[0];
+
+  ulong nr1= 1, nr2= 4;
+  my_charset_bin.coll->hash_sort(&my_charset_bin, (const uchar*) query,
+                                 query_length, &nr1, &nr2);
+  return &m_query_cache[nr1 % query_cache_instances];
+}
+
+
+void Query_cache_manager::init()
+{
+  DBUG_ENTER("Query_cache_manager::init");
+  for (uint i= 0; i < query_cache_instances; i++)
+  {
+    m_query_cache[i].result_size_limit(query_cache_limit);
+    m_query_cache[i].init();
+  }
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+  Resize the query cache. The memory is split evenly between the
+  instances.
+
+  @return the memory used by all the instances, 0 if the cache is disabled.
+*/
+
+ulong Query_cache_manager::resize(ulong query_cache_size_arg)
+{
+  ulong instance_size= query_cache_size_arg / query_cache_instances;
+  ulong new_query_cache_size= 0;
+  DBUG_ENTER("Query_cache_manager::resize");
+
+  for (uint i= 0; i < query_cache_instances; i++)
+    new_query_cache_size+= m_query_cache[i].resize(instance_size);
+
+  query_cache_size= new_query_cache_size;
+  DBUG_RETURN(new_query_cache_size);
+}
+
+
+void Query_cache_manager::result_size_limit(ulong limit)
+{
+  query_cache_limit= limit;
+  for (uint i= 0; i < query_cache_instances; i++)
+    m_query_cache[i].result_size_limit(limit);
+}
+
+
+ulong Query_cache_manager::set_min_res_unit(ulong size)
+{
+  ulong new_size= size;
+  for (uint i= 0; i < query_cache_instances; i++)
+    new_size= m_query_cache[i].set_min_res_unit(size);
+  return new_size;
+}
+
+
+void Query_cache_manager::store_query(THD *thd, TABLE_LIST *tables_used)
+{
+  get_cache(thd->query(), thd->query_length())->store_query(thd, tables_used);
+}
+
+
+int Query_cache_manager::send_result_to_client(THD *thd, char *sql,
+                                               uint query_length)
+{
+  return get_cache(sql, query_length)->send_result_to_client(thd, sql,
+                                                             query_length);
+}
+
+
+/*
+  The result of a query goes to the instance which registered it in
+  store_query(). See the comment on double-check locking usage above.
+*/
+
+void Query_cache_manager::insert(Query_cache_tls *query_cache_tls,
+                                 const char *packet, ulong length,
+                                 unsigned pkt_nr)
+{
+  if (query_cache_tls->first_query_block == NULL)
+    return;
+  query_cache_tls->cache->insert(query_cache_tls, packet, length, pkt_nr);
+}
+
+
+void Query_cache_manager::end_of_result(THD *thd)
+{
+  if (thd->query_cache_tls.first_query_block == NULL)
+    return;
+  thd->query_cache_tls.cache->end_of_result(thd);
+}
+
+
+void Query_cache_manager::abort(Query_cache_tls *query_cache_tls)
+{
+  if (query_cache_tls->first_query_block == NULL)
+    return;
+  query_cache_tls->cache->abort(query_cache_tls);
+}
+
+
+void Query_cache_manager::invalidate(char *db)
+{
+  for (uint i= 0; i < query_cache_instances; i++)
+    m_query_cache[i].invalidate(db);
+}
+
+
+void Query_cache_manager::flush()
+{
+  for (uint i= 0; i < query_cache_instances; i++)
+    m_query_cache[i].flush();
+}
+
+
+void Query_cache_manager::pack(ulong join_limit, uint iteration_limit)
+{
+  for (uint i= 0; i < query_cache_instances; i++)
+    m_query_cache[i].pack(join_limit, iteration_limit);
+}
+
+
+void Query_cache_manager::destroy()
+{
+  for (uint i= 0; i < query_cache_instances; i++)
+    m_query_cache[i].destroy();
+}
+
+
+ulong Query_cache_manager::sum(ulong Query_cache::*counter)
+{
+  ulong total= 0;
+  for (uint i= 0; i < query_cache_instances; i++)
+    total+= m_query_cache[i].*counter;
+  return total;
+}
+
+
+void Query_cache_manager::reset_counters()
+{
+  for (uint i= 0; i < query_cache_instances; i++)
+  {
+    Query_cache *cache= &m_query_cache[i];
+    cache->hits= cache->inserts= cache->refused= cache->lowmem_prunes= 0;
+  }
+}
+
 /****************************************************************************
   Functions to be used when debugging
 ****************************************************************************/
@@ -4879,6 +5095,23 @@ err2:
   return result;
 }
 
+
+void Query_cache_manager::wreck(uint line, const char *message)
+{
+  query_cache_size= 0;
+  for (uint i= 0; i < query_cache_instances; i++)
+    m_query_cache[i].wreck(line, message);
+}
+
+
+my_bool Query_cache_manager::check_integrity(bool locked)
+{
+  my_bool result= 0;
+  for (uint i= 0; i < query_cache_instances; i++)
+    result|= m_query_cache[i].check_integrity(locked);
+  return result;
+}
+
 #endif /* DBUG_OFF */
 
 #endif /*HAVE_QUERY_CACHE*/
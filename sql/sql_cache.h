@@ -68,6 +68,9 @@ typedef ulonglong sql_mode_t;
 #define QUERY_CACHE_PACK_ITERATION		2
 #define QUERY_CACHE_PACK_LIMIT			(512*1024L)
 
+/* number of table presence counters in every query cache instance */
+#define QUERY_CACHE_TABLE_REF_SLOTS		256
+
 #define TABLE_COUNTER_TYPE uint
 
 struct Query_cache_block;
@@ -300,6 +303,14 @@ private:
 
   bool m_query_cache_is_disabled;
 
+  /*
+    Number of cached tables whose key hashes to every slot; lets
+    Query_cache_manager skip the instances that can't hold a table.
+    These are presence counters, not invalidation generations.
+    Changed under structure_guard_mutex, read without it.
+  */
+  int32 m_table_refs[QUERY_CACHE_TABLE_REF_SLOTS];
+
   void free_query_internal(Query_cache_block *point);
   void invalidate_table_internal(THD *thd, uchar *key, uint32 key_length);
   void disable_query_cache(void) { m_query_cache_is_disabled= TRUE; }
@@ -357,8 +368,6 @@ protected:
 			      ulong data_len,
 			      Query_cache_block *query_block,
 			      my_bool first_block);
-  void invalidate_table(THD *thd, TABLE_LIST *table);
-  void invalidate_table(THD *thd, TABLE *table);
   void invalidate_table(THD *thd, uchar *key, uint32  key_length);
   void invalidate_table(THD *thd, Query_cache_block *table_block);
   void invalidate_query_block_list(THD *thd,
@@ -466,21 +475,9 @@ protected:
   */
   int send_result_to_client(THD *thd, char *query, uint query_length);
 
-  /* Remove all queries that uses any of the listed following tables */
-  void invalidate(THD* thd, TABLE_LIST *tables_used,
-		  my_bool using_transactions);
-  void invalidate(CHANGED_TABLE_LIST *tables_used);
-  void invalidate_locked_for_write(TABLE_LIST *tables_used);
-  void invalidate(THD* thd, TABLE *table, my_bool using_transactions);
-  void invalidate(THD *thd, const char *key, uint32  key_length,
-		  my_bool using_transactions);
-
   /* Remove all queries that uses any of the tables in following database */
   void invalidate(char *db);
 
-  /* Remove all queries that uses any of the listed following table */
-  void invalidate_by_MyISAM_filename(const char *filename);
-
   void flush();
   void pack(ulong join_limit = QUERY_CACHE_PACK_LIMIT,
 	    uint iteration_limit = QUERY_CACHE_PACK_ITERATION);
@@ -517,6 +514,86 @@ protected:
   void lock(void);
   void lock_and_suspend(void);
   void unlock(void);
+
+  friend class Query_cache_manager;
+};
+
+
+/**
+  Container class for all query cache instances in the system.
+
+  A query is cached in the instance chosen by the hash of its text, so
+  lookups and inserts of different queries take different mutexes. A
+  table is invalidated in every instance which may cache queries using it.
+*/
+
+class Query_cache_manager
+{
+public:
+  /** Maximum supported number of query cache instances. */
+  static const int MAX_QUERY_CACHES= 64;
+
+  /* Info */
+  ulong query_cache_size, query_cache_limit;
+
+  Query_cache_manager() :query_cache_size(0), query_cache_limit(ULONG_MAX) {}
+
+  bool is_disabled(void) { return m_query_cache[0].is_disabled(); }
+
+  void init();
+  ulong resize(ulong query_cache_size);
+  void result_size_limit(ulong limit);
+  ulong set_min_res_unit(ulong size);
+
+  void store_query(THD *thd, TABLE_LIST *used_tables);
+  int send_result_to_client(THD *thd, char *query, uint query_length);
+
+  /* Remove all queries that uses any of the listed following tables */
+  void invalidate(THD* thd, TABLE_LIST *tables_used,
+		  my_bool using_transactions);
+  void invalidate(CHANGED_TABLE_LIST *tables_used);
+  void invalidate_locked_for_write(TABLE_LIST *tables_used);
+  void invalidate(THD* thd, TABLE *table, my_bool using_transactions);
+  void invalidate(THD *thd, const char *key, uint32  key_length,
+		  my_bool using_transactions);
+
+  /* Remove all queries that uses any of the tables in following database */
+  void invalidate(char *db);
+
+  /* Remove all queries that uses any of the listed following table */
+  void invalidate_by_MyISAM_filename(const char *filename);
+
+  void flush();
+  void pack(ulong join_limit = QUERY_CACHE_PACK_LIMIT,
+	    uint iteration_limit = QUERY_CACHE_PACK_ITERATION);
+  void destroy();
+
+  void insert(Query_cache_tls *query_cache_tls,
+              const char *packet,
+              ulong length,
+              unsigned pkt_nr);
+  void end_of_result(THD *thd);
+  void abort(Query_cache_tls *query_cache_tls);
+
+  /** Sum of a statistics counter over all the instances. */
+  ulong sum(ulong Query_cache::*counter);
+  /** Reset the counters FLUSH STATUS resets. */
+  void reset_counters();
+
+  void wreck(uint line, const char *message);
+  my_bool check_integrity(bool not_locked);
+
+private:
+  Query_cache *get_cache(const char *query, size_t query_length);
+  void invalidate_table(THD *thd, TABLE_LIST *table_list);
+  void invalidate_table(THD *thd, TABLE *table);
+  void invalidate_table(THD *thd, uchar *key, uint32 key_length);
+
+  /**
+    An array of Query_cache instances.
+    Only the first query_cache_instances elements in it are used.
+  */
+  Query_cache m_query_cache[MAX_QUERY_CACHES];
 };
 
 #ifdef HAVE_QUERY_CACHE
@@ -591,5 +668,5 @@ Query_cache_query_flags get_query_cache_flags(THD *thd, bool from_QC);
 #define query_cache_is_cacheable_query(L) 0
 #endif /*HAVE_QUERY_CACHE*/
 
-extern Query_cache query_cache;
+extern Query_cache_manager query_cache;
 #endif
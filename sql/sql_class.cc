@@ -4313,6 +4313,17 @@ void thd_increment_bytes_sent(ulong length)
 }
 
 
+void thd_increment_net_compression(ulong input_length, ulong output_length)
+{
+  THD *thd=current_thd;
+  if (likely(thd != 0))
+  {
+    thd->status_var.net_compress_input_bytes+= input_length;
+    thd->status_var.net_compress_output_bytes+= output_length;
+  }
+}
+
+
 void thd_increment_bytes_received(ulong length)
 {
   current_thd->status_var.bytes_received+= length;
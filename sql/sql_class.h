@@ -563,6 +563,7 @@ class MY_LOCALE;
 */
 
 struct Query_cache_block;
+class Query_cache;
 
 struct Query_cache_tls
 {
@@ -571,12 +572,14 @@ struct Query_cache_tls
     functions and methods to maintain proper locking.
   */
   Query_cache_block *first_query_block;
+  /* The query cache instance 'first_query_block' belongs to. */
+  Query_cache *cache;
   void set_first_query_block(Query_cache_block *first_query_block_arg)
   {
     first_query_block= first_query_block_arg;
   }
 
-  Query_cache_tls() :first_query_block(NULL) {}
+  Query_cache_tls() :first_query_block(NULL), cache(NULL) {}
 };
 
 /* SIGNAL / RESIGNAL / GET DIAGNOSTICS */
@@ -706,6 +709,8 @@ typedef struct system_variables
   ulong slow_log_if_rows_examined_exceed;
   ulong div_precincrement;
   ulong sortbuff_size;
+  ulong filesort_threads;
+  ulong range_scan_threads;
   ulong max_sp_recursion_depth;
   ulong default_week_format;
   ulong max_seeks_for_key;
@@ -747,6 +752,7 @@ typedef struct system_variables
   my_bool old_alter_table;
   uint old_passwords;
   my_bool big_tables;
+  my_bool filesort_radix_sort;
 
   plugin_ref table_plugin;
   plugin_ref temp_table_plugin;
@@ -915,6 +921,7 @@ typedef struct system_status_var
   ulonglong select_full_join_count;
   ulonglong select_full_range_join_count;
   ulonglong select_range_count;
+  ulonglong select_range_parallel_count;
   ulonglong select_range_check_count;
   ulonglong select_scan_count;
   ulonglong long_query_count;
@@ -922,6 +929,8 @@ typedef struct system_status_var
   ulonglong filesort_range_count;
   ulonglong filesort_rows;
   ulonglong filesort_scan_count;
+  ulonglong filesort_parallel_buffers;
+  ulonglong filesort_parallel_threads;
   /* Prepared statements and binary protocol */
   ulonglong com_stmt_prepare;
   ulonglong com_stmt_reprepare;
@@ -936,6 +945,9 @@ typedef struct system_status_var
 
   ulonglong bytes_received;
   ulonglong bytes_sent;
+  /* Packet payload before and after compression by the network layer */
+  ulonglong net_compress_input_bytes;
+  ulonglong net_compress_output_bytes;
 
   /* Performance counters */
   ulonglong command_time;       /* Time handling client commands */
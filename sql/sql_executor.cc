@@ -3066,6 +3066,59 @@ end:
   DBUG_RETURN(NESTED_LOOP_OK);
 }
 
+/**
+  Convert a full HEAP group table to an on-disk table and update a row there.
+
+  An update makes a HEAP row larger when the new values of its BLOB/TEXT
+  columns need more space, so the update itself can fill the table.
+
+  @param join_tab  Tab of the group table
+  @param error     Error returned by ha_update_row()
+
+  @return false on success, true on error (already reported)
+*/
+
+static bool update_row_after_heap_full(JOIN_TAB *join_tab, int error)
+{
+  TABLE *const table= join_tab->table;
+  bool is_duplicate= false;
+
+  /*
+    Unchanged BLOB/TEXT values of record[0] still point into the HEAP
+    table, which is dropped by the conversion.
+  */
+  for (uint *ptr= table->s->blob_field,
+         *end= ptr + table->s->blob_fields; ptr != end; ptr++)
+  {
+    if (((Field_blob*) table->field[*ptr])->copy())
+      return true;
+  }
+
+  if (create_myisam_from_heap(join_tab->join->thd, table,
+                              join_tab->tmp_table_param->start_recinfo,
+                              &join_tab->tmp_table_param->recinfo,
+                              error, TRUE, &is_duplicate))
+    return true;                                // Not a table_is_full error
+
+  /*
+    The old version of the row was copied to the new table, so record[0]
+    was a duplicate of it. Update it through the duplicate position like
+    end_unique_update() does.
+  */
+  DBUG_ASSERT(is_duplicate);
+  if ((int) table->file->get_dup_key(HA_ERR_FOUND_DUPP_KEY) < 0 ||
+      (error= table->file->ha_rnd_pos(table->record[1],
+                                      table->file->dup_ref)) ||
+      (error= table->file->ha_update_row(table->record[1],
+                                         table->record[0])))
+  {
+    table->file->print_error(error, MYF(0));
+    return true;
+  }
+  return false;
+}
+
+
 /* ARGSUSED */
 /** Group by searching after group record and updating it if possible. */
 
@@ -3106,8 +3159,20 @@ end_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records)
     if ((error=table->file->ha_update_row(table->record[1],
                                           table->record[0])))
     {
-      table->file->print_error(error,MYF(0));	/* purecov: inspected */
-      DBUG_RETURN(NESTED_LOOP_ERROR);            /* purecov: inspected */
+      if (error != HA_ERR_RECORD_FILE_FULL)
+      {
+        table->file->print_error(error,MYF(0));	/* purecov: inspected */
+        DBUG_RETURN(NESTED_LOOP_ERROR);          /* purecov: inspected */
+      }
+      if (update_row_after_heap_full(join_tab, error))
+        DBUG_RETURN(NESTED_LOOP_ERROR);
+      /* Change method to update rows */
+      if ((error= table->file->ha_index_init(0, 0)))
+      {
+        table->file->print_error(error, MYF(0));
+        DBUG_RETURN(NESTED_LOOP_ERROR);
+      }
+      ((QEP_tmp_table*)join_tab->op)->set_write_func(end_unique_update);
     }
     DBUG_RETURN(NESTED_LOOP_OK);
   }
@@ -3189,8 +3254,13 @@ end_unique_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records)
     if ((error=table->file->ha_update_row(table->record[1],
                                           table->record[0])))
     {
-      table->file->print_error(error,MYF(0));	/* purecov: inspected */
-      DBUG_RETURN(NESTED_LOOP_ERROR);            /* purecov: inspected */
+      if (error != HA_ERR_RECORD_FILE_FULL)
+      {
+        table->file->print_error(error,MYF(0));	/* purecov: inspected */
+        DBUG_RETURN(NESTED_LOOP_ERROR);          /* purecov: inspected */
+      }
+      if (update_row_after_heap_full(join_tab, error))
+        DBUG_RETURN(NESTED_LOOP_ERROR);
     }
   }
   DBUG_RETURN(NESTED_LOOP_OK);
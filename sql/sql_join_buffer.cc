@@ -1833,7 +1833,6 @@ finish:
 
 enum_nested_loop_state JOIN_CACHE_BNL::join_matching_records(bool skip_last)
 {
-  uint cnt;
   int error;
   READ_RECORD *info;
   enum_nested_loop_state rc= NESTED_LOOP_OK;
@@ -1853,6 +1852,9 @@ enum_nested_loop_state JOIN_CACHE_BNL::join_matching_records(bool skip_last)
   */             
   if (skip_last)     
     put_record_in_cache();     
+
+  const uint count= records - MY_TEST(skip_last);
+  prepare_matching_records(count);
  
   if (join_tab->use_quick == QS_DYNAMIC_RANGE && join_tab->select->quick)
     /* A dynamic range access was used last. Clean up after it */
@@ -1889,24 +1891,9 @@ enum_nested_loop_state JOIN_CACHE_BNL::join_matching_records(bool skip_last)
         return NESTED_LOOP_ERROR;
       if (consider_record)
       {
-        /* Prepare to read records from the join buffer */
-        reset_cache(false);
-
-        /* Read each record from the join buffer and look for matches */
-        for (cnt= records - MY_TEST(skip_last) ; cnt; cnt--)
-        { 
-          /* 
-            If only the first match is needed and it has been already found for
-            the next record read from the join buffer then the record is skipped.
-          */
-          if (!check_only_first_match || !skip_record_if_match())
-          {
-            get_record();
-            rc= generate_full_extensions(get_curr_rec());
-            if (rc != NESTED_LOOP_OK)
-              return rc;
-          }
-        }
+        rc= match_cached_records(count);
+        if (rc != NESTED_LOOP_OK)
+          return rc;
       }
     }
   } while (!(error= info->read_record(info)));
@@ -1916,6 +1903,388 @@ enum_nested_loop_state JOIN_CACHE_BNL::join_matching_records(bool skip_last)
   return rc;
 }
 
+
+/*
+  Using BNL find matches for the current row of the joined table
+
+  SYNOPSIS
+    match_cached_records()
+      count    number of records from the join buffer to look through
+
+  DESCRIPTION
+    The function reads each of the first 'count' records from the join buffer
+    and generates all the extensions of it by the current row of join_tab
+    that satisfy the pushdown conditions.
+
+  RETURN
+    return one of enum_nested_loop_state.
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNL::match_cached_records(uint count)
+{
+  enum_nested_loop_state rc;
+
+  /* Prepare to read records from the join buffer */
+  reset_cache(false);
+
+  /* Read each record from the join buffer and look for matches */
+  for (uint cnt= count; cnt; cnt--)
+  {
+    /*
+      If only the first match is needed and it has been already found for
+      the next record read from the join buffer then the record is skipped.
+    */
+    if (!check_only_first_match || !skip_record_if_match())
+    {
+      get_record();
+      rc= generate_full_extensions(get_curr_rec());
+      if (rc != NESTED_LOOP_OK)
+        return rc;
+    }
+  }
+  return NESTED_LOOP_OK;
+}
+
+
+/*
+  Check if an equality can be used as a part of the hash join key
+
+  SYNOPSIS
+    is_hashable()
+      outer    the argument of the equality over the buffered tables
+      inner    the argument of the equality that is a column of join_tab
+      cs       the collation the equality compares strings with
+
+  DESCRIPTION
+    Records are only compared with the rows that have the same hash value,
+    so any two values that compare equal must have the same hash value.
+    This holds for integers and for strings hashed with the collation used
+    for the comparison, if neither argument has to be converted to it.
+    Temporal values and other types, which can be equal with different
+    representations, are not supported.
+
+  RETURN
+    TRUE    the equality can be a part of the key
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_HASH::is_hashable(Item *outer, Item *inner,
+                                  const CHARSET_INFO *cs)
+{
+  if (outer->result_type() != inner->result_type())
+    return FALSE;
+
+  const enum_field_types types[2]= { outer->field_type(),
+                                     inner->field_type() };
+  for (uint i= 0; i < 2; i++)
+  {
+    switch (types[i]) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+      if (outer->result_type() != INT_RESULT)
+        return FALSE;
+      break;
+    case MYSQL_TYPE_VARCHAR:
+    case MYSQL_TYPE_VAR_STRING:
+    case MYSQL_TYPE_STRING:
+      if (outer->result_type() != STRING_RESULT)
+        return FALSE;
+      break;
+    default:
+      return FALSE;
+    }
+  }
+
+  return (outer->result_type() == INT_RESULT ||
+          (outer->collation.collation == cs &&
+           inner->collation.collation == cs));
+}
+
+
+/*
+  Get the hash join key part from an equality
+
+  SYNOPSIS
+    get_hash_key_part()
+      cond       a conjunct of the condition attached to the joined table
+      table      the joined table
+      part  OUT  the key part, or NULL if it is not needed
+
+  RETURN
+    TRUE    cond is an equality that can be used as a part of the key
+    FALSE   otherwise
+*/
+
+static bool get_hash_key_part(Item *cond, TABLE *table,
+                              JOIN_CACHE_HASH::Key_part *part)
+{
+  if (cond->type() != Item::FUNC_ITEM ||
+      ((Item_func *) cond)->functype() != Item_func::EQ_FUNC)
+    return FALSE;
+
+  Item_func_eq *eq= (Item_func_eq *) cond;
+  Item **args= eq->arguments();
+  for (uint i= 0; i < 2; i++)
+  {
+    Item *inner= args[i];
+    Item *outer= args[1 - i];
+    if (inner->real_item()->type() != Item::FIELD_ITEM ||
+        inner->used_tables() != table->map ||
+        (outer->used_tables() & (table->map | RAND_TABLE_BIT)) ||
+        !JOIN_CACHE_HASH::is_hashable(outer, inner, eq->compare_collation()))
+      continue;
+
+    if (part)
+    {
+      part->outer= outer;
+      part->inner= inner;
+      part->cs= eq->compare_collation();
+    }
+    return TRUE;
+  }
+  return FALSE;
+}
+
+
+/*
+  Find the hash join key in the condition attached to a table
+
+  SYNOPSIS
+    find_key_parts()
+      tab         the joined table
+      parts  OUT  array of MAX_REF_PARTS key parts, or NULL to only count them
+
+  DESCRIPTION
+    The function looks for equalities between the columns of the table and
+    expressions over the preceding tables among the top level conjuncts of
+    the condition that is checked for each extended record. Conditions under
+    triggers, such as the ON conditions of outer joins, are not used.
+
+  RETURN
+    the number of key parts, 0 if a hash join can't be used for the table
+*/
+
+uint JOIN_CACHE_HASH::find_key_parts(JOIN_TAB *tab, Key_part *parts)
+{
+  Item *cond= tab->select ? tab->select->cond : NULL;
+  uint count= 0;
+
+  if (cond == NULL)
+    return 0;
+
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond *) cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    List_iterator_fast<Item> li(*((Item_cond *) cond)->argument_list());
+    Item *item;
+    while ((item= li++) && count < MAX_REF_PARTS)
+    {
+      if (get_hash_key_part(item, tab->table, parts ? parts + count : NULL))
+        count++;
+    }
+  }
+  else if (get_hash_key_part(cond, tab->table, parts))
+    count++;
+
+  return count;
+}
+
+
+/*
+  Initialize a hash join cache
+
+  SYNOPSIS
+    init()
+
+  DESCRIPTION
+    The function finds the join key in the condition attached to join_tab
+    and then initializes the cache as a BNL cache.
+
+  RETURN
+    0   initialization with buffer allocations has been succeeded
+    1   otherwise
+*/
+
+int JOIN_CACHE_HASH::init()
+{
+  DBUG_ENTER("JOIN_CACHE_HASH::init");
+
+  if (!(key_parts= find_key_parts(join_tab, key_part)))
+    DBUG_RETURN(1);
+
+  DBUG_RETURN(JOIN_CACHE_BNL::init());
+}
+
+
+/*
+  Reserve room for the hash table: an entry and up to two bucket heads
+  for every record put into the join buffer
+*/
+
+uint JOIN_CACHE_HASH::aux_buffer_incr()
+{
+  return sizeof(Hash_entry) + 2 * sizeof(uint32);
+}
+
+
+uint JOIN_CACHE_HASH::aux_buffer_min_size() const
+{
+  return sizeof(Hash_entry) + 2 * sizeof(uint32) + sizeof(double);
+}
+
+
+/*
+  Calculate the hash value of a join key
+
+  SYNOPSIS
+    calc_hash()
+      outer      TRUE to hash the key of the record read from the join buffer,
+                 FALSE to hash the key of the current row of join_tab
+      hash  OUT  the hash value
+
+  RETURN
+    TRUE    a part of the key is NULL, so that it can't match any other key
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_HASH::calc_hash(bool outer, uint32 *hash)
+{
+  ulong nr1= 1, nr2= 4;
+
+  for (uint i= 0; i < key_parts; i++)
+  {
+    Item *item= outer ? key_part[i].outer : key_part[i].inner;
+    if (item->result_type() == INT_RESULT)
+    {
+      uchar buff[8];
+      const longlong value= item->val_int();
+      if (item->null_value)
+        return TRUE;
+      int8store(buff, value);
+      my_charset_bin.coll->hash_sort(&my_charset_bin, buff, sizeof(buff),
+                                     &nr1, &nr2);
+    }
+    else
+    {
+      const CHARSET_INFO *cs= key_part[i].cs;
+      char buff[STRING_BUFFER_USUAL_SIZE];
+      String tmp(buff, sizeof(buff), cs);
+      const String *str= item->val_str(&tmp);
+      if (str == NULL)
+        return TRUE;
+      cs->coll->hash_sort(cs, (const uchar *) str->ptr(), str->length(),
+                          &nr1, &nr2);
+    }
+  }
+  *hash= (uint32) nr1;
+  return FALSE;
+}
+
+
+/*
+  Build the hash table over the records in the join buffer
+
+  SYNOPSIS
+    prepare_matching_records()
+      count    number of records from the join buffer to put into the table
+
+  DESCRIPTION
+    The function reads the first 'count' records from the join buffer,
+    calculates the hash values of their join keys and places the hash table
+    in the auxiliary buffer after the last record. If the auxiliary buffer
+    is too small, which may happen when the last record barely fits into
+    the join buffer, no hash table is built and the records are joined as
+    with BNL.
+
+  RETURN
+    none
+*/
+
+void JOIN_CACHE_HASH::prepare_matching_records(uint count)
+{
+  uint32 buckets= 1;
+  while (buckets < count)
+    buckets<<= 1;
+
+  uchar *start= (uchar *) ALIGN_SIZE((size_t) end_pos);
+  hash_entries= NULL;
+  hash_buckets= NULL;
+  if (start + count * sizeof(Hash_entry) + buckets * sizeof(uint32) >
+      buff + buff_size)
+    return;
+
+  hash_entries= (Hash_entry *) start;
+  hash_buckets= (uint32 *) (start + count * sizeof(Hash_entry));
+  hash_mask= buckets - 1;
+  memset(hash_buckets, 0xFF, buckets * sizeof(uint32));
+
+  reset_cache(false);
+  for (uint i= 0; i < count; i++)
+  {
+    Hash_entry *entry= hash_entries + i;
+    get_record();
+    entry->rec_ptr= calc_hash(TRUE, &entry->hash) ? NULL : get_curr_rec();
+  }
+
+  /* Link the entries backwards to keep the buckets in the buffer order */
+  for (uint i= count; i-- > 0; )
+  {
+    Hash_entry *entry= hash_entries + i;
+    if (entry->rec_ptr == NULL)
+      continue;
+    uint32 *head= hash_buckets + (entry->hash & hash_mask);
+    entry->next= *head;
+    *head= i;
+  }
+}
+
+
+/*
+  Using the hash table find matches for the current row of the joined table
+
+  SYNOPSIS
+    match_cached_records()
+      count    number of records from the join buffer to look through
+
+  DESCRIPTION
+    The function calculates the hash value of the join key of the current
+    row of join_tab and generates the matching extensions of the records
+    from the join buffer with the same hash value.
+
+  RETURN
+    return one of enum_nested_loop_state.
+*/
+
+enum_nested_loop_state JOIN_CACHE_HASH::match_cached_records(uint count)
+{
+  enum_nested_loop_state rc;
+  uint32 hash;
+
+  if (hash_buckets == NULL)
+    return JOIN_CACHE_BNL::match_cached_records(count);
+
+  if (calc_hash(FALSE, &hash))
+    return NESTED_LOOP_OK;
+
+  for (uint32 i= hash_buckets[hash & hash_mask]; i != UINT_MAX32;
+       i= hash_entries[i].next)
+  {
+    Hash_entry *entry= hash_entries + i;
+    if (entry->hash != hash ||
+        (check_only_first_match && get_match_flag_by_pos(entry->rec_ptr)))
+      continue;
+
+    get_record_by_pos(entry->rec_ptr);
+    rc= generate_full_extensions(entry->rec_ptr);
+    if (rc != NESTED_LOOP_OK)
+      return rc;
+  }
+  return NESTED_LOOP_OK;
+}
+
      
 /*
   Set match flag for a record in join buffer if it has not been set yet    
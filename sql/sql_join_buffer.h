@@ -512,9 +512,10 @@ public:
   }
 
   /** Bits describing cache's type @sa setup_join_buffering() */
-  enum {ALG_NONE= 0, ALG_BNL= 1, ALG_BKA= 2, ALG_BKA_UNIQUE= 4};
+  enum {ALG_NONE= 0, ALG_BNL= 1, ALG_BKA= 2, ALG_BKA_UNIQUE= 4, ALG_HASH= 8};
 
   friend class JOIN_CACHE_BNL;
+  friend class JOIN_CACHE_HASH;
   friend class JOIN_CACHE_BKA;
   friend class JOIN_CACHE_BKA_UNIQUE;
 };
@@ -527,6 +528,18 @@ protected:
   /* Using BNL find matches from the next table for records from join buffer */
   enum_nested_loop_state join_matching_records(bool skip_last);
 
+  /*
+    Prepare to look for matches for the first 'count' records of the join
+    buffer once all of them have been written into it
+  */
+  virtual void prepare_matching_records(uint count) {}
+
+  /*
+    Generate the extensions of the first 'count' records of the join buffer
+    that match the current row of the joined table
+  */
+  virtual enum_nested_loop_state match_cached_records(uint count);
+
 public:
   JOIN_CACHE_BNL(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev)
     : JOIN_CACHE(j, tab, prev)
@@ -537,6 +550,86 @@ public:
 
 };
 
+/*
+  The class JOIN_CACHE_HASH supports the hash join algorithm. It is used
+  instead of JOIN_CACHE_BNL when the condition attached to the joined table
+  contains equalities between columns of the table and expressions over the
+  tables in the join buffer, which do not have an index to use BKA with.
+  Once the join buffer is full, a hash table over the values of these
+  expressions is built for all records in the buffer, and every row read
+  from the joined table is only compared with the records in its hash
+  chain instead of with all records in the buffer. When the join buffer
+  can't hold all records at once, the records are joined block by block
+  with a rescan of the joined table per block, as for BNL.
+
+  The hash table is placed in the auxiliary part of the join buffer, right
+  after the last record: an array with an entry for every record followed
+  by the bucket heads. The entries of a bucket are chained in the order of
+  the records in the buffer, so the rows are generated in the same order as
+  with BNL. The hash values are only used to skip records: every candidate
+  record is still checked against the full condition.
+*/
+
+class JOIN_CACHE_HASH :public JOIN_CACHE_BNL
+{
+public:
+  /* A part of the join key: the equality outer = inner */
+  struct Key_part
+  {
+    Item *outer;                /**< expression over the buffered tables */
+    Item *inner;                /**< column of the joined table */
+    const CHARSET_INFO *cs;     /**< collation the strings are compared with */
+  };
+
+private:
+
+  /* Entry of the hash table for a record from the join buffer */
+  struct Hash_entry
+  {
+    uchar *rec_ptr;             /**< the record, NULL if its key is NULL */
+    uint32 hash;                /**< hash value of the key of the record */
+    uint32 next;                /**< next entry in the bucket */
+  };
+
+  Key_part key_part[MAX_REF_PARTS];
+  uint key_parts;
+
+  /* The hash table, NULL if there was not enough room in the join buffer */
+  Hash_entry *hash_entries;
+  uint32 *hash_buckets;
+  uint32 hash_mask;
+
+  /* Calculate the hash value of the outer or of the inner join key */
+  bool calc_hash(bool outer, uint32 *hash);
+
+protected:
+
+  /* Reserve room for the hash table for every record in the join buffer */
+  uint aux_buffer_incr();
+  uint aux_buffer_min_size() const;
+
+  /* Build the hash table over the records in the join buffer */
+  void prepare_matching_records(uint count);
+
+  /* Look up the current row of the joined table in the hash table */
+  enum_nested_loop_state match_cached_records(uint count);
+
+public:
+  JOIN_CACHE_HASH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev)
+    : JOIN_CACHE_BNL(j, tab, prev), key_parts(0), hash_entries(NULL),
+      hash_buckets(NULL), hash_mask(0)
+  {}
+
+  /* Initialize the hash join cache */
+  int init();
+
+  /* Check if an equality outer = inner can be used as a part of the key */
+  static bool is_hashable(Item *outer, Item *inner, const CHARSET_INFO *cs);
+
+  /* Find the join key in the condition attached to the table */
+  static uint find_key_parts(JOIN_TAB *tab, Key_part *parts);
+};
+
 class JOIN_CACHE_BKA :public JOIN_CACHE
 {
 protected:
@@ -1113,6 +1113,8 @@ JOIN::optimize()
     DBUG_RETURN(1);
   }
 
+  optimize_parallel_range_scan();
+
   error= 0;
   if (beginning_id)
     measure_compilation_cpu(thd, cpu_res, beginning_id);
@@ -9714,6 +9716,95 @@ JOIN::optimize_fts_limit_query()
 }
 
 
+/**
+   Replace the range scan of a single-table aggregate query by a scan
+   whose ranges are read by several worker threads.
+
+   The rows are aggregated in the session thread, in the order in which
+   the workers return them. This is only done if
+   1. range_scan_threads is larger than 1
+   2. this is a plain SELECT in autocommit mode, not EXPLAIN, without
+      subqueries or stored routines
+   3. there is a single table, read by a range scan
+   4. the query is implicitly grouped, and all aggregate functions are
+      COUNT, SUM, AVG, MIN or MAX without DISTINCT
+   5. the rows are read without locks, and the engine can share a
+      consistent read view between threads
+   6. no BLOB is read, as the workers read through their own table
+      instances. For the same reason, a condition pushed to the index is
+      taken back and evaluated by the session thread.
+*/
+void
+JOIN::optimize_parallel_range_scan()
+{
+  const uint threads= thd->variables.range_scan_threads;
+  LEX *const lex= thd->lex;
+
+  if (threads <= 1 ||                                   // 1
+      lex->sql_command != SQLCOM_SELECT ||              // 2
+      (select_options & SELECT_DESCRIBE) ||
+      thd->in_multi_stmt_transaction_mode() ||
+      !lex->is_single_level_stmt() ||
+      lex->uses_stored_routines() ||
+      primary_tables != 1 || const_tables != 0 ||       // 3
+      !implicit_grouping || select_distinct ||          // 4
+      rollup.state != ROLLUP::STATE_NONE)
+    return;
+
+  JOIN_TAB *const tab= join_tab;
+  TABLE *const table= tab->table;
+  if (tab->type != JT_ALL || !tab->select || !tab->select->quick ||
+      tab->select->quick->get_type() != QUICK_SELECT_I::QS_TYPE_RANGE)
+    return;
+
+  const handlerton *const hton= table->file->ht;
+  if (table->s->tmp_table != NO_TMP_TABLE ||            // 5
+      table->reginfo.lock_type != TL_READ ||
+      !hton->create_cursor_read_view ||
+      !hton->set_cursor_read_view ||
+      !hton->close_cursor_read_view)
+    return;
+
+  for (Field **field= table->field; *field; field++)     // 6
+  {
+    if (((*field)->flags & BLOB_FLAG) &&
+        bitmap_is_set(table->read_set, (*field)->field_index))
+      return;
+  }
+
+  List_iterator<Item> it(all_fields);
+  Item *item;
+  while ((item= it++))
+  {
+    if (item->type() != Item::SUM_FUNC_ITEM)
+      continue;
+    switch (static_cast<Item_sum*>(item)->sum_func()) {
+    case Item_sum::COUNT_FUNC:
+    case Item_sum::SUM_FUNC:
+    case Item_sum::AVG_FUNC:
+    case Item_sum::MIN_FUNC:
+    case Item_sum::MAX_FUNC:
+      break;
+    default:
+      return;
+    }
+  }
+
+  QUICK_RANGE_SELECT *const quick=
+    static_cast<QUICK_RANGE_SELECT*>(tab->select->quick);
+  QUICK_SELECT_I *const parallel_quick= quick->make_parallel(thd, threads);
+  if (!parallel_quick)
+    return;
+
+  if (table->file->pushed_idx_cond)
+  {
+    table->file->cancel_pushed_idx_cond();
+    tab->set_jt_and_sel_condition(tab->pre_idx_push_cond, __LINE__);
+  }
+  tab->select->set_quick(parallel_quick);
+}
+
+
 /**
    For {semijoin,subquery} materialization: calculates various cost
    information, based on a plan in join->best_positions covering the
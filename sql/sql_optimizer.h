@@ -643,6 +643,12 @@ private:
    */
   void optimize_fts_limit_query();
 
+  /**
+     Read the range scan of a single-table aggregate query in several
+     threads, see QUICK_PARALLEL_RANGE_SELECT.
+   */
+  void optimize_parallel_range_scan();
+
   /**
      Replace all Item_field objects with the given field name with the
      given item in all parts of the query.
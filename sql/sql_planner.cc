@@ -30,6 +30,7 @@
 #include "opt_trace.h"
 #include "sql_executor.h"
 #include "merge_sort.h"
+#include "sql_join_buffer.h"
 #include <my_bit.h>
 
 #include <algorithm>
@@ -373,6 +374,52 @@ cache_record_length(JOIN *join,uint idx)
 }
 
 
+/**
+  Check if a table scan joined with a hash join cache can look up the
+  buffered records by a hash key.
+
+  @param join             the join being optimized
+  @param s                the table to be joined
+  @param remaining_tables set of tables not included in the partial plan yet
+
+  @return true if a multiple equality binds a column of 's' to a column of
+          a table of the partial plan and can be used as a part of the key
+          (see JOIN_CACHE_HASH::is_hashable())
+*/
+
+static bool has_hash_join_key(JOIN *join, JOIN_TAB *s,
+                              table_map remaining_tables)
+{
+  if (join->cond_equal == NULL)
+    return false;
+
+  List_iterator_fast<Item_equal> it(join->cond_equal->current_level);
+  Item_equal *item_equal;
+  while ((item_equal= it++))
+  {
+    if (item_equal->get_const())
+      continue;
+
+    Item_field *inner= NULL;
+    Item_field *outer= NULL;
+    Item_equal_iterator fields(*item_equal);
+    Item_field *item;
+    while ((item= fields++))
+    {
+      if (item->field->table == s->table)
+        inner= item;
+      else if (!(item->used_tables() & remaining_tables))
+        outer= item;
+    }
+    if (inner && outer &&
+        JOIN_CACHE_HASH::is_hashable(outer, inner,
+                                     item_equal->compare_collation()))
+      return true;
+  }
+  return false;
+}
+
+
 /**
   Find the best access path for an extension of a partial execution
   plan and add this path to the plan.
@@ -965,6 +1012,9 @@ void Optimize_table_order::best_access_path(
     if (s->table->quick_condition_rows != s->found_records)
       rnd_records= s->table->quick_condition_rows;
 
+    /* Cost of matching the rows of the table with the partial plan */
+    double pair_cost= record_count * ROW_EVALUATE_COST * rnd_records;
+
     /*
       Range optimizer never proposes a RANGE if it isn't better
       than FULL: so if RANGE is present, it's always preferred to FULL.
@@ -1016,9 +1066,10 @@ void Optimize_table_order::best_access_path(
           It would be more exact to round the result of the division with
           floor(), but that takes 5% of time in a 20-table query plan search.
         */
-        tmp*= (1.0 + ((double) cache_record_length(join,idx) *
-                      record_count /
-                      (double) thd->variables.join_buff_size));
+        const double refills=
+          1.0 + ((double) cache_record_length(join,idx) * record_count /
+                 (double) thd->variables.join_buff_size);
+        tmp*= refills;
         /* 
             We don't make full cartesian product between rows in the scanned
            table and existing records because we skip all rows from the
@@ -1027,11 +1078,23 @@ void Optimize_table_order::best_access_path(
            take into account cost to read and skip these records.
         */
         tmp+= (s->records - rnd_records) * ROW_EVALUATE_COST;
+
+        if (thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_JOIN) &&
+            has_hash_join_key(join, s, remaining_tables))
+        {
+          trace_access_scan.add("using_hash_join", true);
+          /*
+            A hash join cache hashes every buffered record once and every
+            row read from the table once per refill of the buffer, instead
+            of matching every row against every buffered record.
+          */
+          pair_cost= (record_count + rnd_records * refills) *
+                     ROW_EVALUATE_COST;
+        }
       }
     }
 
-    const double scan_cost=
-      tmp + (record_count * ROW_EVALUATE_COST * rnd_records);
+    const double scan_cost= tmp + pair_cost;
 
     trace_access_scan.add("rows", rows2double(rnd_records)).
       add("cost", scan_cost);
@@ -2373,7 +2373,10 @@ void revise_cache_usage(JOIN_TAB *join_tab)
     If block_nested_loop is turned on, and if all other criteria for using
     join buffering is fulfilled (see below), then join buffer is used
     for any join operation (inner join, outer join, semi-join) with 'JT_ALL'
-    access method.  In that case, a JOIN_CACHE_BNL object is always employed.
+    access method.  In that case, a JOIN_CACHE_BNL object is employed, or,
+    if hash_join is also on and the condition attached to the table has
+    equalities usable as a hash key (see JOIN_CACHE_HASH::find_key_parts()),
+    a JOIN_CACHE_HASH object.
 
     If an index is used to access rows of the joined table and batched_key_access
     is on, then a JOIN_CACHE_BKA object is employed. (Unless debug flag,
@@ -2556,6 +2559,26 @@ static bool setup_join_buffering(JOIN_TAB *tab, JOIN *join,
       goto no_join_cache;
     }
 
+    if (join->thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_JOIN) &&
+        JOIN_CACHE_HASH::find_key_parts(tab, NULL) > 0)
+    {
+      if ((options & SELECT_DESCRIBE) ||
+          ((tab->op= new JOIN_CACHE_HASH(join, tab, prev_cache)) &&
+           !tab->op->init()))
+      {
+        *icp_other_tables_ok= FALSE;
+        DBUG_ASSERT(might_do_join_buffering(join_buffer_alg(join->thd), tab));
+        tab->use_join_cache= JOIN_CACHE::ALG_HASH;
+        return false;
+      }
+      /* Fall back to a plain BNL cache */
+      if (tab->op)
+      {
+        tab->op->free();
+        tab->op= NULL;
+      }
+    }
+
     if ((options & SELECT_DESCRIBE) ||
         ((tab->op= new JOIN_CACHE_BNL(join, tab, prev_cache)) &&
          !tab->op->init()))
@@ -2886,6 +2909,8 @@ make_join_readinfo(JOIN *join, ulonglong options, uint no_jbuf_after)
         DBUG_RETURN(true);
       if (tab->use_join_cache != JOIN_CACHE::ALG_NONE)
         tab[-1].next_select=sub_select_op;
+      if (tab->use_join_cache == JOIN_CACHE::ALG_HASH)
+        trace_refine_table.add("using_hash_join", true);
 
       /* These init changes read_record */
       if (tab->use_quick == QS_DYNAMIC_RANGE)
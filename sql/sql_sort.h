@@ -88,6 +88,8 @@ public:
   uchar *unique_buff;
   bool not_killable;
   char* tmp_buffer;
+  uint max_sort_threads;      // Max threads for sorting a buffer.
+  bool use_radix_sort;        // Sort buffers with prefix_radix_sort().
   // The fields below are used only by Unique class.
   qsort2_cmp compare;
   BUFFPEK_COMPARE_CONTEXT cmp_context;
@@ -509,6 +509,44 @@ static uint get_temp_pool_slot_without_conflicts()
           MyISAM header size limit.
 */
 
+/**
+  Check if the BLOB/TEXT columns of a temporary table can be stored in a
+  MEMORY table.
+
+  MEMORY keeps the values in a blob arena outside of the records, but it
+  cannot index them, so the table must not have a group or distinct key
+  over a BLOB/TEXT column. Document columns always use MyISAM.
+
+  @param table         the temporary table, with its columns created
+  @param group         group key of the table, NULL if none
+  @param distinct_key  true if a distinct key over the result columns
+                       will be created
+
+  @return true if a MEMORY table can be used
+*/
+
+static bool heap_can_store_blobs(TABLE *table, ORDER *group,
+                                 bool distinct_key)
+{
+  TABLE_SHARE *share= table->s;
+
+  if (distinct_key)
+    return false;
+  for (uint i= 0; i < share->blob_fields; i++)
+  {
+    if (table->field[share->blob_field[i]]->type() == MYSQL_TYPE_DOCUMENT)
+      return false;
+  }
+  for (; group; group= group->next)
+  {
+    Field *field= (*group->item)->get_tmp_table_field();
+    if (field && (field->flags & BLOB_FLAG))
+      return false;
+  }
+  return true;
+}
+
+
 #define STRING_TOTAL_LENGTH_TO_PACK_ROWS 128
 #define AVG_STRING_LENGTH_TO_PACK_ROWS   64
 #define RATIO_TO_PACK_ROWS	       2
@@ -894,10 +932,17 @@ update_hidden:
   *blob_field= 0;				// End marker
   share->fields= field_count;
 
+  share->blob_fields= blob_count;
+
   /* If result table is small; use a heap */
   /* If result table has document columns then use MyISAM */
+  /* Blobs can be stored in a heap if no key is built over them */
   /* future: storage engine selection can be made dynamic? */
-  if (blob_count || using_unique_constraint
+  if ((blob_count &&
+       !heap_can_store_blobs(table, group,
+                             distinct &&
+                             field_count != param->hidden_field_count))
+      || using_unique_constraint
       || (thd->variables.big_tables && !(select_options & SELECT_SMALL_RESULT))
       || (select_options & TMP_TABLE_FORCE_MYISAM))
   {
@@ -927,7 +972,6 @@ update_hidden:
   if (!using_unique_constraint)
     reclength+= group_null_items;	// null flag is stored separately
 
-  share->blob_fields= blob_count;
   if (blob_count == 0)
   {
     /* We need to ensure that first byte is not 0 for the delete link */
@@ -486,6 +486,30 @@ typedef struct st_table_stats {
                          table stats. */
 } TABLE_STATS;
 
+/*
+  Table statistics of one handler that were not merged into its TABLE_STATS
+  yet, see handler::update_global_table_stats(). The row counts are also
+  counted for the index in 'index' unless that is MAX_KEY.
+*/
+typedef struct st_table_stats_delta {
+  ulonglong queries_used;
+  ulonglong queries_empty;
+  ulonglong rows_inserted;
+  ulonglong rows_updated;
+  ulonglong rows_deleted;
+  ulonglong rows_read;
+  ulonglong rows_requested;
+  ulonglong rows_index_first;
+  ulonglong rows_index_next;
+  ulonglong index_inserts;
+  ulonglong comment_bytes;
+  ulonglong last_admin;         /* last admin use, seconds since epoch */
+  ulonglong last_non_admin;     /* last non admin use, seconds ... */
+  my_io_perf_t io_perf_read;    /* Read IO performance counters of 'index' */
+  uint index;                   /* index used, MAX_KEY for none */
+  ulonglong start_time;         /* first buffered statement, milliseconds */
+} TABLE_STATS_DELTA;
+
 typedef struct st_db_stats {
   char db[NAME_LEN + 1];
   atomic_stat<ulonglong> us_user;
@@ -69,6 +69,7 @@
 #include "sql_parse.h"                          // check_global_access
 #include "sql_reload.h"                         // reload_acl_and_cache
 #include "column_statistics.h"
+#include "threadpool.h"
 
 #ifdef _WIN32
 #include "named_pipe.h"
@@ -1161,6 +1162,14 @@ static Sys_var_charptr Sys_histogram_step_size_binlog_fsync(
        IN_FS_CHARSET, DEFAULT("16ms"), NO_MUTEX_GUARD, NOT_IN_BINLOG,
        ON_CHECK(check_histogram_step_size_syntax));
 
+static Sys_var_charptr Sys_histogram_step_size_binlog_stage(
+       "histogram_step_size_binlog_stage", "Step size of the Histograms which "
+       "are used to track the latencies of the flush, sync and commit stages "
+       "of binlog group commit.",
+       GLOBAL_VAR(histogram_step_size_binlog_stage), CMD_LINE(REQUIRED_ARG),
+       IN_FS_CHARSET, DEFAULT("1ms"), NO_MUTEX_GUARD, NOT_IN_BINLOG,
+       ON_CHECK(check_histogram_step_size_syntax));
+
 static bool update_thread_priority_str(sys_var *self, THD *thd,
                                        set_var *var)
 {
@@ -2772,7 +2781,7 @@ static const char *optimizer_switch_names[]=
   "subquery_materialization_cost_based",
 #endif
   "use_index_extensions", "skip_scan", "skip_scan_cost_based",
-  "multi_range_groupby",
+  "multi_range_groupby", "hash_join",
   "default", NullS
 };
 /** propagates changes to @@engine_condition_pushdown */
@@ -2796,7 +2805,7 @@ static Sys_var_flagset Sys_optimizer_switch(
        " subquery_materialization_cost_based"
 #endif
        ", block_nested_loop, batched_key_access, use_index_extensions"
-       ", skip_scan, skip_scan_cost_based, multi_range_groupby"
+       ", skip_scan, skip_scan_cost_based, multi_range_groupby, hash_join"
        "} and val is one of {on, off, default}",
        SESSION_VAR(optimizer_switch), CMD_LINE(REQUIRED_ARG),
        optimizer_switch_names, DEFAULT(OPTIMIZER_SWITCH_DEFAULT),
@@ -3113,6 +3122,13 @@ static Sys_var_uint Sys_part_scan_max(
        SESSION_VAR(part_scan_max), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(1, UINT_MAX32), DEFAULT(10), BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_part_open_lazily(
+       "part_open_lazily",
+       "Open the partitions of an InnoDB partitioned table when a statement "
+       "first locks or reads them, instead of opening all of them with the "
+       "table.",
+       GLOBAL_VAR(opt_part_open_lazily), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static Sys_var_ulong Sys_range_alloc_block_size(
        "range_alloc_block_size",
        "Allocation block size for storing ranges during optimization",
@@ -3120,6 +3136,24 @@ static Sys_var_ulong Sys_range_alloc_block_size(
        VALID_RANGE(RANGE_ALLOC_BLOCK_SIZE, ULONG_MAX),
        DEFAULT(RANGE_ALLOC_BLOCK_SIZE), BLOCK_SIZE(1024));
 
+static Sys_var_ulong Sys_range_scan_max_threads(
+       "range_scan_max_threads",
+       "Maximum number of range scan worker threads reading at once across "
+       "all sessions. Each parallel range scan gets as many of its "
+       "range_scan_threads as are free. 0 reads in the session thread only.",
+       GLOBAL_VAR(range_scan_max_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 1024), DEFAULT(32), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_range_scan_threads(
+       "range_scan_threads",
+       "Maximum number of threads used to read the ranges of a range scan "
+       "in a single-table query whose only aggregate functions are COUNT, "
+       "SUM, AVG, MIN and MAX. 1 reads in the session thread only. Setting "
+       "the session value requires the SUPER privilege.",
+       SESSION_VAR(range_scan_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 64), DEFAULT(1), BLOCK_SIZE(1), NO_MUTEX_GUARD,
+       NOT_IN_BINLOG, ON_CHECK(check_has_super));
+
 static Sys_var_ulong Sys_multi_range_count(
        "multi_range_count",
        "Number of key ranges to request at once. "
@@ -3281,16 +3315,108 @@ static Sys_var_ulong Sys_trans_prealloc_size(
 
 static const char *thread_handling_names[]=
 {
-  "one-thread-per-connection", "no-threads", "loaded-dynamically",
+  "one-thread-per-connection", "no-threads", "pool-of-threads",
+  "loaded-dynamically",
   0
 };
 static Sys_var_enum Sys_thread_handling(
        "thread_handling",
        "Define threads usage for handling queries, one of "
-       "one-thread-per-connection, no-threads, loaded-dynamically"
+       "one-thread-per-connection, no-threads, pool-of-threads, "
+       "loaded-dynamically"
        , READ_ONLY GLOBAL_VAR(thread_handling), CMD_LINE(REQUIRED_ARG),
        thread_handling_names, DEFAULT(0));
 
+#ifdef HAVE_POOL_OF_THREADS
+static bool fix_tp_max_threads(sys_var *, THD *, enum_var_type)
+{
+  if (thread_handling == SCHEDULER_POOL_OF_THREADS)
+    thread_scheduler->max_threads= threadpool_max_threads;
+  return false;
+}
+
+static bool fix_threadpool_size(sys_var*, THD*, enum_var_type)
+{
+  tp_set_threadpool_size(threadpool_size);
+  return false;
+}
+
+static bool fix_threadpool_stall_limit(sys_var*, THD*, enum_var_type)
+{
+  tp_set_threadpool_stall_limit(threadpool_stall_limit);
+  return false;
+}
+
+static Sys_var_uint Sys_threadpool_idle_thread_timeout(
+       "thread_pool_idle_timeout",
+       "Timeout in seconds for an idle thread in the thread pool. "
+       "Worker thread will be shut down after timeout",
+       GLOBAL_VAR(threadpool_idle_timeout), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, UINT_MAX), DEFAULT(60), BLOCK_SIZE(1));
+
+static Sys_var_uint Sys_threadpool_oversubscribe(
+       "thread_pool_oversubscribe",
+       "How many additional active worker threads in a group are allowed.",
+       GLOBAL_VAR(threadpool_oversubscribe), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 1000), DEFAULT(3), BLOCK_SIZE(1));
+
+static Sys_var_uint Sys_threadpool_size(
+       "thread_pool_size",
+       "Number of thread groups in the pool. "
+       "This parameter is roughly equivalent to maximum number of "
+       "concurrently executing threads (threads in a waiting state do not "
+       "count as executing). 0 means the number of processors.",
+       GLOBAL_VAR(threadpool_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, MAX_THREAD_GROUPS), DEFAULT(0), BLOCK_SIZE(1),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_threadpool_size));
+
+static Sys_var_uint Sys_threadpool_stall_limit(
+       "thread_pool_stall_limit",
+       "Maximum query execution time in milliseconds, "
+       "before an executing non-yielding thread is considered stalled. "
+       "If a worker thread is stalled, additional worker thread "
+       "may be created to handle remaining clients.",
+       GLOBAL_VAR(threadpool_stall_limit), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(10, UINT_MAX), DEFAULT(500), BLOCK_SIZE(1),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_threadpool_stall_limit));
+
+static Sys_var_uint Sys_threadpool_max_threads(
+       "thread_pool_max_threads",
+       "Maximum allowed number of worker threads in the thread pool",
+       GLOBAL_VAR(threadpool_max_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 100000), DEFAULT(100000),
+       BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_tp_max_threads));
+
+static Sys_var_uint Sys_threadpool_high_prio_tickets(
+       "thread_pool_high_prio_tickets",
+       "Number of tickets to enter the high priority event queue for each "
+       "transaction.",
+       GLOBAL_VAR(threadpool_high_prio_tickets), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX), DEFAULT(UINT_MAX), BLOCK_SIZE(1));
+
+static const char *threadpool_high_prio_mode_names[]=
+{
+  "transactions", "statements", "none", 0
+};
+static Sys_var_enum Sys_threadpool_high_prio_mode(
+       "thread_pool_high_prio_mode",
+       "High priority queue mode: one of 'transactions', 'statements' or "
+       "'none'. In the 'transactions' mode the thread pool uses both high- "
+       "and low-priority queues depending on whether an event is generated "
+       "by an already started transaction and whether it has any high "
+       "priority tickets (see thread_pool_high_prio_tickets). In the "
+       "'statements' mode all events (i.e. individual statements) always go "
+       "to the high priority queue, regardless of the current transaction "
+       "state and high priority tickets. 'none' is the opposite of "
+       "'statements', i.e. disables the high priority queue completely.",
+       GLOBAL_VAR(threadpool_high_prio_mode), CMD_LINE(REQUIRED_ARG),
+       threadpool_high_prio_mode_names,
+       DEFAULT(TP_HIGH_PRIO_MODE_TRANSACTIONS));
+#endif /* HAVE_POOL_OF_THREADS */
+
 static const char *allow_noncurrent_db_rw_levels[] =
 {
   "ON", "LOG", "LOG_WARN", "OFF", 0
@@ -3326,11 +3452,27 @@ static Sys_var_ulong Sys_query_cache_size(
        NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_query_cache_size));
 
+static bool fix_query_cache_limit(sys_var *self, THD *thd, enum_var_type type)
+{
+  query_cache.result_size_limit(query_cache.query_cache_limit);
+  return false;
+}
 static Sys_var_ulong Sys_query_cache_limit(
        "query_cache_limit",
        "Don't cache results that are bigger than this",
        GLOBAL_VAR(query_cache.query_cache_limit), CMD_LINE(REQUIRED_ARG),
-       VALID_RANGE(0, ULONG_MAX), DEFAULT(1024*1024), BLOCK_SIZE(1));
+       VALID_RANGE(0, ULONG_MAX), DEFAULT(1024*1024), BLOCK_SIZE(1),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_query_cache_limit));
+
+static Sys_var_ulong Sys_query_cache_instances(
+       "query_cache_instances",
+       "The number of query cache instances. Queries are spread over the "
+       "instances by the hash of their text, and query_cache_size is split "
+       "evenly between them",
+       READ_ONLY GLOBAL_VAR(query_cache_instances), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, Query_cache_manager::MAX_QUERY_CACHES), DEFAULT(1),
+       BLOCK_SIZE(1));
 
 static bool fix_qcache_min_res_unit(sys_var *self, THD *thd, enum_var_type type)
 {
@@ -3784,6 +3926,16 @@ static Sys_var_long Sys_zstd_net_compression_level(
       GLOBAL_VAR(zstd_net_compression_level), CMD_LINE(OPT_ARG),
       VALID_RANGE(LONG_MIN, 22), DEFAULT(ZSTD_CLEVEL_DEFAULT), BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_net_compression_adaptive(
+       "net_compression_adaptive",
+       "Adjust the compression level of each compressed client connection "
+       "to the time spent compressing its packets versus writing them to "
+       "the network, starting from the level configured for its compression "
+       "library. The level is lowered when compressing takes longer and "
+       "raised when the network is slower.",
+       GLOBAL_VAR(net_compression_adaptive), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static Sys_var_ulong Sys_sort_buffer(
        "sort_buffer_size",
        "Each thread that needs to do a sort allocates a buffer of this size",
@@ -4287,6 +4439,31 @@ static Sys_var_ulonglong Sys_filesort_max_file_size(
        VALID_RANGE(0, ULONGLONG_MAX), DEFAULT(0),
        BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_filesort_max_threads(
+       "filesort_max_threads",
+       "Maximum number of filesort worker threads running at once across "
+       "all sessions. Each parallel sort of a buffer gets as many of its "
+       "filesort_threads as are free. 0 sorts in the session thread only.",
+       GLOBAL_VAR(filesort_max_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 1024), DEFAULT(32), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_filesort_threads(
+       "filesort_threads",
+       "Maximum number of threads used to sort each buffer of keys in a "
+       "filesort. 1 sorts in the session thread only. Setting the session "
+       "value requires the SUPER privilege.",
+       SESSION_VAR(filesort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 64), DEFAULT(1), BLOCK_SIZE(1), NO_MUTEX_GUARD,
+       NOT_IN_BINLOG, ON_CHECK(check_has_super));
+
+static Sys_var_mybool Sys_filesort_radix_sort(
+       "filesort_radix_sort",
+       "Sort buffers of 1000 or more keys in a filesort with a radix sort "
+       "on a copy of the first 8 bytes of each key, instead of comparing "
+       "the keys through their pointers. The copies take 32 bytes per key, "
+       "which are counted against sort_buffer_size.",
+       SESSION_VAR(filesort_radix_sort), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static Sys_var_mybool Sys_timed_mutexes(
        "timed_mutexes",
        "Specify whether to time mutexes. Deprecated, has no effect.",
@@ -6953,10 +7130,23 @@ static Sys_var_enum Sys_column_stats_control(
 
 static Sys_var_mybool Sys_use_cached_table_stats_ptr(
        "use_cached_table_stats_ptr",
-       "Controls the use of the cached table_stats ptr in the handler object",
+       "Controls the use of the cached table_stats ptr in the handler object. "
+       "If OFF, the table statistics are looked up for every statement. If "
+       "ON, the cached object is used until the table is renamed or dropped",
        GLOBAL_VAR(use_cached_table_stats_ptr),
        CMD_LINE(OPT_ARG), DEFAULT(FALSE));
 
+static Sys_var_ulong Sys_table_stats_flush_interval_ms(
+       "table_stats_flush_interval_ms",
+       "How long, in milliseconds, a handler may buffer its table and index "
+       "statistics before merging them into TABLE_STATISTICS and "
+       "INDEX_STATISTICS. The statistics are also merged when the table is "
+       "closed, and for tables not in use when TABLE_STATISTICS or "
+       "INDEX_STATISTICS is read. If 0, they are merged at the end of every "
+       "statement",
+       GLOBAL_VAR(table_stats_flush_interval_ms), CMD_LINE(OPT_ARG),
+       VALID_RANGE(0, 60000), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_uint Sys_max_db_stats_entries(
       "max_db_stats_entries",
       "Maximum number of entries in DB_STATISTICS",
@@ -349,8 +349,8 @@ public:
 
   Filesort_info(): record_pointers(0) {};
   /** Sort filesort_buffer */
-  void sort_buffer(Sort_param *param, uint count)
-  { filesort_buffer.sort_buffer(param, count); }
+  uint sort_buffer(Sort_param *param, uint count)
+  { return filesort_buffer.sort_buffer(param, count); }
 
   /**
      Accessors for Filesort_buffer (which @c).
@@ -185,6 +185,27 @@ void Table_cache::free_old_unused_tables(time_point cutpoint)
   }
 }
 
+/**
+  Merge the table statistics buffered by the unused TABLE objects in the
+  table cache, see handler::update_global_table_stats(). No thread uses
+  these handlers while we own the lock.
+*/
+
+void Table_cache::flush_unused_table_stats()
+{
+  assert_owner();
+
+  if (!m_unused_tables)
+    return;
+
+  TABLE *t= m_unused_tables;
+  do
+  {
+    t->file->flush_table_stats_delta();
+    t= t->next;
+  } while (t != m_unused_tables);
+}
+
 #ifndef DBUG_OFF
 /**
   Print debug information for the contents of the table cache.
@@ -426,6 +447,21 @@ void Table_cache_manager::free_old_unused_tables(time_point cutpoint)
     m_table_cache[i].free_old_unused_tables(cutpoint);
 }
 
+/**
+  Merge the table statistics buffered by the unused TABLE objects in all
+  table cache instances, locking one instance at a time.
+*/
+
+void Table_cache_manager::flush_unused_table_stats()
+{
+  for (uint i= 0; i < table_cache_instances; i++)
+  {
+    m_table_cache[i].lock();
+    m_table_cache[i].flush_unused_table_stats();
+    m_table_cache[i].unlock();
+  }
+}
+
 #ifndef DBUG_OFF
 /**
   Print debug information for the contents of all table cache instances.
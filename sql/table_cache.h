@@ -132,6 +132,7 @@ public:
 
   void free_all_unused_tables();
   void free_old_unused_tables(time_point cutpoint);
+  void flush_unused_table_stats();
 
 #ifndef DBUG_OFF
   void print_tables();
@@ -178,6 +179,7 @@ public:
 
   void free_all_unused_tables();
   void free_old_unused_tables(time_point cutpoint);
+  void flush_unused_table_stats();
 
 #ifndef DBUG_OFF
   void print_tables();
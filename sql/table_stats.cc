@@ -3,9 +3,16 @@
 #include "sql_show.h"
 #include "my_atomic.h"
 #include "mysqld.h"
+#include "table_cache.h"
 
 HASH global_table_stats;
 
+/*
+  Incremented whenever a TABLE_STATS object is renamed or freed, so that
+  handlers know their cached object must be looked up again.
+*/
+longlong global_table_stats_version = 0;
+
 /* ########### begin of encoding service ########### */
 
 static bool names_map_initialized = false;
@@ -789,12 +796,23 @@ bool valid_global_table_stats(TABLE_STATS *table_stats)
     return true;
 }
 
+/*
+  Merge the statistics buffered by handlers that no thread is using, so
+  that they are not held back until the handler is used again, see
+  table_stats_flush_interval_ms.
+*/
+static void flush_unused_table_stats()
+{
+  table_cache_manager.flush_unused_table_stats();
+}
+
 int fill_table_stats(THD *thd, TABLE_LIST *tables, Item *cond)
 {
   DBUG_ENTER("fill_table_stats");
   TABLE* table= tables->table;
 
   ha_get_table_stats(fill_table_stats_cb);
+  flush_unused_table_stats();
 
   bool table_stats_lock_acquired = lock_global_table_stats();
 
@@ -1008,6 +1026,8 @@ int fill_index_stats(THD *thd, TABLE_LIST *tables, Item *cond)
   DBUG_ENTER("fill_index_stats");
   TABLE* table= tables->table;
 
+  flush_unused_table_stats();
+
   bool table_stats_lock_acquired = lock_global_table_stats();
 
   ID_NAME_MAP db_map;
@@ -1253,6 +1273,8 @@ void table_stats_rename(const char *old_name, const char *new_name)
 
   if (stats)
   {
+    my_atomic_add64(&global_table_stats_version, 1);
+
     /* Update the DB ID and/or table ID, and hash key */
 
     /* db_id can be invalid if new DB name could not be inserted */
@@ -1344,7 +1366,10 @@ void table_stats_delete(const char *old_name)
       my_hash_search(&global_table_stats, (uchar*)&hash_key, sizeof(hash_key));
 
     if (old_stats)
+    {
+      my_atomic_add64(&global_table_stats_version, 1);
       my_hash_delete(&global_table_stats, (uchar*)old_stats);
+    }
 
     unlock_global_table_stats(table_stats_lock_acquired);
 
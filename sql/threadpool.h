@@ -0,0 +1,95 @@
+/* Copyright (C) 2012 Monty Program Ab
+   Copyright (c) 2016, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef THREADPOOL_INCLUDED
+#define THREADPOOL_INCLUDED
+
+/*
+  Pool-of-threads connection scheduler (--thread-handling=pool-of-threads).
+
+  Connections are distributed over thread_pool_size thread groups. Each
+  group owns an epoll descriptor on which idle connections are parked, a
+  queue of connections that have a pending request, and a small set of
+  worker threads. One of the workers acts as the listener and waits on
+  epoll; the others execute queued requests. A timer thread detects groups
+  whose active worker has not finished within thread_pool_stall_limit and
+  lets the group wake or create another worker, and workers that block
+  inside the server (see thd_wait_begin()) are likewise replaced.
+*/
+
+#include "my_global.h"
+
+#if defined(HAVE_EPOLL) && !defined(EMBEDDED_LIBRARY)
+#define HAVE_POOL_OF_THREADS 1
+#endif
+
+#ifdef HAVE_POOL_OF_THREADS
+
+#include <atomic>
+
+class THD;
+
+#define MAX_THREAD_GROUPS 128
+
+enum tp_high_prio_mode_t
+{
+  TP_HIGH_PRIO_MODE_TRANSACTIONS,
+  TP_HIGH_PRIO_MODE_STATEMENTS,
+  TP_HIGH_PRIO_MODE_NONE
+};
+
+/* Threadpool parameters */
+extern uint threadpool_idle_timeout; /* Shutdown idle worker threads  after this timeout */
+extern uint threadpool_size; /* Number of parallel executing threads */
+extern uint threadpool_max_threads;
+extern uint threadpool_stall_limit;  /* time interval in milliseconds for stall checks*/
+extern uint threadpool_oversubscribe;  /* Maximum active threads in group */
+extern uint threadpool_high_prio_tickets;
+extern ulong threadpool_high_prio_mode;
+
+/* Threadpool status variables */
+extern std::atomic<int32> tp_thread_count;          /* Number of worker threads */
+extern std::atomic<ulonglong> tp_stall_count;       /* Number of stalls detected */
+extern std::atomic<ulonglong> tp_high_prio_queued;  /* Events queued as high priority */
+extern std::atomic<ulonglong> tp_low_prio_queued;   /* Events queued as low priority */
+
+/* Common thread pool routines, suitable for different implementations */
+extern void threadpool_remove_connection(THD *thd);
+extern int  threadpool_process_request(THD *thd);
+extern int  threadpool_add_connection(THD *thd);
+
+/*
+  Functions used by scheduler.
+  OS-specific implementations are in
+  threadpool_unix.cc
+*/
+extern bool tp_init();
+extern void tp_add_connection(THD*);
+extern void tp_wait_begin(THD *, int);
+extern void tp_wait_end(THD*);
+extern void tp_post_kill_notification(THD *thd);
+extern void tp_end(void);
+
+/* Used in SHOW for Threadpool_idle_threads */
+extern int  tp_get_idle_thread_count();
+
+/* Functions to set threadpool parameters */
+extern void tp_set_threadpool_size(uint val);
+extern void tp_set_threadpool_stall_limit(uint val);
+
+#endif /* HAVE_POOL_OF_THREADS */
+
+#endif /* THREADPOOL_INCLUDED */
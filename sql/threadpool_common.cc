@@ -0,0 +1,263 @@
+/* Copyright (C) 2012 Monty Program Ab
+   Copyright (c) 2016, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  Connection handling shared by the pool-of-threads implementations:
+  login, execution of a single request, and disconnect. Unlike
+  do_handle_one_connection(), these functions run on an arbitrary worker
+  thread, so the per-connection thread state (mysys_var, PSI thread,
+  THR_THD) is attached to the worker while the connection is served and
+  detached afterwards.
+*/
+
+#include "sql_priv.h"
+#include "threadpool.h"
+
+#ifdef HAVE_POOL_OF_THREADS
+
+#include "sql_class.h"
+#include "sql_connect.h"
+#include "sql_parse.h"
+#include "sql_audit.h"
+#include "sql_multi_tenancy.h"
+#include "mysqld.h"
+#include "global_threads.h"
+#include "scheduler.h"
+#include "debug_sync.h"
+
+uint threadpool_idle_timeout;
+uint threadpool_size;
+uint threadpool_max_threads;
+uint threadpool_stall_limit;
+uint threadpool_oversubscribe;
+uint threadpool_high_prio_tickets;
+ulong threadpool_high_prio_mode;
+
+
+/*
+  Worker threads contexts, and THD contexts.
+  =========================================
+
+  Both worker threads and connections have their sets of thread local
+  variables. At the moment it is mysys_var (which has e.g dbug my_error and
+  similar goodies inside), and PSI per-client structure.
+
+  Whenever query is executed following needs to be done:
+
+  1. Save worker thread context.
+  2. Change TLS variables to connection specific ones using thread_attach(THD*).
+     This function does some additional work.
+  3. Process query
+  4. Restore worker thread context.
+
+  Connection login and termination follows similar schema w.r.t saving and
+  restoring contexts.
+
+  For both worker thread, and for the connection, mysys variables are created
+  using my_thread_init() and freed with my_thread_end().
+*/
+struct Worker_thread_context
+{
+  PSI_thread *psi_thread;
+  st_my_thread_var* mysys_var;
+
+  void save()
+  {
+#ifdef HAVE_PSI_THREAD_INTERFACE
+    psi_thread= PSI_THREAD_CALL(get_thread)();
+#endif
+    mysys_var= my_thread_var;
+  }
+
+  void restore()
+  {
+#ifdef HAVE_PSI_THREAD_INTERFACE
+    PSI_THREAD_CALL(set_thread)(psi_thread);
+#endif
+    set_mysys_var(mysys_var);
+    pthread_setspecific(THR_THD, 0);
+    pthread_setspecific(THR_MALLOC, 0);
+  }
+};
+
+
+/*
+  Attach/associate the connection with the OS thread,
+*/
+static bool thread_attach(THD* thd)
+{
+  set_mysys_var(thd->mysys_var);
+  thd->thread_stack=(char*)&thd;
+  thd->store_globals();
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  PSI_THREAD_CALL(set_thread)(thd_get_psi(thd));
+#endif
+  mysql_socket_set_thread_owner(thd->get_net()->vio->mysql_socket);
+  return 0;
+}
+
+
+int threadpool_add_connection(THD *thd)
+{
+  int retval=1;
+  Worker_thread_context worker_context;
+  worker_context.save();
+
+  /*
+    Create a new connection context: mysys_thread_var and PSI thread
+    Store them in THD.
+  */
+
+  set_mysys_var(NULL);
+  my_thread_init();
+  thd->set_mysys_var(my_thread_var);
+  if (!thd->mysys_var)
+  {
+    /* Out of memory? */
+    worker_context.restore();
+    return 1;
+  }
+
+  /* Create new PSI thread for use with the THD. */
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  thd_set_psi(thd,
+              PSI_THREAD_CALL(new_thread)
+                (key_thread_one_connection, thd, thd->thread_id()));
+#endif
+
+
+  /* Login. */
+  thread_attach(thd);
+  ulonglong now= my_micro_time();
+  thd->prior_thr_create_utime= now;
+  thd->start_utime= now;
+  thd->thr_create_utime= now;
+
+  if (!thd_prepare_connection(thd))
+  {
+    /*
+      Check if THD is ok, as prepare_new_connection_state()
+      can fail, for example if init command failed.
+    */
+    if (thd_is_connection_alive(thd))
+    {
+      per_user_session_variables.set_thd(thd);
+      retval= 0;
+      thd->get_net()->reading_or_writing= 1;
+    }
+  }
+
+  worker_context.restore();
+  return retval;
+}
+
+
+void threadpool_remove_connection(THD *thd)
+{
+  Worker_thread_context worker_context;
+  worker_context.save();
+
+  thread_attach(thd);
+  thd->get_net()->reading_or_writing= 0;
+
+  thd_update_net_stats(thd);
+  multi_tenancy_close_connection(thd);
+  end_connection(thd);
+  close_connection(thd, 0);
+
+  thd->release_resources();
+  remove_global_thread(thd);
+  delete thd;
+
+  /*
+    Free resources associated with this connection:
+    mysys thread_var and PSI thread.
+  */
+  my_thread_end();
+
+  /* close_connections() waits for the last THD to go away. */
+  mysql_mutex_lock(&LOCK_thread_count);
+  if (get_thread_count() == 0)
+    mysql_cond_broadcast(&COND_thread_count);
+  dec_connection_count_locked();
+  mysql_mutex_unlock(&LOCK_thread_count);
+
+  worker_context.restore();
+}
+
+
+/**
+  Process a single client request or a single batch.
+*/
+int threadpool_process_request(THD *thd)
+{
+  int retval= 0;
+  Worker_thread_context  worker_context;
+  worker_context.save();
+
+  thread_attach(thd);
+
+  if (thd->killed == THD::KILL_CONNECTION)
+  {
+    /*
+      killed flag was set by timeout handler
+      or KILL command. Return error.
+    */
+    retval= 1;
+    goto end;
+  }
+
+  /*
+    In the loop below, the flow is essentially the copy of thead-per-connections
+    logic, see do_handle_one_connection() in sql_connect.c
+
+    The goal is to execute a single query, thus the loop is normally executed
+    only once. However for SSL connections, it can be executed multiple times
+    (SSL can preread and cache incoming data, and vio->has_data() checks if it
+    was the case).
+  */
+  for(;;)
+  {
+    Vio *vio;
+    thd->get_net()->reading_or_writing= 0;
+    mysql_audit_release(thd);
+
+    if ((retval= do_command(thd)) != 0)
+      goto end;
+
+    if (!thd_is_connection_alive(thd))
+    {
+      retval= 1;
+      goto end;
+    }
+
+    vio= thd->get_net()->vio;
+    if (!vio->has_data(vio))
+    {
+      /* More info on this debug sync is in sql_parse.cc*/
+      DEBUG_SYNC(thd, "before_do_command_net_read");
+      thd->get_net()->reading_or_writing= 1;
+      goto end;
+    }
+  }
+
+end:
+  worker_context.restore();
+  return retval;
+}
+
+
+#endif /* HAVE_POOL_OF_THREADS */
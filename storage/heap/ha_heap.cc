@@ -677,8 +677,11 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   ha_rows max_rows;
   HP_KEYDEF *keydef;
   HA_KEYSEG *seg;
+  HP_BLOB_DESC *blob_desc;
   TABLE_SHARE *share= table_arg->s;
   bool found_real_auto_increment= 0;
+  /* Only internal temporary tables may have BLOB/TEXT columns */
+  uint blobs= internal_table ? share->blob_fields : 0;
 
   memset(hp_create_info, 0, sizeof(*hp_create_info));
 
@@ -686,10 +689,18 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
     parts+= table_arg->key_info[key].user_defined_key_parts;
 
   if (!(keydef= (HP_KEYDEF*) my_malloc(keys * sizeof(HP_KEYDEF) +
-				       parts * sizeof(HA_KEYSEG),
+				       parts * sizeof(HA_KEYSEG) +
+				       blobs * sizeof(HP_BLOB_DESC),
 				       MYF(MY_WME))))
     return my_errno;
   seg= reinterpret_cast<HA_KEYSEG*>(keydef + keys);
+  blob_desc= reinterpret_cast<HP_BLOB_DESC*>(seg + parts);
+  for (uint i= 0; i < blobs; i++)
+  {
+    Field_blob *field= (Field_blob*) table_arg->field[share->blob_field[i]];
+    blob_desc[i].offset= field->offset(table_arg->record[0]);
+    blob_desc[i].packlength= field->pack_length_no_ptr();
+  }
   for (key= 0; key < keys; key++)
   {
     KEY *pos= table_arg->key_info+key;
@@ -769,6 +780,16 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->auto_key= auto_key;
   hp_create_info->auto_key_type= auto_key_type;
   hp_create_info->max_table_size=current_thd->variables.max_heap_table_size;
+  if (blobs)
+  {
+    /*
+      The values are stored outside of the records, so the number of
+      records does not limit the size of the table; convert it to
+      on-disk when it grows beyond tmp_table_size instead.
+    */
+    set_if_smaller(hp_create_info->max_table_size,
+                   current_thd->variables.tmp_table_size);
+  }
   hp_create_info->with_auto_increment= found_real_auto_increment;
   hp_create_info->internal_table= internal_table;
 
@@ -781,6 +802,8 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->keys= share->keys;
   hp_create_info->reclength= share->reclength;
   hp_create_info->keydef= keydef;
+  hp_create_info->blobs= blobs;
+  hp_create_info->blob_descs= blob_desc;
   return 0;
 }
 
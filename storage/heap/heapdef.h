@@ -98,6 +98,12 @@ extern my_bool hp_if_null_in_key(HP_KEYDEF *keyinfo, const uchar *record);
 extern int hp_close(register HP_INFO *info);
 extern void hp_clear(HP_SHARE *info);
 extern void hp_clear_keys(HP_SHARE *info);
+extern int hp_alloc_blobs(HP_SHARE *share, const uchar *record,
+                          uchar *old_data, uchar **data);
+extern void hp_copy_blobs(HP_SHARE *share, uchar *pos, uchar *data);
+extern uchar *hp_blob_data(HP_SHARE *share, const uchar *pos);
+extern void hp_free_blob_data(HP_SHARE *share, uchar *data);
+extern void hp_free_blobs(HP_SHARE *share);
 extern uint hp_rb_pack_key(HP_KEYDEF *keydef, uchar *key, const uchar *old,
                            key_part_map keypart_map);
 
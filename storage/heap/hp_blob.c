@@ -0,0 +1,301 @@
+/* Copyright (c) 2016, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/* Storage of BLOB/TEXT values of heap tables in the blob arena */
+
+#include "heapdef.h"
+
+#define HP_BLOB_PAGE_SIZE (64*1024L - sizeof(HP_BLOB_PAGE))
+
+
+static ulong hp_blob_length(const HP_BLOB_DESC *desc, const uchar *record)
+{
+  const uchar *pos= record + desc->offset;
+  switch (desc->packlength) {
+  case 1:
+    return (ulong) *pos;
+  case 2:
+    return (ulong) uint2korr(pos);
+  case 3:
+    return (ulong) uint3korr(pos);
+  case 4:
+    return (ulong) uint4korr(pos);
+  default:
+    DBUG_ASSERT(0);
+  }
+  return 0;
+}
+
+
+/* Number of the free list of a chunk of the given size */
+
+static uint hp_blob_free_list(size_t size)
+{
+  uint n= 0;
+  while (size >>= 1)
+    n++;
+  return n;
+}
+
+
+/*
+  Allocate a chunk of the blob arena
+
+  SYNOPSIS
+    hp_alloc_blob_chunk()
+    share     Heap table
+    length    Bytes needed
+
+  DESCRIPTION
+    A free chunk is taken from the first free list whose chunks are all
+    large enough. Otherwise the chunk is carved from the current page, or
+    from a new page.
+
+  RETURN
+    The data of the chunk, NULL on error with my_errno set
+*/
+
+static uchar *hp_alloc_blob_chunk(HP_SHARE *share, size_t length)
+{
+  HP_BLOB_PAGE *page= share->blob_pages;
+  HP_BLOB_CHUNK *chunk;
+  size_t chunk_length, alloc_length;
+  uint n;
+
+  length= ALIGN_SIZE(length);
+  chunk_length= ALIGN_SIZE(sizeof(HP_BLOB_CHUNK)) + length;
+
+  n= hp_blob_free_list(length);
+  if (((size_t) 1 << n) < length)
+    n++;
+  for (; n < HP_BLOB_FREE_LISTS; n++)
+  {
+    if ((chunk= share->blob_free[n]))
+    {
+      share->blob_free[n]= chunk->next_free;
+      return (uchar*) chunk + ALIGN_SIZE(sizeof(HP_BLOB_CHUNK));
+    }
+  }
+
+  if (page && page->size - page->used >= chunk_length)
+  {
+    chunk= (HP_BLOB_CHUNK*) ((uchar*) (page + 1) + page->used);
+    page->used+= chunk_length;
+  }
+  else
+  {
+    alloc_length= MY_MAX(chunk_length, HP_BLOB_PAGE_SIZE);
+    if (share->data_length + share->index_length + alloc_length >
+        share->max_table_size)
+    {
+      my_errno= HA_ERR_RECORD_FILE_FULL;
+      return NULL;
+    }
+    if (!(page= (HP_BLOB_PAGE*) my_malloc(sizeof(HP_BLOB_PAGE) +
+                                          alloc_length, MYF(0))))
+    {
+      my_errno= HA_ERR_OUT_OF_MEM;
+      return NULL;
+    }
+    page->size= alloc_length;
+    page->used= chunk_length;
+    share->data_length+= sizeof(HP_BLOB_PAGE) + alloc_length;
+
+    /* Keep allocating from the current page if this one is full already */
+    if (chunk_length == alloc_length && share->blob_pages)
+    {
+      page->next= share->blob_pages->next;
+      share->blob_pages->next= page;
+    }
+    else
+    {
+      page->next= share->blob_pages;
+      share->blob_pages= page;
+    }
+    chunk= (HP_BLOB_CHUNK*) (page + 1);
+  }
+  chunk->size= length;
+  return (uchar*) chunk + ALIGN_SIZE(sizeof(HP_BLOB_CHUNK));
+}
+
+
+static HP_BLOB_CHUNK *hp_blob_chunk(uchar *data)
+{
+  return (HP_BLOB_CHUNK*) (data - ALIGN_SIZE(sizeof(HP_BLOB_CHUNK)));
+}
+
+
+/*
+  Allocate space for the blob values of a record
+
+  SYNOPSIS
+    hp_alloc_blobs()
+    share     Heap table
+    record    Record whose values will be stored
+    old_data  Blob data of the record that is updated, NULL if none
+    data OUT  Start of the allocated space, NULL if all values are empty
+
+  DESCRIPTION
+    The space is allocated before the record is written, so that the write
+    can fail before any index is changed. The values are copied into it
+    by hp_copy_blobs() once the record has been stored.
+
+    An update reuses the chunk of the old values if the new ones fit and
+    none of them is read from another place of that chunk. Otherwise the
+    chunk grows at least twice as large, so that a value growing with every
+    update of a GROUP BY row moves only a few times. The caller frees old_data once the new
+    values are copied if a different chunk was returned.
+
+  RETURN
+    0                       OK
+    HA_ERR_RECORD_FILE_FULL The table would exceed max_table_size
+    HA_ERR_OUT_OF_MEM       Out of memory
+*/
+
+int hp_alloc_blobs(HP_SHARE *share, const uchar *record, uchar *old_data,
+                   uchar **data)
+{
+  HP_BLOB_DESC *desc, *end;
+  size_t length= 0, old_length;
+  my_bool reuse= TRUE;
+  DBUG_ENTER("hp_alloc_blobs");
+
+  for (desc= share->blob_descs, end= desc + share->blobs; desc < end; desc++)
+  {
+    const ulong value_length= hp_blob_length(desc, record);
+    uchar *value;
+
+    if (!value_length)
+      continue;
+    memcpy(&value, record + desc->offset + desc->packlength, sizeof(value));
+    /* A value that is already in place, like an unchanged one, is kept */
+    if (old_data && value < old_data + hp_blob_chunk(old_data)->size &&
+        value + value_length > old_data && value != old_data + length)
+      reuse= FALSE;
+    length+= value_length;
+  }
+
+  *data= NULL;
+  if (!length)
+    DBUG_RETURN(0);
+
+  if (old_data)
+  {
+    old_length= hp_blob_chunk(old_data)->size;
+    if (reuse && length <= old_length)
+    {
+      *data= old_data;
+      DBUG_RETURN(0);
+    }
+    if (length > old_length)
+      length= MY_MAX(length, 2 * old_length);
+  }
+
+  if (!(*data= hp_alloc_blob_chunk(share, length)))
+    DBUG_RETURN(my_errno);
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Get the blob data of a stored record
+
+  RETURN
+    The chunk holding the values of the record, NULL if all are empty
+*/
+
+uchar *hp_blob_data(HP_SHARE *share, const uchar *pos)
+{
+  HP_BLOB_DESC *desc, *end;
+
+  /* hp_copy_blobs() stores the first non-empty value at the chunk start */
+  for (desc= share->blob_descs, end= desc + share->blobs; desc < end; desc++)
+  {
+    if (hp_blob_length(desc, pos))
+    {
+      uchar *value;
+      memcpy(&value, pos + desc->offset + desc->packlength, sizeof(value));
+      return value;
+    }
+  }
+  return NULL;
+}
+
+
+/* Put the chunk of blob data on its free list */
+
+void hp_free_blob_data(HP_SHARE *share, uchar *data)
+{
+  HP_BLOB_CHUNK *chunk;
+  uint n;
+
+  if (!data)
+    return;
+  chunk= hp_blob_chunk(data);
+  n= hp_blob_free_list(chunk->size);
+  chunk->next_free= share->blob_free[n];
+  share->blob_free[n]= chunk;
+}
+
+
+/*
+  Copy the blob values of a stored record into the blob arena
+
+  SYNOPSIS
+    hp_copy_blobs()
+    share     Heap table
+    pos       The stored record, which still points to the caller's values
+    data      Space allocated for the values by hp_alloc_blobs()
+*/
+
+void hp_copy_blobs(HP_SHARE *share, uchar *pos, uchar *data)
+{
+  HP_BLOB_DESC *desc, *end;
+
+  for (desc= share->blob_descs, end= desc + share->blobs; desc < end; desc++)
+  {
+    uchar *ptr_pos= pos + desc->offset + desc->packlength;
+    const ulong length= hp_blob_length(desc, pos);
+    uchar *value;
+
+    if (!length)
+      value= NULL;
+    else
+    {
+      memcpy(&value, ptr_pos, sizeof(value));
+      if (value != data)
+        memcpy(data, value, length);
+      value= data;
+      data+= length;
+    }
+    memcpy(ptr_pos, &value, sizeof(value));
+  }
+}
+
+
+/* Free the blob arena of a table */
+
+void hp_free_blobs(HP_SHARE *share)
+{
+  HP_BLOB_PAGE *page, *next;
+
+  for (page= share->blob_pages; page; page= next)
+  {
+    next= page->next;
+    my_free(page);
+  }
+  share->blob_pages= NULL;
+  memset(share->blob_free, 0, sizeof(share->blob_free));
+}
@@ -21,7 +21,7 @@
 int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
 {
   HP_KEYDEF *keydef, *end, *p_lastinx;
-  uchar *pos;
+  uchar *pos, *blob_data= NULL, *old_blob_data= NULL;
   my_bool auto_key_changed= 0;
   HP_SHARE *share= info->s;
   DBUG_ENTER("heap_update");
@@ -31,6 +31,12 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
 
   if (info->opt_flag & READ_CHECK_USED && hp_rectest(info,old))
     DBUG_RETURN(my_errno);				/* Record changed */
+  if (share->blobs)
+  {
+    old_blob_data= hp_blob_data(share, pos);
+    if (hp_alloc_blobs(share, heap_new, old_blob_data, &blob_data))
+      DBUG_RETURN(my_errno);
+  }
   if (--(share->records) < share->blength >> 1) share->blength>>= 1;
   share->changed=1;
 
@@ -48,6 +54,12 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
   }
 
   memcpy(pos,heap_new,(size_t) share->reclength);
+  if (share->blobs)
+  {
+    hp_copy_blobs(share, pos, blob_data);
+    if (old_blob_data != blob_data)
+      hp_free_blob_data(share, old_blob_data);
+  }
   if (++(share->records) == share->blength) share->blength+= share->blength;
 
 #if !defined(DBUG_OFF) && defined(EXTRA_HEAP_DEBUG)
@@ -83,6 +95,8 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
       keydef--;
     }
   }
+  if (blob_data != old_blob_data)
+    hp_free_blob_data(share, blob_data);
   if (++(share->records) == share->blength)
     share->blength+= share->blength;
   DBUG_RETURN(my_errno);
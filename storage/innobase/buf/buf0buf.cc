@@ -61,6 +61,10 @@ Created 11/5/1995 Heikki Tuuri
 #endif // HAVE_LIBNUMA
 
 #include <new>
+#if defined(LINUX_NATIVE_AIO) && defined(HAVE_LIBURING)
+#include <sys/uio.h>
+#include <vector>
+#endif /* LINUX_NATIVE_AIO && HAVE_LIBURING */
 
 /*
 		IMPLEMENTATION OF THE BUFFER POOL
@@ -1642,6 +1646,35 @@ buf_pool_free_instance(
 	hash_table_free(buf_pool->zip_hash);
 }
 
+/********************************************************************//**
+Registers the memory of all buffer pool chunks as fixed buffers for
+io_uring based asynchronous i/o. */
+static
+void
+buf_pool_register_aio_buffers(void)
+/*===============================*/
+{
+#if defined(LINUX_NATIVE_AIO) && defined(HAVE_LIBURING)
+	std::vector<struct iovec>	regions;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
+		buf_pool_t*	buf_pool = buf_pool_from_array(i);
+		buf_chunk_t*	chunk = buf_pool->chunks;
+
+		for (ulint j = 0; j < buf_pool->n_chunks; ++j, ++chunk) {
+			struct iovec	region;
+
+			region.iov_base = chunk->mem;
+			region.iov_len = chunk->mem_size;
+			regions.push_back(region);
+		}
+	}
+
+	os_aio_uring_register_buffers(
+		regions.empty() ? NULL : &regions[0], regions.size());
+#endif /* LINUX_NATIVE_AIO && HAVE_LIBURING */
+}
+
 /********************************************************************//**
 Creates the buffer pool.
 @return	DB_SUCCESS if success, DB_ERROR if not enough memory or error */
@@ -1717,6 +1750,8 @@ buf_pool_init(
 
 	buf_lru_event = os_event_create();
 
+	buf_pool_register_aio_buffers();
+
 	return(DB_SUCCESS);
 }
 
@@ -2464,12 +2499,14 @@ buf_pool_resize()
 
 	buf_resize_status("Disabling adaptive hash index.");
 
-	rw_lock_s_lock(&btr_search_latch);
+	/* btr_search_enabled is modified only while holding all of
+	btr_search_latches; any one of them protects a read of it. */
+	rw_lock_s_lock(btr_search_latches[0]);
 	if (btr_search_enabled) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(btr_search_latches[0]);
 		btr_search_disabled = true;
 	} else {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(btr_search_latches[0]);
 	}
 
 	btr_search_disable();
@@ -2822,6 +2859,14 @@ wait_lock_empty:
 		goto abort_resize;
 	}
 
+#if defined(LINUX_NATIVE_AIO) && defined(HAVE_LIBURING)
+	/* The chunks are about to change: drop the io_uring fixed
+	buffers, they are registered again once the resize is done.
+	This waits for the fixed buffer requests in flight, and the
+	i/o issued during the resize does not use fixed buffers. */
+	os_aio_uring_register_buffers(NULL, 0);
+#endif /* LINUX_NATIVE_AIO && HAVE_LIBURING */
+
 	/* Acquire all buf_pool_mutex/hash_lock */
 	for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
 		buf_pool_t*	buf_pool = buf_pool_from_array(i);
@@ -3042,6 +3087,8 @@ wait_lock_empty:
 	/* normalize ibuf->max_size */
 	ibuf_max_size_update(srv_change_buffer_max_size);
 
+	buf_pool_register_aio_buffers();
+
 skip_resize:
 	/* wake all other threads up */
 	buf_pool_resizing_bg = false;
@@ -3164,7 +3211,7 @@ buf_pool_clear_hash_index(void)
 	ulint	p;
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(btr_search_own_all(RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 	ut_ad(!buf_pool_forbidden);
 	ut_ad(!btr_search_enabled);
@@ -3182,8 +3229,8 @@ buf_pool_clear_hash_index(void)
 				dict_index_t*	index	= block->index;
 
 				/* We can set block->index = NULL
-				when we have an x-latch on btr_search_latch;
-				see the comment in buf0buf.h */
+				when we have an x-latch on the partition
+				latch; see the comment in buf0buf.h */
 
 				if (!index) {
 					/* Not hashed */
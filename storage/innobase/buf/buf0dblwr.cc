@@ -41,6 +41,7 @@ Created 2011/12/19
 #ifdef UNIV_PFS_MUTEX
 /* Key to register the mutex with performance schema */
 UNIV_INTERN mysql_pfs_key_t	buf_dblwr_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	buf_dblwr_batch_mutex_key;
 #endif /* UNIV_PFS_RWLOCK */
 
 /** The doublewrite buffer */
@@ -49,6 +50,36 @@ UNIV_INTERN buf_dblwr_t*	buf_dblwr = NULL;
 /** Set to TRUE when the doublewrite buffer is being created */
 UNIV_INTERN ibool	buf_dblwr_being_created = FALSE;
 
+/* The parallel doublewrite file starts with a file header page, followed
+by a region of 1 + srv_doublewrite_batch_size pages for each batch: the
+batch header page and the copies of the pages of the batch. */
+
+/** @name Offsets in the file header page of the parallel doublewrite file */
+/* @{ */
+#define BUF_DBLWR_FILE_MAGIC		0	/*!< BUF_DBLWR_FILE_MAGIC_N */
+#define BUF_DBLWR_FILE_PAGE_SIZE	4	/*!< UNIV_PAGE_SIZE */
+#define BUF_DBLWR_FILE_N_BATCHES	8	/*!< number of batch regions */
+#define BUF_DBLWR_FILE_BATCH_SIZE	12	/*!< number of page copies
+						in a region */
+/* @} */
+
+/** Contents of BUF_DBLWR_FILE_MAGIC */
+#define BUF_DBLWR_FILE_MAGIC_N		0x64626C77
+
+/** @name Offsets in a batch header page. The header page has the page type
+and checksum of the reduced-doublewrite header. */
+/* @{ */
+#define BUF_DBLWR_BATCH_N_PAGES		FIL_PAGE_DATA
+					/*!< number of pages of the batch */
+#define BUF_DBLWR_BATCH_FULL		(FIL_PAGE_DATA + 2)
+					/*!< 1 if the page copies follow the
+					header, 0 if the batch was written in
+					reduced-doublewrite mode */
+#define BUF_DBLWR_BATCH_PAGES		(FIL_PAGE_DATA + 3)
+					/*!< space id and page number of
+					each page of the batch */
+/* @} */
+
 /****************************************************************//**
 Determines if a page number is located inside the doublewrite buffer.
 @return TRUE if the location is inside the two blocks of the
@@ -119,6 +150,418 @@ buf_dblwr_sync_datafiles()
 	fil_flush_file_spaces(FIL_TABLESPACE, FLUSH_FROM_DOUBLEWRITE);
 }
 
+/****************************************************************//**
+Gets the path of the parallel doublewrite file. */
+static
+void
+buf_dblwr_parallel_file_name(
+/*=========================*/
+	char*	name)	/*!< out: path, OS_FILE_MAX_PATH bytes */
+{
+	ulint	dirnamelen = strlen(srv_data_home);
+
+	ut_a(dirnamelen + sizeof BUF_DBLWR_PARALLEL_FILE_NAME
+	     < OS_FILE_MAX_PATH - 1);
+
+	memcpy(name, srv_data_home, dirnamelen);
+
+	/* Add a path separator if needed. */
+	if (dirnamelen && name[dirnamelen - 1] != SRV_PATH_SEPARATOR) {
+		name[dirnamelen++] = SRV_PATH_SEPARATOR;
+	}
+
+	strcpy(name + dirnamelen, BUF_DBLWR_PARALLEL_FILE_NAME);
+}
+
+/****************************************************************//**
+Gets the parallel doublewrite batch of a buffer pool instance.
+@return the batch */
+UNIV_INLINE
+buf_dblwr_batch_t*
+buf_dblwr_get_batch(
+/*================*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	buf_flush_t		flush_type)	/*!< in: BUF_FLUSH_LRU or
+						BUF_FLUSH_LIST */
+{
+	ut_ad(buf_dblwr->batches != NULL);
+	ut_ad(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
+
+	return(&buf_dblwr->batches[buf_pool_index(buf_pool)
+				   * BUF_DBLWR_BATCHES_PER_INSTANCE
+				   + (flush_type == BUF_FLUSH_LIST)]);
+}
+
+/****************************************************************//**
+Creates the parallel doublewrite file and the batches of the buffer pool
+instances if innodb_parallel_doublewrite is set, or removes a file left by
+an earlier run if it is not. Must be called after buf_dblwr_process() has
+restored the pages read from that file by buf_dblwr_parallel_load(), and
+before any thread other than the caller flushes pages. If the file cannot
+be created the doublewrite buffer in the system tablespace is used for all
+flushes. */
+UNIV_INTERN
+void
+buf_dblwr_parallel_init(void)
+/*=========================*/
+{
+	char		name[OS_FILE_MAX_PATH];
+	ibool		success;
+	os_file_t	file;
+	byte*		unaligned_page;
+	byte*		page;
+	const ulint	n_batches = srv_buf_pool_instances
+		* BUF_DBLWR_BATCHES_PER_INSTANCE;
+	const ulint	region_size = (1 + srv_doublewrite_batch_size)
+		* UNIV_PAGE_SIZE;
+
+	ut_ad(buf_dblwr != NULL);
+	ut_ad(buf_dblwr->batches == NULL);
+
+	if (srv_read_only_mode) {
+		return;
+	}
+
+	buf_dblwr_parallel_file_name(name);
+
+	/* The pages of a file left by a crash have been restored and
+	synced to the data files by buf_dblwr_process(), so its copies
+	are no longer needed. */
+	os_file_delete_if_exists(innodb_file_data_key, name);
+
+	if (!srv_parallel_doublewrite || !srv_use_doublewrite_buf) {
+		return;
+	}
+
+	file = os_file_create(innodb_file_data_key, name, OS_FILE_CREATE,
+			      OS_FILE_NORMAL, OS_DATA_FILE, &success);
+
+	if (!success) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"Cannot create the parallel doublewrite file %s. "
+			"Using the doublewrite buffer in the system "
+			"tablespace instead.", name);
+		return;
+	}
+
+	unaligned_page = static_cast<byte*>(ut_malloc(2 * UNIV_PAGE_SIZE));
+	page = static_cast<byte*>(ut_align(unaligned_page, UNIV_PAGE_SIZE));
+
+	memset(page, 0, UNIV_PAGE_SIZE);
+	mach_write_to_4(page + BUF_DBLWR_FILE_MAGIC, BUF_DBLWR_FILE_MAGIC_N);
+	mach_write_to_4(page + BUF_DBLWR_FILE_PAGE_SIZE, UNIV_PAGE_SIZE);
+	mach_write_to_4(page + BUF_DBLWR_FILE_N_BATCHES, n_batches);
+	mach_write_to_4(page + BUF_DBLWR_FILE_BATCH_SIZE,
+			srv_doublewrite_batch_size);
+
+	success = os_file_set_size(name, file,
+				   UNIV_PAGE_SIZE + n_batches * region_size)
+		&& os_file_write(name, file, page, 0, UNIV_PAGE_SIZE)
+		&& os_file_flush(file);
+
+	ut_free(unaligned_page);
+
+	if (!success) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"Cannot initialize the parallel doublewrite file %s. "
+			"Using the doublewrite buffer in the system "
+			"tablespace instead.", name);
+		os_file_close(file);
+		os_file_delete_if_exists(innodb_file_data_key, name);
+		return;
+	}
+
+	buf_dblwr->parallel_file = file;
+
+	buf_dblwr->batches = static_cast<buf_dblwr_batch_t*>(
+		mem_zalloc(n_batches * sizeof(buf_dblwr_batch_t)));
+
+	for (ulint i = 0; i < n_batches; i++) {
+		buf_dblwr_batch_t*	batch = &buf_dblwr->batches[i];
+
+		mutex_create(buf_dblwr_batch_mutex_key,
+			     &batch->mutex, SYNC_DOUBLEWRITE);
+
+		batch->b_event = os_event_create();
+		batch->offset = UNIV_PAGE_SIZE + i * region_size;
+
+		batch->write_buf_unaligned = static_cast<byte*>(
+			mem_zalloc((2 + srv_doublewrite_batch_size)
+				   * UNIV_PAGE_SIZE));
+
+		batch->write_buf = static_cast<byte*>(
+			ut_align(batch->write_buf_unaligned,
+				 UNIV_PAGE_SIZE));
+
+		batch->buf_block_arr = static_cast<buf_page_t**>(
+			mem_zalloc(srv_doublewrite_batch_size
+				   * sizeof(void*)));
+
+		mach_write_to_4(batch->write_buf + FIL_PAGE_OFFSET, i);
+		mach_write_to_2(batch->write_buf + FIL_PAGE_TYPE,
+				FIL_PAGE_TYPE_DBLWR_HEADER);
+	}
+
+	/* The LRU and flush list batches are no longer written to the
+	doublewrite buffer in the system tablespace. Clear it before the
+	first single page flush, so that stale page copies written by an
+	earlier run cannot be used in a later crash recovery. */
+	srv_doublewrite_reset = TRUE;
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Using the parallel doublewrite file %s with %lu batches "
+		"of %lu pages.", name, (ulong) n_batches,
+		(ulong) srv_doublewrite_batch_size);
+}
+
+/****************************************************************//**
+Checks a batch header page read from the parallel doublewrite file.
+@return number of pages of the batch, 0 if the header is unused or was not
+completely written */
+static
+ulint
+buf_dblwr_parallel_batch_n_pages(
+/*=============================*/
+	const byte*	header,		/*!< in: batch header page */
+	ulint		batch_size)	/*!< in: number of page copies in a
+					region of the file */
+{
+	ulint	n_pages;
+
+	if (fil_page_get_type(header) != FIL_PAGE_TYPE_DBLWR_HEADER) {
+		/* The region has not been used since the file was
+		created. */
+		return(0);
+	}
+
+	if (buf_page_is_corrupted(FALSE, header, BUF_DBLWR_HEADER_SIZE)) {
+		/* The write of the batch to the doublewrite file was
+		interrupted, so none of its pages was being written to
+		the data files yet. */
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Ignoring the partially written batch %lu of the "
+			"parallel doublewrite file.",
+			(ulong) mach_read_from_4(header + FIL_PAGE_OFFSET));
+		return(0);
+	}
+
+	n_pages = mach_read_from_2(header + BUF_DBLWR_BATCH_N_PAGES);
+
+	if (n_pages > batch_size) {
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"Ignoring batch %lu of the parallel doublewrite file "
+			"with %lu pages: a batch holds at most %lu pages.",
+			(ulong) mach_read_from_4(header + FIL_PAGE_OFFSET),
+			(ulong) n_pages, (ulong) batch_size);
+		return(0);
+	}
+
+	return(n_pages);
+}
+
+/****************************************************************//**
+Reads the parallel doublewrite file, if one was left by a crash, and adds
+the pages of its batches to recv_sys->dblwr. The page copies are kept in
+recv_sys->dblwr.parallel_buf. */
+static
+void
+buf_dblwr_parallel_load(void)
+/*=========================*/
+{
+	char		name[OS_FILE_MAX_PATH];
+	ibool		success;
+	os_file_t	file;
+	byte*		unaligned_read_buf;
+	byte*		read_buf;
+	byte*		page = NULL;
+	ulint		n_batches;
+	ulint		batch_size;
+	ulint		region_size;
+	ulint		n_pages = 0;
+	recv_dblwr_t&	recv_dblwr = recv_sys->dblwr;
+
+	buf_dblwr_parallel_file_name(name);
+
+	/* The file is removed at a clean shutdown. */
+	file = os_file_create_simple_no_error_handling(
+		innodb_file_data_key, name, OS_FILE_OPEN,
+		OS_FILE_READ_ONLY, &success);
+
+	if (!success) {
+		return;
+	}
+
+	unaligned_read_buf = static_cast<byte*>(ut_malloc(2 * UNIV_PAGE_SIZE));
+
+	read_buf = static_cast<byte*>(
+		ut_align(unaligned_read_buf, UNIV_PAGE_SIZE));
+
+	if (!os_file_read_no_error_handling(file, read_buf, 0,
+					    UNIV_PAGE_SIZE)) {
+
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"Ignoring the parallel doublewrite file %s: cannot "
+			"read its header page.", name);
+		goto func_exit;
+	}
+
+	if (mach_read_from_4(read_buf + BUF_DBLWR_FILE_MAGIC)
+	    != BUF_DBLWR_FILE_MAGIC_N
+	    || mach_read_from_4(read_buf + BUF_DBLWR_FILE_PAGE_SIZE)
+	    != UNIV_PAGE_SIZE) {
+
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"Ignoring the parallel doublewrite file %s: it was "
+			"not created with innodb_page_size=%lu.",
+			name, (ulong) UNIV_PAGE_SIZE);
+		goto func_exit;
+	}
+
+	n_batches = mach_read_from_4(read_buf + BUF_DBLWR_FILE_N_BATCHES);
+	batch_size = mach_read_from_4(read_buf + BUF_DBLWR_FILE_BATCH_SIZE);
+
+	/* A batch header page must be able to list the pages of a full
+	batch. */
+	if (n_batches == 0
+	    || n_batches > MAX_BUFFER_POOLS * BUF_DBLWR_BATCHES_PER_INSTANCE
+	    || batch_size == 0
+	    || BUF_DBLWR_BATCH_PAGES + batch_size * 8
+	    > BUF_DBLWR_HEADER_SIZE - FIL_PAGE_DATA_END) {
+
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"Ignoring the parallel doublewrite file %s: its "
+			"header page is corrupt (%lu batches of %lu pages).",
+			name, (ulong) n_batches, (ulong) batch_size);
+		goto func_exit;
+	}
+
+	region_size = (1 + batch_size) * UNIV_PAGE_SIZE;
+
+	if (os_file_get_size(file)
+	    < (os_offset_t) (UNIV_PAGE_SIZE + n_batches * region_size)) {
+
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"Ignoring the parallel doublewrite file %s: it is "
+			"shorter than its %lu batches of %lu pages.",
+			name, (ulong) n_batches, (ulong) batch_size);
+		goto func_exit;
+	}
+
+	ut_free(unaligned_read_buf);
+
+	/* Read the batch headers first, to read the page copies of all
+	batches into one buffer. */
+	unaligned_read_buf = static_cast<byte*>(
+		ut_malloc((1 + n_batches) * UNIV_PAGE_SIZE));
+
+	read_buf = static_cast<byte*>(
+		ut_align(unaligned_read_buf, UNIV_PAGE_SIZE));
+
+	for (ulint i = 0; i < n_batches; i++) {
+		byte*	header = read_buf + i * UNIV_PAGE_SIZE;
+
+		if (!os_file_read_no_error_handling(
+			    file, header, UNIV_PAGE_SIZE + i * region_size,
+			    UNIV_PAGE_SIZE)) {
+
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"Ignoring batch %lu of the parallel "
+				"doublewrite file %s: cannot read its "
+				"header.", (ulong) i, name);
+			memset(header, 0, UNIV_PAGE_SIZE);
+		} else if (!buf_dblwr_parallel_batch_n_pages(
+				   header, batch_size)) {
+			/* Do not look at this header again. */
+			memset(header, 0, UNIV_PAGE_SIZE);
+		} else if (mach_read_from_1(header + BUF_DBLWR_BATCH_FULL)) {
+			n_pages += mach_read_from_2(
+				header + BUF_DBLWR_BATCH_N_PAGES);
+		}
+	}
+
+	if (n_pages > 0) {
+		recv_dblwr.parallel_buf = static_cast<byte*>(
+			ut_malloc((1 + n_pages) * UNIV_PAGE_SIZE));
+
+		page = static_cast<byte*>(
+			ut_align(recv_dblwr.parallel_buf, UNIV_PAGE_SIZE));
+	}
+
+	for (ulint i = 0; i < n_batches; i++) {
+		const byte*	header = read_buf + i * UNIV_PAGE_SIZE;
+		const byte*	ptr = header + BUF_DBLWR_BATCH_PAGES;
+		bool		full = mach_read_from_1(
+			header + BUF_DBLWR_BATCH_FULL);
+		ulint		n = mach_read_from_2(
+			header + BUF_DBLWR_BATCH_N_PAGES);
+
+		if (n > 0 && full
+		    && !os_file_read_no_error_handling(
+			    file, page,
+			    UNIV_PAGE_SIZE + i * region_size
+			    + UNIV_PAGE_SIZE,
+			    n * UNIV_PAGE_SIZE)) {
+
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"Ignoring batch %lu of the parallel "
+				"doublewrite file %s: cannot read its "
+				"pages.", (ulong) i, name);
+			continue;
+		}
+
+		for (ulint j = 0; j < n; j++) {
+			ulint	space_id = mach_read_from_4(ptr);
+			ulint	page_no = mach_read_from_4(ptr + 4);
+
+			ptr += 8;
+
+			if (full) {
+				recv_dblwr.add(page, space_id, page_no);
+				page += UNIV_PAGE_SIZE;
+			} else {
+				recv_dblwr.add(NULL, space_id, page_no);
+			}
+		}
+	}
+
+func_exit:
+	ut_free(unaligned_read_buf);
+	os_file_close(file);
+}
+
+/****************************************************************//**
+Frees the parallel doublewrite batches and removes the parallel
+doublewrite file, which is not needed once all batches have been written
+to the data files. */
+static
+void
+buf_dblwr_parallel_free(void)
+/*=========================*/
+{
+	char		name[OS_FILE_MAX_PATH];
+	const ulint	n_batches = srv_buf_pool_instances
+		* BUF_DBLWR_BATCHES_PER_INSTANCE;
+
+	for (ulint i = 0; i < n_batches; i++) {
+		buf_dblwr_batch_t*	batch = &buf_dblwr->batches[i];
+
+		ut_ad(batch->b_reserved == 0);
+
+		os_event_free(batch->b_event);
+		mem_free(batch->write_buf_unaligned);
+		mem_free(batch->buf_block_arr);
+		mutex_free(&batch->mutex);
+	}
+
+	mem_free(buf_dblwr->batches);
+	buf_dblwr->batches = NULL;
+
+	os_file_close(buf_dblwr->parallel_file);
+
+	buf_dblwr_parallel_file_name(name);
+	os_file_delete_if_exists(innodb_file_data_key, name);
+}
+
 /****************************************************************//**
 Creates or initialializes the doublewrite buffer at a database start. */
 static
@@ -467,6 +910,13 @@ buf_dblwr_init_or_load_pages(
 	    == TRX_SYS_DOUBLEWRITE_MAGIC_N) {
 		/* The doublewrite buffer has been created */
 
+		if (load_corrupt_pages) {
+			/* Read the batches of the parallel doublewrite
+			file. It is replaced by buf_dblwr_parallel_init()
+			once buf_dblwr_process() has restored them. */
+			buf_dblwr_parallel_load();
+		}
+
 		buf_dblwr_init(doublewrite);
 
 		block1 = buf_dblwr->block1;
@@ -634,6 +1084,19 @@ buf_dblwr_process()
 				page_no_dblwr);
 		} else {
 			ulint	zip_size = fil_space_get_zip_size(i->space_id);
+			byte*	page = i->page;
+
+			/* The page may have been written by more than one
+			batch of the parallel doublewrite file: restore the
+			newest copy. */
+			if (page != NULL) {
+				byte*	newest = recv_sys->dblwr.find_page(
+					i->space_id, i->page_no);
+
+				if (newest != NULL) {
+					page = newest;
+				}
+			}
 
 			/* Read in the actual page from the file */
 			fil_io(OS_FILE_READ, true, i->space_id, zip_size,
@@ -644,7 +1107,7 @@ buf_dblwr_process()
 			/* Check if the page is corrupt */
 
 			if (buf_page_is_corrupted(true, read_buf, zip_size)) {
-				if (!i->page) {
+				if (!page) {
 					fprintf(stderr,
 						"InnoDB: Database page"
 						" corruption or a failed "
@@ -674,7 +1137,7 @@ buf_dblwr_process()
 					(ulong) i->page_no);
 
 				if (buf_page_is_corrupted(true,
-							  i->page, zip_size)) {
+							  page, zip_size)) {
 					fprintf(stderr,
 						"InnoDB: Dump of the page:\n");
 					buf_page_print(
@@ -685,7 +1148,7 @@ buf_dblwr_process()
 						" corresponding page"
 						" in doublewrite buffer:\n");
 					buf_page_print(
-						i->page, zip_size,
+						page, zip_size,
 						BUF_PAGE_PRINT_NO_CRASH);
 
 					fprintf(stderr,
@@ -709,16 +1172,16 @@ buf_dblwr_process()
 				fil_io(OS_FILE_WRITE, true, i->space_id,
 				       zip_size, i->page_no, 0,
 				       zip_size ? zip_size : UNIV_PAGE_SIZE,
-				       i->page, NULL);
+				       page, NULL);
 
 				ib_logf(IB_LOG_LEVEL_INFO,
 					"Recovered the page from"
 					" the doublewrite buffer.");
-			} else if (i->page &&
+			} else if (page &&
 				   buf_page_is_zeroes(read_buf, zip_size)) {
 
-				if (!buf_page_is_zeroes(i->page, zip_size)
-				    && !buf_page_is_corrupted(true, i->page,
+				if (!buf_page_is_zeroes(page, zip_size)
+				    && !buf_page_is_corrupted(true, page,
 							      zip_size)) {
 
 					/* Database page contained only
@@ -729,7 +1192,7 @@ buf_dblwr_process()
 					       zip_size, i->page_no, 0,
 					       zip_size ? zip_size
 							: UNIV_PAGE_SIZE,
-					       i->page, NULL);
+					       page, NULL);
 				}
 			}
 		}
@@ -766,11 +1229,78 @@ buf_dblwr_free(void)
 	mem_free(buf_dblwr->in_use);
 	buf_dblwr->in_use = NULL;
 
+	if (buf_dblwr->batches != NULL) {
+		buf_dblwr_parallel_free();
+	}
+
 	mutex_free(&buf_dblwr->mutex);
 	mem_free(buf_dblwr);
 	buf_dblwr = NULL;
 }
 
+/********************************************************************//**
+Marks the region of a parallel doublewrite batch unused in the file once
+its pages have been synced to the data files, so that a recovery does not
+restore these older copies of the pages. The write is not synced: if a
+crash loses it, buf_dblwr_process() still prefers any newer copy of a
+page in another batch or in the doublewrite buffer. */
+static
+void
+buf_dblwr_parallel_invalidate(
+/*==========================*/
+	buf_dblwr_batch_t*	batch)	/*!< in/out: batch whose pages
+					have been written */
+{
+	ut_ad(batch->batch_running);
+
+	mach_write_to_2(batch->write_buf + FIL_PAGE_TYPE,
+			FIL_PAGE_TYPE_ALLOCATED);
+
+	if (!os_file_write(BUF_DBLWR_PARALLEL_FILE_NAME,
+			   buf_dblwr->parallel_file, batch->write_buf,
+			   batch->offset, BUF_DBLWR_HEADER_SIZE)) {
+		ib_logf(IB_LOG_LEVEL_FATAL,
+			"Cannot write to the parallel doublewrite file.");
+	}
+
+	mach_write_to_2(batch->write_buf + FIL_PAGE_TYPE,
+			FIL_PAGE_TYPE_DBLWR_HEADER);
+}
+
+/********************************************************************//**
+Updates a parallel doublewrite batch when the write of one of its pages
+to the data file is completed. */
+static
+void
+buf_dblwr_parallel_update(
+/*======================*/
+	buf_dblwr_batch_t*	batch)	/*!< in/out: batch of the page */
+{
+	mutex_enter(&batch->mutex);
+
+	ut_ad(batch->batch_running);
+	ut_ad(batch->b_reserved > 0);
+	ut_ad(batch->b_reserved <= batch->first_free);
+
+	batch->b_reserved--;
+
+	if (batch->b_reserved == 0) {
+		mutex_exit(&batch->mutex);
+		/* This will finish the batch. Sync data files
+		to the disk. */
+		fil_flush_file_spaces(FIL_TABLESPACE, FLUSH_FROM_DOUBLEWRITE);
+		buf_dblwr_parallel_invalidate(batch);
+		mutex_enter(&batch->mutex);
+
+		/* We can now reuse the region of the batch: */
+		batch->first_free = 0;
+		batch->batch_running = false;
+		os_event_set(batch->b_event);
+	}
+
+	mutex_exit(&batch->mutex);
+}
+
 /********************************************************************//**
 Updates the doublewrite buffer when an IO request is completed. */
 UNIV_INTERN
@@ -787,6 +1317,14 @@ buf_dblwr_update(
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
+		if (buf_dblwr->batches != NULL) {
+			buf_dblwr_parallel_update(
+				buf_dblwr_get_batch(
+					buf_pool_from_bpage(bpage),
+					flush_type));
+			break;
+		}
+
 		mutex_enter(&buf_dblwr->mutex);
 
 		ut_ad(buf_dblwr->batch_running);
@@ -962,16 +1500,276 @@ buf_dblwr_write_block_to_datafile(
 
 }
 
+/********************************************************************//**
+Copies a page to be written to a doublewrite buffer slot. A compressed page
+is padded with zeroes. */
+static
+void
+buf_dblwr_copy_page(
+/*================*/
+	byte*			slot,	/*!< out: UNIV_PAGE_SIZE bytes */
+	const buf_page_t*	bpage)	/*!< in: page to write */
+{
+	ulint	zip_size = buf_page_get_zip_size(bpage);
+
+	if (zip_size) {
+		UNIV_MEM_ASSERT_RW(bpage->zip.data, zip_size);
+		/* Copy the compressed page and clear the rest. */
+		memcpy(slot, bpage->zip.data, zip_size);
+		memset(slot + zip_size, 0, UNIV_PAGE_SIZE - zip_size);
+	} else {
+		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
+		UNIV_MEM_ASSERT_RW(((buf_block_t*) bpage)->frame,
+				   UNIV_PAGE_SIZE);
+
+		memcpy(slot, ((buf_block_t*) bpage)->frame, UNIV_PAGE_SIZE);
+	}
+}
+
+#ifdef UNIV_DEBUG
+/********************************************************************//**
+Writes a copy of a batch that was just written to the parallel doublewrite
+file also to the region of the other flush type of the same buffer pool
+instance, unless that region is in use. Recovery then finds older copies of
+the pages in that region, as if its header had not been invalidated before
+a crash. */
+static
+void
+buf_dblwr_parallel_copy_batch(
+/*==========================*/
+	const buf_dblwr_batch_t*	batch,	/*!< in: batch written */
+	ulint				len)	/*!< in: number of bytes
+						written */
+{
+	ulint			i = batch - buf_dblwr->batches;
+	buf_dblwr_batch_t*	other = &buf_dblwr->batches[
+		i - i % BUF_DBLWR_BATCHES_PER_INSTANCE
+		+ (i + 1) % BUF_DBLWR_BATCHES_PER_INSTANCE];
+
+	mutex_enter(&other->mutex);
+
+	if (!other->batch_running
+	    && (!os_file_write(BUF_DBLWR_PARALLEL_FILE_NAME,
+			       buf_dblwr->parallel_file, batch->write_buf,
+			       other->offset, len)
+		|| !os_file_flush(buf_dblwr->parallel_file))) {
+		ib_logf(IB_LOG_LEVEL_FATAL,
+			"Cannot write to the parallel doublewrite file.");
+	}
+
+	mutex_exit(&other->mutex);
+}
+#endif /* UNIV_DEBUG */
+
+/********************************************************************//**
+Writes a parallel doublewrite batch to its region of the parallel
+doublewrite file, syncs the file and posts the writes of the pages to the
+data files. The batch is released by buf_dblwr_parallel_update() when all
+of these writes have completed. */
+static
+void
+buf_dblwr_parallel_flush(
+/*=====================*/
+	buf_dblwr_batch_t*	batch)	/*!< in/out: batch to write */
+{
+	ulint		first_free;
+	ulint		len;
+	byte*		header_ptr;
+	ibool		success;
+	ulong		use_doublewrite_buf = srv_use_doublewrite_buf;
+
+try_again:
+	mutex_enter(&batch->mutex);
+
+	if (batch->first_free == 0) {
+
+		mutex_exit(&batch->mutex);
+
+		return;
+	}
+
+	if (batch->batch_running) {
+		/* The batch is being written right now. Wait for it
+		to finish. */
+		ib_int64_t	sig_count = os_event_reset(batch->b_event);
+		mutex_exit(&batch->mutex);
+
+		srv_stats.dblwr_batch_waits.inc();
+		os_event_wait_low(batch->b_event, sig_count);
+		goto try_again;
+	}
+
+	ut_ad(batch->first_free == batch->b_reserved);
+
+	/* Disallow anyone else to post to the batch until its pages
+	have been written to the data files. */
+	batch->batch_running = true;
+	first_free = batch->first_free;
+
+	mutex_exit(&batch->mutex);
+
+	header_ptr = batch->write_buf + FIL_PAGE_DATA;
+	memset(header_ptr, 0, BUF_DBLWR_HEADER_SIZE - FIL_PAGE_DATA);
+	mach_write_to_2(batch->write_buf + BUF_DBLWR_BATCH_N_PAGES,
+			first_free);
+	mach_write_to_1(batch->write_buf + BUF_DBLWR_BATCH_FULL,
+			use_doublewrite_buf == 1);
+	header_ptr = batch->write_buf + BUF_DBLWR_BATCH_PAGES;
+
+	for (ulint i = 0; i < first_free; i++) {
+
+		const buf_block_t*	block;
+
+		block = (buf_block_t*) batch->buf_block_arr[i];
+		mach_write_to_4(header_ptr, buf_page_get_space(&block->page));
+		header_ptr += 4;
+		mach_write_to_4(header_ptr, buf_page_get_page_no(&block->page));
+		header_ptr += 4;
+
+		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
+		    || block->page.zip.data) {
+			/* No simple validate for compressed
+			pages exists. */
+			continue;
+		}
+
+		/* Check that the actual page in the buffer pool is
+		not corrupt and the LSN values are sane. */
+		buf_dblwr_check_block(block);
+
+		/* Check that the page as written to the doublewrite
+		buffer has sane LSN values. */
+		buf_dblwr_check_page_lsn(
+			batch->write_buf + (1 + i) * UNIV_PAGE_SIZE);
+	}
+
+	mach_write_to_4(batch->write_buf + FIL_PAGE_SPACE_OR_CHKSUM,
+			page_zip_calc_checksum(
+				batch->write_buf, BUF_DBLWR_HEADER_SIZE,
+				static_cast<srv_checksum_algorithm_t>(
+					srv_checksum_algorithm)));
+
+	/* In reduced-doublewrite mode only the header is written, in
+	full mode the page copies follow it. */
+	len = use_doublewrite_buf == 1
+		? (1 + first_free) * UNIV_PAGE_SIZE
+		: BUF_DBLWR_HEADER_SIZE;
+
+	success = os_file_write(BUF_DBLWR_PARALLEL_FILE_NAME,
+				buf_dblwr->parallel_file, batch->write_buf,
+				batch->offset, len);
+
+	success = success && os_file_flush(buf_dblwr->parallel_file);
+
+	if (!success) {
+		ib_logf(IB_LOG_LEVEL_FATAL,
+			"Cannot write to the parallel doublewrite file.");
+	}
+
+#ifdef UNIV_DEBUG
+	DBUG_EXECUTE_IF("dblwr_parallel_copy_batch",
+			buf_dblwr_parallel_copy_batch(batch, len););
+#endif /* UNIV_DEBUG */
+
+	DBUG_EXECUTE_IF("dblwr_parallel_crash_after_write",
+			DBUG_SUICIDE(););
+
+	/* increment the doublewrite flushed pages counter */
+	if (use_doublewrite_buf == 1) {
+		srv_stats.dblwr_pages_written.add(first_free);
+	} else {
+		srv_stats.dblwr_pages_written.inc();
+	}
+	srv_stats.dblwr_writes.inc();
+
+	/* We know that the writes have been flushed to disk now
+	and in recovery we will find them in the parallel doublewrite
+	file. Next do the writes to the intended positions. Only this
+	thread accesses the pages of the batch until they are written,
+	see buf_dblwr_flush_buffered_writes() for why first_free is
+	used in the loop. */
+	for (ulint i = 0; i < first_free; i++) {
+		buf_dblwr_write_block_to_datafile(
+			batch->buf_block_arr[i], false);
+	}
+
+	/* Wake possible simulated aio thread to actually post the
+	writes to the operating system. */
+	os_aio_simulated_wake_handler_threads();
+}
+
+/********************************************************************//**
+Posts a buffer page for writing to a parallel doublewrite batch. If the
+batch is full, writes it and waits for its region to become free. */
+static
+void
+buf_dblwr_parallel_add_to_batch(
+/*============================*/
+	buf_dblwr_batch_t*	batch,	/*!< in/out: batch of the buffer
+					pool instance and flush type */
+	buf_page_t*		bpage)	/*!< in: buffer block to write */
+{
+try_again:
+	mutex_enter(&batch->mutex);
+
+	ut_a(batch->first_free <= srv_doublewrite_batch_size);
+
+	if (batch->batch_running) {
+		/* The previous batch of this buffer pool instance
+		and flush type has not been written yet. */
+		ib_int64_t	sig_count = os_event_reset(batch->b_event);
+		mutex_exit(&batch->mutex);
+
+		srv_stats.dblwr_batch_waits.inc();
+		os_event_wait_low(batch->b_event, sig_count);
+		goto try_again;
+	}
+
+	if (batch->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&batch->mutex);
+
+		buf_dblwr_parallel_flush(batch);
+
+		goto try_again;
+	}
+
+	/* The first page of the region is the batch header. */
+	buf_dblwr_copy_page(
+		batch->write_buf + UNIV_PAGE_SIZE * (1 + batch->first_free),
+		bpage);
+
+	batch->buf_block_arr[batch->first_free] = bpage;
+
+	batch->first_free++;
+	batch->b_reserved++;
+
+	ut_ad(batch->first_free == batch->b_reserved);
+
+	if (batch->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&batch->mutex);
+
+		buf_dblwr_parallel_flush(batch);
+
+		return;
+	}
+
+	mutex_exit(&batch->mutex);
+}
+
 /********************************************************************//**
 Flushes possible buffered writes from the doublewrite memory buffer to disk,
 and also wakes up the aio thread if simulated aio is used. It is very
 important to call this function after a batch of writes has been posted,
 and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+of threads can occur. With the parallel doublewrite file only the batch of
+the given buffer pool instance and flush type is written. */
 UNIV_INTERN
 void
-buf_dblwr_flush_buffered_writes(void)
-/*=================================*/
+buf_dblwr_flush_buffered_writes(
+/*============================*/
+	buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	buf_flush_t	flush_type)	/*!< in: BUF_FLUSH_LRU or
+					BUF_FLUSH_LIST */
 {
 	byte*		write_buf;
 	ulint		first_free;
@@ -985,6 +1783,12 @@ buf_dblwr_flush_buffered_writes(void)
 		return;
 	}
 
+	if (buf_dblwr->batches != NULL) {
+		buf_dblwr_parallel_flush(
+			buf_dblwr_get_batch(buf_pool, flush_type));
+		return;
+	}
+
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
@@ -1005,6 +1809,7 @@ try_again:
 		ib_int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
 		mutex_exit(&buf_dblwr->mutex);
 
+		srv_stats.dblwr_batch_waits.inc();
 		os_event_wait_low(buf_dblwr->b_event, sig_count);
 		goto try_again;
 	}
@@ -1172,10 +1977,17 @@ buf_dblwr_add_to_batch(
 /*====================*/
 	buf_page_t*	bpage)	/*!< in: buffer block to write */
 {
-	ulint	zip_size;
+	buf_pool_t*	buf_pool = buf_pool_from_bpage(bpage);
+	buf_flush_t	flush_type = buf_page_get_flush_type(bpage);
 
 	ut_a(buf_page_in_file(bpage));
 
+	if (buf_dblwr->batches != NULL) {
+		buf_dblwr_parallel_add_to_batch(
+			buf_dblwr_get_batch(buf_pool, flush_type), bpage);
+		return;
+	}
+
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
@@ -1192,6 +2004,7 @@ try_again:
 		ib_int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
 		mutex_exit(&buf_dblwr->mutex);
 
+		srv_stats.dblwr_batch_waits.inc();
 		os_event_wait_low(buf_dblwr->b_event, sig_count);
 		goto try_again;
 	}
@@ -1199,31 +2012,14 @@ try_again:
 	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
 		mutex_exit(&(buf_dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool, flush_type);
 
 		goto try_again;
 	}
 
-	zip_size = buf_page_get_zip_size(bpage);
-
-	if (zip_size) {
-		UNIV_MEM_ASSERT_RW(bpage->zip.data, zip_size);
-		/* Copy the compressed page and clear the rest. */
-		memcpy(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free,
-		       bpage->zip.data, zip_size);
-		memset(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free
-		       + zip_size, 0, UNIV_PAGE_SIZE - zip_size);
-	} else {
-		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
-		UNIV_MEM_ASSERT_RW(((buf_block_t*) bpage)->frame,
-				   UNIV_PAGE_SIZE);
-
-		memcpy(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free,
-		       ((buf_block_t*) bpage)->frame, UNIV_PAGE_SIZE);
-	}
+	buf_dblwr_copy_page(
+		buf_dblwr->write_buf + UNIV_PAGE_SIZE * buf_dblwr->first_free,
+		bpage);
 
 	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
 
@@ -1237,7 +2033,7 @@ try_again:
 	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
 		mutex_exit(&(buf_dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool, flush_type);
 
 		return;
 	}
@@ -1299,11 +2095,22 @@ retry:
 		ib_int64_t	sig_count =
 			os_event_reset(buf_dblwr->s_event);
 		mutex_exit(&buf_dblwr->mutex);
+		srv_stats.dblwr_single_page_waits.inc();
 		os_event_wait_low(buf_dblwr->s_event, sig_count);
 
 		goto retry;
 	}
 
+	if (srv_doublewrite_reset && buf_dblwr->batches != NULL
+	    && buf_dblwr->s_reserved == 0) {
+		/* The batches are written to the parallel doublewrite
+		file, and no single page write is in progress: nothing
+		else writes to the doublewrite buffer now. See
+		buf_dblwr_flush_buffered_writes() for why it is reset. */
+		buf_dblwr_reset(srv_use_doublewrite_buf);
+		srv_doublewrite_reset = FALSE;
+	}
+
 	for (i = srv_doublewrite_batch_size; i < size; ++i) {
 
 		if (!buf_dblwr->in_use[i]) {
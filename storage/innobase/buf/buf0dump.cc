@@ -41,6 +41,8 @@ Created April 08, 2011 Vasil Dimov
 #include "ut0byte.h" /* ut_ull_create() */
 #include "ut0sort.h" /* UT_SORT_FUNCTION_BODY */
 
+#include "zlib.h" /* compress2(), uncompress() */
+
 enum status_severity {
 	STATUS_INFO,
 	STATUS_NOTICE,
@@ -68,6 +70,35 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/* Quit a dump on shutdown unless it is the dump at shutdown */
+#define SHOULD_QUIT()	(SHUTTING_DOWN() && obey_shutdown)
+
+/* The compressed dump format (innodb_buffer_pool_dump_compressed) starts
+with a header of BUF_DUMP_HEADER_SIZE bytes, followed by chunks of at most
+BUF_DUMP_CHUNK_ENTRIES entries. Every chunk is a 4-byte length of the
+compressed data, the 4-byte number of entries and the zlib compressed
+entries, each one a big-endian buf_dump_t. As in the text format, the
+hottest pages of all buffer pool instances come first. */
+#define BUF_DUMP_MAGIC		0	/*!< BUF_DUMP_MAGIC_N */
+#define BUF_DUMP_VERSION	4	/*!< BUF_DUMP_VERSION_1 */
+#define BUF_DUMP_N_ENTRIES	8	/*!< number of entries */
+#define BUF_DUMP_HEADER_SIZE	16
+
+/** Contents of BUF_DUMP_MAGIC. A text dump starts with a digit. */
+#define BUF_DUMP_MAGIC_N	0x49425044
+/** Contents of BUF_DUMP_VERSION */
+#define BUF_DUMP_VERSION_1	1
+
+/** Size of a chunk header in the compressed dump format */
+#define BUF_DUMP_CHUNK_HEADER_SIZE	8
+/** Maximum number of entries of a chunk in the compressed dump format */
+#define BUF_DUMP_CHUNK_ENTRIES		65536
+
+/** Number of pages that a load reads in one batch. The pages of a batch are
+read in space_no, page_no order, each run of adjacent pages with one
+buf_read_pages_async() call, while the batches are read hottest first. */
+#define BUF_LOAD_BATCH_SIZE		1024
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -186,6 +217,196 @@ get_buf_dump_dir()
 	return(dump_dir);
 }
 
+/*****************************************************************//**
+Frees the per-instance arrays of a buffer pool dump. */
+static
+void
+buf_dump_free(
+/*==========*/
+	buf_dump_t**	dumps,		/*!< in,own: dump of each instance */
+	ulint*		n_pages)	/*!< in,own: number of entries in
+					each dump */
+{
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		if (dumps[i] != NULL) {
+			ut_free(dumps[i]);
+		}
+	}
+
+	ut_free(dumps);
+	ut_free(n_pages);
+}
+
+/*****************************************************************//**
+Merges the per-instance dumps into one array, taking the entries from the
+instances in turn. Every instance dump is ordered from the hottest to the
+coldest page, so the result is too. Frees dumps and n_pages.
+@return merged dump, to be freed with ut_free(), or NULL if out of memory */
+static
+buf_dump_t*
+buf_dump_interleave(
+/*================*/
+	buf_dump_t**	dumps,		/*!< in,own: dump of each instance */
+	ulint*		n_pages,	/*!< in,own: number of entries in
+					each dump */
+	ulint*		n_dump)		/*!< out: number of entries in the
+					merged dump */
+{
+	buf_dump_t*	dump;
+	ulint		n_max = 0;
+	ulint		n = 0;
+
+	*n_dump = 0;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		if (dumps[i] == NULL) {
+			n_pages[i] = 0;
+		}
+
+		*n_dump += n_pages[i];
+
+		if (n_pages[i] > n_max) {
+			n_max = n_pages[i];
+		}
+	}
+
+	/* Allocate at least one entry so that an empty buffer pool is
+	not reported as out of memory. */
+	dump = static_cast<buf_dump_t*>(
+		ut_malloc(ut_max(*n_dump, 1) * sizeof(*dump)));
+
+	if (dump != NULL) {
+		for (ulint j = 0; j < n_max; j++) {
+			for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+				if (j < n_pages[i]) {
+					dump[n++] = dumps[i][j];
+				}
+			}
+		}
+
+		ut_a(n == *n_dump);
+	}
+
+	buf_dump_free(dumps, n_pages);
+
+	return(dump);
+}
+
+/*****************************************************************//**
+Writes a buffer pool dump as text, one "space_no,page_no" line per page.
+@return TRUE on success or if interrupted by shutdown, FALSE on write error */
+static
+ibool
+buf_dump_write_text(
+/*================*/
+	FILE*			f,		/*!< in: dump file */
+	const buf_dump_t*	dump,		/*!< in: dump entries */
+	ulint			n_dump,		/*!< in: number of entries */
+	ibool			obey_shutdown)	/*!< in: quit if we are in a
+						shutting down state */
+{
+	for (ulint j = 0; j < n_dump && !SHOULD_QUIT(); j++) {
+		if (fprintf(f, ULINTPF "," ULINTPF "\n",
+			    BUF_DUMP_SPACE(dump[j]),
+			    BUF_DUMP_PAGE(dump[j])) < 0) {
+
+			return(FALSE);
+		}
+
+		if (j % 128 == 0) {
+			buf_dump_status(
+				STATUS_INFO,
+				"Dumping buffer pool page "
+				ULINTPF "/" ULINTPF,
+				j + 1, n_dump);
+		}
+	}
+
+	return(TRUE);
+}
+
+/*****************************************************************//**
+Writes a buffer pool dump in the compressed format, see BUF_DUMP_MAGIC.
+@return TRUE on success or if interrupted by shutdown, FALSE on error */
+static
+ibool
+buf_dump_write_compressed(
+/*======================*/
+	FILE*			f,		/*!< in: dump file */
+	const buf_dump_t*	dump,		/*!< in: dump entries */
+	ulint			n_dump,		/*!< in: number of entries */
+	ibool			obey_shutdown)	/*!< in: quit if we are in a
+						shutting down state */
+{
+	byte	header[BUF_DUMP_HEADER_SIZE];
+	byte*	entries;
+	byte*	zbuf;
+	uLong	zbuf_size;
+	ibool	success = TRUE;
+
+	mach_write_to_4(header + BUF_DUMP_MAGIC, BUF_DUMP_MAGIC_N);
+	mach_write_to_4(header + BUF_DUMP_VERSION, BUF_DUMP_VERSION_1);
+	mach_write_to_8(header + BUF_DUMP_N_ENTRIES, n_dump);
+
+	if (fwrite(header, 1, sizeof(header), f) != sizeof(header)) {
+		return(FALSE);
+	}
+
+	zbuf_size = compressBound(BUF_DUMP_CHUNK_ENTRIES * sizeof(*dump));
+
+	entries = static_cast<byte*>(
+		ut_malloc(BUF_DUMP_CHUNK_ENTRIES * sizeof(*dump)));
+	zbuf = static_cast<byte*>(
+		ut_malloc(BUF_DUMP_CHUNK_HEADER_SIZE + zbuf_size));
+
+	if (entries == NULL || zbuf == NULL) {
+		ut_free(entries);
+		ut_free(zbuf);
+		return(FALSE);
+	}
+
+	for (ulint j = 0; j < n_dump && !SHOULD_QUIT();
+	     j += BUF_DUMP_CHUNK_ENTRIES) {
+
+		ulint	n = ut_min(n_dump - j, BUF_DUMP_CHUNK_ENTRIES);
+		uLongf	len = zbuf_size;
+
+		for (ulint k = 0; k < n; k++) {
+			mach_write_to_8(entries + k * sizeof(*dump),
+					dump[j + k]);
+		}
+
+		if (compress2(zbuf + BUF_DUMP_CHUNK_HEADER_SIZE, &len,
+			      entries, n * sizeof(*dump),
+			      Z_DEFAULT_COMPRESSION) != Z_OK) {
+
+			errno = ENOMEM;
+			success = FALSE;
+			break;
+		}
+
+		mach_write_to_4(zbuf, len);
+		mach_write_to_4(zbuf + 4, n);
+
+		len += BUF_DUMP_CHUNK_HEADER_SIZE;
+
+		if (fwrite(zbuf, 1, len, f) != len) {
+			success = FALSE;
+			break;
+		}
+
+		buf_dump_status(STATUS_INFO,
+				"Dumping buffer pool page "
+				ULINTPF "/" ULINTPF,
+				j + n, n_dump);
+	}
+
+	ut_free(entries);
+	ut_free(zbuf);
+
+	return(success);
+}
+
 /*****************************************************************//**
 Perform a buffer pool dump into the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -199,14 +420,17 @@ buf_dump(
 	ibool	obey_shutdown)	/*!< in: quit if we are in a shutting down
 				state */
 {
-#define SHOULD_QUIT()	(SHUTTING_DOWN() && obey_shutdown)
-
-	char	full_filename[OS_FILE_MAX_PATH];
-	char	tmp_filename[OS_FILE_MAX_PATH];
-	char	now[32];
-	FILE*	f;
-	ulint	i;
-	int	ret;
+	char		full_filename[OS_FILE_MAX_PATH];
+	char		tmp_filename[OS_FILE_MAX_PATH];
+	char		now[32];
+	FILE*		f;
+	buf_dump_t**	dumps;
+	buf_dump_t*	dump;
+	ulint*		n_pages;
+	ulint		n_dump;
+	ulint		i;
+	ibool		success;
+	int		ret;
 
 	ut_snprintf(full_filename, sizeof(full_filename),
 		    "%s%c%s", get_buf_dump_dir(), SRV_PATH_SEPARATOR,
@@ -218,7 +442,7 @@ buf_dump(
 	buf_dump_status(STATUS_NOTICE, "Dumping buffer pool(s) to %s",
 			full_filename);
 
-	f = fopen(tmp_filename, "w");
+	f = fopen(tmp_filename, "wb");
 	if (f == NULL) {
 		buf_dump_status(STATUS_ERR,
 				"Cannot open '%s' for writing: %s",
@@ -227,12 +451,29 @@ buf_dump(
 	}
 	/* else */
 
+	dumps = static_cast<buf_dump_t**>(
+		ut_malloc(srv_buf_pool_instances * sizeof(*dumps)));
+	n_pages = static_cast<ulint*>(
+		ut_malloc(srv_buf_pool_instances * sizeof(*n_pages)));
+
+	if (dumps == NULL || n_pages == NULL) {
+		ut_free(dumps);
+		ut_free(n_pages);
+		fclose(f);
+		buf_dump_status(STATUS_ERR, "Cannot allocate memory: %s",
+				strerror(errno));
+		/* leave tmp_filename to exist */
+		return;
+	}
+
+	memset(dumps, 0, srv_buf_pool_instances * sizeof(*dumps));
+	memset(n_pages, 0, srv_buf_pool_instances * sizeof(*n_pages));
+
 	/* walk through each buffer pool */
 	for (i = 0; i < srv_buf_pool_instances && !SHOULD_QUIT(); i++) {
 		buf_pool_t*		buf_pool;
 		const buf_page_t*	bpage;
 		buf_dump_t*		dump;
-		ulint			n_pages;
 		ulint			j;
 
 		buf_pool = buf_pool_from_array(i);
@@ -241,10 +482,10 @@ buf_dump(
 		UT_LIST_GET_LEN(buf_pool->LRU) could change */
 		buf_pool_mutex_enter(buf_pool);
 
-		n_pages = UT_LIST_GET_LEN(buf_pool->LRU);
+		n_pages[i] = UT_LIST_GET_LEN(buf_pool->LRU);
 
 		/* skip empty buffer pools */
-		if (n_pages == 0) {
+		if (n_pages[i] == 0) {
 			buf_pool_mutex_exit(buf_pool);
 			continue;
 		}
@@ -252,29 +493,30 @@ buf_dump(
 		if (srv_buf_pool_dump_pct != 100) {
 			ut_ad(srv_buf_pool_dump_pct < 100);
 
-			n_pages = n_pages * srv_buf_pool_dump_pct / 100;
+			n_pages[i] = n_pages[i] * srv_buf_pool_dump_pct / 100;
 
-			if (n_pages == 0) {
-				n_pages = 1;
+			if (n_pages[i] == 0) {
+				n_pages[i] = 1;
 			}
 		}
 
 		dump = static_cast<buf_dump_t*>(
-			ut_malloc(n_pages * sizeof(*dump))) ;
+			ut_malloc(n_pages[i] * sizeof(*dump))) ;
 
 		if (dump == NULL) {
 			buf_pool_mutex_exit(buf_pool);
+			buf_dump_free(dumps, n_pages);
 			fclose(f);
 			buf_dump_status(STATUS_ERR,
 					"Cannot allocate " ULINTPF " bytes: %s",
-					(ulint) (n_pages * sizeof(*dump)),
+					(ulint) (n_pages[i] * sizeof(*dump)),
 					strerror(errno));
 			/* leave tmp_filename to exist */
 			return;
 		}
 
 		for (bpage = UT_LIST_GET_FIRST(buf_pool->LRU), j = 0;
-			bpage != NULL && j < n_pages;
+			bpage != NULL && j < n_pages[i];
 			bpage = UT_LIST_GET_NEXT(LRU, bpage), j++) {
 
 			ut_a(buf_page_in_file(bpage));
@@ -283,36 +525,43 @@ buf_dump(
 						  buf_page_get_page_no(bpage));
 		}
 
-		ut_a(j == n_pages);
+		ut_a(j == n_pages[i]);
 
 		buf_pool_mutex_exit(buf_pool);
 
-		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
-			ret = fprintf(f, ULINTPF "," ULINTPF "\n",
-				      BUF_DUMP_SPACE(dump[j]),
-				      BUF_DUMP_PAGE(dump[j]));
-			if (ret < 0) {
-				ut_free(dump);
-				fclose(f);
-				buf_dump_status(STATUS_ERR,
-						"Cannot write to '%s': %s",
-						tmp_filename, strerror(errno));
-				/* leave tmp_filename to exist */
-				return;
-			}
+		dumps[i] = dump;
+	}
 
-			if (j % 128 == 0) {
-				buf_dump_status(
-					STATUS_INFO,
-					"Dumping buffer pool "
-					ULINTPF "/" ULINTPF ", "
-					"page " ULINTPF "/" ULINTPF,
-					i + 1, srv_buf_pool_instances,
-					j + 1, n_pages);
-			}
-		}
+	/* Merge the LRU lists of all instances, hottest pages first, so that
+a load that is cut short still brings in the most useful pages. */
+	dump = buf_dump_interleave(dumps, n_pages, &n_dump);
 
-		ut_free(dump);
+	if (dump == NULL) {
+		fclose(f);
+		buf_dump_status(STATUS_ERR,
+				"Cannot allocate " ULINTPF " bytes: %s",
+				(ulint) (n_dump * sizeof(*dump)),
+				strerror(errno));
+		/* leave tmp_filename to exist */
+		return;
+	}
+
+	if (srv_buf_pool_dump_compressed) {
+		success = buf_dump_write_compressed(f, dump, n_dump,
+						    obey_shutdown);
+	} else {
+		success = buf_dump_write_text(f, dump, n_dump, obey_shutdown);
+	}
+
+	ut_free(dump);
+
+	if (!success) {
+		fclose(f);
+		buf_dump_status(STATUS_ERR,
+				"Cannot write to '%s': %s",
+				tmp_filename, strerror(errno));
+		/* leave tmp_filename to exist */
+		return;
 	}
 
 	ret = fclose(f);
@@ -390,47 +639,44 @@ buf_dump_sort(
 }
 
 /*****************************************************************//**
-Perform a buffer pool load from the file specified by
-innodb_buffer_pool_filename. If any errors occur then the value of
-innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
-The dump filename can be specified by (relative to srv_data_home):
-SET GLOBAL innodb_buffer_pool_filename='filename'; */
+Returns the number of entries of a dump that fit in the buffer pool(s).
+If a dump is larger than the buffer pool(s), then we ignore the extra
+trailing, which are the coldest pages. This could happen if a dump is
+made, then buffer pool is shrunk and then load it attempted.
+@return number of entries to load */
 static
-void
-buf_load()
-/*======*/
+ulint
+buf_load_max_entries(
+/*=================*/
+	ulint	dump_n)	/*!< in: number of entries in the dump */
+{
+	ulint	total_buffer_pools_pages = buf_pool_get_n_pages()
+		* srv_buf_pool_instances;
+
+	return(ut_min(dump_n, total_buffer_pools_pages));
+}
+
+/*****************************************************************//**
+Reads a buffer pool dump in the text format, one "space_no,page_no" line
+per page. On error sets innodb_buffer_pool_load_status.
+@return TRUE on success */
+static
+ibool
+buf_load_read_text(
+/*===============*/
+	FILE*		f,		/*!< in: dump file */
+	const char*	full_filename,	/*!< in: name of the dump file */
+	buf_dump_t**	dump_out,	/*!< out: dump entries, to be freed
+					with ut_free() */
+	ulint*		dump_n_out)	/*!< out: number of entries */
 {
-	char		full_filename[OS_FILE_MAX_PATH];
-	char		now[32];
-	FILE*		f;
 	buf_dump_t*	dump;
-	buf_dump_t*	dump_tmp;
 	ulint		dump_n;
-	ulint		total_buffer_pools_pages;
 	ulint		i;
 	ulint		space_id;
 	ulint		page_no;
 	int		fscanf_ret;
 
-	/* Ignore any leftovers from before */
-	buf_load_abort_flag = FALSE;
-
-	ut_snprintf(full_filename, sizeof(full_filename),
-		    "%s%c%s", get_buf_dump_dir(), SRV_PATH_SEPARATOR,
-		    srv_buf_dump_filename);
-
-	buf_load_status(STATUS_NOTICE,
-			"Loading buffer pool(s) from %s", full_filename);
-
-	f = fopen(full_filename, "r");
-	if (f == NULL) {
-		buf_load_status(STATUS_ERR,
-				"Cannot open '%s' for reading: %s",
-				full_filename, strerror(errno));
-		return;
-	}
-	/* else */
-
 	/* First scan the file to estimate how many entries are in it.
 	This file is tiny (approx 500KB per 1GB buffer pool), reading it
 	two times is fine. */
@@ -448,44 +694,23 @@ buf_load()
 		} else {
 			what = "parsing";
 		}
-		fclose(f);
 		buf_load_status(STATUS_ERR, "Error %s '%s', "
 				"unable to load buffer pool (stage 1)",
 				what, full_filename);
-		return;
+		return(FALSE);
 	}
 
-	/* If dump is larger than the buffer pool(s), then we ignore the
-	extra trailing. This could happen if a dump is made, then buffer
-	pool is shrunk and then load it attempted. */
-	total_buffer_pools_pages = buf_pool_get_n_pages()
-		* srv_buf_pool_instances;
-	if (dump_n > total_buffer_pools_pages) {
-		dump_n = total_buffer_pools_pages;
-	}
+	dump_n = buf_load_max_entries(dump_n);
 
-	dump = static_cast<buf_dump_t*>(ut_malloc(dump_n * sizeof(*dump)));
+	dump = static_cast<buf_dump_t*>(
+		ut_malloc(ut_max(dump_n, 1) * sizeof(*dump)));
 
 	if (dump == NULL) {
-		fclose(f);
 		buf_load_status(STATUS_ERR,
 				"Cannot allocate " ULINTPF " bytes: %s",
 				(ulint) (dump_n * sizeof(*dump)),
 				strerror(errno));
-		return;
-	}
-
-	dump_tmp = static_cast<buf_dump_t*>(
-		ut_malloc(dump_n * sizeof(*dump_tmp)));
-
-	if (dump_tmp == NULL) {
-		ut_free(dump);
-		fclose(f);
-		buf_load_status(STATUS_ERR,
-				"Cannot allocate " ULINTPF " bytes: %s",
-				(ulint) (dump_n * sizeof(*dump_tmp)),
-				strerror(errno));
-		return;
+		return(FALSE);
 	}
 
 	rewind(f);
@@ -501,19 +726,15 @@ buf_load()
 			/* else */
 
 			ut_free(dump);
-			ut_free(dump_tmp);
-			fclose(f);
 			buf_load_status(STATUS_ERR,
 					"Error parsing '%s', unable "
 					"to load buffer pool (stage 2)",
 					full_filename);
-			return;
+			return(FALSE);
 		}
 
 		if (space_id > ULINT32_MASK || page_no > ULINT32_MASK) {
 			ut_free(dump);
-			ut_free(dump_tmp);
-			fclose(f);
 			buf_load_status(STATUS_ERR,
 					"Error parsing '%s': bogus "
 					"space,page " ULINTPF "," ULINTPF
@@ -522,7 +743,7 @@ buf_load()
 					full_filename,
 					space_id, page_no,
 					i);
-			return;
+			return(FALSE);
 		}
 
 		dump[i] = BUF_DUMP_CREATE(space_id, page_no);
@@ -531,10 +752,210 @@ buf_load()
 	/* Set dump_n to the actual number of initialized elements,
 	i could be smaller than dump_n here if the file got truncated after
 	we read it the first time. */
-	dump_n = i;
+	*dump_out = dump;
+	*dump_n_out = i;
+
+	return(TRUE);
+}
+
+/*****************************************************************//**
+Reads a buffer pool dump in the compressed format, see BUF_DUMP_MAGIC.
+On error sets innodb_buffer_pool_load_status.
+@return TRUE on success */
+static
+ibool
+buf_load_read_compressed(
+/*=====================*/
+	FILE*		f,		/*!< in: dump file, positioned
+					after BUF_DUMP_MAGIC */
+	const char*	full_filename,	/*!< in: name of the dump file */
+	buf_dump_t**	dump_out,	/*!< out: dump entries, to be freed
+					with ut_free() */
+	ulint*		dump_n_out)	/*!< out: number of entries */
+{
+	byte		header[BUF_DUMP_HEADER_SIZE];
+	byte		chunk_header[BUF_DUMP_CHUNK_HEADER_SIZE];
+	byte*		entries;
+	byte*		zbuf;
+	uLong		zbuf_size;
+	buf_dump_t*	dump;
+	ib_uint64_t	file_n;
+	ulint		dump_n;
+	ulint		i = 0;
+	const char*	error = NULL;
+
+	if (fread(header + BUF_DUMP_VERSION, 1,
+		  sizeof(header) - BUF_DUMP_VERSION, f)
+	    != sizeof(header) - BUF_DUMP_VERSION) {
+
+		error = "truncated header";
+	} else if (mach_read_from_4(header + BUF_DUMP_VERSION)
+		   != BUF_DUMP_VERSION_1) {
+
+		error = "unknown version";
+	}
+
+	if (error != NULL) {
+		buf_load_status(STATUS_ERR,
+				"Error parsing '%s': %s, "
+				"unable to load buffer pool",
+				full_filename, error);
+		return(FALSE);
+	}
+
+	file_n = mach_read_from_8(header + BUF_DUMP_N_ENTRIES);
+	dump_n = buf_load_max_entries(
+		static_cast<ulint>(ut_min(file_n, ULINT_MAX)));
+
+	zbuf_size = compressBound(BUF_DUMP_CHUNK_ENTRIES * sizeof(*dump));
+
+	dump = static_cast<buf_dump_t*>(
+		ut_malloc(ut_max(dump_n, 1) * sizeof(*dump)));
+	entries = static_cast<byte*>(
+		ut_malloc(BUF_DUMP_CHUNK_ENTRIES * sizeof(*dump)));
+	zbuf = static_cast<byte*>(ut_malloc(zbuf_size));
+
+	if (dump == NULL || entries == NULL || zbuf == NULL) {
+		ut_free(dump);
+		ut_free(entries);
+		ut_free(zbuf);
+		buf_load_status(STATUS_ERR,
+				"Cannot allocate " ULINTPF " bytes: %s",
+				(ulint) (dump_n * sizeof(*dump)),
+				strerror(errno));
+		return(FALSE);
+	}
+
+	while (i < dump_n && !SHUTTING_DOWN()) {
+		ulint	zlen;
+		ulint	n;
+		uLongf	len;
+
+		if (fread(chunk_header, 1, sizeof(chunk_header), f)
+		    != sizeof(chunk_header)) {
+
+			/* A dump that got truncated is loaded as far as
+			it goes, like a truncated text dump. */
+			if (ferror(f)) {
+				error = "read error";
+			}
+			break;
+		}
+
+		zlen = mach_read_from_4(chunk_header);
+		n = mach_read_from_4(chunk_header + 4);
+
+		if (zlen > zbuf_size || n == 0
+		    || n > BUF_DUMP_CHUNK_ENTRIES) {
+
+			error = "bogus chunk header";
+			break;
+		}
+
+		if (fread(zbuf, 1, zlen, f) != zlen) {
+			if (ferror(f)) {
+				error = "read error";
+			}
+			break;
+		}
+
+		len = n * sizeof(*dump);
+
+		if (uncompress(entries, &len, zbuf, zlen) != Z_OK
+		    || len != n * sizeof(*dump)) {
+
+			error = "corrupted chunk";
+			break;
+		}
+
+		for (ulint k = 0; k < n && i < dump_n; k++, i++) {
+			dump[i] = mach_read_from_8(entries
+						   + k * sizeof(*dump));
+		}
+	}
+
+	ut_free(entries);
+	ut_free(zbuf);
+
+	if (error != NULL) {
+		ut_free(dump);
+		buf_load_status(STATUS_ERR,
+				"Error parsing '%s': %s at entry " ULINTPF
+				", unable to load buffer pool",
+				full_filename, error, i);
+		return(FALSE);
+	}
+
+	*dump_out = dump;
+	*dump_n_out = i;
+
+	return(TRUE);
+}
+
+/*****************************************************************//**
+Perform a buffer pool load from the file specified by
+innodb_buffer_pool_filename. If any errors occur then the value of
+innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
+The dump filename can be specified by (relative to srv_data_home):
+SET GLOBAL innodb_buffer_pool_filename='filename';
+The dump is read in batches of BUF_LOAD_BATCH_SIZE pages. The batches
+follow the order of the dump, hottest pages first, so that the pages that
+are most likely to be accessed are warmed up first; within a batch the
+pages are sorted on space_no, page_no and runs of adjacent pages are
+submitted together, so that they can be read with fewer and larger IOs. */
+static
+void
+buf_load()
+/*======*/
+{
+	char		full_filename[OS_FILE_MAX_PATH];
+	char		now[32];
+	FILE*		f;
+	byte		magic[4];
+	buf_dump_t*	dump;
+	buf_dump_t*	dump_tmp;
+	ulint		dump_n;
+	ulint		i;
+	ibool		success;
+
+	/* Ignore any leftovers from before */
+	buf_load_abort_flag = FALSE;
+
+	ut_snprintf(full_filename, sizeof(full_filename),
+		    "%s%c%s", get_buf_dump_dir(), SRV_PATH_SEPARATOR,
+		    srv_buf_dump_filename);
+
+	buf_load_status(STATUS_NOTICE,
+			"Loading buffer pool(s) from %s", full_filename);
+
+	f = fopen(full_filename, "rb");
+	if (f == NULL) {
+		buf_load_status(STATUS_ERR,
+				"Cannot open '%s' for reading: %s",
+				full_filename, strerror(errno));
+		return;
+	}
+	/* else */
+
+	/* A text dump starts with a digit and can not match the magic
+	number of the compressed format. */
+	if (fread(magic, 1, sizeof(magic), f) == sizeof(magic)
+	    && mach_read_from_4(magic) == BUF_DUMP_MAGIC_N) {
+
+		success = buf_load_read_compressed(f, full_filename,
+						   &dump, &dump_n);
+	} else {
+		rewind(f);
+		success = buf_load_read_text(f, full_filename,
+					     &dump, &dump_n);
+	}
 
 	fclose(f);
 
+	if (!success) {
+		return;
+	}
+
 	if (dump_n == 0) {
 		ut_free(dump);
 		ut_sprintf_timestamp(now);
@@ -544,38 +965,64 @@ buf_load()
 		return;
 	}
 
-	if (!SHUTTING_DOWN()) {
-		buf_dump_sort(dump, dump_tmp, 0, dump_n);
+	dump_tmp = static_cast<buf_dump_t*>(
+		ut_malloc(BUF_LOAD_BATCH_SIZE * sizeof(*dump_tmp)));
+
+	if (dump_tmp == NULL) {
+		ut_free(dump);
+		buf_load_status(STATUS_ERR,
+				"Cannot allocate " ULINTPF " bytes: %s",
+				(ulint) (BUF_LOAD_BATCH_SIZE
+					 * sizeof(*dump_tmp)),
+				strerror(errno));
+		return;
 	}
 
-	ut_free(dump_tmp);
+	for (i = 0; i < dump_n && !SHUTTING_DOWN();
+	     i += BUF_LOAD_BATCH_SIZE) {
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+		ulint	n = ut_min(dump_n - i, BUF_LOAD_BATCH_SIZE);
 
-		buf_read_page_async(BUF_DUMP_SPACE(dump[i]),
-				    BUF_DUMP_PAGE(dump[i]));
+		buf_dump_sort(dump + i, dump_tmp, 0, n);
 
-		if (i % 64 == 63) {
-			os_aio_simulated_wake_handler_threads();
-		}
+		ulint	n_run;
 
-		if (i % 128 == 0) {
-			buf_load_status(STATUS_INFO,
-					"Loaded " ULINTPF "/" ULINTPF " pages",
-					i + 1, dump_n);
-		}
+		for (ulint j = i; j < i + n && !SHUTTING_DOWN(); j += n_run) {
 
-		if (buf_load_abort_flag) {
-			buf_load_abort_flag = FALSE;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_NOTICE,
-				"Buffer pool(s) load aborted on request");
-			return;
+			ulint	space = BUF_DUMP_SPACE(dump[j]);
+			ulint	page_no = BUF_DUMP_PAGE(dump[j]);
+
+			if (buf_load_abort_flag) {
+				buf_load_abort_flag = FALSE;
+				ut_free(dump);
+				ut_free(dump_tmp);
+				buf_load_status(
+					STATUS_NOTICE,
+					"Buffer pool(s) load aborted on request"
+					" after " ULINTPF "/" ULINTPF " pages",
+					j, dump_n);
+				return;
+			}
+
+			/* Find the run of adjacent pages starting at j */
+			for (n_run = 1;
+			     j + n_run < i + n
+			     && BUF_DUMP_SPACE(dump[j + n_run]) == space
+			     && BUF_DUMP_PAGE(dump[j + n_run])
+			     == page_no + n_run;
+			     n_run++) {
+			}
+
+			buf_read_pages_async(space, page_no, n_run);
 		}
+
+		buf_load_status(STATUS_INFO,
+				"Loaded " ULINTPF "/" ULINTPF " pages",
+				i + n, dump_n);
 	}
 
 	ut_free(dump);
+	ut_free(dump_tmp);
 
 	ut_sprintf_timestamp(now);
 
@@ -620,9 +1067,21 @@ DECLARE_THREAD(buf_dump_thread)(
 	}
 
 	while (!SHUTTING_DOWN()) {
+		ulint	interval = srv_buf_pool_dump_interval;
+
 		buf_pool_resizable_dump = true;
 
-		os_event_wait(srv_buf_dump_event);
+		/* With innodb_buffer_pool_dump_interval the dump is
+		refreshed in the background, so that a crash loses at most
+		one interval of warmup state. */
+		if (interval == 0) {
+			os_event_wait(srv_buf_dump_event);
+		} else if (os_event_wait_time(srv_buf_dump_event,
+					      interval * 1000000)
+			   == OS_SYNC_TIME_EXCEEDED) {
+
+			buf_dump_should_start = TRUE;
+		}
 
 		if (buf_pool_resizing) {
 			os_event_wait(buf_pool_resized_event);
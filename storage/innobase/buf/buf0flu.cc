@@ -63,6 +63,7 @@ UNIV_INTERN ibool buf_lru_manager_is_active = FALSE;
 
 #ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_thread_key;
+UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_worker_thread_key;
 UNIV_INTERN mysql_pfs_key_t buf_lru_manager_thread_key;
 #endif /* UNIV_PFS_THREAD */
 
@@ -1050,7 +1051,7 @@ buf_flush_page(
 			/* avoiding deadlock possibility involves doublewrite
 			buffer, should flush it, because it might hold the
 			another block->lock. */
-			buf_dblwr_flush_buffered_writes();
+			buf_dblwr_flush_buffered_writes(buf_pool, flush_type);
 
 			rw_lock_s_lock_gen(rw_lock, BUF_IO_WRITE);
                 }
@@ -1719,10 +1720,11 @@ static
 void
 buf_flush_common(
 /*=============*/
+	buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
 	buf_flush_t	flush_type,	/*!< in: type of flush */
 	ulint		page_count)	/*!< in: number of pages flushed */
 {
-	buf_dblwr_flush_buffered_writes();
+	buf_dblwr_flush_buffered_writes(buf_pool, flush_type);
 
 	ut_a(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
 
@@ -1793,7 +1795,7 @@ buf_flush_end(
 	buf_pool_mutex_exit(buf_pool);
 
 	if (!srv_read_only_mode) {
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool, flush_type);
 	}
 }
 
@@ -1943,7 +1945,7 @@ buf_flush_list(
 
 		buf_flush_end(buf_pool, BUF_FLUSH_LIST);
 
-		buf_flush_common(BUF_FLUSH_LIST, res.first);
+		buf_flush_common(buf_pool, BUF_FLUSH_LIST, res.first);
 
 		if (n_processed) {
 			*n_processed += res.first;
@@ -2151,7 +2153,7 @@ buf_flush_LRU_tail(void)
 
 		buf_flush_end(buf_pool, BUF_FLUSH_LRU);
 
-		buf_flush_common(BUF_FLUSH_LRU, res.first);
+		buf_flush_common(buf_pool, BUF_FLUSH_LRU, res.first);
 
 		if (res.first) {
 			MONITOR_INC_VALUE_CUMULATIVE(
@@ -2200,8 +2202,360 @@ buf_flush_wait_LRU_batch_end(void)
 	}
 }
 
+/** State of the flush list batch of a buffer pool instance in a flush
+round of the page_cleaner threads */
+enum page_cleaner_state_t {
+	PAGE_CLEANER_STATE_NONE = 0,	/*!< not requested */
+	PAGE_CLEANER_STATE_REQUESTED,	/*!< requested, not taken by any
+					page_cleaner thread yet */
+	PAGE_CLEANER_STATE_FLUSHING,	/*!< being flushed */
+	PAGE_CLEANER_STATE_FINISHED	/*!< flushed */
+};
+
+/** Flush request for a buffer pool instance */
+struct page_cleaner_slot_t {
+	page_cleaner_state_t	state;		/*!< state of the request */
+	ulint			n_pages_requested;
+						/*!< number of pages to flush */
+	ulint			n_flushed;	/*!< number of pages flushed */
+	bool			succeeded;	/*!< false if another flush
+						list batch was running */
+};
+
+/** State shared by the page_cleaner coordinator and its workers. The
+coordinator requests a flush round, flushes buffer pool instances itself
+along with the workers and waits for all instances to be flushed. */
+struct page_cleaner_t {
+	os_ib_mutex_t		mutex;		/*!< protects the members
+						below */
+	os_event_t		is_requested;	/*!< set while there are
+						requested slots, or when
+						the workers must exit */
+	os_event_t		is_finished;	/*!< set when all slots of
+						the round are finished */
+	bool			is_running;	/*!< false when the workers
+						must exit */
+	ulint			n_workers;	/*!< number of worker threads
+						that have not exited */
+	ulint			n_started;	/*!< number of worker threads
+						that have started, used to
+						number them */
+	lsn_t			lsn_limit;	/*!< lsn limit of the round */
+	ulint			round_start;	/*!< ut_time_ms() when the
+						round was requested */
+	ulint			n_slots_requested;
+						/*!< slots in state
+						PAGE_CLEANER_STATE_REQUESTED */
+	ulint			n_slots_finished;
+						/*!< slots in state
+						PAGE_CLEANER_STATE_FINISHED */
+	page_cleaner_slot_t*	slots;		/*!< one slot per buffer
+						pool instance */
+};
+
+/** Statistics of a page_cleaner thread */
+struct page_cleaner_stat_t {
+	ulint	n_flushed;	/*!< pages flushed by the thread */
+	ulint	lag;		/*!< milliseconds from the start of the last
+				round to the end of the thread's share of it */
+};
+
+/** Shared state of the page_cleaner threads, NULL if the coordinator
+runs without workers */
+static page_cleaner_t*	page_cleaner = NULL;
+
+/** Statistics of the page_cleaner threads, the coordinator first. These
+are not protected by any mutex, they are only read by the monitor. */
+static page_cleaner_stat_t	page_cleaner_stats[BUF_FLUSH_PAGE_CLEANERS_MAX];
+
+/******************************************************************//**
+Initializes the state shared by the page_cleaner threads. Must be called
+before the page_cleaner threads are created. Clamps srv_n_page_cleaners
+to the number of buffer pool instances. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void)
+/*=============================*/
+{
+	ut_ad(page_cleaner == NULL);
+
+	if (srv_n_page_cleaners > srv_buf_pool_instances) {
+		srv_n_page_cleaners = srv_buf_pool_instances;
+	}
+
+	memset(page_cleaner_stats, 0, sizeof page_cleaner_stats);
+
+	if (srv_n_page_cleaners <= 1) {
+		return;
+	}
+
+	page_cleaner = static_cast<page_cleaner_t*>(
+		mem_zalloc(sizeof *page_cleaner));
+
+	page_cleaner->mutex = os_mutex_create();
+	page_cleaner->is_requested = os_event_create();
+	page_cleaner->is_finished = os_event_create();
+	page_cleaner->is_running = true;
+	page_cleaner->n_workers = srv_n_page_cleaners - 1;
+	page_cleaner->slots = static_cast<page_cleaner_slot_t*>(
+		mem_zalloc(srv_buf_pool_instances
+			   * sizeof *page_cleaner->slots));
+}
+
+/******************************************************************//**
+Stops the page_cleaner workers and frees the state shared by the
+page_cleaner threads. Called by the coordinator when it exits. */
+static
+void
+buf_flush_page_cleaner_close(void)
+/*==============================*/
+{
+	if (page_cleaner == NULL) {
+		return;
+	}
+
+	os_mutex_enter(page_cleaner->mutex);
+	page_cleaner->is_running = false;
+	os_event_set(page_cleaner->is_requested);
+	os_mutex_exit(page_cleaner->mutex);
+
+	/* Wait for the workers to exit */
+	os_mutex_enter(page_cleaner->mutex);
+
+	while (page_cleaner->n_workers > 0) {
+		os_mutex_exit(page_cleaner->mutex);
+		os_thread_sleep(10000);
+		os_mutex_enter(page_cleaner->mutex);
+	}
+
+	os_mutex_exit(page_cleaner->mutex);
+
+	os_event_free(page_cleaner->is_finished);
+	os_event_free(page_cleaner->is_requested);
+	os_mutex_free(page_cleaner->mutex);
+	mem_free(page_cleaner->slots);
+	mem_free(page_cleaner);
+	page_cleaner = NULL;
+}
+
+/******************************************************************//**
+Gets the statistics of a page_cleaner thread.
+@return false if there is no such thread */
+UNIV_INTERN
+bool
+buf_flush_page_cleaner_stats(
+/*=========================*/
+	ulint	id,		/*!< in: 0 for the coordinator, 1 and above
+				for the workers */
+	ulint*	n_flushed,	/*!< out: pages flushed by the thread */
+	ulint*	lag)		/*!< out: milliseconds from the start of
+				the last flush round to the end of the
+				thread's share of it */
+{
+	if (id >= srv_n_page_cleaners) {
+		return(false);
+	}
+
+	*n_flushed = page_cleaner_stats[id].n_flushed;
+	*lag = page_cleaner_stats[id].lag;
+
+	return(true);
+}
+
+/*********************************************************************//**
+Requests a flush round of the flush lists of all buffer pool instances
+from the page_cleaner threads. The pages to flush are shared out to the
+instances in proportion to the length of their flush lists, so that the
+instances with the most dirty pages, which hold back the checkpoint the
+most, get the largest batches. */
+static
+void
+page_cleaner_request(
+/*=================*/
+	ulint		min_n,		/*!< in: wished minimum number of
+					pages to flush, or ULINT_MAX */
+	lsn_t		lsn_limit)	/*!< in: LSN up to which flushing
+					must happen */
+{
+	ulint	total_dirty = 0;
+	ulint	i;
+
+	os_mutex_enter(page_cleaner->mutex);
+
+	ut_ad(page_cleaner->n_slots_requested == 0);
+	ut_ad(page_cleaner->n_slots_finished == 0);
+
+	/* The flush list lengths are read without the flush list
+	mutexes, an estimate is enough here */
+	for (i = 0; i < srv_buf_pool_instances; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		slot->n_pages_requested = UT_LIST_GET_LEN(
+			buf_pool_from_array(i)->flush_list);
+		total_dirty += slot->n_pages_requested;
+	}
+
+	for (i = 0; i < srv_buf_pool_instances; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		if (min_n == ULINT_MAX) {
+			slot->n_pages_requested = ULINT_MAX;
+		} else if (total_dirty == 0) {
+			slot->n_pages_requested =
+				(min_n + srv_buf_pool_instances - 1)
+				/ srv_buf_pool_instances;
+		} else {
+			slot->n_pages_requested = static_cast<ulint>(
+				(static_cast<ib_uint64_t>(min_n)
+				 * slot->n_pages_requested
+				 + total_dirty - 1) / total_dirty);
+		}
+
+		slot->state = PAGE_CLEANER_STATE_REQUESTED;
+		slot->n_flushed = 0;
+		slot->succeeded = true;
+	}
+
+	page_cleaner->lsn_limit = lsn_limit;
+	page_cleaner->round_start = ut_time_ms();
+	page_cleaner->n_slots_requested = srv_buf_pool_instances;
+
+	os_event_reset(page_cleaner->is_finished);
+	os_event_set(page_cleaner->is_requested);
+
+	os_mutex_exit(page_cleaner->mutex);
+}
+
+/*********************************************************************//**
+Takes a requested slot of the current flush round and flushes the flush
+list of its buffer pool instance.
+@return false if no slot was left to take */
+static
+bool
+page_cleaner_flush_slot(
+/*====================*/
+	ulint	id)	/*!< in: page_cleaner thread, 0 for the
+			coordinator */
+{
+	page_cleaner_slot_t*	slot = NULL;
+	buf_pool_t*		buf_pool;
+	ulint			n_pages;
+	lsn_t			lsn_limit;
+	ulint			i;
+
+	os_mutex_enter(page_cleaner->mutex);
+
+	if (page_cleaner->n_slots_requested == 0) {
+		os_mutex_exit(page_cleaner->mutex);
+		return(false);
+	}
+
+	for (i = 0; i < srv_buf_pool_instances; i++) {
+		slot = &page_cleaner->slots[i];
+
+		if (slot->state == PAGE_CLEANER_STATE_REQUESTED) {
+			break;
+		}
+	}
+
+	ut_a(i < srv_buf_pool_instances);
+
+	slot->state = PAGE_CLEANER_STATE_FLUSHING;
+
+	if (--page_cleaner->n_slots_requested == 0) {
+		os_event_reset(page_cleaner->is_requested);
+	}
+
+	n_pages = slot->n_pages_requested;
+	lsn_limit = page_cleaner->lsn_limit;
+
+	os_mutex_exit(page_cleaner->mutex);
+
+	buf_pool = buf_pool_from_array(i);
+
+	if (!buf_flush_start(buf_pool, BUF_FLUSH_LIST)) {
+		/* Another flush list batch is running, see
+		buf_flush_list() */
+		slot->succeeded = false;
+	} else {
+		std::pair<ulint, ulint>	res;
+
+		res = buf_flush_batch(
+			buf_pool, BUF_FLUSH_LIST, n_pages, lsn_limit);
+
+		buf_flush_end(buf_pool, BUF_FLUSH_LIST);
+
+		buf_flush_common(buf_pool, BUF_FLUSH_LIST, res.first);
+
+		slot->n_flushed = res.first;
+
+		if (res.first) {
+			MONITOR_INC_VALUE_CUMULATIVE(
+				MONITOR_FLUSH_BATCH_TOTAL_PAGE,
+				MONITOR_FLUSH_BATCH_COUNT,
+				MONITOR_FLUSH_BATCH_PAGES,
+				res.first);
+		}
+	}
+
+	os_mutex_enter(page_cleaner->mutex);
+
+	slot->state = PAGE_CLEANER_STATE_FINISHED;
+
+	page_cleaner_stats[id].n_flushed += slot->n_flushed;
+	page_cleaner_stats[id].lag = ut_time_ms() - page_cleaner->round_start;
+
+	if (++page_cleaner->n_slots_finished == srv_buf_pool_instances) {
+		os_event_set(page_cleaner->is_finished);
+	}
+
+	os_mutex_exit(page_cleaner->mutex);
+
+	return(true);
+}
+
+/*********************************************************************//**
+Waits for all slots of the current flush round to be finished.
+@return true if the flush list of every instance was flushed, false if
+another flush list batch was running in some instance */
+static
+bool
+page_cleaner_wait_finished(
+/*=======================*/
+	ulint*	n_flushed)	/*!< out: number of pages flushed */
+{
+	bool	success = true;
+
+	os_event_wait(page_cleaner->is_finished);
+
+	os_mutex_enter(page_cleaner->mutex);
+
+	ut_ad(page_cleaner->n_slots_requested == 0);
+	ut_ad(page_cleaner->n_slots_finished == srv_buf_pool_instances);
+
+	*n_flushed = 0;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		ut_ad(slot->state == PAGE_CLEANER_STATE_FINISHED);
+
+		*n_flushed += slot->n_flushed;
+		success = success && slot->succeeded;
+		slot->state = PAGE_CLEANER_STATE_NONE;
+	}
+
+	page_cleaner->n_slots_finished = 0;
+
+	os_mutex_exit(page_cleaner->mutex);
+
+	return(success);
+}
+
 /*********************************************************************//**
-Flush a batch of dirty pages from the flush list
+Flush a batch of dirty pages from the flush list. With page_cleaner
+workers, the buffer pool instances are flushed in parallel by the
+workers and the calling coordinator.
 @return number of pages flushed, 0 if no page is flushed or if another
 flush_list type batch is running */
 static
@@ -2215,7 +2569,24 @@ page_cleaner_do_flush_batch(
 {
 	ulint n_flushed;
 
-	buf_flush_list(n_to_flush, lsn_limit, &n_flushed);
+	if (page_cleaner == NULL) {
+		ulint	start = ut_time_ms();
+
+		buf_flush_list(n_to_flush, lsn_limit, &n_flushed);
+
+		page_cleaner_stats[0].n_flushed += n_flushed;
+		page_cleaner_stats[0].lag = ut_time_ms() - start;
+
+		return(n_flushed);
+	}
+
+	page_cleaner_request(n_to_flush, lsn_limit);
+
+	while (page_cleaner_flush_slot(0)) {
+		/* Flush instances along with the workers */
+	}
+
+	page_cleaner_wait_finished(&n_flushed);
 
 	return(n_flushed);
 }
@@ -2538,8 +2909,9 @@ lru_manager_adapt_sleep_time(
 }
 
 /******************************************************************//**
-page_cleaner thread tasked with flushing dirty pages from the buffer
-pools. As of now we'll have only one instance of this thread.
+page_cleaner coordinator thread tasked with flushing dirty pages from
+the buffer pools. The flush list batches of the buffer pool instances
+are shared out to srv_n_page_cleaners - 1 worker threads.
 @return a dummy parameter */
 extern "C" UNIV_INTERN
 os_thread_ret_t
@@ -2668,6 +3040,8 @@ DECLARE_THREAD(buf_flush_page_cleaner_thread)(
 	/* We have lived our life. Time to die. */
 
 thread_exit:
+	buf_flush_page_cleaner_close();
+
 	buf_pool_resizable_page_cleaner = true;
 	buf_page_cleaner_is_active = FALSE;
 
@@ -2679,6 +3053,63 @@ thread_exit:
 	OS_THREAD_DUMMY_RETURN;
 }
 
+/******************************************************************//**
+page_cleaner worker thread that flushes the flush lists of the buffer
+pool instances requested by the coordinator.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	ulint	id;
+
+	ut_ad(!srv_read_only_mode);
+	ut_ad(page_cleaner != NULL);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_page_cleaner_worker_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	os_mutex_enter(page_cleaner->mutex);
+	id = ++page_cleaner->n_started;
+	os_mutex_exit(page_cleaner->mutex);
+
+	ut_a(id < srv_n_page_cleaners);
+
+#ifdef UNIV_DEBUG_THREAD_CREATION
+	fprintf(stderr, "InnoDB: page_cleaner worker %lu running, id %lu\n",
+		id, os_thread_pf(os_thread_get_curr_id()));
+#endif /* UNIV_DEBUG_THREAD_CREATION */
+
+	for (;;) {
+		bool	is_running;
+
+		os_event_wait(page_cleaner->is_requested);
+
+		os_mutex_enter(page_cleaner->mutex);
+		is_running = page_cleaner->is_running;
+		os_mutex_exit(page_cleaner->mutex);
+
+		if (!is_running) {
+			break;
+		}
+
+		page_cleaner_flush_slot(id);
+	}
+
+	os_mutex_enter(page_cleaner->mutex);
+	page_cleaner->n_workers--;
+	os_mutex_exit(page_cleaner->mutex);
+
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /******************************************************************//**
 lru_manager thread tasked with performing LRU flushes and evictions to refill
 the buffer pool free lists.  As of now we'll have only one instance of this
@@ -523,6 +523,65 @@ buf_read_page_async(
 	return(count > 0);
 }
 
+/********************************************************************//**
+High-level function which reads a run of adjacent pages asynchronously from
+a file to the buffer buf_pool, skipping those already there. Like the
+read-ahead functions, it buffers the aio requests and submits them together
+so that the pages can be read with fewer and larger i/o operations.
+@return number of page read requests issued */
+UNIV_INTERN
+ulint
+buf_read_pages_async(
+/*=================*/
+	ulint	space,	/*!< in: space id */
+	ulint	offset,	/*!< in: page number of the first page */
+	ulint	n_pages)/*!< in: number of pages */
+{
+	ulint		zip_size;
+	ib_int64_t	tablespace_version;
+	ulint		count;
+	ulint		i;
+	dberr_t		err;
+
+	zip_size = fil_space_get_zip_size(space);
+
+	if (zip_size == ULINT_UNDEFINED) {
+		return(0);
+	}
+
+	tablespace_version = fil_space_get_version(space);
+
+	count = 0;
+
+	for (i = offset; i < offset + n_pages; i++) {
+		count += buf_read_page_low(
+			&err, false,
+			BUF_READ_ANY_PAGE | OS_AIO_SIMULATED_WAKE_LATER
+			| BUF_READ_IGNORE_NONEXISTENT_PAGES,
+			space, zip_size, FALSE, tablespace_version, i,
+			NULL, TRUE);
+
+		if (err == DB_TABLESPACE_DELETED) {
+			break;
+		}
+	}
+#if defined(LINUX_NATIVE_AIO)
+	/* Tell aio to submit all buffered requests. */
+	os_aio_linux_dispatch_read_array_submit();
+#endif
+
+	/* In simulated aio the handler threads merge the adjacent
+	requests into one i/o once they are woken up */
+	os_aio_simulated_wake_handler_threads();
+
+	srv_stats.buf_pool_reads.add(count);
+
+	/* Like buf_read_page_async(), we do not count these deliberate
+	reads in the LRU policy heuristics (buf_LRU_stat_inc_io()). */
+
+	return(count);
+}
+
 /********************************************************************//**
 Applies linear read-ahead if in the buf_pool the page is a border page of
 a linear read-ahead area and all the pages in the area have been accessed.
@@ -283,6 +283,15 @@ static TYPELIB innodb_default_row_format_typelib = {
     array_elements(innodb_default_row_format_names) - 1,
     "innodb_default_row_format_typelib", innodb_default_row_format_names, NULL};
 
+/** Used to define an enumerate type of the system variable
+innodb_compression_algorithm. */
+static TYPELIB innodb_compression_algorithm_typelib = {
+	array_elements(page_zip_algorithm_names) - 1,
+	"innodb_compression_algorithm_typelib",
+	page_zip_algorithm_names,
+	NULL
+};
+
 /* The following counter is used to convey information to InnoDB
 about server activity: in case of normal DML ops it is not
 sensible to call srv_active_wake_master_thread after each
@@ -389,9 +398,10 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	{&sync_thread_mutex_key, "sync_thread_mutex", 0},
 #  endif /* UNIV_SYNC_DEBUG */
 	{&buf_dblwr_mutex_key, "buf_dblwr_mutex", 0},
+	{&buf_dblwr_batch_mutex_key, "buf_dblwr_batch_mutex", 0},
 	{&trx_undo_mutex_key, "trx_undo_mutex", 0},
 	{&srv_sys_mutex_key, "srv_sys_mutex", 0},
-	{&lock_sys_mutex_key, "lock_mutex", 0},
+	{&lock_rec_shard_mutex_key, "lock_rec_shard_mutex", 0},
 	{&lock_sys_wait_mutex_key, "lock_wait_mutex", 0},
 	{&trx_mutex_key, "trx_mutex", 0},
 	{&srv_sys_tasks_mutex_key, "srv_threads_mutex", 0},
@@ -408,6 +418,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 #endif /* !HAVE_ATOMIC_BUILTINS_64 */
 	{&ut_list_mutex_key, "ut_list_mutex", 0},
 	{&trx_sys_mutex_key, "trx_sys_mutex", 0},
+	{&trx_sys_view_mutex_key, "trx_sys_view_mutex", 0},
 	{&zip_pad_mutex_key, "zip_pad_mutex", 0},
 };
 # endif /* UNIV_PFS_MUTEX */
@@ -436,6 +447,7 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	{&trx_purge_latch_key, "trx_purge_latch", 0},
 	{&index_tree_rw_lock_key, "index_tree_rw_lock", 0},
 	{&index_online_log_key, "index_online_log", 0},
+	{&lock_sys_latch_key, "lock_sys_latch", 0},
 	{&dict_table_stats_key, "dict_table_stats", 0},
 	{&hash_table_rw_lock_key, "hash_table_locks", 0}
 };
@@ -454,6 +466,7 @@ static PSI_thread_info	all_innodb_threads[] = {
 	{&srv_master_thread_key, "srv_master_thread", 0},
 	{&srv_purge_thread_key, "srv_purge_thread", 0},
 	{&buf_page_cleaner_thread_key, "page_cleaner_thread", 0},
+	{&buf_page_cleaner_worker_thread_key, "page_cleaner_worker_thread", 0},
 	{&buf_lru_manager_thread_key, "lru_manager_thread", 0},
 	{&recv_writer_thread_key, "recv_writer_thread", 0},
 	{&srv_slowrm_thread_key, "srv_slowrm_thread", 0}
@@ -898,6 +911,10 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_dblwr_pages_written,	  SHOW_LONG},
   {"dblwr_writes",
   (char*) &export_vars.innodb_dblwr_writes,		  SHOW_LONG},
+  {"dblwr_batch_waits",
+  (char*) &export_vars.innodb_dblwr_batch_waits,	  SHOW_LONG},
+  {"dblwr_single_page_waits",
+  (char*) &export_vars.innodb_dblwr_single_page_waits,	  SHOW_LONG},
   {"have_atomic_builtins",
   (char*) &export_vars.innodb_have_atomic_builtins,	  SHOW_BOOL},
   {"drop_table_purge_skipped_row",
@@ -10810,6 +10827,12 @@ index_bad:
 
 	dict_tf_set(flags, innodb_row_format, zip_ssize, use_data_dir);
 
+	/* The pages of a compressed table are compressed with the
+	algorithm that was chosen when the table was created or rebuilt. */
+	if (zip_ssize) {
+		*flags2 |= page_zip_algorithm << DICT_TF2_POS_ZIP_ALGORITHM;
+	}
+
 	if (create_info->options & HA_LEX_CREATE_TMP_TABLE) {
 		*flags2 |= DICT_TF2_TEMPORARY;
 	}
@@ -17687,6 +17710,31 @@ buffer_pool_dump_now(
 	}
 }
 
+/****************************************************************//**
+Update innodb_buffer_pool_dump_interval and wake up the buffer pool
+dump/load thread so that it starts waiting with the new interval. This
+function is registered as a callback with MySQL. */
+static
+void
+buffer_pool_dump_interval_update(
+/*=============================*/
+	THD*				thd	/*!< in: thread handle */
+					MY_ATTRIBUTE((unused)),
+	struct st_mysql_sys_var*	var	/*!< in: pointer to system
+						variable */
+					MY_ATTRIBUTE((unused)),
+	void*				var_ptr,/*!< out: where the formal
+						string goes */
+	const void*			save)	/*!< in: immediate result from
+						check function */
+{
+	*static_cast<ulong*>(var_ptr) = *static_cast<const ulong*>(save);
+
+	if (!srv_read_only_mode) {
+		os_event_set(srv_buf_dump_event);
+	}
+}
+
 /****************************************************************//**
 Trigger a load of the buffer pool if innodb_buffer_pool_load_now is set
 to ON. This function is registered as a callback with MySQL. */
@@ -17808,6 +17856,14 @@ static MYSQL_SYSVAR_ULONG(doublewrite, srv_use_doublewrite_buf,
   "2=Enable reduced doublewrite mode. ",
   NULL, innodb_doublewrite_update, 1, 0, 2, 0);
 
+static MYSQL_SYSVAR_BOOL(parallel_doublewrite, srv_parallel_doublewrite,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Write LRU and flush list batches to a region of the ib_doublewrite file "
+  "per buffer pool instance and flush type instead of the doublewrite "
+  "buffer in the system tablespace, so that they can be written in "
+  "parallel. Disabled by default.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_BOOL(stats_include_delete_marked,
   srv_stats_include_delete_marked,
   PLUGIN_VAR_OPCMDARG,
@@ -18101,6 +18157,13 @@ static MYSQL_SYSVAR_BOOL(adaptive_hash_index, btr_search_enabled,
   "Disable with --skip-innodb-adaptive-hash-index.",
   NULL, innodb_adaptive_hash_index_update, TRUE);
 
+static MYSQL_SYSVAR_ULONG(adaptive_hash_index_parts, btr_ahi_parts,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of partitions of the InnoDB adaptive hash index. Each partition "
+  "has its own latch and hash table, and an index is assigned to a "
+  "partition by its index id (8 by default).",
+  NULL, NULL, 8, 1, BTR_AHI_PARTS_MAX, 0);
+
 static MYSQL_SYSVAR_ULONG(replication_delay, srv_replication_delay,
   PLUGIN_VAR_RQCMDARG,
   "Replication thread delay (ms) on the slave server if "
@@ -18113,6 +18176,16 @@ static MYSQL_SYSVAR_UINT(compression_level, page_zip_level,
   ", 1 is fastest, 9 is best compression and default is 6.",
   NULL, NULL, DEFAULT_COMPRESSION_LEVEL, 0, 9, 0);
 
+static MYSQL_SYSVAR_ENUM(compression_algorithm, page_zip_algorithm,
+  PLUGIN_VAR_RQCMDARG,
+  "Compression algorithm of the pages of tables that are created or rebuilt"
+  " with ROW_FORMAT=COMPRESSED. Possible values are ZLIB (default), LZ4 and"
+  " ZSTD. The algorithm is stored with the table, so changing this does not"
+  " affect existing tables. innodb_compression_level is ignored by LZ4, and"
+  " 0 selects the default level of ZSTD.",
+  NULL, NULL, PAGE_ZIP_ALGORITHM_ZLIB,
+  &innodb_compression_algorithm_typelib);
+
 static MYSQL_SYSVAR_BOOL(zlib_wrap, page_zip_zlib_wrap,
   PLUGIN_VAR_OPCMDARG,
   "When this parameter is OFF, innodb tells zlib to not compute adler32 values "
@@ -18286,6 +18359,20 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_dump_pct, srv_buf_pool_dump_pct,
   "Dump only the hottest N% of each buffer pool, defaults to 100",
   NULL, NULL, 100, 1, 100, 0);
 
+static MYSQL_SYSVAR_BOOL(buffer_pool_dump_compressed,
+  srv_buf_pool_dump_compressed,
+  PLUGIN_VAR_NOCMDARG,
+  "Write the buffer pool dump as zlib compressed binary chunks instead of "
+  "text. A load detects the format of the dump file.",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_ULONG(buffer_pool_dump_interval,
+  srv_buf_pool_dump_interval,
+  PLUGIN_VAR_RQCMDARG,
+  "Dump the buffer pool in the background every N seconds, so that a "
+  "restart after a crash can warm up from a recent dump. 0 disables.",
+  NULL, buffer_pool_dump_interval_update, 0, 0, 86400 * 7, 0);
+
 #ifdef UNIV_DEBUG
 static MYSQL_SYSVAR_STR(buffer_pool_evict, srv_buffer_pool_evict,
   PLUGIN_VAR_RQCMDARG,
@@ -18463,6 +18550,16 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(merge_sort_threads, srv_merge_sort_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of threads that merge sort the index entries of one"
+  " index creation and insert them into the new indexes. The clustered"
+  " index is still read by one thread. Non-unique indexes are sorted and"
+  " loaded by separate threads, and the entries of the other indexes are"
+  " sorted by several threads. Every extra thread allocates"
+  " 3 * innodb_sort_buffer_size bytes.",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -18664,6 +18761,19 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(use_io_uring, srv_use_io_uring,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Use io_uring instead of libaio for native AIO if supported on this "
+  "platform.",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_BOOL(io_uring_poll, srv_io_uring_poll,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Busy-poll for completed data file reads and writes when io_uring is "
+  "used. Requires innodb_flush_method to be one of the O_DIRECT methods "
+  "and data files on devices that support polled I/O.",
+  NULL, NULL, FALSE);
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
@@ -18919,6 +19029,13 @@ static MYSQL_SYSVAR_BOOL(page_cleaner_adaptive_sleep, srv_pc_adaptive_sleep,
   "Enable adaptive sleep time calculation for page cleaner thread",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_ULONG(page_cleaners, srv_n_page_cleaners,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of page cleaner threads flushing the flush lists of the buffer "
+  "pool instances in parallel, including the coordinator. Limited to the "
+  "number of buffer pool instances (1 by default).",
+  NULL, NULL, 1, 1, BUF_FLUSH_PAGE_CLEANERS_MAX, 0);
+
 static MYSQL_SYSVAR_ULONG(aio_old_usecs, srv_io_old_usecs,
   PLUGIN_VAR_RQCMDARG,
   "AIO requests are scheduled in file offset order until they are this old. ",
@@ -18979,6 +19096,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
   MYSQL_SYSVAR(dump_core_without_large_mem_buf),
   MYSQL_SYSVAR(buffer_pool_dump_pct),
+  MYSQL_SYSVAR(buffer_pool_dump_compressed),
+  MYSQL_SYSVAR(buffer_pool_dump_interval),
   MYSQL_SYSVAR(evicted_pages_sampling_ratio),
   MYSQL_SYSVAR(buffer_pool_resizing_timeout),
   MYSQL_SYSVAR(histogram_step_size_async_read),
@@ -19010,11 +19129,13 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(commit_concurrency),
   MYSQL_SYSVAR(concurrency_tickets),
   MYSQL_SYSVAR(compression_level),
+  MYSQL_SYSVAR(compression_algorithm),
   MYSQL_SYSVAR(data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(deadlock_detect),
   MYSQL_SYSVAR(max_deadlock_detection_steps),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(parallel_doublewrite),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(api_enable_binlog),
   MYSQL_SYSVAR(api_enable_mdl),
@@ -19083,6 +19204,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_recalc_threshold),
   MYSQL_SYSVAR(stats_locked_reads),
   MYSQL_SYSVAR(adaptive_hash_index),
+  MYSQL_SYSVAR(adaptive_hash_index_parts),
   MYSQL_SYSVAR(stats_method),
   MYSQL_SYSVAR(replication_delay),
   MYSQL_SYSVAR(status_file),
@@ -19093,6 +19215,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(support_xa),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(merge_sort_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -19111,6 +19234,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(use_fdatasync),
   MYSQL_SYSVAR(use_sys_malloc),
   MYSQL_SYSVAR(use_native_aio),
+  MYSQL_SYSVAR(use_io_uring),
+  MYSQL_SYSVAR(io_uring_poll),
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
 #endif // HAVE_LIBNUMA
@@ -19182,6 +19307,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(zlib_strategy),
   MYSQL_SYSVAR(lru_manager_max_sleep_time),
   MYSQL_SYSVAR(page_cleaner_adaptive_sleep),
+  MYSQL_SYSVAR(page_cleaners),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(allow_ibuf_merges),
 #endif /* UNIV_DEBUG */
@@ -19208,6 +19334,7 @@ mysql_declare_plugin(innobase)
 i_s_innodb_trx,
 i_s_innodb_locks,
 i_s_innodb_lock_waits,
+i_s_innodb_lock_shards,
 i_s_innodb_cmp,
 i_s_innodb_cmp_reset,
 i_s_innodb_cmpmem,
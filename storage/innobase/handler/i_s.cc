@@ -46,6 +46,7 @@ Created July 18, 2007 Vasil Dimov
 #include "dict0types.h"
 #include "ha_prototypes.h"
 #include "srv0start.h"
+#include "lock0lock.h"
 #include "trx0i_s.h"
 #include "trx0trx.h"
 #include "srv0mon.h"
@@ -1632,6 +1633,164 @@ trx_i_s_common_fill_table(
 #endif
 }
 
+/* Fields of the dynamic table INFORMATION_SCHEMA.innodb_lock_shards */
+static ST_FIELD_INFO	i_s_lock_shards_fields_info[] =
+{
+#define IDX_LOCK_SHARD_ID		0
+	{STRUCT_FLD(field_name,		"SHARD_ID"),
+	 STRUCT_FLD(field_length,	MY_INT32_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_LOCK_SHARD_REQUESTS		1
+	{STRUCT_FLD(field_name,		"REQUESTS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_LOCK_SHARD_WAITS		2
+	{STRUCT_FLD(field_name,		"WAITS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_LOCK_SHARD_GLOBAL		3
+	{STRUCT_FLD(field_name,		"GLOBAL_FALLBACKS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+	END_OF_ST_FIELD_INFO
+};
+
+/*******************************************************************//**
+Fill the dynamic table INFORMATION_SCHEMA.innodb_lock_shards with the
+statistics of the partitions of the record lock hash table. The counters
+are read without latching.
+@return	0 on success, 1 on failure */
+static
+int
+i_s_lock_shards_fill(
+/*=================*/
+	THD*		thd,	/*!< in: thread */
+	TABLE_LIST*	tables,	/*!< in/out: tables to fill */
+	Item*		)	/*!< in: condition (ignored) */
+{
+	TABLE*	table	= tables->table;
+
+	DBUG_ENTER("i_s_lock_shards_fill");
+
+	/* deny access to non-superusers */
+	if (check_global_access(thd, PROCESS_ACL)) {
+
+		DBUG_RETURN(0);
+	}
+
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name);
+
+	for (ulint i = 0; i < LOCK_REC_N_SHARDS; i++) {
+		const lock_rec_shard_t*	shard = &lock_sys->rec_shards[i];
+
+		OK(table->field[IDX_LOCK_SHARD_ID]->store(longlong(i), TRUE));
+		OK(table->field[IDX_LOCK_SHARD_REQUESTS]->store(
+			   longlong(shard->n_requests), TRUE));
+		OK(table->field[IDX_LOCK_SHARD_WAITS]->store(
+			   longlong(shard->n_waits), TRUE));
+		OK(table->field[IDX_LOCK_SHARD_GLOBAL]->store(
+			   longlong(shard->n_global), TRUE));
+
+		OK(schema_table_store_record(thd, table));
+	}
+
+	DBUG_RETURN(0);
+}
+
+/*******************************************************************//**
+Bind the dynamic table INFORMATION_SCHEMA.innodb_lock_shards
+@return	0 on success */
+static
+int
+i_s_lock_shards_init(
+/*=================*/
+	void*	p)	/*!< in/out: table schema object */
+{
+	ST_SCHEMA_TABLE*	schema;
+
+	DBUG_ENTER("i_s_lock_shards_init");
+
+	schema = (ST_SCHEMA_TABLE*) p;
+
+	schema->fields_info = i_s_lock_shards_fields_info;
+	schema->fill_table = i_s_lock_shards_fill;
+
+	DBUG_RETURN(0);
+}
+
+UNIV_INTERN struct st_mysql_plugin	i_s_innodb_lock_shards =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	STRUCT_FLD(type, MYSQL_INFORMATION_SCHEMA_PLUGIN),
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	STRUCT_FLD(info, &i_s_info),
+
+	/* plugin name */
+	/* const char* */
+	STRUCT_FLD(name, "INNODB_LOCK_SHARDS"),
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(author, plugin_author),
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(descr, "InnoDB record lock hash table shard statistics"),
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	STRUCT_FLD(license, PLUGIN_LICENSE_GPL),
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(init, i_s_lock_shards_init),
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(deinit, i_s_common_deinit),
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	STRUCT_FLD(version, INNODB_VERSION_SHORT),
+
+	/* struct st_mysql_show_var* */
+	STRUCT_FLD(status_vars, NULL),
+
+	/* struct st_mysql_sys_var** */
+	STRUCT_FLD(system_vars, NULL),
+
+	/* reserved for dependency checking */
+	/* void* */
+	STRUCT_FLD(__reserved1, NULL),
+
+	/* Plugin flags */
+	/* unsigned long */
+	STRUCT_FLD(flags, 0UL),
+};
+
 /* Fields of the dynamic table information_schema.innodb_cmp. */
 static ST_FIELD_INFO	i_s_cmp_fields_info[] =
 {
@@ -1799,6 +1958,14 @@ static ST_FIELD_INFO	i_s_cmp_fields_info[] =
 		    " in Seconds"),
 	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
 
+	{STRUCT_FLD(field_name,		"algorithm"),
+	 STRUCT_FLD(field_length,	4),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		"Compression Algorithm"),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
 	END_OF_ST_FIELD_INFO
 };
 
@@ -1829,8 +1996,12 @@ i_s_cmp_fill_low(
 
 	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name);
 
-	for (uint i = 0; i < PAGE_ZIP_SSIZE_MAX; i++) {
-		page_zip_stat_t*	zip_stat = &page_zip_stat[i];
+	for (uint n = 0; n < PAGE_ZIP_ALGORITHM_MAX * PAGE_ZIP_SSIZE_MAX;
+	     n++) {
+		uint			i = n % PAGE_ZIP_SSIZE_MAX;
+		uint			algorithm = n / PAGE_ZIP_SSIZE_MAX;
+		page_zip_stat_t*	zip_stat
+			= &page_zip_stat[algorithm][i];
 
 		int col = -1;
 		table->field[++col]->store(UNIV_ZIP_SIZE_MIN << i);
@@ -1877,6 +2048,8 @@ i_s_cmp_fill_low(
 		table->field[++col]->store(
 			(ulong) my_timer_to_microseconds(
 			zip_stat->decompressed_secondary_time));
+		OK(field_store_string(table->field[++col],
+				      page_zip_algorithm_names[algorithm]));
 
 		if (reset) {
 			memset(zip_stat, 0, sizeof *zip_stat);
@@ -57,6 +57,42 @@ void
 btr_search_sys_free(void);
 /*=====================*/
 
+/********************************************************************//**
+X-lock the latches of all adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_x_lock_all(void);
+/*========================*/
+
+/********************************************************************//**
+X-unlock the latches of all adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_x_unlock_all(void);
+/*==========================*/
+
+#ifdef UNIV_SYNC_DEBUG
+/********************************************************************//**
+Checks if the thread owns the latches of all adaptive hash index
+partitions in the given mode.
+@return	TRUE if all are owned */
+UNIV_INTERN
+ibool
+btr_search_own_all(
+/*===============*/
+	ulint	lock_type);	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+
+/********************************************************************//**
+Checks if the thread owns the latch of any adaptive hash index
+partition in the given mode.
+@return	TRUE if one is owned */
+UNIV_INTERN
+ibool
+btr_search_own_any(
+/*===============*/
+	ulint	lock_type);	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+#endif /* UNIV_SYNC_DEBUG */
+
 /********************************************************************//**
 Disable the adaptive hash search system and empty the index. */
 UNIV_INTERN
@@ -70,6 +106,42 @@ void
 btr_search_enable(void);
 /*====================*/
 
+/********************************************************************//**
+Returns the adaptive hash index partition of an index id.
+@return	partition number, less than btr_ahi_parts */
+UNIV_INLINE
+ulint
+btr_search_get_part_by_id(
+/*======================*/
+	index_id_t	index_id)	/*!< in: index id */
+	MY_ATTRIBUTE((pure));
+/********************************************************************//**
+Returns the adaptive hash index partition of an index.
+@return	partition number, less than btr_ahi_parts */
+UNIV_INLINE
+ulint
+btr_search_get_part(
+/*================*/
+	const dict_index_t*	index)	/*!< in: index */
+	MY_ATTRIBUTE((nonnull, pure));
+/********************************************************************//**
+Returns the latch protecting the adaptive hash index partition of an index.
+@return	partition latch */
+UNIV_INLINE
+rw_lock_t*
+btr_search_get_latch(
+/*=================*/
+	const dict_index_t*	index)	/*!< in: index */
+	MY_ATTRIBUTE((nonnull, pure));
+/********************************************************************//**
+Returns the hash table of the adaptive hash index partition of an index.
+@return	partition hash table */
+UNIV_INLINE
+hash_table_t*
+btr_search_get_hash_table(
+/*======================*/
+	const dict_index_t*	index)	/*!< in: index */
+	MY_ATTRIBUTE((nonnull, pure));
 /********************************************************************//**
 Returns search info for an index.
 @return	search info; search mutex reserved */
@@ -88,14 +160,15 @@ btr_search_info_create(
 /*===================*/
 	mem_heap_t*	heap);	/*!< in: heap where created */
 /*****************************************************************//**
-Returns the value of ref_count. The value is protected by
-btr_search_latch.
+Returns the value of ref_count. The value is protected by the
+adaptive hash index partition latch of the index.
 @return	ref_count value. */
 UNIV_INTERN
 ulint
 btr_search_info_get_ref_count(
 /*==========================*/
-	btr_search_t*   info);	/*!< in: search info. */
+	btr_search_t*   info,	/*!< in: search info. */
+	dict_index_t*	index);	/*!< in: index */
 /*********************************************************************//**
 Updates the search info. */
 UNIV_INLINE
@@ -121,7 +194,8 @@ btr_search_guess_on_hash(
 	ulint		latch_mode,	/*!< in: BTR_SEARCH_LEAF, ... */
 	btr_cur_t*	cursor,		/*!< out: tree cursor */
 	ulint		has_search_latch,/*!< in: latch mode the caller
-					currently has on btr_search_latch:
+					currently has on the partition
+					latch of index:
 					RW_S_LATCH, RW_X_LATCH, or 0 */
 	mtr_t*		mtr);		/*!< in: mtr */
 /********************************************************************//**
@@ -205,7 +279,7 @@ struct btr_search_t{
 	ulint	ref_count;	/*!< Number of blocks in this index tree
 				that have search index built
 				i.e. block->index points to this index.
-				Protected by btr_search_latch except
+				Protected by the partition latch except
 				when during initialization in
 				btr_search_info_create(). */
 
@@ -255,11 +329,28 @@ struct btr_search_t{
 #endif /* UNIV_DEBUG */
 };
 
+/** Per-partition adaptive hash index statistics. The counters are
+updated without holding any latch and are therefore approximate, in
+the same way as btr_cur_n_sea. */
+struct btr_search_part_stats_t{
+	ulint	n_searches;	/*!< number of successful searches
+				in the partition */
+	ulint	n_misses;	/*!< number of failed searches
+				in the partition */
+	byte	pad[64 - 2 * sizeof(ulint)];
+				/*!< keep partitions on separate
+				cache lines */
+};
+
 /** The hash index system */
 struct btr_search_sys_t{
-	hash_table_t*	hash_index;	/*!< the adaptive hash index,
-					mapping dtuple_fold values
-					to rec_t pointers on index pages */
+	hash_table_t**	hash_tables;	/*!< the adaptive hash index
+					partitions, mapping dtuple_fold
+					values to rec_t pointers on index
+					pages; btr_ahi_parts elements */
+	btr_search_part_stats_t*
+			part_stats;	/*!< statistics of each partition;
+					btr_ahi_parts elements */
 };
 
 /** The adaptive hash index */
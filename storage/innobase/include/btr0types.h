@@ -41,10 +41,10 @@ struct btr_search_t;
 
 #ifndef UNIV_HOTBACKUP
 
-/** @brief The latch protecting the adaptive search system
+/** @brief The latches protecting the adaptive search system
 
-This latch protects the
-(1) hash index;
+Each latch protects the
+(1) the hash table of its partition;
 (2) columns of a record to which we have a pointer in the hash index;
 
 but does NOT protect:
@@ -53,16 +53,23 @@ but does NOT protect:
 (4) next or previous records on the same page.
 
 Bear in mind (3) and (4) when using the hash index.
-*/
-extern rw_lock_t*	btr_search_latch_temp;
+
+The adaptive hash index is split into btr_ahi_parts partitions, each with
+its own hash table and latch. An index is assigned to a partition by its
+index id, see btr_search_get_latch(). */
+extern rw_lock_t**	btr_search_latches;
 
 #endif /* UNIV_HOTBACKUP */
 
-/** The latch protecting the adaptive search system */
-#define btr_search_latch	(*btr_search_latch_temp)
+/** Maximum value of innodb_adaptive_hash_index_parts */
+#define BTR_AHI_PARTS_MAX	16
+
+/** Number of adaptive hash index partitions
+(innodb_adaptive_hash_index_parts) */
+extern ulong	btr_ahi_parts;
 
 /** Flag: has the search system been enabled?
-Protected by btr_search_latch. */
+Protected by all of btr_search_latches. */
 extern char	btr_search_enabled;
 
 #ifdef UNIV_BLOB_DEBUG
@@ -40,6 +40,11 @@ extern ibool		buf_dblwr_being_created;
 /** The size of the doublewrite header page when the reduced-doublewrite mode
 is used. */
 #define BUF_DBLWR_HEADER_SIZE 4096
+/** Name of the parallel doublewrite file in the data home directory */
+#define BUF_DBLWR_PARALLEL_FILE_NAME "ib_doublewrite"
+/** Number of parallel doublewrite batches of a buffer pool instance: one
+for LRU and one for flush list batches */
+#define BUF_DBLWR_BATCHES_PER_INSTANCE 2
 
 /****************************************************************//**
 Creates the doublewrite buffer to a new InnoDB installation. The header of the
@@ -68,6 +73,19 @@ void
 buf_dblwr_process(void);
 /*===================*/
 
+/****************************************************************//**
+Creates the parallel doublewrite file and the batches of the buffer pool
+instances if innodb_parallel_doublewrite is set, or removes a file left by
+an earlier run if it is not. Must be called after buf_dblwr_process() has
+restored the pages read from that file by buf_dblwr_parallel_load(), and
+before any thread other than the caller flushes pages. If the file cannot
+be created the doublewrite buffer in the system tablespace is used for all
+flushes. */
+UNIV_INTERN
+void
+buf_dblwr_parallel_init(void);
+/*=========================*/
+
 /****************************************************************//**
 frees doublewrite buffer. */
 UNIV_INTERN
@@ -105,11 +123,15 @@ Flushes possible buffered writes from the doublewrite memory buffer to disk,
 and also wakes up the aio thread if simulated aio is used. It is very
 important to call this function after a batch of writes has been posted,
 and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+of threads can occur. With the parallel doublewrite file only the batch of
+the given buffer pool instance and flush type is written. */
 UNIV_INTERN
 void
-buf_dblwr_flush_buffered_writes(void);
-/*=================================*/
+buf_dblwr_flush_buffered_writes(
+/*============================*/
+	buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	buf_flush_t	flush_type);	/*!< in: BUF_FLUSH_LRU or
+					BUF_FLUSH_LIST */
 /********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
 the page to the datafile and sync the datafile. This function is used
@@ -125,6 +147,31 @@ buf_dblwr_write_single_page(
 	buf_page_t*	bpage,	/*!< in: buffer block to write */
 	bool		sync);	/*!< in: true if sync IO requested */
 
+/** Doublewrite batch of one buffer pool instance and flush type. It is
+written to its own region of the parallel doublewrite file, so that batches
+of different instances do not wait for each other. */
+struct buf_dblwr_batch_t{
+	ib_mutex_t	mutex;	/*!< mutex protecting the fields below */
+	ulint		first_free;/*!< first free position in write_buf
+				measured in units of UNIV_PAGE_SIZE,
+				not counting the header page */
+	ulint		b_reserved;/*!< number of slots currently reserved
+				for the batch */
+	os_event_t	b_event;/*!< event where threads wait for the
+				batch to end */
+	bool		batch_running;/*!< set to true if the batch is
+				currently being written */
+	os_offset_t	offset;	/*!< offset of the region of the batch
+				in the parallel doublewrite file */
+	byte*		write_buf;/*!< the batch header page followed by
+				srv_doublewrite_batch_size page copies,
+				aligned to UNIV_PAGE_SIZE */
+	byte*		write_buf_unaligned;/*!< pointer to write_buf,
+				but unaligned */
+	buf_page_t**	buf_block_arr;/*!< the buffer blocks which have
+				been copied to write_buf */
+};
+
 /** Doublewrite control struct */
 struct buf_dblwr_t{
 	ib_mutex_t	mutex;	/*!< mutex protecting the first_free
@@ -162,6 +209,12 @@ struct buf_dblwr_t{
 				mode (innodb_doublewrite=2) */
 	byte*		header_unaligned;/*!< pointer to header,
 				but unaligned */
+	buf_dblwr_batch_t* batches;/*!< the LRU and flush list batches of
+				each buffer pool instance when the
+				parallel doublewrite file is used
+				(innodb_parallel_doublewrite), else
+				NULL */
+	os_file_t	parallel_file;/*!< the parallel doublewrite file */
 };
 
 
@@ -42,6 +42,9 @@ extern ibool buf_lru_manager_is_active;
 /** Event to synchronise with the flushing. */
 extern os_event_t	buf_lru_event;
 
+/** Maximum value of innodb_page_cleaners */
+#define BUF_FLUSH_PAGE_CLEANERS_MAX	16
+
 /********************************************************************//**
 Remove a block from the flush list of modified blocks. */
 UNIV_INTERN
@@ -209,12 +212,44 @@ buf_flush_ready_for_replace(
 	buf_page_t*	bpage);	/*!< in: buffer control block, must be
 				buf_page_in_file(bpage) and in the LRU list */
 /******************************************************************//**
-page_cleaner thread tasked with flushing dirty pages from the buffer
-pools. As of now we'll have only one instance of this thread.
+Initializes the state shared by the page_cleaner threads. Must be called
+before the page_cleaner threads are created. Clamps srv_n_page_cleaners
+to the number of buffer pool instances. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void);
+/*=============================*/
+/******************************************************************//**
+Gets the statistics of a page_cleaner thread.
+@return false if there is no such thread */
+UNIV_INTERN
+bool
+buf_flush_page_cleaner_stats(
+/*=========================*/
+	ulint	id,		/*!< in: 0 for the coordinator, 1 and above
+				for the workers */
+	ulint*	n_flushed,	/*!< out: pages flushed by the thread */
+	ulint*	lag);		/*!< out: milliseconds from the start of
+				the last flush round to the end of the
+				thread's share of it */
+/******************************************************************//**
+page_cleaner coordinator thread tasked with flushing dirty pages from
+the buffer pools. The flush list batches of the buffer pool instances
+are shared out to srv_n_page_cleaners - 1 worker threads.
 @return a dummy parameter */
 extern "C" UNIV_INTERN
 os_thread_ret_t
 DECLARE_THREAD(buf_flush_page_cleaner_thread)(
+/*==========================================*/
+	void*	arg);		/*!< in: a dummy parameter required by
+				os_thread_create */
+/******************************************************************//**
+page_cleaner worker thread that flushes the flush lists of the buffer
+pool instances requested by the coordinator.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 /*==========================================*/
 	void*	arg);		/*!< in: a dummy parameter required by
 				os_thread_create */
@@ -94,6 +94,19 @@ buf_read_page_async(
 	ulint	space,	/*!< in: space id */
 	ulint	offset);/*!< in: page number */
 /********************************************************************//**
+High-level function which reads a run of adjacent pages asynchronously from
+a file to the buffer buf_pool, skipping those already there. Like the
+read-ahead functions, it buffers the aio requests and submits them together
+so that the pages can be read with fewer and larger i/o operations.
+@return number of page read requests issued */
+UNIV_INTERN
+ulint
+buf_read_pages_async(
+/*=================*/
+	ulint	space,	/*!< in: space id */
+	ulint	offset,	/*!< in: page number of the first page */
+	ulint	n_pages);/*!< in: number of pages */
+/********************************************************************//**
 Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
 page, not even the one at the position (space, offset), if the read-ahead
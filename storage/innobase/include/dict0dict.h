@@ -1817,6 +1817,16 @@ dict_table_is_temporary(
 	const dict_table_t*	table)	/*!< in: table to check */
 	MY_ATTRIBUTE((nonnull, pure, warn_unused_result));
 
+/********************************************************************//**
+Get the compression algorithm of the compressed pages of a table.
+@return	page_zip_algorithm_t of the table */
+UNIV_INLINE
+ulint
+dict_table_get_zip_algorithm(
+/*=========================*/
+	const dict_table_t*	table)	/*!< in: table */
+	MY_ATTRIBUTE((nonnull, pure, warn_unused_result));
+
 #ifndef UNIV_HOTBACKUP
 /*********************************************************************//**
 This function should be called whenever a page is successfully
@@ -195,7 +195,7 @@ ROW_FORMAT=REDUNDANT.  InnoDB engines do not check these flags
 for unknown bits in order to protect backward incompatibility. */
 /* @{ */
 /** Total number of bits in table->flags2. */
-#define DICT_TF2_BITS			7
+#define DICT_TF2_BITS			9
 #define DICT_TF2_BIT_MASK		~(~0U << DICT_TF2_BITS)
 
 /** TEMPORARY; TRUE for tables from CREATE TEMPORARY TABLE. */
@@ -217,6 +217,11 @@ use its own tablespace instead of the system tablespace. */
 /** This bit is set if all aux table names (both common tables and
 index tables) of a FTS table are in HEX format. */
 #define DICT_TF2_FTS_AUX_HEX_NAME	64
+
+/** The compressed pages of the table are compressed with this
+page_zip_algorithm_t; zero bits are zlib. */
+#define DICT_TF2_POS_ZIP_ALGORITHM	7
+#define DICT_TF2_MASK_ZIP_ALGORITHM	(3U << DICT_TF2_POS_ZIP_ALGORITHM)
 /* @} */
 
 #define DICT_TF2_FLAG_SET(table, flag)				\
@@ -1258,7 +1263,9 @@ struct dict_table_t{
 				/*!< Count of the number of record locks on
 				this table. We use this to determine whether
 				we can evict the table from the dictionary
-				cache. It is protected by lock_sys->mutex. */
+				cache. It is protected by lock_sys->latch;
+				holders of the S-latch increment it
+				atomically. */
 	ulint		n_ref_count;
 				/*!< count of how many handles are opened
 				to this table; dropping of the table is
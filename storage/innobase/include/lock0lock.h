@@ -36,6 +36,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "lock0types.h"
 #include "read0types.h"
 #include "hash0hash.h"
+#include "sync0rw.h"
 #include "srv0srv.h"
 #include "ut0vec.h"
 
@@ -940,12 +941,41 @@ struct lock_op_t{
 	enum lock_mode	mode;	/*!< lock mode */
 };
 
+/** Number of partitions of the record lock hash table */
+#define LOCK_REC_N_SHARDS	64
+
+/** A partition of the record lock hash table. The lock queue of a page
+belongs to the shard of its hash cell. A thread holding lock_sys->latch
+in S mode may access the queues of a shard while holding its mutex. */
+struct lock_rec_shard_t{
+	ib_mutex_t	mutex;			/*!< Mutex protecting the
+						record lock queues of the
+						shard */
+	ulint		n_requests;		/*!< Number of record lock
+						requests handled in the
+						shard */
+	ulint		n_waits;		/*!< Number of times the
+						mutex was not free */
+	ulint		n_global;		/*!< Number of requests that
+						had to be retried under the
+						exclusive lock_sys->latch */
+	byte		pad[64];		/*!< Padding to keep the
+						shards on separate cache
+						lines */
+};
+
 /** The lock system struct */
 struct lock_sys_t{
-	ib_mutex_t	mutex;			/*!< Mutex protecting the
-						locks */
+	rw_lock_t	latch;			/*!< Latch protecting the
+						locks. Table locks, lock waits
+						and deadlock detection require
+						it in X mode; record locks may
+						be granted holding it in S mode
+						and the mutex of a shard */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
+	lock_rec_shard_t* rec_shards;		/*!< partitions of rec_hash,
+						LOCK_REC_N_SHARDS elements */
 	ib_mutex_t	wait_mutex;		/*!< Mutex protecting the
 						next two fields */
 	srv_slot_t*	waiting_threads;	/*!< Array  of user threads
@@ -976,20 +1006,25 @@ struct lock_sys_t{
 /** The lock system */
 extern lock_sys_t*	lock_sys;
 
-/** Test if lock_sys->mutex can be acquired without waiting. */
-#define lock_mutex_enter_nowait() mutex_enter_nowait(&lock_sys->mutex)
+/** Try to X-latch lock_sys->latch without waiting.
+@return 0 if the latch was acquired */
+#define lock_mutex_enter_nowait()				\
+	(!rw_lock_x_lock_nowait(&lock_sys->latch))
 
-/** Test if lock_sys->mutex is owned. */
-#define lock_mutex_own() mutex_own(&lock_sys->mutex)
+/** Test if lock_sys->latch is X-latched by the current thread. */
+#define lock_mutex_own()					\
+	(rw_lock_get_writer(&lock_sys->latch) == RW_LOCK_EX	\
+	 && os_thread_eq(lock_sys->latch.writer_thread,		\
+			 os_thread_get_curr_id()))
 
-/** Acquire the lock_sys->mutex. */
+/** X-latch lock_sys->latch. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys->mutex);		\
+	rw_lock_x_lock(&lock_sys->latch);	\
 } while (0)
 
-/** Release the lock_sys->mutex. */
+/** Release the X-latch on lock_sys->latch. */
 #define lock_mutex_exit() do {			\
-	mutex_exit(&lock_sys->mutex);		\
+	rw_lock_x_unlock(&lock_sys->latch);	\
 } while (0)
 
 /** Test if lock_sys->wait_mutex is owned. */
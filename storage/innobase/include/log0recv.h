@@ -392,14 +392,21 @@ struct recv_dblwr_item_t {
 };
 
 struct recv_dblwr_t {
+	recv_dblwr_t() : parallel_buf(NULL) {}
+
 	void add(byte* page, ulint space_id, ulint page_no);
 
 	byte* find_page(ulint space_id, ulint page_no);
 
 	std::list<recv_dblwr_item_t> pages; /* Pages from double write buffer */
 
+	byte*	parallel_buf;	/* Memory of the pages read from the parallel
+				doublewrite file, allocated with ut_malloc() */
+
 	void operator() () {
 		pages.clear();
+		ut_free(parallel_buf);
+		parallel_buf = NULL;
 	}
 };
 
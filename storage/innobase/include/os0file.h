@@ -1433,6 +1433,24 @@ Submit buffered AIO requests on the given segment to the kernel.
 UNIV_INTERN
 void
 os_aio_linux_dispatch_read_array_submit();
+
+# ifdef HAVE_LIBURING
+/*******************************************************************//**
+Registers memory with the io_uring instances of the read, write and
+insert buffer arrays as fixed buffers, replacing the memory registered
+before. Reads and writes whose buffer lies entirely within one of the
+regions then skip mapping the pages in the kernel for each request.
+Safe to call while i/o is in progress: waits for the fixed buffer
+requests already queued to complete before dropping the old memory.
+Does nothing unless io_uring is used. */
+UNIV_INTERN
+void
+os_aio_uring_register_buffers(
+/*==========================*/
+	const struct iovec*	regions,	/*!< in: memory regions, or
+						NULL to unregister all */
+	ulint			n_regions);	/*!< in: number of regions */
+# endif /* HAVE_LIBURING */
 #endif /* LINUX_NATIVE_AIO */
 
 int slowfileremove(const char *filename);
@@ -63,6 +63,14 @@ ssize, which is the number of shifts from 512. */
 # error "PAGE_ZIP_SSIZE_MAX >= (1 << PAGE_ZIP_SSIZE_BITS)"
 #endif
 
+/** Compression algorithms of compressed pages */
+enum page_zip_algorithm_t {
+	PAGE_ZIP_ALGORITHM_ZLIB = 0,	/*!< zlib deflate */
+	PAGE_ZIP_ALGORITHM_LZ4,		/*!< LZ4 */
+	PAGE_ZIP_ALGORITHM_ZSTD,	/*!< Zstandard */
+	PAGE_ZIP_ALGORITHM_MAX		/*!< number of algorithms */
+};
+
 /** Compressed page descriptor */
 struct page_zip_des_t
 {
@@ -135,13 +143,40 @@ struct page_zip_stat_t {
 		compressed_ok_time(0),
 		decompressed_time(0)
 	{ }
+
+	/** Add the counts of another page_zip_stat_t to these. */
+	void add(const page_zip_stat_t& other)
+	{
+		compressed += other.compressed;
+		compressed_primary += other.compressed_primary;
+		compressed_secondary += other.compressed_secondary;
+		compressed_ok += other.compressed_ok;
+		compressed_primary_ok += other.compressed_primary_ok;
+		compressed_secondary_ok += other.compressed_secondary_ok;
+		decompressed += other.decompressed;
+		decompressed_primary += other.decompressed_primary;
+		decompressed_secondary += other.decompressed_secondary;
+		compressed_time += other.compressed_time;
+		compressed_primary_time += other.compressed_primary_time;
+		compressed_secondary_time += other.compressed_secondary_time;
+		compressed_ok_time += other.compressed_ok_time;
+		compressed_primary_ok_time
+			+= other.compressed_primary_ok_time;
+		compressed_secondary_ok_time
+			+= other.compressed_secondary_ok_time;
+		decompressed_time += other.decompressed_time;
+		decompressed_primary_time += other.decompressed_primary_time;
+		decompressed_secondary_time
+			+= other.decompressed_secondary_time;
+	}
 };
 
 /** Compression statistics types */
 typedef map<index_id_t, page_zip_stat_t>	page_zip_stat_per_index_t;
 
-/** Statistics on compression, indexed by page_zip_des_t::ssize - 1 */
-extern page_zip_stat_t				page_zip_stat[PAGE_ZIP_SSIZE_MAX];
+/** Statistics on compression, indexed by page_zip_algorithm_t
+and page_zip_des_t::ssize - 1 */
+extern page_zip_stat_t	page_zip_stat[PAGE_ZIP_ALGORITHM_MAX][PAGE_ZIP_SSIZE_MAX];
 /** Statistics on compression, indexed by dict_index_t::id */
 extern page_zip_stat_per_index_t		page_zip_stat_per_index;
 extern ib_mutex_t				page_zip_stat_per_index_mutex;
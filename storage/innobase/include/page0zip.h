@@ -54,6 +54,11 @@ compression algorithm changes in zlib. */
 extern my_bool	page_zip_log_pages;
 extern my_bool page_zip_zlib_wrap;
 extern uint page_zip_zlib_strategy;
+/* Compression algorithm (page_zip_algorithm_t) of tables that are
+created or rebuilt with ROW_FORMAT=COMPRESSED. Settable by user. */
+extern ulong page_zip_algorithm;
+/* Names of the compression algorithms, indexed by page_zip_algorithm_t */
+extern const char* page_zip_algorithm_names[PAGE_ZIP_ALGORITHM_MAX + 1];
 
 #ifndef UNIV_INNOCHECKSUM
 /**********************************************************************//**
@@ -507,7 +512,8 @@ page_zip_decode_compression_flags(
 	uchar  flags,
 	uint*  level,
 	uint*  no_wrap,
-	uint*  strategy);
+	uint*  strategy,
+	uint*  algorithm);
 
 /**********************************************************************//**
 Write the compression level and other compression options into the compression
@@ -518,13 +524,17 @@ page_zip_encode_compression_flags(
 /*=============================*/
 	uint  level,
 	uint  no_wrap,
-	uint  strategy);
+	uint  strategy,
+	uint  algorithm);
 
-#define page_zip_compression_flags \
+/** Compression flags for compressing a page of an index with the current
+settings and the compression algorithm of the table of the index */
+#define page_zip_compression_flags(index) \
     page_zip_encode_compression_flags( \
     page_zip_level, \
     page_zip_zlib_wrap, \
-    page_zip_zlib_strategy)
+    page_zip_zlib_strategy, \
+    dict_table_get_zip_algorithm((index)->table))
 
 /**********************************************************************//**
 Parses a log record of compressing an index page without the data.
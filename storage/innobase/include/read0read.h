@@ -57,14 +57,22 @@ read_view_purge_open(
 	mem_heap_t*	heap);		/*!< in: memory heap from which
 					allocated */
 /*********************************************************************//**
-Remove a read view from the trx_sys->view_list. */
+Remove a read view from its partition of the read view list. */
 UNIV_INLINE
 void
 read_view_remove(
 /*=============*/
 	read_view_t*	view,		/*!< in: read view, can be 0 */
 	bool		own_mutex);	/*!< in: true if caller owns the
-					trx_sys_t::mutex */
+					mutex of the view's partition in
+					trx_sys_t::view_shards */
+/*********************************************************************//**
+Returns the number of open read views. This is a dirty read.
+@return	number of views in trx_sys_t::view_shards */
+UNIV_INTERN
+ulint
+read_view_get_n_open(void);
+/*======================*/
 /*********************************************************************//**
 Closes a consistent read view for MySQL. This function is called at an SQL
 statement end if the trx isolation level is <= TRX_ISO_READ_COMMITTED. */
@@ -158,6 +166,9 @@ struct read_view_t{
 				0 used in purge */
 	UT_LIST_NODE_T(read_view_t) view_list;
 				/*!< List of read views in trx_sys */
+	trx_view_shard_t*	shard;
+				/*!< Partition of trx_sys_t::view_shards
+				that the view is in, or NULL */
 };
 
 /** Read view types @{ */
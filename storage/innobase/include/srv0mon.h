@@ -114,6 +114,26 @@ name shall start with MONITOR_OVLD
 Please refer to "innodb_counter_info" in srv/srv0mon.cc for detail
 information for each monitor counter */
 
+/** The counters of adaptive hash index partition n. The three counters
+of a partition must be adjacent and in this order, see
+srv_mon_process_existing_counter(). */
+#define MONITOR_AHI_PART_IDS(n)				\
+	MONITOR_OVLD_ADAPTIVE_HASH_PART##n##_SEARCH,	\
+	MONITOR_OVLD_ADAPTIVE_HASH_PART##n##_MISS,	\
+	MONITOR_OVLD_ADAPTIVE_HASH_PART##n##_LATCH_WAIT
+
+/** Number of counters of each adaptive hash index partition */
+#define MONITOR_AHI_N_PART_COUNTERS	3
+
+/** The counters of page_cleaner thread n. The two counters of a thread
+must be adjacent and in this order, see srv_mon_process_existing_counter(). */
+#define MONITOR_PAGE_CLEANER_IDS(n)			\
+	MONITOR_OVLD_PAGE_CLEANER##n##_PAGES,		\
+	MONITOR_OVLD_PAGE_CLEANER##n##_LAG
+
+/** Number of counters of each page_cleaner thread */
+#define MONITOR_PAGE_CLEANER_N_COUNTERS	2
+
 enum monitor_id_t {
 	/* This is to identify the default value set by the metrics
 	control global variables */
@@ -193,6 +213,22 @@ enum monitor_id_t {
 	MONITOR_FLUSH_BACKGROUND_TOTAL_PAGE,
 	MONITOR_FLUSH_BACKGROUND_COUNT,
 	MONITOR_FLUSH_BACKGROUND_PAGES,
+	MONITOR_PAGE_CLEANER_IDS(0),
+	MONITOR_PAGE_CLEANER_IDS(1),
+	MONITOR_PAGE_CLEANER_IDS(2),
+	MONITOR_PAGE_CLEANER_IDS(3),
+	MONITOR_PAGE_CLEANER_IDS(4),
+	MONITOR_PAGE_CLEANER_IDS(5),
+	MONITOR_PAGE_CLEANER_IDS(6),
+	MONITOR_PAGE_CLEANER_IDS(7),
+	MONITOR_PAGE_CLEANER_IDS(8),
+	MONITOR_PAGE_CLEANER_IDS(9),
+	MONITOR_PAGE_CLEANER_IDS(10),
+	MONITOR_PAGE_CLEANER_IDS(11),
+	MONITOR_PAGE_CLEANER_IDS(12),
+	MONITOR_PAGE_CLEANER_IDS(13),
+	MONITOR_PAGE_CLEANER_IDS(14),
+	MONITOR_PAGE_CLEANER_IDS(15),
 	MONITOR_LRU_BATCH_SCANNED,
 	MONITOR_LRU_BATCH_SCANNED_NUM_CALL,
 	MONITOR_LRU_BATCH_SCANNED_PER_CALL,
@@ -329,6 +365,22 @@ enum monitor_id_t {
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVED,
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVE_NOT_FOUND,
 	MONITOR_ADAPTIVE_HASH_ROW_UPDATED,
+	MONITOR_AHI_PART_IDS(0),
+	MONITOR_AHI_PART_IDS(1),
+	MONITOR_AHI_PART_IDS(2),
+	MONITOR_AHI_PART_IDS(3),
+	MONITOR_AHI_PART_IDS(4),
+	MONITOR_AHI_PART_IDS(5),
+	MONITOR_AHI_PART_IDS(6),
+	MONITOR_AHI_PART_IDS(7),
+	MONITOR_AHI_PART_IDS(8),
+	MONITOR_AHI_PART_IDS(9),
+	MONITOR_AHI_PART_IDS(10),
+	MONITOR_AHI_PART_IDS(11),
+	MONITOR_AHI_PART_IDS(12),
+	MONITOR_AHI_PART_IDS(13),
+	MONITOR_AHI_PART_IDS(14),
+	MONITOR_AHI_PART_IDS(15),
 
 	/* Tablespace related counters */
 	MONITOR_MODULE_FIL_SYSTEM,
@@ -93,6 +93,15 @@ struct srv_stats_t {
 	doublewrite buffer */
 	ulint_ctr_1_t		dblwr_pages_written;
 
+	/** Number of times a batch flush had to wait for a doublewrite
+	batch of the same buffer pool instance and flush type (or of any,
+	without the parallel doublewrite file) to be written */
+	ulint_ctr_1_t		dblwr_batch_waits;
+
+	/** Number of times a single page flush had to wait for a free
+	slot in the doublewrite buffer */
+	ulint_ctr_1_t		dblwr_single_page_waits;
+
 	/** Store the number of write requests issued */
 	ulint_ctr_1_t		buf_pool_write_requests;
 
@@ -286,6 +295,9 @@ extern ibool	srv_locks_unsafe_for_binlog;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Maximum number of threads that merge sort the index entries of one
+index creation; the clustered index is scanned by one thread */
+extern ulong	srv_merge_sort_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -294,6 +306,8 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
+extern my_bool	srv_use_io_uring;
+extern my_bool	srv_io_uring_poll;
 extern my_bool	srv_numa_interleave;
 #ifdef __WIN__
 extern ibool	srv_use_native_conditions;
@@ -372,6 +386,10 @@ extern ulint	srv_buf_pool_base_size;	/*!< current size as scaling factor
 extern ulint	srv_buf_pool_curr_size;	/*!< current size in bytes */
 extern ulong	srv_buf_pool_dump_pct;	/*!< dump that may % of each buffer
 					pool during BP dump */
+extern my_bool	srv_buf_pool_dump_compressed;/*!< write the BP dump in the
+					compressed format */
+extern ulong	srv_buf_pool_dump_interval;/*!< seconds between background
+					BP dumps, 0 if disabled */
 extern ulint	srv_sync_pool_size;	/*!< requested size (number) */
 extern ulint	srv_mem_pool_size;
 extern ulint	srv_lock_table_size;
@@ -464,6 +482,7 @@ extern my_bool srv_recv_ibuf_operations;
 extern ulong	srv_use_doublewrite_buf;
 extern my_bool	srv_doublewrite_reset;
 extern ulong	srv_doublewrite_batch_size;
+extern my_bool	srv_parallel_doublewrite;
 
 extern double	srv_max_buf_pool_modified_pct;
 extern ulong	srv_max_purge_lag;
@@ -612,6 +631,9 @@ extern my_bool srv_allow_ibuf_merges;
 /* the number of purge threads to use from the worker pool (currently 0 or 1) */
 extern ulong srv_n_purge_threads;
 
+/* the number of page cleaner threads, including the coordinator */
+extern ulong srv_n_page_cleaners;
+
 /* the number of pages to purge in one batch */
 extern ulong srv_purge_batch_size;
 
@@ -664,6 +686,7 @@ extern srv_stats_t	srv_stats;
 # ifdef UNIV_PFS_THREAD
 /* Keys to register InnoDB threads with performance schema */
 extern mysql_pfs_key_t	buf_page_cleaner_thread_key;
+extern mysql_pfs_key_t	buf_page_cleaner_worker_thread_key;
 extern mysql_pfs_key_t  buf_lru_manager_thread_key;
 extern mysql_pfs_key_t	trx_rollback_clean_thread_key;
 extern mysql_pfs_key_t	io_handler_thread_key;
@@ -1089,6 +1112,8 @@ struct export_var_t{
 
 	ulint innodb_dblwr_pages_written;	/*!< srv_dblwr_pages_written */
 	ulint innodb_dblwr_writes;		/*!< srv_dblwr_writes */
+	ulint innodb_dblwr_batch_waits;		/*!< srv_dblwr_batch_waits */
+	ulint innodb_dblwr_single_page_waits;	/*!< srv_dblwr_single_page_waits */
 	ulint innodb_hash_nonsearches;		/*!< btr_cur_n_sea */
 	ulint innodb_hash_searches;		/*!< btr_cur_n_non_sea */
 	ibool innodb_have_atomic_builtins;	/*!< HAVE_ATOMIC_BUILTINS */
@@ -1395,6 +1420,8 @@ struct srv_slot_t{
 #else /* !UNIV_HOTBACKUP */
 # define srv_use_adaptive_hash_indexes		FALSE
 # define srv_use_native_aio			FALSE
+# define srv_use_io_uring			FALSE
+# define srv_io_uring_poll			FALSE
 # define srv_numa_interleave			FALSE
 # define srv_force_recovery			0UL
 # define srv_set_io_thread_op_info(t,info)	((void) 0)
@@ -185,6 +185,56 @@ UNIV_INLINE
 trx_id_t
 trx_sys_get_max_trx_id(void);
 /*========================*/
+/*****************************************************************//**
+Starts a change of the read-write transaction descriptors or of
+trx_sys->max_trx_id that must appear atomic to read view creation.
+The caller must hold trx_sys->mutex. */
+UNIV_INLINE
+void
+trx_sys_descr_write_begin(void);
+/*===========================*/
+/*****************************************************************//**
+Ends a change started with trx_sys_descr_write_begin(). */
+UNIV_INLINE
+void
+trx_sys_descr_write_end(void);
+/*=========================*/
+/*****************************************************************//**
+Makes room for one more descriptor in trx_sys->descr. Must be called
+while holding trx_sys->mutex, before trx_sys_descr_write_begin(), so that
+read views never wait for a change that is allocating memory. */
+UNIV_INTERN
+void
+trx_sys_descr_reserve(void);
+/*=======================*/
+/*****************************************************************//**
+Adds the descriptor of a read-write transaction to trx_sys->descr.
+Must be called between trx_sys_descr_write_begin() and
+trx_sys_descr_write_end(), after trx_sys_descr_reserve(). */
+UNIV_INTERN
+void
+trx_sys_descr_insert(
+/*=================*/
+	trx_id_t	id);	/*!< in: transaction id */
+/*****************************************************************//**
+Removes the descriptor of a read-write transaction from trx_sys->descr.
+Must be called between trx_sys_descr_write_begin() and
+trx_sys_descr_write_end(). */
+UNIV_INTERN
+void
+trx_sys_descr_remove(
+/*=================*/
+	trx_id_t	id);	/*!< in: transaction id */
+/*****************************************************************//**
+Stores the serialisation number of a committing read-write transaction
+in its descriptor. Must be called between trx_sys_descr_write_begin()
+and trx_sys_descr_write_end(). */
+UNIV_INTERN
+void
+trx_sys_descr_set_no(
+/*=================*/
+	trx_id_t	id,	/*!< in: transaction id */
+	trx_id_t	no);	/*!< in: transaction serialisation number */
 
 #ifdef UNIV_DEBUG
 /* Flag to control TRX_RSEG_N_SLOTS behavior debugging. */
@@ -606,6 +656,38 @@ identifier is added to this 64-bit constant. */
 /* @} */
 
 #ifndef UNIV_HOTBACKUP
+/** Descriptor of a read-write transaction, copied into read views. */
+struct trx_descr_t{
+	trx_id_t	id;		/*!< transaction id */
+	trx_id_t	no;		/*!< transaction serialisation
+					number, or TRX_ID_MAX if the
+					transaction has not started
+					committing */
+};
+
+/** Initial number of slots in trx_sys_t::descr */
+#define TRX_SYS_DESCR_INITIAL_SIZE	1024
+
+/** Maximum number of times trx_sys_t::descr can be doubled */
+#define TRX_SYS_DESCR_MAX_GROW		48
+
+/** Number of partitions of the list of read views */
+#define TRX_SYS_N_VIEW_SHARDS		32
+
+/** A partition of the list of read views. A view is created and added
+to the partition while holding its mutex. Purge holds the mutexes of
+all partitions while it looks for the oldest view, so that it cannot
+overtake a view that is being created. */
+struct trx_view_shard_t{
+	ib_mutex_t	mutex;		/*!< mutex protecting view_list */
+	UT_LIST_BASE_NODE_T(read_view_t) view_list;
+					/*!< List of read views sorted
+					on trx no, biggest first */
+	byte		pad[64];	/*!< Padding to keep the mutexes
+					of different partitions in
+					different cache lines */
+};
+
 /** The transaction system central memory data structure. */
 struct trx_sys_t{
 
@@ -666,9 +748,32 @@ struct trx_sys_t{
 					list (update undo logs for committed
 					transactions), protected by
 					rseg->mutex */
-	UT_LIST_BASE_NODE_T(read_view_t) view_list;
-					/*!< List of read views sorted
-					on trx no, biggest first */
+	trx_view_shard_t view_shards[TRX_SYS_N_VIEW_SHARDS];
+					/*!< Partitions of the list of
+					read views */
+	volatile ulint	descr_version;	/*!< Sequence number of changes to
+					descr, n_descr and max_trx_id;
+					odd while a change is in
+					progress. Read views copy descr
+					without acquiring mutex and retry
+					when this changes. Written while
+					holding mutex. */
+	trx_descr_t*	descr;		/*!< Descriptors of the transactions
+					on rw_trx_list, sorted on trx id,
+					smallest first; modified while
+					holding mutex */
+	ulint		n_descr;	/*!< Number of used slots in descr;
+					written after descr when the array
+					is reallocated */
+	ulint		descr_size;	/*!< Number of allocated slots in
+					descr */
+	trx_descr_t*	descr_old[TRX_SYS_DESCR_MAX_GROW];
+					/*!< Arrays replaced by a bigger
+					descr. A read view may still be
+					copying one of them, so they are
+					freed only at shutdown. */
+	ulint		n_descr_old;	/*!< Number of used slots in
+					descr_old */
 };
 
 /** When a trx id which is zero modulo this number (which must be a power of
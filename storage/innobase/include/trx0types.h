@@ -75,6 +75,8 @@ struct trx_t;
 struct trx_lock_t;
 /** Transaction system */
 struct trx_sys_t;
+/** Partition of the list of read views */
+struct trx_view_shard_t;
 /** Signal */
 struct trx_sig_t;
 /** Rollback segment */
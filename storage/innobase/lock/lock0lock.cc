@@ -390,11 +390,16 @@ static const ulint	lock_types = UT_ARR_SIZE(lock_compatibility_matrix);
 
 #ifdef UNIV_PFS_MUTEX
 /* Key to register mutex with performance schema */
-UNIV_INTERN mysql_pfs_key_t	lock_sys_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	lock_rec_shard_mutex_key;
 /* Key to register mutex with performance schema */
 UNIV_INTERN mysql_pfs_key_t	lock_sys_wait_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
+#ifdef UNIV_PFS_RWLOCK
+/* Key to register rw-lock with performance schema */
+UNIV_INTERN mysql_pfs_key_t	lock_sys_latch_key;
+#endif /* UNIV_PFS_RWLOCK */
+
 #ifdef UNIV_DEBUG
 UNIV_INTERN ibool	lock_print_waits	= FALSE;
 
@@ -613,7 +618,16 @@ lock_sys_create(
 
 	lock_sys->last_slot = lock_sys->waiting_threads;
 
-	mutex_create(lock_sys_mutex_key, &lock_sys->mutex, SYNC_LOCK_SYS);
+	rw_lock_create(lock_sys_latch_key, &lock_sys->latch, SYNC_LOCK_SYS);
+
+	lock_sys->rec_shards = static_cast<lock_rec_shard_t*>(
+		mem_zalloc(sizeof(*lock_sys->rec_shards) * LOCK_REC_N_SHARDS));
+
+	for (ulint i = 0; i < LOCK_REC_N_SHARDS; i++) {
+		mutex_create(lock_rec_shard_mutex_key,
+			     &lock_sys->rec_shards[i].mutex,
+			     SYNC_LOCK_REC_SHARD);
+	}
 
 	mutex_create(lock_sys_wait_mutex_key,
 		     &lock_sys->wait_mutex, SYNC_LOCK_WAIT_SYS);
@@ -669,7 +683,13 @@ lock_sys_close(void)
 
 	hash_table_free(lock_sys->rec_hash);
 
-	mutex_free(&lock_sys->mutex);
+	for (ulint i = 0; i < LOCK_REC_N_SHARDS; i++) {
+		mutex_free(&lock_sys->rec_shards[i].mutex);
+	}
+
+	mem_free(lock_sys->rec_shards);
+
+	rw_lock_free(&lock_sys->latch);
 	mutex_free(&lock_sys->wait_mutex);
 
 	mem_free(lock_stack);
@@ -679,6 +699,101 @@ lock_sys_close(void)
 	lock_stack = NULL;
 }
 
+/*********************************************************************//**
+Gets the shard of the record lock hash table that a page belongs to. The
+caller must hold lock_sys->latch, because rec_hash may be resized while
+it is X-latched.
+@return	shard */
+UNIV_INLINE
+lock_rec_shard_t*
+lock_rec_get_shard(
+/*===============*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+	/* Partition by hash cell, not by fold: the locks of a cell
+	form one chain, which only one shard may modify. */
+	return(&lock_sys->rec_shards[
+		lock_rec_hash(space, page_no) % LOCK_REC_N_SHARDS]);
+}
+
+#ifdef UNIV_DEBUG
+/*********************************************************************//**
+Checks if the current thread may access the record lock queue of a page:
+it must hold lock_sys->latch in X mode, or the mutex of the shard of the
+page.
+@return	true if the queue is protected */
+static
+bool
+lock_rec_queue_own(
+/*===============*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+	return(lock_mutex_own()
+	       || mutex_own(&lock_rec_get_shard(space, page_no)->mutex));
+}
+#endif /* UNIV_DEBUG */
+
+/*********************************************************************//**
+S-latches lock_sys->latch and acquires the mutex of the shard of a page.
+The record lock queue of the page may then be read and locks that do not
+have to wait may be added to it.
+@return	shard of the page */
+static
+lock_rec_shard_t*
+lock_rec_shard_enter(
+/*=================*/
+	const buf_block_t*	block)	/*!< in: buffer block */
+{
+	lock_rec_shard_t*	shard;
+
+	ut_ad(!lock_mutex_own());
+
+	rw_lock_s_lock(&lock_sys->latch);
+
+	shard = lock_rec_get_shard(buf_block_get_space(block),
+				   buf_block_get_page_no(block));
+
+	if (mutex_enter_nowait(&shard->mutex)) {
+		mutex_enter(&shard->mutex);
+		shard->n_waits++;
+	}
+
+	shard->n_requests++;
+
+	return(shard);
+}
+
+/*********************************************************************//**
+Releases the shard mutex and the S-latch on lock_sys->latch. */
+UNIV_INLINE
+void
+lock_rec_shard_exit(
+/*================*/
+	lock_rec_shard_t*	shard)	/*!< in: shard */
+{
+	mutex_exit(&shard->mutex);
+	rw_lock_s_unlock(&lock_sys->latch);
+}
+
+/*********************************************************************//**
+Releases the shard of a request that cannot be decided without the global
+lock state (it has to wait, or a deadlock check is needed) and X-latches
+lock_sys->latch. The caller must evaluate the request again. */
+static
+void
+lock_rec_shard_exit_to_global(
+/*==========================*/
+	lock_rec_shard_t*	shard)	/*!< in: shard */
+{
+	shard->n_global++;
+
+	lock_rec_shard_exit(shard);
+
+	lock_mutex_enter();
+}
+
 /*********************************************************************//**
 Gets the size of a lock struct.
 @return	size in bytes */
@@ -1186,7 +1301,8 @@ lock_rec_get_next_on_page_const(
 	ulint	space;
 	ulint	page_no;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(lock->un_member.rec_lock.space,
+				 lock->un_member.rec_lock.page_no));
 	ut_ad(lock_get_type_low(lock) == LOCK_REC);
 
 	space = lock->un_member.rec_lock.space;
@@ -1235,7 +1351,7 @@ lock_rec_get_first_on_page_addr(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(space, page_no));
 
 	for (lock = static_cast<lock_t*>(
 			HASH_GET_FIRST(lock_sys->rec_hash,
@@ -1287,7 +1403,7 @@ lock_rec_get_first_on_page(
 	ulint	space	= buf_block_get_space(block);
 	ulint	page_no	= buf_block_get_page_no(block);
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(space, page_no));
 
 	hash = buf_block_get_lock_hash_val(block);
 
@@ -1316,7 +1432,8 @@ lock_rec_get_next(
 	ulint	heap_no,/*!< in: heap number of the record */
 	lock_t*	lock)	/*!< in: lock */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(lock->un_member.rec_lock.space,
+				 lock->un_member.rec_lock.page_no));
 
 	do {
 		ut_ad(lock_get_type_low(lock) == LOCK_REC);
@@ -1351,7 +1468,8 @@ lock_rec_get_first(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(buf_block_get_space(block),
+				 buf_block_get_page_no(block)));
 
 	for (lock = lock_rec_get_first_on_page(block); lock;
 	     lock = lock_rec_get_next_on_page(lock)) {
@@ -1518,7 +1636,8 @@ lock_rec_has_expl(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(buf_block_get_space(block),
+				 buf_block_get_page_no(block)));
 	ut_ad((precise_mode & LOCK_MODE_MASK) == LOCK_S
 	      || (precise_mode & LOCK_MODE_MASK) == LOCK_X);
 	ut_ad(!(precise_mode & LOCK_INSERT_INTENTION));
@@ -1572,7 +1691,8 @@ lock_rec_other_has_expl_req(
 {
 	const lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(buf_block_get_space(block),
+				 buf_block_get_page_no(block)));
 	ut_ad(mode == LOCK_X || mode == LOCK_S);
 	ut_ad(gap == 0 || gap == LOCK_GAP);
 	ut_ad(wait == 0 || wait == LOCK_WAIT);
@@ -1616,7 +1736,8 @@ lock_rec_other_has_conflicting(
 	const lock_t*		lock;
 	ibool			is_supremum;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(buf_block_get_space(block),
+				 buf_block_get_page_no(block)));
 
 	is_supremum = (heap_no == PAGE_HEAP_NO_SUPREMUM);
 
@@ -1646,7 +1767,9 @@ lock_rec_find_similar_on_page(
 	lock_t*		lock,		/*!< in: lock_rec_get_first_on_page() */
 	const trx_t*	trx)		/*!< in: transaction */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(!lock
+	      || lock_rec_queue_own(lock->un_member.rec_lock.space,
+				    lock->un_member.rec_lock.page_no));
 
 	for (/* No op */;
 	     lock != NULL;
@@ -1860,7 +1983,8 @@ lock_rec_create(
 	ulint		n_bytes;
 	const page_t*	page;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(buf_block_get_space(block),
+				 buf_block_get_page_no(block)));
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1888,6 +2012,15 @@ lock_rec_create(
 	n_bits = page_dir_get_n_heap(page) + LOCK_PAGE_BITMAP_MARGIN;
 	n_bytes = 1 + n_bits / 8;
 
+	/* The lock heap and the lock list of trx are protected by
+	trx->mutex: another thread may be converting an implicit lock
+	of trx on a page of a different shard. */
+
+	if (!caller_owns_trx_mutex) {
+		trx_mutex_enter(trx);
+	}
+	ut_ad(trx_mutex_own(trx));
+
 	lock = static_cast<lock_t*>(
 		mem_heap_alloc(trx->lock.lock_heap, sizeof(lock_t) + n_bytes));
 
@@ -1908,18 +2041,15 @@ lock_rec_create(
 	/* Set the bit corresponding to rec */
 	lock_rec_set_nth_bit(lock, heap_no);
 
-	index->table->n_rec_locks++;
+	/* Record locks on different pages of the table may be created
+	concurrently in different shards. */
+	os_atomic_increment_ulint(&index->table->n_rec_locks, 1);
 
 	ut_ad(index->table->n_ref_count > 0 || !index->table->can_be_evicted);
 
 	HASH_INSERT(lock_t, hash, lock_sys->rec_hash,
 		    lock_rec_fold(space, page_no), lock);
 
-	if (!caller_owns_trx_mutex) {
-		trx_mutex_enter(trx);
-	}
-	ut_ad(trx_mutex_own(trx));
-
 	if (type_mode & LOCK_WAIT) {
 
 		lock_set_lock_and_trx_wait(lock, trx);
@@ -1937,8 +2067,8 @@ lock_rec_create(
 		trx_mutex_exit(trx);
 	}
 
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return(lock);
 }
@@ -2094,7 +2224,8 @@ lock_rec_add_to_queue(
 	lock_t*	lock;
 	lock_t*	first_lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(buf_block_get_space(block),
+				 buf_block_get_page_no(block)));
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index)
 	      || dict_index_get_online_status(index) != ONLINE_INDEX_CREATION);
@@ -2209,7 +2340,8 @@ lock_rec_lock_fast(
 	trx_t*			trx;
 	enum lock_rec_req_status status = LOCK_REC_SUCCESS;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(buf_block_get_space(block),
+				 buf_block_get_page_no(block)));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2291,7 +2423,8 @@ lock_rec_lock_slow(
 	trx_t*			trx;
 	dberr_t			err = DB_SUCCESS;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(buf_block_get_space(block),
+				 buf_block_get_page_no(block)));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2402,6 +2535,78 @@ lock_rec_lock(
 	return(DB_ERROR);
 }
 
+/*********************************************************************//**
+Tries to lock the specified record in the mode requested. The request is
+first evaluated holding lock_sys->latch in S mode and the mutex of the
+shard of the page. Only if it conflicts with a lock of another transaction
+is it evaluated again by lock_rec_lock() under the X-latch, which is needed
+for enqueueing a waiting request and for deadlock detection. This is a
+low-level function which does NOT look at implicit locks!
+@return	DB_SUCCESS, DB_SUCCESS_LOCKED_REC, DB_LOCK_WAIT, DB_DEADLOCK,
+DB_QUE_THR_SUSPENDED, DB_FAILED_TO_LOCK_REC_NOWAIT or
+DB_FAILED_TO_LOCK_REC_SKIP_LOCKED */
+static
+dberr_t
+lock_rec_lock_sharded(
+/*==================*/
+	ibool			impl,	/*!< in: if TRUE, no lock is set
+					if no wait is necessary: we
+					assume that the caller will
+					set an implicit lock */
+	ulint			mode,	/*!< in: lock mode: LOCK_X or
+					LOCK_S possibly ORed to either
+					LOCK_GAP or LOCK_REC_NOT_GAP */
+	enum x_lock_mode	x_mode,	/*!< in: mode of the x-lock:
+					LOCK_X_REGULAR, LOCK_X_NOWAIT,
+					or LOCK_X_SKIP_LOCKED, this is
+					for SELECT FOR UPDATE */
+	const buf_block_t*	block,	/*!< in: buffer block containing
+					the record */
+	ulint			heap_no,/*!< in: heap number of record */
+	dict_index_t*		index,	/*!< in: index of record */
+	que_thr_t*		thr)	/*!< in: query thread */
+{
+	lock_rec_shard_t*	shard;
+	dberr_t			err;
+
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+
+	shard = lock_rec_shard_enter(block);
+
+	switch (lock_rec_lock_fast(impl, mode, block, heap_no, index, thr)) {
+	case LOCK_REC_SUCCESS:
+		lock_rec_shard_exit(shard);
+		return(DB_SUCCESS);
+	case LOCK_REC_SUCCESS_CREATED:
+		lock_rec_shard_exit(shard);
+		return(DB_SUCCESS_LOCKED_REC);
+	case LOCK_REC_FAIL:
+		break;
+	}
+
+	/* A waiting request cannot be enqueued in the shard. Ask
+	lock_rec_lock_slow() to report the conflict instead; NOWAIT and
+	SKIP LOCKED requests can be failed right here. */
+
+	err = lock_rec_lock_slow(
+		impl, mode,
+		x_mode == LOCK_X_REGULAR ? LOCK_X_NOWAIT : x_mode,
+		block, heap_no, index, thr);
+
+	if (err != DB_FAILED_TO_LOCK_REC_NOWAIT || x_mode != LOCK_X_REGULAR) {
+		lock_rec_shard_exit(shard);
+		return(err);
+	}
+
+	lock_rec_shard_exit_to_global(shard);
+
+	err = lock_rec_lock(impl, mode, x_mode, block, heap_no, index, thr);
+
+	lock_mutex_exit();
+
+	return(err);
+}
+
 /*********************************************************************//**
 Checks if a waiting record lock request still has to wait in a queue.
 @return	lock that is causing the wait */
@@ -6121,12 +6326,13 @@ lock_rec_insert_check_and_lock(
 				LOCK_GAP type locks from the successor
 				record */
 {
-	const rec_t*	next_rec;
-	trx_t*		trx;
-	lock_t*		lock;
-	dberr_t		err;
-	ulint		next_rec_heap_no;
-	ibool		inherit_in = *inherit;
+	const rec_t*		next_rec;
+	trx_t*			trx;
+	lock_t*			lock;
+	lock_rec_shard_t*	shard;
+	dberr_t			err;
+	ulint			next_rec_heap_no;
+	ibool			inherit_in = *inherit;
 
 	ut_ad(block->frame == page_align(rec));
 	ut_ad(!dict_index_is_online_ddl(index)
@@ -6142,7 +6348,7 @@ lock_rec_insert_check_and_lock(
 	next_rec = page_rec_get_next_const(rec);
 	next_rec_heap_no = page_rec_get_heap_no(next_rec);
 
-	lock_mutex_enter();
+	shard = lock_rec_shard_enter(block);
 	/* Because this code is invoked for a running transaction by
 	the thread that is serving the transaction, it is not necessary
 	to hold trx->mutex here. */
@@ -6157,7 +6363,7 @@ lock_rec_insert_check_and_lock(
 	if (UNIV_LIKELY(lock == NULL)) {
 		/* We optimize CPU time usage in the simplest case */
 
-		lock_mutex_exit();
+		lock_rec_shard_exit(shard);
 
 		if (inherit_in && !dict_index_is_clust(index)) {
 			/* Update the page max trx id field */
@@ -6183,24 +6389,41 @@ lock_rec_insert_check_and_lock(
 	had to wait for their insert. Both had waiting gap type lock requests
 	on the successor, which produced an unnecessary deadlock. */
 
-	if (lock_rec_other_has_conflicting(
+	if (!lock_rec_other_has_conflicting(
 		    static_cast<enum lock_mode>(
 			    LOCK_X | LOCK_GAP | LOCK_INSERT_INTENTION),
 		    block, next_rec_heap_no, trx)) {
 
-		/* Note that we may get DB_SUCCESS also here! */
-		trx_mutex_enter(trx);
+		lock_rec_shard_exit(shard);
 
-		err = lock_rec_enqueue_waiting(
-			LOCK_X | LOCK_GAP | LOCK_INSERT_INTENTION,
-			block, next_rec_heap_no, index, thr);
+		err = DB_SUCCESS;
 
-		trx_mutex_exit(trx);
 	} else {
-		err = DB_SUCCESS;
-	}
+		/* Waiting requires the X-latch. Because the shard was
+		released, the queue must be checked again. */
 
-	lock_mutex_exit();
+		lock_rec_shard_exit_to_global(shard);
+
+		if (lock_rec_other_has_conflicting(
+			    static_cast<enum lock_mode>(
+				    LOCK_X | LOCK_GAP
+				    | LOCK_INSERT_INTENTION),
+			    block, next_rec_heap_no, trx)) {
+
+			/* Note that we may get DB_SUCCESS also here! */
+			trx_mutex_enter(trx);
+
+			err = lock_rec_enqueue_waiting(
+				LOCK_X | LOCK_GAP | LOCK_INSERT_INTENTION,
+				block, next_rec_heap_no, index, thr);
+
+			trx_mutex_exit(trx);
+		} else {
+			err = DB_SUCCESS;
+		}
+
+		lock_mutex_exit();
+	}
 
 	switch (err) {
 	case DB_SUCCESS_LOCKED_REC:
@@ -6277,18 +6500,19 @@ lock_rec_convert_impl_to_expl(
 	}
 
 	if (trx_id != 0) {
-		trx_t*	impl_trx;
-		ulint	heap_no = page_rec_get_heap_no(rec);
+		trx_t*			impl_trx;
+		lock_rec_shard_t*	shard;
+		ulint			heap_no = page_rec_get_heap_no(rec);
 
-		lock_mutex_enter();
+		shard = lock_rec_shard_enter(block);
 
 		/* If the transaction is still active and has no
 		explicit x-lock set on the record, set one for it */
 
 		impl_trx = trx_rw_is_active(trx_id, NULL);
 
-		/* impl_trx cannot be committed until lock_mutex_exit()
-		because lock_trx_release_locks() acquires lock_sys->mutex */
+		/* impl_trx cannot be committed until lock_rec_shard_exit()
+		because lock_trx_release_locks() X-latches lock_sys->latch */
 
 		if (impl_trx != NULL
 		    && !lock_rec_has_expl(LOCK_X | LOCK_REC_NOT_GAP, block,
@@ -6301,7 +6525,7 @@ lock_rec_convert_impl_to_expl(
 				impl_trx, FALSE);
 		}
 
-		lock_mutex_exit();
+		lock_rec_shard_exit(shard);
 	}
 }
 
@@ -6347,16 +6571,11 @@ lock_clust_rec_modify_check_and_lock(
 
 	lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 
-	lock_mutex_enter();
-
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 
-	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP, LOCK_X_REGULAR,
-			    block, heap_no, index, thr);
-
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	err = lock_rec_lock_sharded(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
+				    LOCK_X_REGULAR, block, heap_no, index,
+				    thr);
 
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
@@ -6407,16 +6626,11 @@ lock_sec_rec_modify_check_and_lock(
 	index record, and this would not have been possible if another active
 	transaction had modified this secondary index record. */
 
-	lock_mutex_enter();
-
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 
-	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP, LOCK_X_REGULAR,
-			    block, heap_no, index, thr);
-
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	err = lock_rec_lock_sharded(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
+				    LOCK_X_REGULAR, block, heap_no, index,
+				    thr);
 
 #ifdef UNIV_DEBUG
 	{
@@ -6510,19 +6724,13 @@ lock_sec_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
 	ut_ad(mode != LOCK_X
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 	ut_ad(mode != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 
-	err = lock_rec_lock(FALSE, mode | gap_mode, x_mode,
-			    block, heap_no, index, thr);
-
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	err = lock_rec_lock_sharded(FALSE, mode | gap_mode, x_mode,
+				    block, heap_no, index, thr);
 
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
@@ -6586,19 +6794,13 @@ lock_clust_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
 	ut_ad(mode != LOCK_X
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 	ut_ad(mode != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 
-	err = lock_rec_lock(FALSE, mode | gap_mode, x_mode,
-			    block, heap_no, index, thr);
-
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	err = lock_rec_lock_sharded(FALSE, mode | gap_mode, x_mode,
+				    block, heap_no, index, thr);
 
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
@@ -63,6 +63,10 @@ Created 10/21/1995 Heikki Tuuri
 
 #if defined(LINUX_NATIVE_AIO)
 #include <libaio.h>
+# ifdef HAVE_LIBURING
+#  include <liburing.h>
+#  include <algorithm>
+# endif /* HAVE_LIBURING */
 #endif
 
 /* Ignore posix_fadvise() on those platforms where it does not exist */
@@ -211,6 +215,11 @@ struct os_aio_slot_t{
 	struct iocb	control;	/* Linux control block for aio */
 	int		n_bytes;	/* bytes written/read. */
 	int		ret;		/* AIO return code */
+# ifdef HAVE_LIBURING
+	ibool		uring_fixed;	/* TRUE if the request was queued
+					on an io_uring as a fixed buffer
+					request and has not completed */
+# endif /* HAVE_LIBURING */
 #endif /* WIN_ASYNC_IO */
 };
 
@@ -271,6 +280,21 @@ struct os_aio_array_t{
 				/* Array of length n_segments. Each element
 				counts the number of not-submitted aio request
 				on that segment.*/
+# ifdef HAVE_LIBURING
+	struct io_uring*	rings;
+				/* io_uring instances used instead of
+				aio_ctx when srv_use_io_uring is set,
+				one per segment. Only the i/o thread of
+				the segment reaps its completions. */
+	os_ib_mutex_t*		ring_mutexes;
+				/* Array of length n_segments. Protects
+				the submission queue of each ring and,
+				when io_uring is used, the count of
+				buffered requests of the segment. */
+	ibool			ring_bufs;
+				/* TRUE if os_aio_uring_bufs is registered
+				with the rings of this array */
+# endif /* HAVE_LIBURING */
 #endif /* LINUX_NATIV_AIO */
 };
 
@@ -283,6 +307,27 @@ struct os_aio_array_t{
 
 /** number of attempts before giving up on io_setup(). */
 #define OS_AIO_IO_SETUP_RETRY_ATTEMPTS	5
+
+# ifdef HAVE_LIBURING
+/** Largest memory region that can be registered as one io_uring fixed
+buffer. Larger regions are split. */
+#define OS_AIO_URING_MAX_BUF_SIZE	(1UL << 30)
+
+/** Memory regions registered as fixed buffers with the io_uring
+instances, sorted by address. A request whose buffer lies entirely
+within region i is submitted with buffer index i. Changed while holding
+the mutexes of all rings, so holding any one of them is enough to read
+it. */
+static struct iovec*	os_aio_uring_bufs = NULL;
+
+/** Number of elements in os_aio_uring_bufs */
+static ulint		os_aio_uring_n_bufs = 0;
+
+/** Number of fixed buffer requests queued on the io_uring instances
+that have not completed yet. The fixed buffers must not be unregistered
+while this is nonzero. */
+static volatile ulint	os_aio_uring_n_fixed = 0;
+# endif /* HAVE_LIBURING */
 #endif
 
 /** Array of events used in simulated aio */
@@ -3999,6 +4044,379 @@ os_aio_native_aio_supported(void)
 
 	return(FALSE);
 }
+
+# ifdef HAVE_LIBURING
+/******************************************************************//**
+Creates an io_uring instance for native linux AIO.
+@return	TRUE on success. */
+static
+ibool
+os_aio_uring_create_ring(
+/*=====================*/
+	ulint			entries,	/*!< in: number of entries */
+	ibool			poll,		/*!< in: TRUE if completions
+						should be polled for */
+	struct io_uring*	ring)		/*!< out: ring to initialize */
+{
+	struct io_uring_params	params;
+	int			ret;
+
+	memset(&params, 0x0, sizeof(params));
+
+	if (poll) {
+		params.flags |= IORING_SETUP_IOPOLL;
+	}
+
+	ret = io_uring_queue_init_params(entries, ring, &params);
+
+	if (ret < 0) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"io_uring_queue_init() returned error[%d]", -ret);
+
+		return(FALSE);
+	}
+
+	/* The i/o threads wait for completions with a timeout. Without
+	IORING_FEAT_EXT_ARG liburing implements that timeout with a
+	request on the submission queue, which would race with the
+	threads submitting i/o. */
+	if (!(params.features & IORING_FEAT_EXT_ARG)) {
+		io_uring_queue_exit(ring);
+
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"io_uring on this kernel does not support waiting"
+			" for completions with a timeout.");
+
+		return(FALSE);
+	}
+
+	return(TRUE);
+}
+
+/******************************************************************//**
+Checks if the system supports io_uring for native linux aio.
+@return: TRUE if supported, FALSE otherwise. */
+static
+ibool
+os_aio_uring_supported(void)
+/*========================*/
+{
+	struct io_uring	ring;
+
+	if (!os_aio_uring_create_ring(1, FALSE, &ring)) {
+		return(FALSE);
+	}
+
+	io_uring_queue_exit(&ring);
+
+	return(TRUE);
+}
+
+/*******************************************************************//**
+Submits the requests queued on the io_uring of a segment to the kernel.
+The caller must hold the mutex of the ring.
+@return	number of requests submitted */
+static
+ulint
+os_aio_uring_submit(
+/*================*/
+	os_aio_array_t*	array,	/*!< in: io request array */
+	ulint		segment)/*!< in: segment of the array */
+{
+	ulint	total = 0;
+
+	while (io_uring_sq_ready(&array->rings[segment]) > 0) {
+		int	ret = io_uring_submit(&array->rings[segment]);
+
+		if (ret > 0) {
+			total += ret;
+		} else if (ret == -EAGAIN || ret == -EBUSY) {
+			/* The completion queue is full: let the i/o
+			handler threads reap some events. */
+			os_thread_sleep(1000);
+		} else if (ret != -EINTR) {
+			ib_logf(IB_LOG_LEVEL_FATAL,
+				"io_uring_submit() returned error[%d]", -ret);
+		}
+	}
+
+	array->count[segment] = 0;
+
+	return(total);
+}
+
+/*******************************************************************//**
+Accounts for requests submitted to the kernel. */
+static
+void
+os_aio_linux_submitted(
+/*===================*/
+	ulint	submitted)	/*!< in: number of requests submitted */
+{
+#if defined(HAVE_ATOMIC_BUILTINS) && UNIV_WORD_SIZE == 8
+	(void) os_atomic_increment_ulint(&os_aio_n_outstanding, submitted);
+#else /* !HAVE_ATOMIC_BUILTINS || UNIV_WORD == 8 */
+	os_mutex_enter(os_file_count_mutex);
+	os_aio_n_outstanding += submitted;
+	os_mutex_exit(os_file_count_mutex);
+#endif /* !HAVE_ATOMIC_BUILTINS || UNIV_WORD == 8 */
+
+#ifdef UNIV_DEBUG
+	if (os_aio_n_outstanding > os_aio_max_outstanding) {
+		os_aio_max_outstanding = os_aio_n_outstanding;
+	}
+#endif /* UNIV_DEBUG */
+	srv_stats.n_aio_submitted.add(submitted);
+}
+
+/*******************************************************************//**
+Orders io_uring fixed buffers by address.
+@return	true if a starts before b */
+static
+bool
+os_aio_uring_buf_cmp(
+/*=================*/
+	const struct iovec&	a,	/*!< in: buffer */
+	const struct iovec&	b)	/*!< in: buffer */
+{
+	return(a.iov_base < b.iov_base);
+}
+
+/*******************************************************************//**
+Finds the registered io_uring fixed buffer that contains a request
+buffer. The caller must hold the mutex of a ring.
+@return	index of the fixed buffer, or -1 if there is none */
+static
+int
+os_aio_uring_find_buf(
+/*==================*/
+	const byte*	buf,	/*!< in: buffer of the request */
+	ulint		len)	/*!< in: length of the request */
+{
+	ulint	low = 0;
+	ulint	high = os_aio_uring_n_bufs;
+
+	/* Find the first region that starts after buf. */
+	while (low < high) {
+		ulint	mid = (low + high) / 2;
+
+		if (static_cast<const byte*>(
+			    os_aio_uring_bufs[mid].iov_base) <= buf) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	if (low == 0) {
+		return(-1);
+	}
+
+	const struct iovec*	iov = &os_aio_uring_bufs[low - 1];
+
+	if (buf + len > static_cast<const byte*>(iov->iov_base)
+	    + iov->iov_len) {
+		return(-1);
+	}
+
+	return(static_cast<int>(low - 1));
+}
+
+/*******************************************************************//**
+Adjusts the number of fixed buffer requests that are queued on the
+io_uring instances and have not completed. */
+static
+void
+os_aio_uring_fixed_count(
+/*=====================*/
+	ibool	queued)	/*!< in: TRUE if a request was queued,
+			FALSE if one completed */
+{
+#if defined(HAVE_ATOMIC_BUILTINS) && UNIV_WORD_SIZE == 8
+	if (queued) {
+		(void) os_atomic_increment_ulint(&os_aio_uring_n_fixed, 1);
+	} else {
+		(void) os_atomic_decrement_ulint(&os_aio_uring_n_fixed, 1);
+	}
+#else /* !HAVE_ATOMIC_BUILTINS || UNIV_WORD == 8 */
+	os_mutex_enter(os_file_count_mutex);
+	if (queued) {
+		os_aio_uring_n_fixed++;
+	} else {
+		ut_ad(os_aio_uring_n_fixed > 0);
+		os_aio_uring_n_fixed--;
+	}
+	os_mutex_exit(os_file_count_mutex);
+#endif /* !HAVE_ATOMIC_BUILTINS || UNIV_WORD == 8 */
+}
+
+/*******************************************************************//**
+Registers memory regions as fixed buffers with the io_uring instances of
+the data file aio arrays. Requests whose buffer lies within a registered
+region are submitted as fixed buffer requests, for which the kernel does
+not need to map the pages on every request. Any earlier registration is
+dropped. May be called while data file i/o is in progress: new requests
+are submitted without fixed buffers until the fixed buffer requests
+already queued have completed and the new regions are registered.
+Does nothing unless io_uring is used. */
+UNIV_INTERN
+void
+os_aio_uring_register_buffers(
+/*==========================*/
+	const struct iovec*	regions,	/*!< in: memory regions, or
+						NULL to unregister all */
+	ulint			n_regions)	/*!< in: number of regions */
+{
+	os_aio_array_t*	arrays[3];
+	ulint		n_arrays = 0;
+	struct iovec*	bufs = NULL;
+	ulint		n_bufs = 0;
+
+	if (!srv_use_native_aio || !srv_use_io_uring) {
+		return;
+	}
+
+	if (os_aio_read_array != NULL) {
+		arrays[n_arrays++] = os_aio_read_array;
+	}
+
+	if (os_aio_write_array != NULL) {
+		arrays[n_arrays++] = os_aio_write_array;
+	}
+
+	if (os_aio_ibuf_array != NULL) {
+		arrays[n_arrays++] = os_aio_ibuf_array;
+	}
+
+	/* Split the regions at the size limit of a fixed buffer. */
+	for (ulint i = 0; i < n_regions; ++i) {
+		n_bufs += (regions[i].iov_len + OS_AIO_URING_MAX_BUF_SIZE - 1)
+			/ OS_AIO_URING_MAX_BUF_SIZE;
+	}
+
+	if (n_bufs > 0) {
+		ulint	n = 0;
+
+		bufs = static_cast<struct iovec*>(
+			ut_malloc(n_bufs * sizeof(*bufs)));
+
+		for (ulint i = 0; i < n_regions; ++i) {
+			byte*	ptr = static_cast<byte*>(regions[i].iov_base);
+			ulint	len = regions[i].iov_len;
+
+			while (len > 0) {
+				ulint	size = ut_min(
+					len, ulint(OS_AIO_URING_MAX_BUF_SIZE));
+
+				bufs[n].iov_base = ptr;
+				bufs[n].iov_len = size;
+				++n;
+
+				ptr += size;
+				len -= size;
+			}
+		}
+
+		ut_ad(n == n_bufs);
+
+		std::sort(bufs, bufs + n_bufs, os_aio_uring_buf_cmp);
+	}
+
+	/* Stop queueing fixed buffer requests and submit the ones
+	that are still buffered, so that all of them complete. */
+	for (ulint i = 0; i < n_arrays; ++i) {
+		os_aio_array_t*	array = arrays[i];
+
+		for (ulint j = 0; j < array->n_segments; ++j) {
+			ulint	submitted;
+
+			os_mutex_enter(array->ring_mutexes[j]);
+
+			array->ring_bufs = FALSE;
+			submitted = os_aio_uring_submit(array, j);
+
+			os_mutex_exit(array->ring_mutexes[j]);
+
+			if (submitted > 0) {
+				os_aio_linux_submitted(submitted);
+			}
+		}
+	}
+
+	/* The i/o handler threads reap the completions. Requests
+	queued from now on do not use the fixed buffers. */
+	while (os_aio_uring_n_fixed > 0) {
+		os_thread_sleep(1000);
+	}
+
+	for (ulint i = 0; i < n_arrays; ++i) {
+		for (ulint j = 0; j < arrays[i]->n_segments; ++j) {
+			os_mutex_enter(arrays[i]->ring_mutexes[j]);
+		}
+	}
+
+	ibool	registered = n_bufs > 0;
+
+	for (ulint i = 0; i < n_arrays; ++i) {
+		os_aio_array_t*	array = arrays[i];
+
+		for (ulint j = 0; j < array->n_segments; ++j) {
+			if (os_aio_uring_bufs != NULL) {
+				io_uring_unregister_buffers(&array->rings[j]);
+			}
+
+			if (!registered) {
+				continue;
+			}
+
+			int	ret = io_uring_register_buffers(
+				&array->rings[j], bufs,
+				static_cast<unsigned>(n_bufs));
+
+			if (ret < 0) {
+				ib_logf(IB_LOG_LEVEL_WARN,
+					"io_uring_register_buffers() returned"
+					" error[%d]; the buffer pool will"
+					" not use fixed buffers.", -ret);
+
+				/* Roll back the registrations made so far. */
+				for (ulint k = 0; k <= i; ++k) {
+					ulint	n_segs = (k == i)
+						? j : arrays[k]->n_segments;
+
+					for (ulint l = 0; l < n_segs; ++l) {
+						io_uring_unregister_buffers(
+							&arrays[k]->rings[l]);
+					}
+				}
+
+				registered = FALSE;
+			}
+		}
+	}
+
+	for (ulint i = 0; i < n_arrays; ++i) {
+		arrays[i]->ring_bufs = registered;
+	}
+
+	ut_free(os_aio_uring_bufs);
+
+	if (registered) {
+		os_aio_uring_bufs = bufs;
+		os_aio_uring_n_bufs = n_bufs;
+	} else {
+		ut_free(bufs);
+		os_aio_uring_bufs = NULL;
+		os_aio_uring_n_bufs = 0;
+	}
+
+	for (ulint i = 0; i < n_arrays; ++i) {
+		for (ulint j = 0; j < arrays[i]->n_segments; ++j) {
+			os_mutex_exit(arrays[i]->ring_mutexes[j]);
+		}
+	}
+}
+# endif /* HAVE_LIBURING */
 #endif /* LINUX_NATIVE_AIO */
 
 /******************************************************************//**
@@ -4013,7 +4431,9 @@ os_aio_array_create(
 	ulint	n,		/*!< in: maximum number of pending aio
 				operations allowed; n must be
 				divisible by n_segments */
-	ulint	n_segments)	/*!< in: number of segments in the aio array */
+	ulint	n_segments,	/*!< in: number of segments in the aio array */
+	ibool	poll)		/*!< in: TRUE if io_uring should poll for
+				completions of this array */
 {
 	os_aio_array_t*	array;
 #ifdef WIN_ASYNC_IO
@@ -4047,6 +4467,11 @@ os_aio_array_create(
 #if defined(LINUX_NATIVE_AIO)
 	array->aio_ctx = NULL;
 	array->aio_events = NULL;
+# ifdef HAVE_LIBURING
+	array->rings = NULL;
+	array->ring_mutexes = NULL;
+	array->ring_bufs = FALSE;
+# endif /* HAVE_LIBURING */
 
 	/* If we are not using native aio interface then skip this
 	part of initialization. */
@@ -4054,6 +4479,30 @@ os_aio_array_create(
 		goto skip_native_aio;
 	}
 
+# ifdef HAVE_LIBURING
+	if (srv_use_io_uring) {
+		/* Initialize one io_uring instance per segment in the
+		array instead of the io_context array. Each has room for
+		all requests of its segment. */
+
+		array->rings = static_cast<struct io_uring*>(
+			ut_malloc(n_segments * sizeof(*array->rings)));
+		array->ring_mutexes = static_cast<os_ib_mutex_t*>(
+			ut_malloc(n_segments * sizeof(*array->ring_mutexes)));
+
+		for (ulint i = 0; i < n_segments; ++i) {
+			if (!os_aio_uring_create_ring(n/n_segments, poll,
+						      &array->rings[i])) {
+				return(NULL);
+			}
+
+			array->ring_mutexes[i] = os_mutex_create();
+		}
+
+		goto init_pending;
+	}
+# endif /* HAVE_LIBURING */
+
 	/* Initialize the io_context array. One io_context
 	per segment in the array. */
 
@@ -4080,6 +4529,9 @@ os_aio_array_create(
 	memset(io_event, 0x0, sizeof(*io_event) * n);
 	array->aio_events = io_event;
 
+# ifdef HAVE_LIBURING
+init_pending:
+# endif /* HAVE_LIBURING */
 	array->pending = static_cast<struct iocb**>(
 		ut_malloc(n * sizeof(struct iocb*)));
 	memset(array->pending, 0x0, sizeof(struct iocb*) * n);
@@ -4138,6 +4590,17 @@ os_aio_array_free(
 
 #if defined(LINUX_NATIVE_AIO)
 	if (srv_use_native_aio) {
+# ifdef HAVE_LIBURING
+		if (srv_use_io_uring) {
+			for (ulint i = 0; i < array->n_segments; ++i) {
+				io_uring_queue_exit(&array->rings[i]);
+				os_mutex_free(array->ring_mutexes[i]);
+			}
+
+			ut_free(array->rings);
+			ut_free(array->ring_mutexes);
+		}
+# endif /* HAVE_LIBURING */
 		ut_free(array->aio_events);
 		ut_free(array->aio_ctx);
 		ut_free(array->pending);
@@ -4181,6 +4644,48 @@ os_aio_init(
 	}
 #endif /* LINUX_NATIVE_AIO */
 
+#if defined(LINUX_NATIVE_AIO) && defined(HAVE_LIBURING)
+	if (!srv_use_native_aio) {
+		srv_use_io_uring = FALSE;
+	} else if (srv_use_io_uring && !os_aio_uring_supported()) {
+
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"io_uring disabled, using libaio for Linux native"
+			" AIO.");
+
+		srv_use_io_uring = FALSE;
+	}
+
+	if (srv_use_io_uring) {
+		ib_logf(IB_LOG_LEVEL_INFO, "Using io_uring for Linux native"
+			" AIO.");
+	}
+#else
+	if (srv_use_io_uring) {
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"io_uring is not supported by this build of InnoDB;"
+			" ignoring innodb_use_io_uring.");
+
+		srv_use_io_uring = FALSE;
+	}
+#endif /* LINUX_NATIVE_AIO && HAVE_LIBURING */
+
+	/* Polled i/o only works with files opened with O_DIRECT. */
+	if (srv_io_uring_poll
+	    && (!srv_use_io_uring
+		|| (srv_unix_file_flush_method != SRV_UNIX_O_DIRECT
+		    && srv_unix_file_flush_method != SRV_UNIX_ALL_O_DIRECT
+		    && srv_unix_file_flush_method
+		    != SRV_UNIX_O_DIRECT_NO_FSYNC))) {
+
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"innodb_io_uring_poll requires io_uring and"
+			" innodb_flush_method=O_DIRECT, ALL_O_DIRECT or"
+			" O_DIRECT_NO_FSYNC; ignoring it.");
+
+		srv_io_uring_poll = FALSE;
+	}
+
 	srv_reset_io_thread_op_info();
 	for (ulint i = 0; i < (2 + n_read_segs + n_write_segs); i++) {
 		os_aio_perf[i].init();
@@ -4214,8 +4719,11 @@ os_aio_init(
 	os_sync_read_perf.init();
 	os_sync_write_perf.init();
 
+	/* In read-only mode the read array also serves the log files,
+	which are not opened with O_DIRECT. */
 	os_aio_read_array = os_aio_array_create(
-		n_read_segs * n_per_seg, n_read_segs);
+		n_read_segs * n_per_seg, n_read_segs,
+		srv_io_uring_poll && !srv_read_only_mode);
 
 	if (os_aio_read_array == NULL) {
 		return(FALSE);
@@ -4234,7 +4742,7 @@ os_aio_init(
 
 	if (!srv_read_only_mode) {
 
-		os_aio_log_array = os_aio_array_create(n_per_seg, 1);
+		os_aio_log_array = os_aio_array_create(n_per_seg, 1, FALSE);
 
 		if (os_aio_log_array == NULL) {
 			return(FALSE);
@@ -4244,7 +4752,7 @@ os_aio_init(
 
 		srv_io_thread_function[1] = "log thread";
 
-		os_aio_ibuf_array = os_aio_array_create(n_per_seg, 1);
+		os_aio_ibuf_array = os_aio_array_create(n_per_seg, 1, FALSE);
 
 		os_log_write_perf.init();
 		os_double_write_perf.init();
@@ -4258,7 +4766,8 @@ os_aio_init(
 		srv_io_thread_function[0] = "insert buffer thread";
 
 		os_aio_write_array = os_aio_array_create(
-			n_write_segs * n_per_seg, n_write_segs);
+			n_write_segs * n_per_seg, n_write_segs,
+			srv_io_uring_poll);
 
 		if (os_aio_write_array == NULL) {
 			return(FALSE);
@@ -4276,7 +4785,7 @@ os_aio_init(
 		ut_ad(n_segments > 0);
 	}
 
-	os_aio_sync_array = os_aio_array_create(n_slots_sync, 1);
+	os_aio_sync_array = os_aio_array_create(n_slots_sync, 1, FALSE);
 
 	if (os_aio_sync_array == NULL) {
 		return(FALSE);
@@ -4326,6 +4835,12 @@ os_aio_free(void)
 
 	os_aio_array_free(os_aio_read_array);
 
+#if defined(LINUX_NATIVE_AIO) && defined(HAVE_LIBURING)
+	ut_free(os_aio_uring_bufs);
+	os_aio_uring_bufs = NULL;
+	os_aio_uring_n_bufs = 0;
+#endif /* LINUX_NATIVE_AIO && HAVE_LIBURING */
+
 	for (ulint i = 0; i < os_aio_n_segments; i++) {
 		os_event_free(os_aio_segment_wait_events[i]);
 #ifdef UNIV_DEBUG_VALGRIND
@@ -4831,6 +5346,21 @@ os_aio_linux_dispatch_read_array_submit()
 			os_aio_batch_submission_blocked = TRUE;
 			os_event_wait(os_aio_outstanding_requests_wait_event);
 		}
+# ifdef HAVE_LIBURING
+		if (srv_use_io_uring) {
+			/* The requests were queued on the submission
+			queue of the ring by os_aio_uring_dispatch(). */
+			os_mutex_enter(array->ring_mutexes[i]);
+			submitted = os_aio_uring_submit(array, i);
+			os_mutex_exit(array->ring_mutexes[i]);
+
+			if (submitted > 0) {
+				total_submitted += submitted;
+				os_aio_linux_submitted(submitted);
+			}
+			continue;
+		}
+# endif /* HAVE_LIBURING */
 		os_mutex_enter(array->mutex);
 		count = array->count[i];
 		/* If current segment is empty, continue. */
@@ -4878,6 +5408,95 @@ os_aio_linux_dispatch_read_array_submit()
 	}
 }
 
+# ifdef HAVE_LIBURING
+/*******************************************************************//**
+Queues an AIO request on the io_uring of its segment and submits it
+unless it should be buffered.
+@return	TRUE on success. */
+static
+ibool
+os_aio_uring_dispatch(
+/*==================*/
+	os_aio_array_t*	array,	/*!< in: io request array. */
+	os_aio_slot_t*	slot,	/*!< in: an already reserved slot. */
+	ibool		should_buffer)	/*!< in: should buffer the request
+					rather than submit. */
+{
+	ulint			slots_per_segment;
+	ulint			segment;
+	ulint			submitted = 0;
+	struct io_uring_sqe*	sqe;
+	int			buf_index;
+
+	slots_per_segment = array->n_slots / array->n_segments;
+	segment = slot->pos / slots_per_segment;
+
+	os_mutex_enter(array->ring_mutexes[segment]);
+
+	/* The ring has as many entries as the segment has slots, and
+	every slot has at most one request in flight. */
+	sqe = io_uring_get_sqe(&array->rings[segment]);
+	ut_a(sqe != NULL);
+
+	/* Buffer pool pages are registered with the rings, which saves
+	the kernel from mapping them for every request. */
+	buf_index = array->ring_bufs
+		? os_aio_uring_find_buf(slot->buf, slot->len) : -1;
+
+	if (slot->type == OS_FILE_READ) {
+		if (buf_index >= 0) {
+			io_uring_prep_read_fixed(
+				sqe, slot->file, slot->buf, slot->len,
+				slot->offset, buf_index);
+		} else {
+			io_uring_prep_read(sqe, slot->file, slot->buf,
+					   slot->len, slot->offset);
+		}
+	} else {
+		ut_a(slot->type == OS_FILE_WRITE);
+
+		if (buf_index >= 0) {
+			io_uring_prep_write_fixed(
+				sqe, slot->file, slot->buf, slot->len,
+				slot->offset, buf_index);
+		} else {
+			io_uring_prep_write(sqe, slot->file, slot->buf,
+					    slot->len, slot->offset);
+		}
+	}
+
+	slot->uring_fixed = buf_index >= 0;
+
+	if (slot->uring_fixed) {
+		os_aio_uring_fixed_count(TRUE);
+	}
+
+	io_uring_sqe_set_data(sqe, slot);
+
+	if (should_buffer && array == os_aio_read_array) {
+		ulint	count = ++array->count[segment];
+
+		os_mutex_exit(array->ring_mutexes[segment]);
+
+		if (count == slots_per_segment) {
+			os_aio_linux_dispatch_read_array_submit();
+		}
+
+		return(TRUE);
+	}
+
+	submitted = os_aio_uring_submit(array, segment);
+
+	os_mutex_exit(array->ring_mutexes[segment]);
+
+	if (submitted > 0) {
+		os_aio_linux_submitted(submitted);
+	}
+
+	return(TRUE);
+}
+# endif /* HAVE_LIBURING */
+
 /*******************************************************************//**
 Dispatch an AIO request to the kernel.
 @return	TRUE on success. */
@@ -4899,6 +5518,12 @@ os_aio_linux_dispatch(
 	ut_ad(array);
 	ut_a(slot->reserved);
 
+# ifdef HAVE_LIBURING
+	if (srv_use_io_uring) {
+		return(os_aio_uring_dispatch(array, slot, should_buffer));
+	}
+# endif /* HAVE_LIBURING */
+
 	/* Find out what we are going to work with.
 	The iocb struct is directly in the slot.
 	The io_context is one per segment. */
@@ -5479,6 +6104,103 @@ os_aio_windows_handle(
 #endif
 
 #if defined(LINUX_NATIVE_AIO)
+# ifdef HAVE_LIBURING
+/******************************************************************//**
+The io_uring counterpart of os_aio_linux_collect(): waits with a timeout
+for completions on the ring of a segment and marks the slots of the
+completed requests as done. */
+static
+void
+os_aio_uring_collect(
+/*=================*/
+	os_aio_array_t* array,		/*!< in/out: slot array. */
+	ulint		segment,	/*!< in: local segment no. */
+	ulint		seg_size)	/*!< in: segment size. */
+{
+	int			ret;
+	ulint			start_pos;
+	ulint			end_pos;
+	struct io_uring*	ring;
+	struct io_uring_cqe*	cqe;
+	struct __kernel_timespec timeout;
+
+	ut_ad(array != NULL);
+	ut_ad(seg_size > 0);
+	ut_ad(segment < array->n_segments);
+
+	ring = &array->rings[segment];
+
+	start_pos = segment * seg_size;
+	end_pos = start_pos + seg_size;
+
+retry:
+	timeout.tv_sec = 0;
+	timeout.tv_nsec = OS_AIO_REAP_TIMEOUT;
+
+	/* With IORING_FEAT_EXT_ARG this does not touch the submission
+	queue, so it needs no ring mutex. Only this thread reaps the
+	completion queue of the segment. */
+	ret = io_uring_wait_cqe_timeout(ring, &cqe, &timeout);
+
+	if (ret == 0) {
+		unsigned	head;
+		unsigned	n = 0;
+
+		os_mutex_enter(array->mutex);
+
+		io_uring_for_each_cqe(ring, head, cqe) {
+			os_aio_slot_t*	slot = static_cast<os_aio_slot_t*>(
+				io_uring_cqe_get_data(cqe));
+
+			/* Some sanity checks. */
+			ut_a(slot != NULL);
+			ut_a(slot->reserved);
+			ut_a(slot->pos >= start_pos);
+			ut_a(slot->pos < end_pos);
+
+			/* Mark this request as completed. The error handling
+			will be done in the calling function. */
+			if (cqe->res >= 0) {
+				slot->n_bytes = cqe->res;
+				slot->ret = 0;
+			} else {
+				slot->n_bytes = 0;
+				slot->ret = cqe->res;
+			}
+
+			if (slot->uring_fixed) {
+				slot->uring_fixed = FALSE;
+				os_aio_uring_fixed_count(FALSE);
+			}
+
+			slot->io_already_done = TRUE;
+			++n;
+		}
+
+		os_mutex_exit(array->mutex);
+
+		io_uring_cq_advance(ring, n);
+		return;
+	}
+
+	if (UNIV_UNLIKELY(srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS)) {
+		return;
+	}
+
+	switch (ret) {
+	case -ETIME:
+		/* Timed out. */
+	case -EAGAIN:
+	case -EINTR:
+		goto retry;
+	}
+
+	ib_logf(IB_LOG_LEVEL_FATAL,
+		"unexpected ret_code[%d] from io_uring_wait_cqe_timeout()",
+		ret);
+}
+# endif /* HAVE_LIBURING */
+
 /******************************************************************//**
 This function is only used in Linux native asynchronous i/o. This is
 called from within the io-thread. If there are no completed IO requests
@@ -5506,6 +6228,13 @@ os_aio_linux_collect(
 	struct io_event*	events;
 	struct io_context*	io_ctx;
 
+# ifdef HAVE_LIBURING
+	if (srv_use_io_uring) {
+		os_aio_uring_collect(array, segment, seg_size);
+		return;
+	}
+# endif /* HAVE_LIBURING */
+
 	/* sanity checks. */
 	ut_ad(array != NULL);
 	ut_ad(seg_size > 0);
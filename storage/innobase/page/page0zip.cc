@@ -56,6 +56,8 @@ using namespace std;
 # include "lock0lock.h"
 # include "srv0srv.h"
 # include "zlib_embedded/zlib.h"
+# include <lz4.h>
+# include <zstd.h>
 #endif /* !UNIV_INNOCHECKSUM */
 # include "buf0lru.h"
 # include "srv0mon.h"
@@ -73,8 +75,10 @@ using namespace std;
 
 #ifndef UNIV_HOTBACKUP
 #ifndef UNIV_INNOCHECKSUM
-/** Statistics on compression, indexed by page_zip_des_t::ssize - 1 */
-UNIV_INTERN page_zip_stat_t		page_zip_stat[PAGE_ZIP_SSIZE_MAX];
+/** Statistics on compression, indexed by page_zip_algorithm_t
+and page_zip_des_t::ssize - 1 */
+UNIV_INTERN page_zip_stat_t
+	page_zip_stat[PAGE_ZIP_ALGORITHM_MAX][PAGE_ZIP_SSIZE_MAX];
 /** Statistics on compression, indexed by index->id */
 UNIV_INTERN page_zip_stat_per_index_t	page_zip_stat_per_index;
 /** Mutex protecting page_zip_stat_per_index */
@@ -776,6 +780,366 @@ page_zip_set_alloc(
 	strm->opaque = heap;
 }
 
+/** First byte of a compressed page stream that was compressed with LZ4.
+Neither this nor PAGE_ZIP_ZSTD_MARKER is a valid start of a zlib stream,
+whose compression method in the low 4 bits is always 8, or of a raw deflate
+stream, whose block type in bits 1 and 2 is never 3. */
+#define PAGE_ZIP_LZ4_MARKER	0x06
+/** First byte of a compressed page stream that was compressed with zstd */
+#define PAGE_ZIP_ZSTD_MARKER	0x0E
+/** Size of the header of an LZ4 or zstd page stream: the marker, the
+length of the compressed data and the length of the first block */
+#define PAGE_ZIP_STREAM_HEADER	5
+
+/** Compressed page stream. zlib streams are passed to zlib as is.
+LZ4 and zstd compress a page in one call, so that the input of
+page_zip_deflate() is collected in buf and compressed at Z_FINISH,
+and the first page_zip_inflate() decompresses the whole stream into
+buf, from where it is returned like inflate() would. */
+struct page_zip_stream_t : public z_stream {
+	ulint		algorithm;	/*!< page_zip_algorithm_t */
+	int		level;		/*!< compression level */
+	byte*		buf;		/*!< uncompressed stream of LZ4
+					or zstd */
+	ulint		buf_size;	/*!< size of buf */
+	ulint		buf_len;	/*!< length of the stream in buf, or
+					ULINT_UNDEFINED if not decompressed
+					yet */
+	ulint		buf_pos;	/*!< bytes of buf returned by
+					page_zip_inflate() */
+	ulint		block_len;	/*!< length of the first block, which
+					ends at Z_FULL_FLUSH */
+};
+
+/**********************************************************************//**
+Determine the compression algorithm of a compressed page stream.
+@return	page_zip_algorithm_t */
+static
+ulint
+page_zip_stream_get_algorithm(
+/*==========================*/
+	const byte*	data)	/*!< in: start of the compressed stream */
+{
+	switch (*data) {
+	case PAGE_ZIP_LZ4_MARKER:
+		return(PAGE_ZIP_ALGORITHM_LZ4);
+	case PAGE_ZIP_ZSTD_MARKER:
+		return(PAGE_ZIP_ALGORITHM_ZSTD);
+	}
+
+	return(PAGE_ZIP_ALGORITHM_ZLIB);
+}
+
+/**********************************************************************//**
+Initialize a compressed page stream for page_zip_deflate().
+@return	Z_OK, or a zlib error code */
+static
+int
+page_zip_deflate_init(
+/*==================*/
+	page_zip_stream_t*	strm,		/*!< out: compressed stream */
+	ulint			algorithm,	/*!< in: page_zip_algorithm_t */
+	int			level,		/*!< in: compression level */
+	int			window_bits,	/*!< in: zlib window bits */
+	int			strategy,	/*!< in: zlib strategy */
+	mem_heap_t*		heap)		/*!< in: memory heap to use */
+{
+	page_zip_set_alloc(static_cast<z_stream*>(strm), heap);
+
+	strm->algorithm = algorithm;
+	strm->level = level;
+
+	if (algorithm == PAGE_ZIP_ALGORITHM_ZLIB) {
+		return(deflateInit2(strm, level, Z_DEFLATED, window_bits,
+				    MAX_MEM_LEVEL, strategy));
+	}
+
+	/* The stream holds the index field information and the
+	records of the page, which are less than a page each. */
+	strm->buf_size = 2 * UNIV_PAGE_SIZE;
+	strm->buf = static_cast<byte*>(mem_heap_alloc(heap, strm->buf_size));
+	strm->buf_len = 0;
+	strm->buf_pos = 0;
+	strm->block_len = 0;
+	strm->total_in = 0;
+	strm->total_out = 0;
+	strm->msg = NULL;
+
+	return(Z_OK);
+}
+
+/**********************************************************************//**
+Compress the stream that was collected by page_zip_deflate() with LZ4
+or zstd into next_out.
+@return	Z_STREAM_END, or Z_BUF_ERROR if it does not fit in avail_out */
+static
+int
+page_zip_deflate_finish(
+/*====================*/
+	page_zip_stream_t*	strm)	/*!< in/out: compressed stream */
+{
+	byte*	out = strm->next_out + PAGE_ZIP_STREAM_HEADER;
+	ulint	out_size;
+	ulint	len;
+
+	if (strm->avail_out <= PAGE_ZIP_STREAM_HEADER) {
+		return(Z_BUF_ERROR);
+	}
+
+	out_size = strm->avail_out - PAGE_ZIP_STREAM_HEADER;
+
+	if (strm->algorithm == PAGE_ZIP_ALGORITHM_LZ4) {
+		void*	state = mem_heap_alloc(
+			static_cast<mem_heap_t*>(strm->opaque),
+			LZ4_sizeofState());
+		int	n = LZ4_compress_fast_extState(
+			state, reinterpret_cast<const char*>(strm->buf),
+			reinterpret_cast<char*>(out),
+			static_cast<int>(strm->buf_len),
+			static_cast<int>(out_size), 1);
+
+		if (n <= 0) {
+			return(Z_BUF_ERROR);
+		}
+
+		len = n;
+		*strm->next_out = PAGE_ZIP_LZ4_MARKER;
+	} else {
+		/* Place the context in the heap, like the LZ4 state,
+		instead of allocating and freeing one for every page.
+		Sized for the length of the stream, the context is much
+		smaller than one for an unknown source size. */
+		size_t		cctx_size = ZSTD_estimateCCtxSize_usingCParams(
+			ZSTD_getCParams(strm->level, strm->buf_len, 0));
+		ZSTD_CCtx*	cctx = ZSTD_initStaticCCtx(
+			mem_heap_alloc(static_cast<mem_heap_t*>(strm->opaque),
+				       cctx_size),
+			cctx_size);
+
+		if (cctx == NULL) {
+			return(Z_MEM_ERROR);
+		}
+
+		len = ZSTD_compressCCtx(cctx, out, out_size,
+					strm->buf, strm->buf_len,
+					strm->level);
+
+		if (ZSTD_isError(len)) {
+			return(Z_BUF_ERROR);
+		}
+
+		*strm->next_out = PAGE_ZIP_ZSTD_MARKER;
+	}
+
+	mach_write_to_2(strm->next_out + 1, len);
+	mach_write_to_2(strm->next_out + 3, strm->block_len);
+
+	len += PAGE_ZIP_STREAM_HEADER;
+	strm->next_out += len;
+	strm->avail_out -= static_cast<uInt>(len);
+	strm->total_out += len;
+
+	return(Z_STREAM_END);
+}
+
+/**********************************************************************//**
+Compress data like deflate(). LZ4 and zstd streams only collect the
+data, and compress it at Z_FINISH.
+@return	deflate() status: Z_OK, Z_STREAM_END, Z_BUF_ERROR, ... */
+static
+int
+page_zip_deflate(
+/*=============*/
+	page_zip_stream_t*	strm,	/*!< in/out: compressed stream */
+	int			flush)	/*!< in: deflate() flushing method */
+{
+	if (strm->algorithm == PAGE_ZIP_ALGORITHM_ZLIB) {
+		return(deflate(strm, flush));
+	}
+
+	if (strm->avail_in > strm->buf_size - strm->buf_len) {
+		return(Z_BUF_ERROR);
+	}
+
+	memcpy(strm->buf + strm->buf_len, strm->next_in, strm->avail_in);
+	strm->buf_len += strm->avail_in;
+	strm->total_in += strm->avail_in;
+	strm->next_in += strm->avail_in;
+	strm->avail_in = 0;
+
+	switch (flush) {
+	case Z_FULL_FLUSH:
+		strm->block_len = strm->buf_len;
+		break;
+	case Z_FINISH:
+		return(page_zip_deflate_finish(strm));
+	}
+
+	return(Z_OK);
+}
+
+/**********************************************************************//**
+Free a compressed page stream that was initialized by
+page_zip_deflate_init().
+@return	deflateEnd() status */
+static
+int
+page_zip_deflate_end(
+/*=================*/
+	page_zip_stream_t*	strm)	/*!< in/out: compressed stream */
+{
+	if (strm->algorithm == PAGE_ZIP_ALGORITHM_ZLIB) {
+		return(deflateEnd(strm));
+	}
+
+	return(Z_OK);
+}
+
+/**********************************************************************//**
+Decompress the whole LZ4 or zstd stream at next_in into buf.
+@return	Z_OK, or Z_DATA_ERROR if the stream is corrupted */
+static
+int
+page_zip_inflate_all(
+/*=================*/
+	page_zip_stream_t*	strm)	/*!< in/out: compressed stream */
+{
+	ulint	len;
+	ulint	n;
+
+	if (strm->avail_in <= PAGE_ZIP_STREAM_HEADER) {
+		goto corrupt;
+	}
+
+	len = mach_read_from_2(strm->next_in + 1);
+	strm->block_len = mach_read_from_2(strm->next_in + 3);
+
+	if (len > strm->avail_in - PAGE_ZIP_STREAM_HEADER) {
+		goto corrupt;
+	}
+
+	if (strm->algorithm == PAGE_ZIP_ALGORITHM_LZ4) {
+		int	ret = LZ4_decompress_safe(
+			reinterpret_cast<const char*>(strm->next_in
+						      + PAGE_ZIP_STREAM_HEADER),
+			reinterpret_cast<char*>(strm->buf),
+			static_cast<int>(len),
+			static_cast<int>(strm->buf_size));
+
+		if (ret < 0) {
+			goto corrupt;
+		}
+
+		n = ret;
+	} else {
+		size_t		dctx_size = ZSTD_estimateDCtxSize();
+		ZSTD_DCtx*	dctx = ZSTD_initStaticDCtx(
+			mem_heap_alloc(static_cast<mem_heap_t*>(strm->opaque),
+				       dctx_size),
+			dctx_size);
+
+		if (dctx == NULL) {
+			strm->msg = const_cast<char*>("out of memory");
+			return(Z_MEM_ERROR);
+		}
+
+		n = ZSTD_decompressDCtx(dctx, strm->buf, strm->buf_size,
+					strm->next_in
+					+ PAGE_ZIP_STREAM_HEADER, len);
+
+		if (ZSTD_isError(n)) {
+			goto corrupt;
+		}
+	}
+
+	if (strm->block_len > n) {
+corrupt:
+		strm->msg = const_cast<char*>("corrupted page stream");
+		return(Z_DATA_ERROR);
+	}
+
+	len += PAGE_ZIP_STREAM_HEADER;
+	strm->next_in += len;
+	strm->avail_in -= static_cast<uInt>(len);
+	strm->total_in += len;
+	strm->buf_len = n;
+
+	return(Z_OK);
+}
+
+/**********************************************************************//**
+Decompress data like inflate(). LZ4 and zstd streams are decompressed
+at the first call, and returned from buf like inflate() would return
+them: Z_BLOCK stops at the end of the first block, and Z_STREAM_END is
+returned once all of the data has been returned.
+@return	inflate() status: Z_OK, Z_STREAM_END, Z_BUF_ERROR, ... */
+static
+int
+page_zip_inflate(
+/*=============*/
+	page_zip_stream_t*	strm,	/*!< in/out: compressed stream */
+	int			flush)	/*!< in: inflate() flushing method */
+{
+	ulint	len;
+
+	if (strm->algorithm == PAGE_ZIP_ALGORITHM_ZLIB) {
+		return(inflate(strm, flush));
+	}
+
+	if (strm->buf_len == ULINT_UNDEFINED) {
+		int	err = page_zip_inflate_all(strm);
+
+		if (err != Z_OK) {
+			return(err);
+		}
+	}
+
+	if (flush == Z_BLOCK && strm->buf_pos <= strm->block_len) {
+		len = ut_min(strm->block_len - strm->buf_pos,
+			     static_cast<ulint>(strm->avail_out));
+		memcpy(strm->next_out, strm->buf + strm->buf_pos, len);
+		strm->next_out += len;
+		strm->avail_out -= static_cast<uInt>(len);
+		strm->total_out += len;
+		strm->buf_pos += len;
+
+		return(strm->buf_pos == strm->block_len ? Z_OK : Z_BUF_ERROR);
+	}
+
+	len = ut_min(strm->buf_len - strm->buf_pos,
+		     static_cast<ulint>(strm->avail_out));
+	memcpy(strm->next_out, strm->buf + strm->buf_pos, len);
+	strm->next_out += len;
+	strm->avail_out -= static_cast<uInt>(len);
+	strm->total_out += len;
+	strm->buf_pos += len;
+
+	if (strm->buf_pos == strm->buf_len) {
+		return(Z_STREAM_END);
+	} else if (flush == Z_FINISH || !len) {
+		return(Z_BUF_ERROR);
+	}
+
+	return(Z_OK);
+}
+
+/**********************************************************************//**
+Free a compressed page stream that was initialized by
+page_zip_init_d_stream().
+@return	inflateEnd() status */
+static
+int
+page_zip_inflate_end(
+/*=================*/
+	page_zip_stream_t*	strm)	/*!< in/out: compressed stream */
+{
+	if (strm->algorithm == PAGE_ZIP_ALGORITHM_ZLIB) {
+		return(inflateEnd(strm));
+	}
+
+	return(Z_OK);
+}
+
 #if 0 || defined UNIV_DEBUG || defined UNIV_ZIP_DEBUG
 /** Symbol for enabling compression and decompression diagnostics */
 # define PAGE_ZIP_COMPRESS_DBG
@@ -792,15 +1156,16 @@ as a log file name generator. */
 UNIV_INTERN unsigned	page_zip_compress_log;
 
 /**********************************************************************//**
-Wrapper for deflate().  Log the operation if page_zip_compress_dbg is set.
+Wrapper for page_zip_deflate().  Log the operation if page_zip_compress_dbg
+is set.
 @return	deflate() status: Z_OK, Z_BUF_ERROR, ... */
 static
 int
 page_zip_compress_deflate(
 /*======================*/
-	FILE*		logfile,/*!< in: log file, or NULL */
-	z_streamp	strm,	/*!< in/out: compressed stream for deflate() */
-	int		flush)	/*!< in: deflate() flushing method */
+	FILE*			logfile,/*!< in: log file, or NULL */
+	page_zip_stream_t*	strm,	/*!< in/out: compressed stream */
+	int			flush)	/*!< in: deflate() flushing method */
 {
 	int	status;
 	if (UNIV_UNLIKELY(page_zip_compress_dbg)) {
@@ -809,21 +1174,21 @@ page_zip_compress_deflate(
 	if (UNIV_LIKELY_NULL(logfile)) {
 		blind_fwrite(strm->next_in, 1, strm->avail_in, logfile);
 	}
-	status = deflate(strm, flush);
+	status = page_zip_deflate(strm, flush);
 	if (UNIV_UNLIKELY(page_zip_compress_dbg)) {
 		fprintf(stderr, " -> %d\n", status);
 	}
 	return(status);
 }
 
-/* Redefine deflate(). */
-# undef deflate
-/** Debug wrapper for the zlib compression routine deflate().
+/* Redefine page_zip_deflate(). */
+/** Debug wrapper for the compression routine page_zip_deflate().
 Log the operation if page_zip_compress_dbg is set.
 @param strm	in/out: compressed stream
 @param flush	in: flushing method
 @return		deflate() status: Z_OK, Z_BUF_ERROR, ... */
-# define deflate(strm, flush) page_zip_compress_deflate(logfile, strm, flush)
+# define page_zip_deflate(strm, flush)			\
+	page_zip_compress_deflate(logfile, strm, flush)
 /** Declaration of the logfile parameter */
 # define FILE_LOGFILE FILE* logfile,
 /** The logfile parameter */
@@ -843,7 +1208,7 @@ int
 page_zip_compress_node_ptrs(
 /*========================*/
 	FILE_LOGFILE
-	z_stream*	c_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t*	c_stream,	/*!< in/out: compressed page stream */
 	const rec_t**	recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense,	/*!< in: size of recs[] */
@@ -871,7 +1236,7 @@ page_zip_compress_node_ptrs(
 			rec - REC_N_NEW_EXTRA_BYTES - c_stream->next_in);
 
 		if (c_stream->avail_in) {
-			err = deflate(c_stream, Z_NO_FLUSH);
+			err = page_zip_deflate(c_stream, Z_NO_FLUSH);
 			if (UNIV_UNLIKELY(err != Z_OK)) {
 				break;
 			}
@@ -884,7 +1249,7 @@ page_zip_compress_node_ptrs(
 			rec_offs_data_size(offsets) - REC_NODE_PTR_SIZE);
 
 		if (c_stream->avail_in) {
-			err = deflate(c_stream, Z_NO_FLUSH);
+			err = page_zip_deflate(c_stream, Z_NO_FLUSH);
 			if (UNIV_UNLIKELY(err != Z_OK)) {
 				break;
 			}
@@ -909,7 +1274,7 @@ int
 page_zip_compress_sec(
 /*==================*/
 	FILE_LOGFILE
-	z_stream*	c_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t*	c_stream,	/*!< in/out: compressed page stream */
 	const rec_t**	recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense)	/*!< in: size of recs[] */
@@ -929,7 +1294,7 @@ page_zip_compress_sec(
 		if (UNIV_LIKELY(c_stream->avail_in)) {
 			UNIV_MEM_ASSERT_RW(c_stream->next_in,
 					   c_stream->avail_in);
-			err = deflate(c_stream, Z_NO_FLUSH);
+			err = page_zip_deflate(c_stream, Z_NO_FLUSH);
 			if (UNIV_UNLIKELY(err != Z_OK)) {
 				break;
 			}
@@ -955,7 +1320,7 @@ int
 page_zip_compress_clust_ext(
 /*========================*/
 	FILE_LOGFILE
-	z_stream*	c_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t*	c_stream,	/*!< in/out: compressed page stream */
 	const rec_t*	rec,		/*!< in: record */
 	const ulint*	offsets,	/*!< in: rec_get_offsets(rec) */
 	ulint		trx_id_col,	/*!< in: position of of DB_TRX_ID */
@@ -993,7 +1358,7 @@ page_zip_compress_clust_ext(
 				src - c_stream->next_in);
 
 			if (c_stream->avail_in) {
-				err = deflate(c_stream, Z_NO_FLUSH);
+				err = page_zip_deflate(c_stream, Z_NO_FLUSH);
 				if (UNIV_UNLIKELY(err != Z_OK)) {
 
 					return(err);
@@ -1022,7 +1387,7 @@ page_zip_compress_clust_ext(
 			c_stream->avail_in = static_cast<uInt>(
 				src - c_stream->next_in);
 			if (UNIV_LIKELY(c_stream->avail_in)) {
-				err = deflate(c_stream, Z_NO_FLUSH);
+				err = page_zip_deflate(c_stream, Z_NO_FLUSH);
 				if (UNIV_UNLIKELY(err != Z_OK)) {
 
 					return(err);
@@ -1082,7 +1447,7 @@ int
 page_zip_compress_clust(
 /*====================*/
 	FILE_LOGFILE
-	z_stream*	c_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t*	c_stream,	/*!< in/out: compressed page stream */
 	const rec_t**	recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense,	/*!< in: size of recs[] */
@@ -1120,7 +1485,7 @@ page_zip_compress_clust(
 			- c_stream->next_in);
 
 		if (c_stream->avail_in) {
-			err = deflate(c_stream, Z_NO_FLUSH);
+			err = page_zip_deflate(c_stream, Z_NO_FLUSH);
 			if (UNIV_UNLIKELY(err != Z_OK)) {
 
 				goto func_exit;
@@ -1168,7 +1533,7 @@ page_zip_compress_clust(
 				src - c_stream->next_in);
 
 			if (c_stream->avail_in) {
-				err = deflate(c_stream, Z_NO_FLUSH);
+				err = page_zip_deflate(c_stream, Z_NO_FLUSH);
 				if (UNIV_UNLIKELY(err != Z_OK)) {
 
 					return(err);
@@ -1196,7 +1561,7 @@ page_zip_compress_clust(
 			rec + rec_offs_data_size(offsets) - c_stream->next_in);
 
 		if (c_stream->avail_in) {
-			err = deflate(c_stream, Z_NO_FLUSH);
+			err = page_zip_deflate(c_stream, Z_NO_FLUSH);
 			if (UNIV_UNLIKELY(err != Z_OK)) {
 
 				goto func_exit;
@@ -1211,6 +1576,13 @@ func_exit:
 
 my_bool page_zip_zlib_wrap = FALSE;
 uint page_zip_zlib_strategy = Z_DEFAULT_STRATEGY;
+ulong page_zip_algorithm = PAGE_ZIP_ALGORITHM_ZLIB;
+const char* page_zip_algorithm_names[PAGE_ZIP_ALGORITHM_MAX + 1] = {
+	"zlib",
+	"lz4",
+	"zstd",
+	NullS
+};
 
 /**********************************************************************//**
 Compress a page.
@@ -1228,7 +1600,7 @@ page_zip_compress(
 						         and other options */
 	mtr_t*		mtr)	/*!< in: mini-transaction, or NULL */
 {
-	z_stream	c_stream;
+	page_zip_stream_t	c_stream;
 	int		err;
 	ulint		n_fields;/* number of index fields needed */
 	byte*		fields;	/*!< index field information */
@@ -1242,16 +1614,18 @@ page_zip_compress(
 	ulint		n_blobs	= 0;
 	byte*		storage;/* storage of uncompressed columns */
 #ifndef UNIV_HOTBACKUP
-	page_zip_stat_t* zip_stat = &page_zip_stat[page_zip->ssize - 1];
 	int comp_stats_page_size = 0;
 	fil_stats_t* stats;
 	ib_mutex_t* stats_mutex;
 	uint level;
 	uint wrap;
 	uint strategy;
+	uint algorithm;
 	int window_bits;
 	page_zip_decode_compression_flags(compression_flags, &level,
-	                                  &wrap, &strategy);
+	                                  &wrap, &strategy, &algorithm);
+	page_zip_stat_t* zip_stat
+		= &page_zip_stat[algorithm][page_zip->ssize - 1];
 	window_bits = wrap ? UNIV_PAGE_SIZE_SHIFT
 	                   : - ((int) UNIV_PAGE_SIZE_SHIFT);
 	ulint space_id = page_get_space_id(page);
@@ -1385,11 +1759,9 @@ page_zip_compress(
 	buf_end = buf + page_zip_get_size(page_zip) - PAGE_DATA;
 
 	/* Compress the data payload. */
-	page_zip_set_alloc(&c_stream, heap);
-
-	err = deflateInit2(&c_stream, static_cast<int>(level),
-			   Z_DEFLATED, window_bits,
-			   MAX_MEM_LEVEL, strategy);
+	err = page_zip_deflate_init(&c_stream, algorithm,
+				    static_cast<int>(level),
+				    window_bits, strategy, heap);
 	ut_a(err == Z_OK);
 
 	c_stream.next_out = buf;
@@ -1434,7 +1806,7 @@ page_zip_compress(
 	}
 
 	UNIV_MEM_ASSERT_RW(c_stream.next_in, c_stream.avail_in);
-	err = deflate(&c_stream, Z_FULL_FLUSH);
+	err = page_zip_deflate(&c_stream, Z_FULL_FLUSH);
 	if (err != Z_OK) {
 		goto zlib_error;
 	}
@@ -1488,11 +1860,11 @@ page_zip_compress(
 	ut_a(c_stream.avail_in <= UNIV_PAGE_SIZE - PAGE_ZIP_START - PAGE_DIR);
 
 	UNIV_MEM_ASSERT_RW(c_stream.next_in, c_stream.avail_in);
-	err = deflate(&c_stream, Z_FINISH);
+	err = page_zip_deflate(&c_stream, Z_FINISH);
 
 	if (UNIV_UNLIKELY(err != Z_STREAM_END)) {
 zlib_error:
-		deflateEnd(&c_stream);
+		page_zip_deflate_end(&c_stream);
 		mem_heap_free(heap);
 err_exit:
 #ifdef PAGE_ZIP_COMPRESS_DBG
@@ -1540,7 +1912,7 @@ err_exit:
 		return(FALSE);
 	}
 
-	err = deflateEnd(&c_stream);
+	err = page_zip_deflate_end(&c_stream);
 	ut_a(err == Z_OK);
 
 	ut_ad(buf + c_stream.total_out == c_stream.next_out);
@@ -2299,7 +2671,7 @@ static
 ibool
 page_zip_decompress_heap_no(
 /*========================*/
-	z_stream*	d_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t*	d_stream,	/*!< in/out: compressed page stream */
 	rec_t*		rec,		/*!< in/out: record */
 	ulint&		heap_status)	/*!< in/out: heap_no and status bits */
 {
@@ -2325,7 +2697,7 @@ ibool
 page_zip_decompress_node_ptrs(
 /*==========================*/
 	page_zip_des_t*	page_zip,	/*!< in/out: compressed page */
-	z_stream*	d_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t*	d_stream,	/*!< in/out: compressed page stream */
 	rec_t**		recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense,	/*!< in: size of recs[] */
@@ -2351,7 +2723,7 @@ page_zip_decompress_node_ptrs(
 
 		ut_ad(d_stream->avail_out < UNIV_PAGE_SIZE
 		      - PAGE_ZIP_START - PAGE_DIR);
-		switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+		switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 		case Z_STREAM_END:
 			page_zip_decompress_heap_no(
 				d_stream, rec, heap_status);
@@ -2386,7 +2758,7 @@ page_zip_decompress_node_ptrs(
 		d_stream->avail_out =static_cast<uInt>(
 			rec_offs_data_size(offsets) - REC_NODE_PTR_SIZE);
 
-		switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+		switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 		case Z_STREAM_END:
 			goto zlib_done;
 		case Z_OK:
@@ -2425,12 +2797,13 @@ page_zip_decompress_node_ptrs(
 		goto zlib_error;
 	}
 
-	if (UNIV_UNLIKELY(inflate(d_stream, Z_FINISH) != Z_STREAM_END)) {
+	if (UNIV_UNLIKELY(page_zip_inflate(d_stream, Z_FINISH)
+			  != Z_STREAM_END)) {
 		page_zip_fail(("page_zip_decompress_node_ptrs:"
 			       " inflate(Z_FINISH)=%s\n",
 			       d_stream->msg));
 zlib_error:
-		inflateEnd(d_stream);
+		page_zip_inflate_end(d_stream);
 		return(FALSE);
 	}
 
@@ -2438,7 +2811,7 @@ zlib_error:
 	if the modification log is nonempty. */
 
 zlib_done:
-	if (UNIV_UNLIKELY(inflateEnd(d_stream) != Z_OK)) {
+	if (UNIV_UNLIKELY(page_zip_inflate_end(d_stream) != Z_OK)) {
 		ut_error;
 	}
 
@@ -2514,7 +2887,7 @@ ibool
 page_zip_decompress_sec(
 /*====================*/
 	page_zip_des_t*	page_zip,	/*!< in/out: compressed page */
-	z_stream*	d_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t*	d_stream,	/*!< in/out: compressed page stream */
 	rec_t**		recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense,	/*!< in: size of recs[] */
@@ -2539,7 +2912,7 @@ page_zip_decompress_sec(
 			rec - REC_N_NEW_EXTRA_BYTES - d_stream->next_out);
 
 		if (UNIV_LIKELY(d_stream->avail_out)) {
-			switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+			switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 			case Z_STREAM_END:
 				page_zip_decompress_heap_no(
 					d_stream, rec, heap_status);
@@ -2579,12 +2952,13 @@ page_zip_decompress_sec(
 		goto zlib_error;
 	}
 
-	if (UNIV_UNLIKELY(inflate(d_stream, Z_FINISH) != Z_STREAM_END)) {
+	if (UNIV_UNLIKELY(page_zip_inflate(d_stream, Z_FINISH)
+			  != Z_STREAM_END)) {
 		page_zip_fail(("page_zip_decompress_sec:"
 			       " inflate(Z_FINISH)=%s\n",
 			       d_stream->msg));
 zlib_error:
-		inflateEnd(d_stream);
+		page_zip_inflate_end(d_stream);
 		return(FALSE);
 	}
 
@@ -2592,7 +2966,7 @@ zlib_error:
 	if the modification log is nonempty. */
 
 zlib_done:
-	if (UNIV_UNLIKELY(inflateEnd(d_stream) != Z_OK)) {
+	if (UNIV_UNLIKELY(page_zip_inflate_end(d_stream) != Z_OK)) {
 		ut_error;
 	}
 
@@ -2651,7 +3025,7 @@ static
 ibool
 page_zip_decompress_clust_ext(
 /*==========================*/
-	z_stream*	d_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t*	d_stream,	/*!< in/out: compressed page stream */
 	rec_t*		rec,		/*!< in/out: record */
 	const ulint*	offsets,	/*!< in: rec_get_offsets(rec) */
 	ulint		trx_id_col)	/*!< in: position of of DB_TRX_ID */
@@ -2685,7 +3059,7 @@ page_zip_decompress_clust_ext(
 			d_stream->avail_out = static_cast<uInt>(
 				dst - d_stream->next_out);
 
-			switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+			switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 			case Z_STREAM_END:
 			case Z_OK:
 			case Z_BUF_ERROR:
@@ -2716,7 +3090,7 @@ page_zip_decompress_clust_ext(
 
 			d_stream->avail_out = static_cast<uInt>(
 				dst - d_stream->next_out);
-			switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+			switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 			case Z_STREAM_END:
 			case Z_OK:
 			case Z_BUF_ERROR:
@@ -2762,7 +3136,7 @@ ibool
 page_zip_decompress_clust(
 /*======================*/
 	page_zip_des_t*	page_zip,	/*!< in/out: compressed page */
-	z_stream*	d_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t*	d_stream,	/*!< in/out: compressed page stream */
 	rec_t**		recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense,	/*!< in: size of recs[] */
@@ -2795,7 +3169,7 @@ page_zip_decompress_clust(
 
 		ut_ad(d_stream->avail_out < UNIV_PAGE_SIZE
 		      - PAGE_ZIP_START - PAGE_DIR);
-		err = inflate(d_stream, Z_SYNC_FLUSH);
+		err = page_zip_inflate(d_stream, Z_SYNC_FLUSH);
 		switch (err) {
 		case Z_STREAM_END:
 			page_zip_decompress_heap_no(
@@ -2852,7 +3226,7 @@ page_zip_decompress_clust(
 			d_stream->avail_out = static_cast<uInt>(
 				dst - d_stream->next_out);
 
-			switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+			switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 			case Z_STREAM_END:
 			case Z_OK:
 			case Z_BUF_ERROR:
@@ -2882,7 +3256,7 @@ page_zip_decompress_clust(
 		d_stream->avail_out = static_cast<uInt>(
 			rec_get_end(rec, offsets) - d_stream->next_out);
 
-		switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+		switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 		case Z_STREAM_END:
 		case Z_OK:
 		case Z_BUF_ERROR:
@@ -2912,12 +3286,13 @@ page_zip_decompress_clust(
 		goto zlib_error;
 	}
 
-	if (UNIV_UNLIKELY(inflate(d_stream, Z_FINISH) != Z_STREAM_END)) {
+	if (UNIV_UNLIKELY(page_zip_inflate(d_stream, Z_FINISH)
+			  != Z_STREAM_END)) {
 		page_zip_fail(("page_zip_decompress_clust:"
 			       " inflate(Z_FINISH)=%s\n",
 			       d_stream->msg));
 zlib_error:
-		inflateEnd(d_stream);
+		page_zip_inflate_end(d_stream);
 		return(FALSE);
 	}
 
@@ -2925,7 +3300,7 @@ zlib_error:
 	if the modification log is nonempty. */
 
 zlib_done:
-	if (UNIV_UNLIKELY(inflateEnd(d_stream) != Z_OK)) {
+	if (UNIV_UNLIKELY(page_zip_inflate_end(d_stream) != Z_OK)) {
 		ut_error;
 	}
 
@@ -3061,12 +3436,28 @@ first try the positive window_bits then negative window_bits, because the
 surest way to determine if the stream has adler32 headers is to see if the
 stream begins with the zlib header together with the adler32 value of it.
 This adds a tiny bit of overhead for the pages that were compressed without
-adler32s. */
+adler32s. Streams that were compressed with LZ4 or zstd are only
+recognized here, and decompressed by the first page_zip_inflate(). */
 static
 void
 page_zip_init_d_stream(
-	z_stream* strm)
+	page_zip_stream_t* strm)
 {
+	strm->algorithm = page_zip_stream_get_algorithm(strm->next_in);
+
+	if (strm->algorithm != PAGE_ZIP_ALGORITHM_ZLIB) {
+		strm->buf_size = 2 * UNIV_PAGE_SIZE;
+		strm->buf = static_cast<byte*>(
+			mem_heap_alloc(static_cast<mem_heap_t*>(strm->opaque),
+				       strm->buf_size));
+		strm->buf_len = ULINT_UNDEFINED;
+		strm->buf_pos = 0;
+		strm->total_in = 0;
+		strm->total_out = 0;
+		strm->msg = NULL;
+		return;
+	}
+
 	/* Save initial stream position, in case a reset is required. */
 	Bytef* next_in = strm->next_in;
 	Bytef* next_out = strm->next_out;
@@ -3109,7 +3500,7 @@ page_zip_decompress(
 				after page creation */
 	ulint space_id)
 {
-	z_stream	d_stream;
+	page_zip_stream_t	d_stream;
 	dict_index_t*	index	= NULL;
 	rec_t**		recs;	/*!< dense page directory, sorted by address */
 	ulint		n_dense;/* number of user records on the page */
@@ -3117,7 +3508,9 @@ page_zip_decompress(
 	mem_heap_t*	heap;
 	ulint*		offsets;
 #ifndef UNIV_HOTBACKUP
-	page_zip_stat_t* zip_stat = &page_zip_stat[page_zip->ssize - 1];
+	page_zip_stat_t* zip_stat = &page_zip_stat[
+		page_zip_stream_get_algorithm(page_zip->data + PAGE_DATA)]
+		[page_zip->ssize - 1];
 	ulonglong start = my_timer_now();
 	int comp_stats_page_size;
 	fil_stats_t* stats;
@@ -3197,7 +3590,7 @@ zlib_error:
 	memcpy(page + (PAGE_NEW_SUPREMUM - REC_N_NEW_EXTRA_BYTES + 1),
 	       supremum_extra_data, sizeof supremum_extra_data);
 
-	page_zip_set_alloc(&d_stream, heap);
+	page_zip_set_alloc(static_cast<z_stream*>(&d_stream), heap);
 
 	d_stream.next_in = page_zip->data + PAGE_DATA;
 	/* Subtract the space reserved for
@@ -3209,7 +3602,7 @@ zlib_error:
 
 	page_zip_init_d_stream(&d_stream);
 
-	if (UNIV_UNLIKELY(inflate(&d_stream, Z_BLOCK) != Z_OK)) {
+	if (UNIV_UNLIKELY(page_zip_inflate(&d_stream, Z_BLOCK) != Z_OK)) {
 
 		page_zip_fail(("page_zip_decompress:"
 			       " 2 inflate(Z_BLOCK)=%s\n", d_stream.msg));
@@ -4806,7 +5199,7 @@ page_zip_reorganize(
 	mtr_set_log_mode(mtr, log_mode);
 
 	if (!page_zip_compress(page_zip, page, index,
-			       page_zip_compression_flags, mtr)) {
+			       page_zip_compression_flags(index), mtr)) {
 
 #ifndef UNIV_HOTBACKUP
 		buf_block_free(temp_block);
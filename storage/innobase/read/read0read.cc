@@ -31,6 +31,8 @@ Created 2/16/1997 Heikki Tuuri
 
 #include "srv0srv.h"
 #include "trx0sys.h"
+#include "os0thread.h"
+#include "ut0rnd.h"
 
 /*
 -------------------------------------------------------------------------------
@@ -134,12 +136,13 @@ FACT C: Purge does not remove any delete-marked row that is visible
 in any cursor read view.
 
 PROOF: We know that:
- 1: Currently active read views in trx_sys_t::view_list are ordered by
-    read_view_t::low_limit_no in descending order, that is,
-    newest read view first.
+ 1: Currently active read views in each partition of
+    trx_sys_t::view_shards are ordered by read_view_t::low_limit_no in
+    descending order, that is, newest read view first.
 
- 2: Purge clones the oldest read view and uses that to determine whether there
-    are any active transactions that can see the to be purged records.
+ 2: Purge clones the oldest read view of all partitions and uses that to
+    determine whether there are any active transactions that can see the
+    to be purged records.
 
 Therefore any joining or active transaction will not have a view older
 than the purge view, according to 1.
@@ -166,14 +169,23 @@ For details see: row_vers_old_has_index_entry() and row_purge_poss_sec()
 
 Some additional issues:
 
-What if trx_sys->view_list == NULL and some transaction T1 and Purge both
-try to open read_view at same time. Only one can acquire trx_sys->mutex.
-In which order will the views be opened? Should it matter? If no, why?
-
-The order does not matter. No new transactions can be created and no running
-transaction can commit or rollback (or free views).
+What if there are no read views and some transaction T1 and Purge both
+try to open read_view at same time. T1 holds the mutex of one partition of
+trx_sys->view_shards, Purge needs the mutexes of all of them. In which
+order will the views be opened? Should it matter? If no, why?
+
+The order does not matter. A view is created and added to its partition
+while holding the mutex of the partition, so purge either sees the new
+view or opens its own view after it. Views of different partitions are
+created concurrently. Transactions may start, commit or roll back
+meanwhile, but each of these changes is made visible atomically through
+trx_sys->descr_version (see read_view_copy_descr()).
 */
 
+/** Number of spare cells allocated in a read view for transactions
+that start while the view is being created */
+static const ulint	READ_VIEW_N_SPARE_IDS = 16;
+
 /*********************************************************************//**
 Creates a read view object.
 @return	own: read view struct */
@@ -192,6 +204,7 @@ read_view_create_low(
 
 	view->n_trx_ids = n;
 	view->trx_ids = (trx_id_t*) &view[1];
+	view->shard = NULL;
 
 	return(view);
 }
@@ -214,7 +227,7 @@ read_view_clone(
 	read_view_t*	clone;
 	read_view_t*	new_view;
 
-	ut_ad(mutex_own(&trx_sys->mutex));
+	ut_ad(mutex_own(&view->shard->mutex));
 
 	/* Allocate space for two views. */
 
@@ -226,12 +239,17 @@ read_view_clone(
 		mem_heap_alloc(heap, (sz * 2) + sizeof(trx_id_t)));
 
 	/* Only the contents of the old view are important, the new view
-	will be created from this and so we don't copy that across. */
+	will be created from this and so we don't copy that across. The
+	trx_ids array of the old view need not follow it in memory, see
+	read_view_create_now(). */
 
-	memcpy(clone, view, sz);
+	memcpy(clone, view, sizeof(*view));
 
 	clone->trx_ids = (trx_id_t*) &clone[1];
 
+	memcpy(clone->trx_ids, view->trx_ids,
+	       view->n_trx_ids * sizeof(*view->trx_ids));
+
 	new_view = (read_view_t*) &clone->trx_ids[clone->n_trx_ids];
 	new_view->trx_ids = (trx_id_t*) &new_view[1];
 	new_view->n_trx_ids = clone->n_trx_ids + 1;
@@ -242,116 +260,205 @@ read_view_clone(
 }
 
 /*********************************************************************//**
-Insert the view in the proper order into the trx_sys->view_list. The
-read view list is ordered by read_view_t::low_limit_no in descending order. */
+Returns the partition of the read view list for a new view. Views whose
+memory comes from different heaps, that is, views of different
+transactions, are spread over the partitions.
+@return	partition */
+static
+trx_view_shard_t*
+read_view_get_shard(
+/*================*/
+	const mem_heap_t*	heap)	/*!< in: heap of the view */
+{
+	ulint	fold = reinterpret_cast<ulint>(heap) >> 6;
+
+	return(&trx_sys->view_shards[fold % TRX_SYS_N_VIEW_SHARDS]);
+}
+
+/*********************************************************************//**
+Returns the number of open read views. This is a dirty read.
+@return	number of views in trx_sys_t::view_shards */
+UNIV_INTERN
+ulint
+read_view_get_n_open(void)
+/*======================*/
+{
+	ulint	n = 0;
+
+	for (ulint i = 0; i < TRX_SYS_N_VIEW_SHARDS; ++i) {
+		n += UT_LIST_GET_LEN(trx_sys->view_shards[i].view_list);
+	}
+
+	return(n);
+}
+
+/*********************************************************************//**
+Insert the view in the proper order into a partition of the read view
+list. Each partition is ordered by read_view_t::low_limit_no in descending
+order. */
 static
 void
 read_view_add(
 /*==========*/
-	read_view_t*	view)		/*!< in: view to add to */
+	read_view_t*		view,	/*!< in: view to add to */
+	trx_view_shard_t*	shard)	/*!< in: partition, its mutex
+					owned by the caller */
 {
 	read_view_t*	elem;
 	read_view_t*	prev_elem;
 
-	ut_ad(mutex_own(&trx_sys->mutex));
+	ut_ad(mutex_own(&shard->mutex));
 	ut_ad(read_view_validate(view));
 
 	/* Find the correct slot for insertion. */
-	for (elem = UT_LIST_GET_FIRST(trx_sys->view_list), prev_elem = NULL;
+	for (elem = UT_LIST_GET_FIRST(shard->view_list), prev_elem = NULL;
 	     elem != NULL && view->low_limit_no < elem->low_limit_no;
 	     prev_elem = elem, elem = UT_LIST_GET_NEXT(view_list, elem)) {
 		/* No op */
 	}
 
 	if (prev_elem == NULL) {
-		UT_LIST_ADD_FIRST(view_list, trx_sys->view_list, view);
+		UT_LIST_ADD_FIRST(view_list, shard->view_list, view);
 	} else {
 		UT_LIST_INSERT_AFTER(
-			view_list, trx_sys->view_list, prev_elem, view);
+			view_list, shard->view_list, prev_elem, view);
 	}
 
-	ut_ad(read_view_list_validate());
+	view->shard = shard;
+
+	ut_ad(read_view_list_validate(shard));
 }
 
-/** Functor to create thew view trx_ids array. */
-struct	CreateView {
+/*********************************************************************//**
+Copies the ids of the active read-write transactions into a read view
+and sets its low limits. trx_sys->mutex is not acquired: the copy is
+retried until it was not overlapped by a change of trx_sys->descr.
+The writers never wait for anything while a change is in progress, see
+trx_sys_descr_reserve(), so the caller may hold a view partition mutex.
+@return	false if the view has fewer than trx_sys->n_descr cells */
+static
+bool
+read_view_copy_descr(
+/*=================*/
+	read_view_t*	view,	/*!< in/out: read view */
+	ulint		n_ids)	/*!< in: number of cells in view->trx_ids */
+{
+	ulint	n_spins = 0;
+
+	for (;;) {
+		/* os_rmb is empty on x86 and not even a compiler barrier:
+		the loads are ordered with atomic builtins instead, see
+		trx_sys_descr_write_begin() for the writer. */
+		ulint	version = __atomic_load_n(
+			&trx_sys->descr_version, __ATOMIC_ACQUIRE);
+
+		if (!(version & 1)) {
+			/* Read n_descr before descr: an array that is
+			replaced by trx_sys_descr_reserve() was big enough
+			for every n_descr published before the new array. */
+			ulint			n_descr = __atomic_load_n(
+				&trx_sys->n_descr, __ATOMIC_ACQUIRE);
+			const trx_descr_t*	descr;
+			trx_id_t		max_trx_id;
+			trx_id_t		low_limit_no;
+			ulint			n = 0;
+
+			if (n_descr > n_ids) {
+				return(false);
+			}
 
-	CreateView(read_view_t*	view)
-		: m_view(view)
-	{
-		  m_n_trx = m_view->n_trx_ids;
-		  m_view->n_trx_ids = 0;
-	}
+			descr = __atomic_load_n(
+				&trx_sys->descr, __ATOMIC_ACQUIRE);
 
-	void	operator()(const trx_t* trx)
-	{
-		ut_ad(mutex_own(&trx_sys->mutex));
-		ut_ad(trx->in_rw_trx_list);
+			max_trx_id = __atomic_load_n(
+				&trx_sys->max_trx_id, __ATOMIC_RELAXED);
+			low_limit_no = max_trx_id;
 
-		/* trx->state cannot change from or to NOT_STARTED
-		while we are holding the trx_sys->mutex. It may change
-		from ACTIVE to PREPARED or COMMITTED. */
+			/* trx_sys->descr is sorted on trx id, smallest
+			first, while view->trx_ids is in descending order. */
 
-		if (trx->id != m_view->creator_trx_id
-		    && !trx_state_eq(trx, TRX_STATE_COMMITTED_IN_MEMORY)) {
+			for (ulint i = n_descr; i-- > 0; ) {
+				trx_id_t	id = __atomic_load_n(
+					&descr[i].id, __ATOMIC_RELAXED);
+				trx_id_t	no = __atomic_load_n(
+					&descr[i].no, __ATOMIC_RELAXED);
 
-			ut_ad(m_n_trx > m_view->n_trx_ids);
+				if (id == view->creator_trx_id) {
+					continue;
+				}
 
-			m_view->trx_ids[m_view->n_trx_ids++] = trx->id;
+				view->trx_ids[n++] = id;
 
-			/* NOTE that a transaction whose trx number is <
-			trx_sys->max_trx_id can still be active, if it is
-			in the middle of its commit! Note that when a
-			transaction starts, we initialize trx->no to
-			TRX_ID_MAX. */
+				/* NOTE that a transaction whose trx number
+				is < trx_sys->max_trx_id can still be active,
+				if it is in the middle of its commit! Its
+				descriptor carries the trx number from the
+				moment it is assigned by trx_commit() until
+				the transaction is committed in memory. */
 
-			/* trx->no is protected by trx_sys->mutex, which
-			we are holding. It is assigned by trx_commit()
-			before lock_trx_release_locks() assigns
-			trx->state = TRX_STATE_COMMITTED_IN_MEMORY. */
+				if (low_limit_no > no) {
+					low_limit_no = no;
+				}
+			}
+
+			/* Complete the copy before checking the version. */
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+			if (__atomic_load_n(&trx_sys->descr_version,
+					    __ATOMIC_RELAXED) == version) {
+				view->n_trx_ids = n;
+				view->low_limit_no = low_limit_no;
+				view->low_limit_id = max_trx_id;
 
-			if (m_view->low_limit_no > trx->no) {
-				m_view->low_limit_no = trx->no;
+				return(true);
 			}
 		}
-	}
 
-	read_view_t*	m_view;
-	ulint		m_n_trx;
-};
+		/* A transaction is starting or committing: wait for it to
+		publish its change. */
+
+		if (n_spins++ < srv_n_spin_wait_rounds) {
+			ut_delay(ut_rnd_interval(0, srv_spin_wait_delay));
+		} else {
+			os_thread_yield();
+			n_spins = 0;
+		}
+	}
+}
 
 /*********************************************************************//**
-Opens a read view where exactly the transactions serialized before this
-point in time are seen in the view.
+Creates a read view of the transactions that are active at this point in
+time and sets its limits. The creator transaction is excluded from the
+active transactions.
 @return	own: read view struct */
 static
 read_view_t*
-read_view_open_now_low(
-/*===================*/
+read_view_create_now(
+/*=================*/
 	trx_id_t	cr_trx_id,	/*!< in: trx_id of creating
-					transaction, or 0 used in purge */
+					transaction, 0 or UINT64_UNDEFINED */
 	mem_heap_t*	heap)		/*!< in: memory heap from which
 					allocated */
 {
 	read_view_t*	view;
-	ulint		n_trx = UT_LIST_GET_LEN(trx_sys->rw_trx_list);
-
-	ut_ad(mutex_own(&trx_sys->mutex));
+	/* A dirty read: read_view_copy_descr() checks it. */
+	ulint		n_ids = trx_sys->n_descr + READ_VIEW_N_SPARE_IDS;
 
-	view = read_view_create_low(n_trx, heap);
+	view = read_view_create_low(n_ids, heap);
 
-	view->undo_no = 0;
-	view->type = VIEW_NORMAL;
 	view->creator_trx_id = cr_trx_id;
 
-	/* No future transactions should be visible in the view */
-
-	view->low_limit_no = trx_sys->max_trx_id;
-	view->low_limit_id = view->low_limit_no;
+	while (!read_view_copy_descr(view, n_ids)) {
+		/* More transactions became active than the view has cells
+		for. Keep the view and replace only its trx_ids array, at
+		least doubled so that transactions that keep starting do
+		not make every retry allocate again. */
+		n_ids = ut_max(2 * n_ids,
+			       trx_sys->n_descr + READ_VIEW_N_SPARE_IDS);
 
-	/* No active transaction should be visible, except cr_trx */
-
-	ut_list_map(trx_sys->rw_trx_list, &trx_t::trx_list, CreateView(view));
+		view->trx_ids = static_cast<trx_id_t*>(
+			mem_heap_alloc(heap, n_ids * sizeof(*view->trx_ids)));
+	}
 
 	if (view->n_trx_ids > 0) {
 		/* The last active transaction has the smallest id: */
@@ -360,9 +467,42 @@ read_view_open_now_low(
 		view->up_limit_id = view->low_limit_id;
 	}
 
+	return(view);
+}
+
+/*********************************************************************//**
+Opens a read view where exactly the transactions serialized before this
+point in time are seen in the view.
+@return	own: read view struct */
+static
+read_view_t*
+read_view_open_now_low(
+/*===================*/
+	trx_id_t		cr_trx_id,	/*!< in: trx_id of creating
+						transaction, or 0 used in
+						purge */
+	mem_heap_t*		heap,		/*!< in: memory heap from
+						which allocated */
+	trx_view_shard_t*	shard)		/*!< in: partition to add the
+						view to, its mutex owned by
+						the caller, or NULL for a
+						purge view */
+{
+	read_view_t*	view;
+
+	ut_ad(shard == NULL || mutex_own(&shard->mutex));
+
+	/* No future transactions and no active transaction except
+	cr_trx should be visible in the view */
+
+	view = read_view_create_now(cr_trx_id, heap);
+
+	view->undo_no = 0;
+	view->type = VIEW_NORMAL;
+
 	/* Purge views are not added to the view list. */
 	if (cr_trx_id > 0) {
-		read_view_add(view);
+		read_view_add(view, shard);
 	}
 
 	return(view);
@@ -370,7 +510,10 @@ read_view_open_now_low(
 
 /*********************************************************************//**
 Opens a read view where exactly the transactions serialized before this
-point in time are seen in the view.
+point in time are seen in the view. Only the mutex of one partition of
+trx_sys->view_shards is acquired, so that the creation of read views
+neither contends with transactions starting or committing on
+trx_sys->mutex nor with the creation of most other read views.
 @return	own: read view struct */
 UNIV_INTERN
 read_view_t*
@@ -381,13 +524,14 @@ read_view_open_now(
 	mem_heap_t*	heap)		/*!< in: memory heap from which
 					allocated */
 {
-	read_view_t*	view;
+	read_view_t*		view;
+	trx_view_shard_t*	shard = read_view_get_shard(heap);
 
-	mutex_enter(&trx_sys->mutex);
+	mutex_enter(&shard->mutex);
 
-	view = read_view_open_now_low(cr_trx_id, heap);
+	view = read_view_open_now_low(cr_trx_id, heap, shard);
 
-	mutex_exit(&trx_sys->mutex);
+	mutex_exit(&shard->mutex);
 
 	return(view);
 }
@@ -407,30 +551,49 @@ read_view_purge_open(
 {
 	ulint		i;
 	read_view_t*	view;
-	read_view_t*	oldest_view;
+	read_view_t*	oldest_view = NULL;
 	trx_id_t	creator_trx_id;
 	ulint		insert_done	= 0;
 
-	mutex_enter(&trx_sys->mutex);
+	/* Hold all partitions, so that no view can be created between
+	looking for the oldest view and cloning it. */
 
-	oldest_view = UT_LIST_GET_LAST(trx_sys->view_list);
+	for (i = 0; i < TRX_SYS_N_VIEW_SHARDS; ++i) {
+		trx_view_shard_t*	shard = &trx_sys->view_shards[i];
+		read_view_t*		last;
 
-	if (oldest_view == NULL) {
+		mutex_enter(&shard->mutex);
 
-		view = read_view_open_now_low(0, heap);
+		last = UT_LIST_GET_LAST(shard->view_list);
 
-		mutex_exit(&trx_sys->mutex);
+		if (last != NULL
+		    && (oldest_view == NULL
+			|| last->low_limit_no < oldest_view->low_limit_no)) {
 
-		return(view);
+			oldest_view = last;
+		}
 	}
 
-	/* Allocate space for both views, the oldest and the new purge view. */
+	if (oldest_view == NULL) {
+
+		view = read_view_open_now_low(0, heap, NULL);
+	} else {
+		/* Allocate space for both views, the oldest and the new
+		purge view. */
+
+		oldest_view = read_view_clone(oldest_view, heap);
+
+		ut_ad(read_view_validate(oldest_view));
+	}
 
-	oldest_view = read_view_clone(oldest_view, heap);
+	for (i = TRX_SYS_N_VIEW_SHARDS; i-- > 0; ) {
+		mutex_exit(&trx_sys->view_shards[i].mutex);
+	}
 
-	ut_ad(read_view_validate(oldest_view));
+	if (oldest_view == NULL) {
 
-	mutex_exit(&trx_sys->mutex);
+		return(view);
+	}
 
 	ut_a(oldest_view->creator_trx_id > 0);
 	creator_trx_id = oldest_view->creator_trx_id;
@@ -544,10 +707,10 @@ read_cursor_view_create_for_mysql(
 /*==============================*/
 	trx_t*		cr_trx)	/*!< in: trx where cursor view is created */
 {
-	read_view_t*	view;
-	mem_heap_t*	heap;
-	ulint		n_trx;
-	cursor_view_t*	curview;
+	read_view_t*		view;
+	mem_heap_t*		heap;
+	cursor_view_t*		curview;
+	trx_view_shard_t*	shard;
 
 	/* Use larger heap than in trx_create when creating a read_view
 	because cursors are quite long. */
@@ -565,39 +728,24 @@ read_cursor_view_create_for_mysql(
 
 	cr_trx->n_mysql_tables_in_use = 0;
 
-	mutex_enter(&trx_sys->mutex);
+	shard = read_view_get_shard(heap);
+
+	mutex_enter(&shard->mutex);
 
-	n_trx = UT_LIST_GET_LEN(trx_sys->rw_trx_list);
+	/* No future transactions and no active transaction should be
+	visible in the view */
 
-	curview->read_view = read_view_create_low(n_trx, curview->heap);
+	curview->read_view = read_view_create_now(
+		UINT64_UNDEFINED, curview->heap);
 
 	view = curview->read_view;
 	view->undo_no = cr_trx->undo_no;
 	view->type = VIEW_HIGH_GRANULARITY;
-	view->creator_trx_id = UINT64_UNDEFINED;
-
-	/* No future transactions should be visible in the view */
-
-	view->low_limit_no = trx_sys->max_trx_id;
-	view->low_limit_id = view->low_limit_no;
-
-	/* No active transaction should be visible */
-
-	ut_list_map(trx_sys->rw_trx_list, &trx_t::trx_list, CreateView(view));
-
 	view->creator_trx_id = cr_trx->id;
 
-	if (view->n_trx_ids > 0) {
-		/* The last active transaction has the smallest id: */
-
-		view->up_limit_id = view->trx_ids[view->n_trx_ids - 1];
-	} else {
-		view->up_limit_id = view->low_limit_id;
-	}
-
-	read_view_add(view);
+	read_view_add(view, shard);
 
-	mutex_exit(&trx_sys->mutex);
+	mutex_exit(&shard->mutex);
 
 	return(curview);
 }
@@ -640,8 +788,6 @@ read_cursor_set_for_mysql(
 {
 	ut_a(trx);
 
-	mutex_enter(&trx_sys->mutex);
-
 	if (UNIV_LIKELY(curview != NULL)) {
 		trx->read_view = curview->read_view;
 	} else {
@@ -649,6 +795,4 @@ read_cursor_set_for_mysql(
 	}
 
 	ut_ad(read_view_validate(trx->read_view));
-
-	mutex_exit(&trx_sys->mutex);
 }
@@ -2000,7 +2000,8 @@ wait_again:
 	DBUG_RETURN(err);
 }
 
-/** Write a record via buffer 2 and read the next record to buffer N.
+/** Write a record via buffer 2 and read the next record to buffer N
+from file0 or file1. The output may not hold more than max_n_rec records.
 @param N	number of the buffer (0 or 1)
 @param INDEX	record descriptor
 @param AT_END	statement to execute at end of input */
@@ -2010,12 +2011,12 @@ wait_again:
 					 &buf[2], b2,			\
 					 of->fd, &of->offset,		\
 					 mrec##N, offsets##N);		\
-		if (UNIV_UNLIKELY(!b2 || ++of->n_rec > file->n_rec)) {	\
+		if (UNIV_UNLIKELY(!b2 || ++of->n_rec > max_n_rec)) {	\
 			goto corrupt;					\
 		}							\
 		b##N = row_merge_read_rec(&block[N * srv_sort_buf_size],\
 					  &buf[N], b##N, INDEX,		\
-					  file->fd, foffs##N,		\
+					  file##N->fd, foffs##N,	\
 					  &mrec##N, offsets##N);	\
 		if (UNIV_UNLIKELY(!b##N)) {				\
 			if (mrec##N) {					\
@@ -2034,15 +2035,20 @@ row_merge_blocks(
 /*=============*/
 	const row_merge_dup_t*	dup,	/*!< in: descriptor of
 					index being created */
-	const merge_file_t*	file,	/*!< in: file containing
-					index entries */
+	const merge_file_t*	file0,	/*!< in: file containing
+					the first source list */
+	const merge_file_t*	file1,	/*!< in: file containing
+					the second source list; may
+					be file0 */
 	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
 	ulint*			foffs0,	/*!< in/out: offset of first
-					source list in the file */
+					source list in file0 */
 	ulint*			foffs1,	/*!< in/out: offset of second
-					source list in the file */
+					source list in file1 */
 	merge_file_t*		of)	/*!< in/out: output file */
 {
+	const ib_uint64_t max_n_rec = file0 == file1
+		? file0->n_rec : file0->n_rec + file1->n_rec;
 	mem_heap_t*	heap;	/*!< memory heap for offsets0, offsets1 */
 
 	mrec_buf_t*	buf;	/*!< buffer for handling
@@ -2061,8 +2067,8 @@ row_merge_blocks(
 		fprintf(stderr,
 			"row_merge_blocks fd=%d ofs=%lu + fd=%d ofs=%lu"
 			" = fd=%d ofs=%lu\n",
-			file->fd, (ulong) *foffs0,
-			file->fd, (ulong) *foffs1,
+			file0->fd, (ulong) *foffs0,
+			file1->fd, (ulong) *foffs1,
 			of->fd, (ulong) of->offset);
 	}
 #endif /* UNIV_DEBUG */
@@ -2072,8 +2078,9 @@ row_merge_blocks(
 	/* Write a record and read the next record.  Split the output
 	file in two halves, which can be merged on the following pass. */
 
-	if (!row_merge_read(file->fd, *foffs0, &block[0])
-	    || !row_merge_read(file->fd, *foffs1, &block[srv_sort_buf_size])) {
+	if (!row_merge_read(file0->fd, *foffs0, &block[0])
+	    || !row_merge_read(file1->fd, *foffs1,
+			       &block[srv_sort_buf_size])) {
 corrupt:
 		mem_heap_free(heap);
 		return(DB_CORRUPTION);
@@ -2085,11 +2092,11 @@ corrupt:
 
 	b0 = row_merge_read_rec(
 		&block[0], &buf[0], b0, dup->index,
-		file->fd, foffs0, &mrec0, offsets0);
+		file0->fd, foffs0, &mrec0, offsets0);
 	b1 = row_merge_read_rec(
 		&block[srv_sort_buf_size],
 		&buf[srv_sort_buf_size], b1, dup->index,
-		file->fd, foffs1, &mrec1, offsets1);
+		file1->fd, foffs1, &mrec1, offsets1);
 	if (UNIV_UNLIKELY(!b0 && mrec0)
 	    || UNIV_UNLIKELY(!b1 && mrec1)) {
 
@@ -2144,11 +2151,12 @@ ibool
 row_merge_blocks_copy(
 /*==================*/
 	const dict_index_t*	index,	/*!< in: index being created */
-	const merge_file_t*	file,	/*!< in: input file */
+	const merge_file_t*	file0,	/*!< in: input file */
 	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
 	ulint*			foffs0,	/*!< in/out: input file offset */
 	merge_file_t*		of)	/*!< in/out: output file */
 {
+	const ib_uint64_t max_n_rec = file0->n_rec;
 	mem_heap_t*	heap;	/*!< memory heap for offsets0, offsets1 */
 
 	mrec_buf_t*	buf;	/*!< buffer for handling
@@ -2164,7 +2172,7 @@ row_merge_blocks_copy(
 		fprintf(stderr,
 			"row_merge_blocks_copy fd=%d ofs=%lu"
 			" = fd=%d ofs=%lu\n",
-			file->fd, (ulong) foffs0,
+			file0->fd, (ulong) foffs0,
 			of->fd, (ulong) of->offset);
 	}
 #endif /* UNIV_DEBUG */
@@ -2174,7 +2182,7 @@ row_merge_blocks_copy(
 	/* Write a record and read the next record.  Split the output
 	file in two halves, which can be merged on the following pass. */
 
-	if (!row_merge_read(file->fd, *foffs0, &block[0])) {
+	if (!row_merge_read(file0->fd, *foffs0, &block[0])) {
 corrupt:
 		mem_heap_free(heap);
 		return(FALSE);
@@ -2185,7 +2193,7 @@ corrupt:
 	b2 = &block[2 * srv_sort_buf_size];
 
 	b0 = row_merge_read_rec(&block[0], &buf[0], b0, index,
-				file->fd, foffs0, &mrec0, offsets0);
+				file0->fd, foffs0, &mrec0, offsets0);
 	if (UNIV_UNLIKELY(!b0 && mrec0)) {
 
 		goto corrupt;
@@ -2269,7 +2277,7 @@ row_merge(
 		/* Remember the offset number for this run */
 		run_offset[n_run++] = of.offset;
 
-		error = row_merge_blocks(dup, file, block,
+		error = row_merge_blocks(dup, file, file, block,
 					 &foffs0, &foffs1, &of);
 
 		if (error != DB_SUCCESS) {
@@ -2396,6 +2404,356 @@ row_merge_sort(
 	DBUG_RETURN(error);
 }
 
+/** A part of the merge sort of row_merge_sort_pll() that one thread
+works on: first the sorting of a range of the initial runs, then the
+merging of another sorted part into this one. */
+struct row_merge_sort_slot_t {
+	trx_t*			trx;	/*!< transaction */
+	const row_merge_dup_t*	dup;	/*!< descriptor of index being
+					created, without a MySQL table
+					to report duplicates to */
+	const merge_file_t*	input;	/*!< file containing the
+					initial runs */
+	ulint			first;	/*!< first block of the range */
+	ulint			last;	/*!< block after the range */
+	row_merge_sort_slot_t*	other;	/*!< sorted part to merge into
+					this one, or NULL to sort the
+					range */
+	merge_file_t		file;	/*!< sorted part */
+	int			tmpfd;	/*!< temporary file handle */
+	row_merge_block_t*	block;	/*!< 3 buffers */
+	ulint			block_size;/*!< size of block, or 0 if
+					block is not owned by the slot */
+	dberr_t			error;	/*!< result of the thread */
+	os_event_t		done;	/*!< set when the thread is done */
+};
+
+/*************************************************************//**
+Sorts the initial runs of a range of blocks into a file of its own.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_sort_range(
+/*=================*/
+	row_merge_sort_slot_t*	slot)	/*!< in/out: part to sort */
+{
+	ulint*	run_offset;
+	ulint	num_runs = 0;
+	dberr_t	error = DB_SUCCESS;
+
+	run_offset = static_cast<ulint*>(
+		mem_alloc((slot->last - slot->first) * sizeof *run_offset));
+
+	/* Each block of the input is a run.  Merge the runs pairwise
+	from the shared input, so that the runs of the part are known
+	for the following passes. */
+	for (ulint foffs = slot->first; foffs < slot->last; foffs += 2) {
+		ulint	foffs0 = foffs;
+		ulint	foffs1 = foffs + 1;
+
+		if (trx_is_interrupted(slot->trx)) {
+			error = DB_INTERRUPTED;
+			break;
+		}
+
+		run_offset[num_runs++] = slot->file.offset;
+
+		if (foffs1 < slot->last) {
+			error = row_merge_blocks(
+				slot->dup, slot->input, slot->input,
+				slot->block, &foffs0, &foffs1, &slot->file);
+		} else if (!row_merge_blocks_copy(
+				   slot->dup->index, slot->input,
+				   slot->block, &foffs0, &slot->file)) {
+			error = DB_CORRUPTION;
+		}
+
+		if (error != DB_SUCCESS) {
+			break;
+		}
+	}
+
+	while (error == DB_SUCCESS && num_runs > 1) {
+		error = row_merge(slot->trx, slot->dup, &slot->file,
+				  slot->block, &slot->tmpfd,
+				  &num_runs, run_offset);
+	}
+
+	mem_free(run_offset);
+
+	return(error);
+}
+
+/*************************************************************//**
+Merges the sorted part slot->other into the sorted part slot.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_sort_join(
+/*================*/
+	row_merge_sort_slot_t*	slot)	/*!< in/out: part to merge into */
+{
+	merge_file_t	of;
+	ulint		foffs0 = 0;
+	ulint		foffs1 = 0;
+	dberr_t		error;
+
+	if (trx_is_interrupted(slot->trx)) {
+		return(DB_INTERRUPTED);
+	}
+
+	of.fd = slot->tmpfd;
+	of.offset = 0;
+	of.n_rec = 0;
+
+	error = row_merge_blocks(slot->dup, &slot->file, &slot->other->file,
+				 slot->block, &foffs0, &foffs1, &of);
+
+	if (error == DB_SUCCESS
+	    && of.n_rec != slot->file.n_rec + slot->other->file.n_rec) {
+		error = DB_CORRUPTION;
+	}
+
+	if (error == DB_SUCCESS) {
+		slot->tmpfd = slot->file.fd;
+		slot->file = of;
+	}
+
+	return(error);
+}
+
+/*********************************************************************//**
+Thread that sorts or merges one part of row_merge_sort_pll().
+@return	a dummy parameter */
+static
+os_thread_ret_t
+row_merge_sort_thread(
+/*==================*/
+	void*	arg)	/*!< in/out: row_merge_sort_slot_t */
+{
+	row_merge_sort_slot_t*	slot = static_cast<row_merge_sort_slot_t*>(
+		arg);
+
+	slot->error = slot->other != NULL
+		? row_merge_sort_join(slot)
+		: row_merge_sort_range(slot);
+
+	os_event_set(slot->done);
+
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Runs row_merge_sort_thread() for the parts that have work to do and
+waits for them. The calling thread works on slots[0] itself. When
+merging, only the parts with another part to merge have work to do.
+@return	DB_SUCCESS or the first error */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_sort_pll_run(
+/*===================*/
+	row_merge_sort_slot_t*	slots,	/*!< in/out: parts */
+	ulint			n_slots,/*!< in: number of parts */
+	bool			join)	/*!< in: true to merge parts,
+					false to sort the ranges */
+{
+	dberr_t	error = DB_SUCCESS;
+	ulint	i;
+
+	for (i = 1; i < n_slots; i++) {
+		if (!join || slots[i].other != NULL) {
+			os_event_reset(slots[i].done);
+			os_thread_create(row_merge_sort_thread, &slots[i],
+					 NULL);
+		}
+	}
+
+	ut_ad(!join || slots[0].other != NULL);
+
+	slots[0].error = join
+		? row_merge_sort_join(&slots[0])
+		: row_merge_sort_range(&slots[0]);
+
+	for (i = 0; i < n_slots; i++) {
+		if (join && slots[i].other == NULL) {
+			continue;
+		}
+
+		if (i > 0) {
+			os_event_wait(slots[i].done);
+		}
+
+		if (error == DB_SUCCESS) {
+			error = slots[i].error;
+		}
+	}
+
+	return(error);
+}
+
+/*************************************************************//**
+Merge disk files, splitting the work between up to n_threads threads.
+The initial runs are split into ranges that the threads sort into
+files of their own, and the sorted ranges are then merged pairwise, in
+parallel while there is more than one pair. A duplicate in a unique
+index is reported by sorting the file again with row_merge_sort(), so
+that the duplicate row is reported to the MySQL table by one thread.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_sort_pll(
+/*===============*/
+	trx_t*			trx,	/*!< in: transaction */
+	const row_merge_dup_t*	dup,	/*!< in: descriptor of
+					index being created */
+	merge_file_t*		file,	/*!< in/out: file containing
+					index entries */
+	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
+	int*			tmpfd,	/*!< in/out: temporary file handle */
+	ulint			n_threads)/*!< in: maximum number of
+					threads */
+{
+	row_merge_sort_slot_t*	slots;
+	row_merge_dup_t		pll_dup = *dup;
+	const char*		path;
+	ulint			n_slots;
+	ulint			i;
+	dberr_t			error;
+	DBUG_ENTER("row_merge_sort_pll");
+
+	/* Every part gets at least two initial runs to merge. */
+	n_slots = ut_min(n_threads, file->offset / 2);
+
+	if (n_slots < 2) {
+		DBUG_RETURN(row_merge_sort(trx, dup, file, block, tmpfd));
+	}
+
+	/* The threads must not write to the MySQL row buffer. */
+	pll_dup.table = NULL;
+
+	slots = static_cast<row_merge_sort_slot_t*>(
+		mem_zalloc(n_slots * sizeof *slots));
+
+	/* Allocate the buffers and temporary files here, so that a
+	shortage only reduces the number of parts. */
+	path = thd_innodb_tmpdir(trx->mysql_thd);
+
+	for (i = 0; i < n_slots; i++) {
+		row_merge_sort_slot_t*	slot = &slots[i];
+
+		if (i == 0) {
+			slot->block = block;
+		} else {
+			slot->block_size = 3 * srv_sort_buf_size;
+			slot->block = static_cast<row_merge_block_t*>(
+				os_mem_alloc_large(&slot->block_size, FALSE));
+
+			if (slot->block == NULL) {
+				break;
+			}
+		}
+
+		row_merge_file_create(&slot->file, path);
+		slot->tmpfd = row_merge_file_create_low(path);
+
+		if (slot->file.fd < 0 || slot->tmpfd < 0) {
+			row_merge_file_destroy(&slot->file);
+
+			if (slot->tmpfd >= 0) {
+				row_merge_file_destroy_low(slot->tmpfd);
+			}
+
+			if (slot->block_size > 0) {
+				os_mem_free_large(slot->block,
+						  slot->block_size);
+			}
+
+			break;
+		}
+
+		slot->done = os_event_create();
+	}
+
+	n_slots = i;
+
+	for (i = 0; i < n_slots; i++) {
+		row_merge_sort_slot_t*	slot = &slots[i];
+
+		slot->trx = trx;
+		slot->dup = &pll_dup;
+		slot->input = file;
+		slot->first = file->offset * i / n_slots;
+		slot->last = file->offset * (i + 1) / n_slots;
+	}
+
+	if (n_slots < 2) {
+		error = DB_OUT_OF_MEMORY;
+	} else {
+		error = row_merge_sort_pll_run(slots, n_slots, false);
+	}
+
+	for (ulint step = 1; error == DB_SUCCESS && step < n_slots;
+	     step *= 2) {
+		for (i = 0; i + step < n_slots; i += 2 * step) {
+			slots[i].other = &slots[i + step];
+		}
+
+		error = row_merge_sort_pll_run(slots, n_slots, true);
+
+		/* Close the files of the parts that were merged into
+		others to free up space. */
+		for (i = 0; i + step < n_slots; i += 2 * step) {
+			row_merge_sort_slot_t*	other = slots[i].other;
+
+			row_merge_file_destroy(&other->file);
+			row_merge_file_destroy_low(other->tmpfd);
+			other->tmpfd = -1;
+			slots[i].other = NULL;
+		}
+	}
+
+	if (error == DB_SUCCESS && slots[0].file.n_rec != file->n_rec) {
+		error = DB_CORRUPTION;
+	}
+
+	if (error == DB_SUCCESS) {
+		/* Replace the input with the sorted file. */
+		row_merge_file_destroy_low(file->fd);
+		row_merge_file_destroy_low(*tmpfd);
+		*file = slots[0].file;
+		*tmpfd = slots[0].tmpfd;
+		slots[0].file.fd = -1;
+		slots[0].tmpfd = -1;
+	}
+
+	for (i = 0; i < n_slots; i++) {
+		row_merge_file_destroy(&slots[i].file);
+
+		if (slots[i].tmpfd >= 0) {
+			row_merge_file_destroy_low(slots[i].tmpfd);
+		}
+
+		os_event_free(slots[i].done);
+
+		if (slots[i].block_size > 0) {
+			os_mem_free_large(slots[i].block,
+					  slots[i].block_size);
+		}
+	}
+
+	mem_free(slots);
+
+	/* The input is unchanged unless the sort succeeded. */
+	if (error == DB_OUT_OF_MEMORY
+	    || (error == DB_DUPLICATE_KEY && dup->table != NULL)) {
+		error = row_merge_sort(trx, dup, file, block, tmpfd);
+	}
+
+	DBUG_RETURN(error);
+}
+
 /*************************************************************//**
 Copy externally stored columns to the data tuple. */
 static MY_ATTRIBUTE((nonnull))
@@ -3605,6 +3963,356 @@ row_merge_drop_table(
 	return(row_drop_table_for_mysql(table->name, trx, false, false));
 }
 
+/** State of an index in row_merge_build_indexes() when the sorting and
+loading of the index entries is shared with worker threads */
+enum row_merge_pll_state_t {
+	ROW_MERGE_PLL_SERIAL,	/*!< built by row_merge_build_indexes()
+				itself */
+	ROW_MERGE_PLL_QUEUED,	/*!< may be claimed by any thread */
+	ROW_MERGE_PLL_CLAIMED,	/*!< being sorted and loaded */
+	ROW_MERGE_PLL_DONE	/*!< sorted and loaded, or failed */
+};
+
+struct row_merge_pll_t;
+
+/** Private resources of a row_merge_pll_thread() worker */
+struct row_merge_pll_slot_t {
+	row_merge_pll_t*	pll;	/*!< shared state */
+	row_merge_block_t*	block;	/*!< 3 buffers */
+	ulint			block_size;/*!< size of block */
+	int			tmpfd;	/*!< temporary file handle */
+};
+
+/** Indexes shared out between row_merge_build_indexes() and the
+row_merge_pll_thread() workers. Only the indexes that cannot report
+duplicates are queued, because reporting a duplicate writes to the
+MySQL row buffer of the table. */
+struct row_merge_pll_t {
+	os_ib_mutex_t		mutex;	/*!< protects state, errors,
+					next, n_running and abort */
+	os_event_t		event;	/*!< set when an index is done
+					or a worker exits */
+	trx_t*			trx;	/*!< transaction */
+	const dict_table_t*	old_table;/*!< table where rows are
+					read from */
+	struct TABLE*		table;	/*!< MySQL table */
+	const ulint*		col_map;/*!< mapping of old column
+					numbers to new ones, or NULL */
+	dict_index_t**		indexes;/*!< indexes to be created */
+	merge_file_t*		merge_files;/*!< files containing the
+					index entries */
+	ulint			n_indexes;/*!< size of indexes[] */
+	row_merge_pll_state_t*	state;	/*!< state of each index */
+	dberr_t*		errors;	/*!< result of each index in
+					state ROW_MERGE_PLL_DONE */
+	ulint			next;	/*!< no index before this one
+					is in state ROW_MERGE_PLL_QUEUED */
+	ulint			n_running;/*!< workers that have not
+					exited */
+	bool			abort;	/*!< true if no more indexes
+					may be claimed */
+	row_merge_pll_slot_t*	slots;	/*!< one slot per worker */
+	ulint			n_slots;/*!< size of slots[] */
+};
+
+/*********************************************************************//**
+Sorts the entries of a claimed index and inserts them into the index.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull))
+dberr_t
+row_merge_pll_build(
+/*================*/
+	row_merge_pll_t*	pll,	/*!< in/out: shared state */
+	ulint			i,	/*!< in: index claimed by the
+					caller */
+	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
+	int*			tmpfd)	/*!< in/out: temporary file handle */
+{
+	/* The index is not unique, so row_merge_sort() will not report
+	duplicates to pll->table. */
+	row_merge_dup_t	dup = {
+		pll->indexes[i], pll->table, pll->col_map, 0};
+	dberr_t		error;
+
+	ut_ad(!dict_index_is_unique(pll->indexes[i]));
+
+	error = row_merge_sort(
+		pll->trx, &dup, &pll->merge_files[i], block, tmpfd);
+
+	if (error == DB_SUCCESS) {
+		error = row_merge_insert_index_tuples(
+			pll->trx->id, pll->indexes[i], pll->old_table,
+			pll->merge_files[i].fd, block);
+	}
+
+	os_mutex_enter(pll->mutex);
+
+	ut_ad(pll->state[i] == ROW_MERGE_PLL_CLAIMED);
+	pll->state[i] = ROW_MERGE_PLL_DONE;
+	pll->errors[i] = error;
+
+	if (error != DB_SUCCESS) {
+		pll->abort = true;
+	}
+
+	os_event_set(pll->event);
+	os_mutex_exit(pll->mutex);
+
+	return(error);
+}
+
+/*********************************************************************//**
+Claims the first queued index.
+@return	index number, or ULINT_UNDEFINED if none can be claimed */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+ulint
+row_merge_pll_claim(
+/*================*/
+	row_merge_pll_t*	pll)	/*!< in/out: shared state */
+{
+	ulint	i = ULINT_UNDEFINED;
+
+	os_mutex_enter(pll->mutex);
+
+	for (; !pll->abort && pll->next < pll->n_indexes; pll->next++) {
+		if (pll->state[pll->next] == ROW_MERGE_PLL_QUEUED) {
+			i = pll->next++;
+			pll->state[i] = ROW_MERGE_PLL_CLAIMED;
+			break;
+		}
+	}
+
+	os_mutex_exit(pll->mutex);
+
+	return(i);
+}
+
+/*********************************************************************//**
+Worker thread that sorts and loads queued indexes until none is left.
+@return	a dummy parameter */
+static
+os_thread_ret_t
+row_merge_pll_thread(
+/*=================*/
+	void*	arg)	/*!< in/out: row_merge_pll_slot_t of the worker */
+{
+	row_merge_pll_slot_t*	slot = static_cast<row_merge_pll_slot_t*>(
+		arg);
+	row_merge_pll_t*	pll = slot->pll;
+	ulint			i;
+
+	while ((i = row_merge_pll_claim(pll)) != ULINT_UNDEFINED) {
+		if (row_merge_pll_build(pll, i, slot->block, &slot->tmpfd)
+		    != DB_SUCCESS) {
+			break;
+		}
+	}
+
+	/* The shared state may be freed as soon as the mutex is
+	released, do not touch it after that. */
+	os_mutex_enter(pll->mutex);
+	pll->n_running--;
+	os_event_set(pll->event);
+	os_mutex_exit(pll->mutex);
+
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Queues the non-unique indexes whose entries are to be sorted and loaded
+and starts up to srv_merge_sort_threads - 1 workers for them. The remaining
+indexes are built by row_merge_build_indexes() in the meantime.
+@return	shared state, or NULL if the indexes are to be built serially */
+static MY_ATTRIBUTE((nonnull(1,2,5,6), warn_unused_result))
+row_merge_pll_t*
+row_merge_pll_create(
+/*=================*/
+	trx_t*			trx,		/*!< in: transaction */
+	const dict_table_t*	old_table,	/*!< in: table where rows
+						are read from */
+	struct TABLE*		table,		/*!< in: MySQL table */
+	const ulint*		col_map,	/*!< in: mapping of old
+						column numbers to new ones,
+						or NULL */
+	dict_index_t**		indexes,	/*!< in: indexes to be
+						created */
+	merge_file_t*		merge_files,	/*!< in/out: files
+						containing the index
+						entries */
+	ulint			n_indexes)	/*!< in: size of indexes[] */
+{
+	row_merge_pll_t*	pll;
+	const char*		path;
+	ulint			n_queued = 0;
+	ulint			n_slots;
+	ulint			i;
+
+	for (i = 0; i < n_indexes; i++) {
+		if (!(indexes[i]->type & DICT_FTS)
+		    && !dict_index_is_unique(indexes[i])
+		    && merge_files[i].fd != -1) {
+			n_queued++;
+		}
+	}
+
+	n_slots = ut_min(srv_merge_sort_threads - 1, n_queued);
+
+	if (n_slots == 0 || n_indexes < 2) {
+		return(NULL);
+	}
+
+	pll = static_cast<row_merge_pll_t*>(mem_zalloc(sizeof *pll));
+	pll->trx = trx;
+	pll->old_table = old_table;
+	pll->table = table;
+	pll->col_map = col_map;
+	pll->indexes = indexes;
+	pll->merge_files = merge_files;
+	pll->n_indexes = n_indexes;
+	pll->state = static_cast<row_merge_pll_state_t*>(
+		mem_alloc(n_indexes * sizeof *pll->state));
+	pll->errors = static_cast<dberr_t*>(
+		mem_alloc(n_indexes * sizeof *pll->errors));
+	pll->slots = static_cast<row_merge_pll_slot_t*>(
+		mem_alloc(n_slots * sizeof *pll->slots));
+
+	for (i = 0; i < n_indexes; i++) {
+		pll->state[i] = (!(indexes[i]->type & DICT_FTS)
+				 && !dict_index_is_unique(indexes[i])
+				 && merge_files[i].fd != -1)
+			? ROW_MERGE_PLL_QUEUED
+			: ROW_MERGE_PLL_SERIAL;
+		pll->errors[i] = DB_SUCCESS;
+	}
+
+	/* Allocate the buffers and temporary files of the workers here,
+	so that a shortage only reduces the number of workers. */
+	path = thd_innodb_tmpdir(trx->mysql_thd);
+
+	for (i = 0; i < n_slots; i++) {
+		row_merge_pll_slot_t*	slot = &pll->slots[i];
+
+		slot->pll = pll;
+		slot->block_size = 3 * srv_sort_buf_size;
+		slot->block = static_cast<row_merge_block_t*>(
+			os_mem_alloc_large(&slot->block_size, FALSE));
+
+		if (slot->block == NULL) {
+			break;
+		}
+
+		slot->tmpfd = row_merge_file_create_low(path);
+
+		if (slot->tmpfd < 0) {
+			os_mem_free_large(slot->block, slot->block_size);
+			break;
+		}
+	}
+
+	pll->n_slots = i;
+
+	if (pll->n_slots == 0) {
+		mem_free(pll->slots);
+		mem_free(pll->errors);
+		mem_free(pll->state);
+		mem_free(pll);
+		return(NULL);
+	}
+
+	pll->mutex = os_mutex_create();
+	pll->event = os_event_create();
+	pll->n_running = pll->n_slots;
+
+	for (i = 0; i < pll->n_slots; i++) {
+		os_thread_create(row_merge_pll_thread, &pll->slots[i], NULL);
+	}
+
+	return(pll);
+}
+
+/*********************************************************************//**
+Gets the result of a queued index. The index is sorted and loaded by
+the calling thread unless a worker has claimed it, in which case this
+waits for the worker to finish it.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull))
+dberr_t
+row_merge_pll_wait(
+/*===============*/
+	row_merge_pll_t*	pll,	/*!< in/out: shared state */
+	ulint			i,	/*!< in: queued index */
+	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
+	int*			tmpfd)	/*!< in/out: temporary file handle */
+{
+	dberr_t	error;
+
+	os_mutex_enter(pll->mutex);
+
+	ut_ad(pll->state[i] != ROW_MERGE_PLL_SERIAL);
+
+	if (pll->state[i] == ROW_MERGE_PLL_QUEUED) {
+		pll->state[i] = ROW_MERGE_PLL_CLAIMED;
+		os_mutex_exit(pll->mutex);
+
+		return(row_merge_pll_build(pll, i, block, tmpfd));
+	}
+
+	while (pll->state[i] != ROW_MERGE_PLL_DONE) {
+		ib_int64_t	sig_count = os_event_reset(pll->event);
+
+		os_mutex_exit(pll->mutex);
+		os_event_wait_low(pll->event, sig_count);
+		os_mutex_enter(pll->mutex);
+	}
+
+	error = pll->errors[i];
+
+	os_mutex_exit(pll->mutex);
+
+	return(error);
+}
+
+/*********************************************************************//**
+Stops the workers from claiming more indexes, waits for them to exit
+and frees the shared state. */
+static MY_ATTRIBUTE((nonnull))
+void
+row_merge_pll_free(
+/*===============*/
+	row_merge_pll_t*	pll)	/*!< in,own: shared state */
+{
+	ulint	i;
+
+	os_mutex_enter(pll->mutex);
+
+	pll->abort = true;
+
+	while (pll->n_running > 0) {
+		ib_int64_t	sig_count = os_event_reset(pll->event);
+
+		os_mutex_exit(pll->mutex);
+		os_event_wait_low(pll->event, sig_count);
+		os_mutex_enter(pll->mutex);
+	}
+
+	os_mutex_exit(pll->mutex);
+
+	for (i = 0; i < pll->n_slots; i++) {
+		row_merge_file_destroy_low(pll->slots[i].tmpfd);
+		os_mem_free_large(pll->slots[i].block,
+				  pll->slots[i].block_size);
+	}
+
+	os_event_free(pll->event);
+	os_mutex_free(pll->mutex);
+	mem_free(pll->slots);
+	mem_free(pll->errors);
+	mem_free(pll->state);
+	mem_free(pll);
+}
+
 /*********************************************************************//**
 Build indexes on a table by reading a clustered index,
 creating a temporary file containing index entries, merge sorting
@@ -3651,6 +4359,7 @@ row_merge_build_indexes(
 	fts_psort_t*		merge_info = NULL;
 	ib_int64_t		sig_count = 0;
 	bool			fts_psort_initiated = false;
+	row_merge_pll_t*	pll = NULL;
 	DBUG_ENTER("row_merge_build_indexes");
 
 	ut_ad(!srv_read_only_mode);
@@ -3731,7 +4440,12 @@ row_merge_build_indexes(
 	DEBUG_SYNC_C("row_merge_after_scan");
 
 	/* Now we have files containing index entries ready for
-	sorting and inserting. */
+	sorting and inserting. Share the non-unique indexes out to
+	worker threads if innodb_merge_sort_threads allows it. */
+
+	pll = row_merge_pll_create(
+		trx, old_table, table, col_map, indexes, merge_files,
+		n_indexes);
 
 	for (i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
@@ -3809,13 +4523,17 @@ wait_again:
 #ifdef FTS_INTERNAL_DIAG_PRINT
 			DEBUG_FTS_SORT_PRINT("FTS_SORT: Complete Insert\n");
 #endif
+		} else if (pll != NULL
+			   && pll->state[i] != ROW_MERGE_PLL_SERIAL) {
+			error = row_merge_pll_wait(
+				pll, i, block, &tmpfd);
 		} else if (merge_files[i].fd != -1) {
 			row_merge_dup_t	dup = {
 				sort_idx, table, col_map, 0};
 
-			error = row_merge_sort(
+			error = row_merge_sort_pll(
 				trx, &dup, &merge_files[i],
-				block, &tmpfd);
+				block, &tmpfd, srv_merge_sort_threads);
 
 			if (error == DB_SUCCESS) {
 				error = row_merge_insert_index_tuples(
@@ -3861,6 +4579,10 @@ wait_again:
 	}
 
 func_exit:
+	if (pll != NULL) {
+		row_merge_pll_free(pll);
+	}
+
 	DBUG_EXECUTE_IF(
 		"ib_build_indexes_too_many_concurrent_trxs",
 		error = DB_TOO_MANY_CONCURRENT_TRXS;
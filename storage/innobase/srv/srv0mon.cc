@@ -34,6 +34,8 @@ Created 12/9/2009 Jimmy Yang
 #include "trx0rseg.h"
 #include "lock0lock.h"
 #include "ibuf0ibuf.h"
+#include "btr0sea.h"
+#include "buf0flu.h"
 #ifdef UNIV_NONINL
 #include "srv0mon.ic"
 #endif
@@ -452,6 +454,41 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_SET_MEMBER, MONITOR_FLUSH_BACKGROUND_TOTAL_PAGE,
 	 MONITOR_FLUSH_BACKGROUND_PAGES},
 
+#define MONITOR_PAGE_CLEANER_INFO(n)					\
+	{"buffer_flush_page_cleaner" #n "_pages", "buffer",		\
+	 "Pages flushed from the flush lists by page cleaner thread " #n \
+	 " (0 is the coordinator)",					\
+	 MONITOR_EXISTING,						\
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_PAGE_CLEANER##n##_PAGES},	\
+									\
+	{"buffer_flush_page_cleaner" #n "_lag", "buffer",		\
+	 "Milliseconds from the start of the last flush round to the"	\
+	 " end of the share of page cleaner thread " #n,		\
+	 static_cast<monitor_type_t>(					\
+	 MONITOR_EXISTING | MONITOR_DISPLAY_CURRENT),			\
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_PAGE_CLEANER##n##_LAG}
+
+#if BUF_FLUSH_PAGE_CLEANERS_MAX != 16
+# error "MONITOR_PAGE_CLEANER_INFO() must be listed for every thread"
+#endif
+
+	MONITOR_PAGE_CLEANER_INFO(0),
+	MONITOR_PAGE_CLEANER_INFO(1),
+	MONITOR_PAGE_CLEANER_INFO(2),
+	MONITOR_PAGE_CLEANER_INFO(3),
+	MONITOR_PAGE_CLEANER_INFO(4),
+	MONITOR_PAGE_CLEANER_INFO(5),
+	MONITOR_PAGE_CLEANER_INFO(6),
+	MONITOR_PAGE_CLEANER_INFO(7),
+	MONITOR_PAGE_CLEANER_INFO(8),
+	MONITOR_PAGE_CLEANER_INFO(9),
+	MONITOR_PAGE_CLEANER_INFO(10),
+	MONITOR_PAGE_CLEANER_INFO(11),
+	MONITOR_PAGE_CLEANER_INFO(12),
+	MONITOR_PAGE_CLEANER_INFO(13),
+	MONITOR_PAGE_CLEANER_INFO(14),
+	MONITOR_PAGE_CLEANER_INFO(15),
+
 	/* Cumulative counter for LRU batch scan */
 	{"buffer_LRU_batch_scanned", "buffer",
 	 "Total pages scanned as part of LRU batch",
@@ -989,6 +1026,47 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_ROW_UPDATED},
 
+#define MONITOR_AHI_PART_INFO(n)					\
+	{"adaptive_hash_part" #n "_searches", "adaptive_hash_index",	\
+	 "Number of successful searches in Adaptive Hash Index"		\
+	 " partition " #n,						\
+	 MONITOR_EXISTING,						\
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART##n##_SEARCH},\
+									\
+	{"adaptive_hash_part" #n "_misses", "adaptive_hash_index",	\
+	 "Number of failed searches in Adaptive Hash Index"		\
+	 " partition " #n,						\
+	 MONITOR_EXISTING,						\
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART##n##_MISS},	\
+									\
+	{"adaptive_hash_part" #n "_latch_waits", "adaptive_hash_index",	\
+	 "Number of OS waits on the latch of Adaptive Hash Index"	\
+	 " partition " #n,						\
+	 MONITOR_EXISTING,						\
+	 MONITOR_DEFAULT_START,						\
+	 MONITOR_OVLD_ADAPTIVE_HASH_PART##n##_LATCH_WAIT}
+
+#if BTR_AHI_PARTS_MAX != 16
+# error "MONITOR_AHI_PART_INFO() must be listed for every partition"
+#endif
+
+	MONITOR_AHI_PART_INFO(0),
+	MONITOR_AHI_PART_INFO(1),
+	MONITOR_AHI_PART_INFO(2),
+	MONITOR_AHI_PART_INFO(3),
+	MONITOR_AHI_PART_INFO(4),
+	MONITOR_AHI_PART_INFO(5),
+	MONITOR_AHI_PART_INFO(6),
+	MONITOR_AHI_PART_INFO(7),
+	MONITOR_AHI_PART_INFO(8),
+	MONITOR_AHI_PART_INFO(9),
+	MONITOR_AHI_PART_INFO(10),
+	MONITOR_AHI_PART_INFO(11),
+	MONITOR_AHI_PART_INFO(12),
+	MONITOR_AHI_PART_INFO(13),
+	MONITOR_AHI_PART_INFO(14),
+	MONITOR_AHI_PART_INFO(15),
+
 	/* ========== Counters for tablespace ========== */
 	{"module_file", "file_system", "Tablespace and File System Manager",
 	 MONITOR_MODULE,
@@ -1887,6 +1965,58 @@ srv_mon_process_existing_counter(
 		break;
 
 	default:
+		if (monitor_id >= MONITOR_OVLD_PAGE_CLEANER0_PAGES
+		    && monitor_id <= MONITOR_OVLD_PAGE_CLEANER15_LAG) {
+			ulint	offset = monitor_id
+				- MONITOR_OVLD_PAGE_CLEANER0_PAGES;
+			ulint	n_flushed;
+			ulint	lag;
+
+			value = 0;
+
+			/* Threads beyond srv_n_page_cleaners do not exist */
+			if (!buf_flush_page_cleaner_stats(
+				    offset / MONITOR_PAGE_CLEANER_N_COUNTERS,
+				    &n_flushed, &lag)) {
+				break;
+			}
+
+			value = offset % MONITOR_PAGE_CLEANER_N_COUNTERS
+				? lag : n_flushed;
+			break;
+		}
+
+		if (monitor_id >= MONITOR_OVLD_ADAPTIVE_HASH_PART0_SEARCH
+		    && monitor_id
+		    <= MONITOR_OVLD_ADAPTIVE_HASH_PART15_LATCH_WAIT) {
+			ulint	offset = monitor_id
+				- MONITOR_OVLD_ADAPTIVE_HASH_PART0_SEARCH;
+			ulint	part = offset / MONITOR_AHI_N_PART_COUNTERS;
+
+			value = 0;
+
+			/* Partitions beyond btr_ahi_parts do not exist */
+			if (part >= btr_ahi_parts || !btr_search_sys) {
+				break;
+			}
+
+			switch (offset % MONITOR_AHI_N_PART_COUNTERS) {
+			case 0:
+				value = btr_search_sys->part_stats[part]
+					.n_searches;
+				break;
+			case 1:
+				value = btr_search_sys->part_stats[part]
+					.n_misses;
+				break;
+			case 2:
+				value = btr_search_latches[part]
+					->count_os_wait;
+				break;
+			}
+			break;
+		}
+
 		ut_error;
 	}
 
@@ -142,6 +142,9 @@ on duplicate key checking and foreign key checking */
 UNIV_INTERN ibool	srv_locks_unsafe_for_binlog = FALSE;
 /** Sort buffer size in index creation */
 UNIV_INTERN ulong	srv_sort_buf_size = 1048576;
+/** Maximum number of threads that merge sort the index entries of one
+index creation; the clustered index is scanned by one thread */
+UNIV_INTERN ulong	srv_merge_sort_threads = 1;
 /** Maximum modification log file size for online index creation */
 UNIV_INTERN unsigned long long	srv_online_max_size;
 
@@ -150,6 +153,12 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 UNIV_INTERN my_bool	srv_use_native_aio = TRUE;
+/* If this flag is TRUE, Linux native aio is done through io_uring
+instead of libaio, provided InnoDB was compiled with liburing */
+UNIV_INTERN my_bool	srv_use_io_uring = FALSE;
+/* If this flag is TRUE, the io_uring instances of the read and write
+i/o threads poll for completions instead of waiting for interrupts */
+UNIV_INTERN my_bool	srv_io_uring_poll = FALSE;
 UNIV_INTERN my_bool	srv_numa_interleave = FALSE;
 
 #ifdef __WIN__
@@ -242,6 +251,10 @@ ulint	srv_buf_pool_base_size	= 0;
 UNIV_INTERN ulint	srv_buf_pool_curr_size	= 0;
 /* dump that may % of each buffer pool during BP dump */
 UNIV_INTERN ulong srv_buf_pool_dump_pct;
+/* write the BP dump in the compressed format */
+UNIV_INTERN my_bool srv_buf_pool_dump_compressed;
+/* seconds between background BP dumps, 0 if disabled */
+UNIV_INTERN ulong srv_buf_pool_dump_interval;
 /* requested size (number) */
 UNIV_INTERN ulint	srv_sync_pool_size	= 1024;
 /* size in bytes */
@@ -326,6 +339,9 @@ UNIV_INTERN ulong	srv_flushing_avg_loops		= 30;
 /* The number of purge threads to use.*/
 UNIV_INTERN ulong	srv_n_purge_threads = 1;
 
+/* The number of page cleaner threads, including the coordinator. */
+UNIV_INTERN ulong	srv_n_page_cleaners = 1;
+
 /* the number of pages to purge in one batch */
 UNIV_INTERN ulong	srv_purge_batch_size = 20;
 
@@ -481,6 +497,11 @@ batch flushing i.e.: LRU flushing and flush_list flushing. The rest
 of the pages are used for single page flushing. */
 UNIV_INTERN ulong	srv_doublewrite_batch_size	= 120;
 
+/** If true, LRU and flush list batches are written to the regions of the
+parallel doublewrite file of their buffer pool instance instead of the
+doublewrite buffer in the system tablespace. */
+UNIV_INTERN my_bool	srv_parallel_doublewrite	= FALSE;
+
 UNIV_INTERN ulong	srv_replication_delay		= 0;
 
 #ifdef XTRABACKUP
@@ -1442,7 +1463,10 @@ srv_printf_innodb_monitor(
 		      "-------------------------------------\n", file);
 		ibuf_print(file);
 
-		ha_print_info(file, btr_search_sys->hash_index);
+		/* One line per adaptive hash index partition */
+		for (ulint i = 0; i < btr_ahi_parts; ++i) {
+			ha_print_info(file, btr_search_sys->hash_tables[i]);
+		}
 
 		fprintf(file,
 			"%.2f hash searches/s, %.2f non-hash searches/s\n",
@@ -1487,9 +1511,9 @@ srv_printf_innodb_monitor(
 				(long) srv_conc_get_active_threads(),
 				srv_conc_get_waiting_threads());
 
-		/* This is a dirty read, without holding trx_sys->mutex. */
+		/* This is a dirty read, without holding any mutex. */
 		fprintf(file, "%lu read views open inside InnoDB\n",
-			UT_LIST_GET_LEN(trx_sys->view_list));
+			read_view_get_n_open());
 
 		n_reserved = fil_space_get_n_reserved_extents(0);
 		if (n_reserved > 0) {
@@ -1898,6 +1922,11 @@ srv_export_innodb_status(void)
 
 	export_vars.innodb_dblwr_writes = srv_stats.dblwr_writes;
 
+	export_vars.innodb_dblwr_batch_waits = srv_stats.dblwr_batch_waits;
+
+	export_vars.innodb_dblwr_single_page_waits =
+		srv_stats.dblwr_single_page_waits;
+
 	export_vars.innodb_pages_created = stat.n_pages_created;
 
 	export_vars.innodb_pages_read = stat.n_pages_read;
@@ -2090,7 +2119,16 @@ srv_export_innodb_status(void)
 		srv_stats.n_logical_read_ahead_in_buf_pool;
 
 	for (i = 0; i < PAGE_ZIP_SSIZE_MAX - 1; i++) {
-		page_zip_stat_t*        zip_stat = &page_zip_stat[i];
+		page_zip_stat_t		zip_stat_sum;
+		page_zip_stat_t*        zip_stat = &zip_stat_sum;
+
+		/* Report the sum over all compression algorithms. */
+		memset(zip_stat, 0, sizeof *zip_stat);
+		for (ulint algorithm = 0;
+		     algorithm < PAGE_ZIP_ALGORITHM_MAX;
+		     algorithm++) {
+			zip_stat->add(page_zip_stat[algorithm][i]);
+		}
 
 		ulint page_size = UNIV_ZIP_SIZE_MIN << i;
 
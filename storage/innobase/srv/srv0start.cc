@@ -1890,7 +1890,7 @@ innobase_start_or_create_for_mysql(void)
 			    + 1 /* dict_stats_thread */
 			    + 1 /* fts_optimize_thread */
 			    + 1 /* recv_writer_thread */
-			    + 1 /* buf_flush_page_cleaner_thread */
+			    + srv_n_page_cleaners /* page_cleaner threads */
 			    + 1 /* trx_rollback_or_clean_all_recovered */
 			    + 128 /* added as margin, for use of
 				  InnoDB Memcached etc. */
@@ -2748,6 +2748,11 @@ files_checked:
 		buf_dblwr_create();
 	}
 
+	/* Crash recovery has restored the pages of the parallel
+	doublewrite file and the page cleaner threads are not running
+	yet, so the file can be replaced now. */
+	buf_dblwr_parallel_init();
+
 	/* Here the double write buffer has already been created and so
 	any new rollback segments will be allocated after the double
 	write buffer. The default segment should already exist.
@@ -2854,7 +2859,14 @@ files_checked:
 	}
 
 	if (!srv_read_only_mode) {
+		buf_flush_page_cleaner_init();
+
 		os_thread_create(buf_flush_page_cleaner_thread, NULL, NULL);
+
+		for (i = 1; i < srv_n_page_cleaners; ++i) {
+			os_thread_create(
+				buf_flush_page_cleaner_worker, NULL, NULL);
+		}
 	}
 
 	os_thread_create(buf_flush_lru_manager_thread, NULL, NULL);
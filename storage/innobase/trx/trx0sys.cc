@@ -121,6 +121,7 @@ static const ulint	FILE_FORMAT_NAME_N
 /* Key to register the mutex with performance schema */
 UNIV_INTERN mysql_pfs_key_t	file_format_max_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	trx_sys_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	trx_sys_view_mutex_key;
 #endif /* UNIV_PFS_RWLOCK */
 
 #ifndef UNIV_HOTBACKUP
@@ -169,6 +170,153 @@ trx_in_trx_list(
 }
 #endif /* UNIV_DEBUG */
 
+/*****************************************************************//**
+Finds the slot of a transaction id in trx_sys->descr.
+@return	index of the first descriptor whose id is not smaller than id */
+static
+ulint
+trx_sys_descr_find(
+/*===============*/
+	trx_id_t	id)	/*!< in: transaction id */
+{
+	ulint	lower = 0;
+	ulint	upper = trx_sys->n_descr;
+
+	/* New transactions get the biggest id: try the end first. */
+	if (upper == 0 || trx_sys->descr[upper - 1].id < id) {
+		return(upper);
+	}
+
+	while (lower < upper) {
+		ulint	mid = (lower + upper) >> 1;
+
+		if (trx_sys->descr[mid].id < id) {
+			lower = mid + 1;
+		} else {
+			upper = mid;
+		}
+	}
+
+	return(lower);
+}
+
+/*****************************************************************//**
+Makes room for one more descriptor in trx_sys->descr. Must be called
+while holding trx_sys->mutex, before trx_sys_descr_write_begin(), so that
+read views never wait for a change that is allocating memory. */
+UNIV_INTERN
+void
+trx_sys_descr_reserve(void)
+/*=======================*/
+{
+	trx_descr_t*	new_descr;
+
+	ut_ad(mutex_own(&trx_sys->mutex));
+	ut_ad(!(trx_sys->descr_version & 1));
+
+	if (trx_sys->n_descr < trx_sys->descr_size) {
+		return;
+	}
+
+	ut_a(trx_sys->n_descr_old < TRX_SYS_DESCR_MAX_GROW);
+
+	new_descr = static_cast<trx_descr_t*>(
+		ut_malloc(2 * trx_sys->descr_size * sizeof(*new_descr)));
+
+	memcpy(new_descr, trx_sys->descr,
+	       trx_sys->n_descr * sizeof(*new_descr));
+
+	/* The contents do not change, so the version is not bumped.
+	A read view that is copying the old array either finishes with
+	the same contents or is restarted by the next change. The old
+	array is never written again and is only freed at shutdown,
+	because nothing tells when the last reader has left it. */
+
+	trx_sys->descr_old[trx_sys->n_descr_old++] = trx_sys->descr;
+
+	/* Make the copy visible before the new pointer. */
+	__atomic_store_n(&trx_sys->descr, new_descr, __ATOMIC_RELEASE);
+	trx_sys->descr_size *= 2;
+}
+
+/*****************************************************************//**
+Adds the descriptor of a read-write transaction to trx_sys->descr.
+Must be called between trx_sys_descr_write_begin() and
+trx_sys_descr_write_end(), after trx_sys_descr_reserve(). */
+UNIV_INTERN
+void
+trx_sys_descr_insert(
+/*=================*/
+	trx_id_t	id)	/*!< in: transaction id */
+{
+	ulint	i;
+
+	ut_ad(trx_sys->descr_version & 1);
+	ut_a(trx_sys->n_descr < trx_sys->descr_size);
+
+	i = trx_sys_descr_find(id);
+
+	ut_ad(i == trx_sys->n_descr || trx_sys->descr[i].id > id);
+
+	memmove(&trx_sys->descr[i + 1], &trx_sys->descr[i],
+		(trx_sys->n_descr - i) * sizeof(*trx_sys->descr));
+
+	trx_sys->descr[i].id = id;
+	trx_sys->descr[i].no = TRX_ID_MAX;
+
+	__atomic_store_n(&trx_sys->n_descr, trx_sys->n_descr + 1,
+			 __ATOMIC_RELAXED);
+}
+
+/*****************************************************************//**
+Removes the descriptor of a read-write transaction from trx_sys->descr.
+Must be called between trx_sys_descr_write_begin() and
+trx_sys_descr_write_end(). */
+UNIV_INTERN
+void
+trx_sys_descr_remove(
+/*=================*/
+	trx_id_t	id)	/*!< in: transaction id */
+{
+	ulint	i;
+
+	ut_ad(trx_sys->descr_version & 1);
+
+	i = trx_sys_descr_find(id);
+
+	ut_a(i < trx_sys->n_descr);
+	ut_a(trx_sys->descr[i].id == id);
+
+	__atomic_store_n(&trx_sys->n_descr, trx_sys->n_descr - 1,
+			 __ATOMIC_RELAXED);
+
+	memmove(&trx_sys->descr[i], &trx_sys->descr[i + 1],
+		(trx_sys->n_descr - i) * sizeof(*trx_sys->descr));
+}
+
+/*****************************************************************//**
+Stores the serialisation number of a committing read-write transaction
+in its descriptor. Must be called between trx_sys_descr_write_begin()
+and trx_sys_descr_write_end(). */
+UNIV_INTERN
+void
+trx_sys_descr_set_no(
+/*=================*/
+	trx_id_t	id,	/*!< in: transaction id */
+	trx_id_t	no)	/*!< in: transaction serialisation number */
+{
+	ulint	i;
+
+	ut_ad(trx_sys->descr_version & 1);
+
+	i = trx_sys_descr_find(id);
+
+	ut_a(i < trx_sys->n_descr);
+	ut_a(trx_sys->descr[i].id == id);
+
+	trx_sys->descr[i].no = no;
+}
+
 /*****************************************************************//**
 Writes the value of max_trx_id to the file based trx system header. */
 UNIV_INTERN
@@ -613,7 +761,9 @@ trx_sys_init_at_db_start(void)
 
 	mutex_exit(&trx_sys->mutex);
 
-	UT_LIST_INIT(trx_sys->view_list);
+	for (ulint i = 0; i < TRX_SYS_N_VIEW_SHARDS; ++i) {
+		UT_LIST_INIT(trx_sys->view_shards[i].view_list);
+	}
 
 	mtr_commit(&mtr);
 
@@ -633,6 +783,14 @@ trx_sys_create(void)
 
 	mutex_create(trx_sys_mutex_key, &trx_sys->mutex, SYNC_TRX_SYS);
 	mutex_create(trx_sys_mutex_key, &trx_sys->trx_memory_mutex, SYNC_TRX);
+	for (ulint i = 0; i < TRX_SYS_N_VIEW_SHARDS; ++i) {
+		mutex_create(trx_sys_view_mutex_key,
+			     &trx_sys->view_shards[i].mutex, SYNC_READ_VIEW);
+	}
+
+	trx_sys->descr_size = TRX_SYS_DESCR_INITIAL_SIZE;
+	trx_sys->descr = static_cast<trx_descr_t*>(
+		ut_malloc(trx_sys->descr_size * sizeof(*trx_sys->descr)));
 }
 
 /*****************************************************************//**
@@ -1205,18 +1363,14 @@ trx_sys_close(void)
 	/* Check that all read views are closed except read view owned
 	by a purge. */
 
-	mutex_enter(&trx_sys->mutex);
-
-	if (UT_LIST_GET_LEN(trx_sys->view_list) > 1) {
+	if (read_view_get_n_open() > 1) {
 		fprintf(stderr,
 			"InnoDB: Error: all read views were not closed"
 			" before shutdown:\n"
 			"InnoDB: %lu read views open \n",
-			UT_LIST_GET_LEN(trx_sys->view_list) - 1);
+			read_view_get_n_open() - 1);
 	}
 
-	mutex_exit(&trx_sys->mutex);
-
 	sess_close(trx_dummy_sess);
 	trx_dummy_sess = NULL;
 
@@ -1253,32 +1407,49 @@ trx_sys_close(void)
 		}
 	}
 
-	view = UT_LIST_GET_FIRST(trx_sys->view_list);
+	for (i = 0; i < TRX_SYS_N_VIEW_SHARDS; ++i) {
+		trx_view_shard_t*	shard = &trx_sys->view_shards[i];
 
-	while (view != NULL) {
-		read_view_t*	prev_view = view;
+		view = UT_LIST_GET_FIRST(shard->view_list);
 
-		view = UT_LIST_GET_NEXT(view_list, prev_view);
+		while (view != NULL) {
+			read_view_t*	prev_view = view;
 
-		/* Views are allocated from the trx_sys->global_read_view_heap.
-		So, we simply remove the element here. */
-		UT_LIST_REMOVE(view_list, trx_sys->view_list, prev_view);
+			view = UT_LIST_GET_NEXT(view_list, prev_view);
+
+			/* Views are allocated from the
+			trx_sys->global_read_view_heap. So, we simply
+			remove the element here. */
+			UT_LIST_REMOVE(view_list, shard->view_list,
+				       prev_view);
+		}
 	}
 
 #ifdef XTRABACKUP
 	if (!srv_apply_log_only) {
 #endif /* XTRABACKUP */
-	ut_a(UT_LIST_GET_LEN(trx_sys->view_list) == 0);
+	ut_a(read_view_get_n_open() == 0);
 	ut_a(UT_LIST_GET_LEN(trx_sys->ro_trx_list) == 0);
 	ut_a(UT_LIST_GET_LEN(trx_sys->rw_trx_list) == 0);
 	ut_a(UT_LIST_GET_LEN(trx_sys->mysql_trx_list) == 0);
+	ut_a(trx_sys->n_descr == 0);
 #ifdef XTRABACKUP
 	}
 #endif /* XTRABACKUP */
 
+	ut_free(trx_sys->descr);
+
+	for (i = 0; i < trx_sys->n_descr_old; ++i) {
+		ut_free(trx_sys->descr_old[i]);
+	}
+
 	mutex_free(&trx_sys->mutex);
 	mutex_free(&trx_sys->trx_memory_mutex);
 
+	for (i = 0; i < TRX_SYS_N_VIEW_SHARDS; ++i) {
+		mutex_free(&trx_sys->view_shards[i].mutex);
+	}
+
 	mem_free(trx_sys);
 
 #ifdef UNIV_DEBUG_VALGRIND
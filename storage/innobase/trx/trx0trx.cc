@@ -599,6 +599,12 @@ trx_free_prepared(
 
 	ut_a(!trx->read_only);
 
+	mutex_enter(&trx_sys->mutex);
+	trx_sys_descr_write_begin();
+	trx_sys_descr_remove(trx->id);
+	trx_sys_descr_write_end();
+	mutex_exit(&trx_sys->mutex);
+
 	UT_LIST_REMOVE(trx_list, trx_sys->rw_trx_list, trx);
 	ut_d(trx->in_rw_trx_list = FALSE);
 
@@ -679,6 +685,19 @@ trx_list_rw_insert_ordered(
 		UT_LIST_ADD_LAST(trx_list, trx_sys->rw_trx_list, trx);
 	}
 
+	/* Transactions that were committed before the crash are
+	visible to read views; trx_cleanup_at_db_startup() will
+	remove them from the list. */
+
+	if (!trx_state_eq(trx, TRX_STATE_COMMITTED_IN_MEMORY)) {
+		mutex_enter(&trx_sys->mutex);
+		trx_sys_descr_reserve();
+		trx_sys_descr_write_begin();
+		trx_sys_descr_insert(trx->id);
+		trx_sys_descr_write_end();
+		mutex_exit(&trx_sys->mutex);
+	}
+
 #ifdef UNIV_DEBUG
 	if (trx->id > trx_sys->rw_max_trx_id) {
 		trx_sys->rw_max_trx_id = trx->id;
@@ -1175,13 +1194,13 @@ trx_start_low(
 
 	trx->state = TRX_STATE_ACTIVE;
 
-	trx->id = trx_sys_get_new_trx_id();
-
 	ut_ad(!trx->in_rw_trx_list);
 	ut_ad(!trx->in_ro_trx_list);
 
 	if (trx->read_only) {
 
+		trx->id = trx_sys_get_new_trx_id();
+
 		/* Note: The trx_sys_t::ro_trx_list doesn't really need to
 		be ordered, we should exploit this using a list type that
 		doesn't need a list wide lock to increase concurrency. */
@@ -1196,6 +1215,21 @@ trx_start_low(
 		      || srv_force_recovery >= SRV_FORCE_NO_TRX_UNDO);
 
 		ut_ad(!trx_is_autocommit_non_locking(trx));
+
+		/* Read views copy trx_sys->max_trx_id and the
+		descriptors without trx_sys->mutex: the new id and its
+		descriptor must become visible to them together. */
+
+		trx_sys_descr_reserve();
+
+		trx_sys_descr_write_begin();
+
+		trx->id = trx_sys_get_new_trx_id();
+
+		trx_sys_descr_insert(trx->id);
+
+		trx_sys_descr_write_end();
+
 		UT_LIST_ADD_FIRST(trx_list, trx_sys->rw_trx_list, trx);
 		ut_d(trx->in_rw_trx_list = TRUE);
 #ifdef UNIV_DEBUG
@@ -1238,8 +1272,14 @@ trx_serialisation_number_get(
 
 	mutex_enter(&trx_sys->mutex);
 
+	trx_sys_descr_write_begin();
+
 	trx->no = trx_sys_get_new_trx_id();
 
+	trx_sys_descr_set_no(trx->id, trx->no);
+
+	trx_sys_descr_write_end();
+
 	/* If the rollack segment is not empty then the
 	new trx_t::no can't be less than any trx_t::no
 	already in the rollback segment. User threads only
@@ -1521,6 +1561,19 @@ trx_commit_in_memory(
 			srv_n_commit_all++;
 		}
 	} else {
+		if (!trx->read_only) {
+			/* Make the transaction visible to new read views
+			before releasing its locks, so that a transaction
+			that acquires one of them will see the changes in
+			its next read view. */
+
+			mutex_enter(&trx_sys->mutex);
+			trx_sys_descr_write_begin();
+			trx_sys_descr_remove(trx->id);
+			trx_sys_descr_write_end();
+			mutex_exit(&trx_sys->mutex);
+		}
+
 		lock_trx_release_locks(trx);
 
 		/* Remove the transaction from the list of active
@@ -1556,13 +1609,11 @@ trx_commit_in_memory(
 
 		trx->state = TRX_STATE_NOT_STARTED;
 
-		/* We already own the trx_sys_t::mutex, by doing it here we
-		avoid a potential context switch later. */
-		read_view_remove(trx->global_read_view, true);
-
 		ut_ad(trx_sys_validate_trx_list());
 
 		mutex_exit(&trx_sys->mutex);
+
+		read_view_remove(trx->global_read_view, false);
 	}
 
 	if (trx->global_read_view != NULL) {
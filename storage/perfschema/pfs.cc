@@ -4811,6 +4811,7 @@ static void end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
    Capture statement stats by digest.
   */
   const sql_digest_storage *digest_storage= NULL;
+  PFS_statements_digest_stat *digest_record= NULL;
   PFS_statement_stat *digest_stat= NULL;
 
   if (flags & STATE_FLAG_THREAD)
@@ -4828,9 +4829,9 @@ static void end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
       if (digest_storage != NULL)
       {
         /* Populate PFS_statements_digest_stat with computed digest information.*/
-        digest_stat= find_or_create_digest(thread, digest_storage,
-                                           state->m_schema_name,
-                                           state->m_schema_name_length);
+        digest_record= find_or_create_digest(thread, digest_storage,
+                                             state->m_schema_name,
+                                             state->m_schema_name_length);
       }
     }
 
@@ -4905,9 +4906,9 @@ static void end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
         if (digest_storage != NULL)
         {
           /* Populate statements_digest_stat with computed digest information. */
-          digest_stat= find_or_create_digest(thread, digest_storage,
-                                             state->m_schema_name,
-                                             state->m_schema_name_length);
+          digest_record= find_or_create_digest(thread, digest_storage,
+                                               state->m_schema_name,
+                                               state->m_schema_name_length);
         }
       }
     }
@@ -4945,6 +4946,9 @@ static void end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
   stat->m_no_index_used+= state->m_no_index_used;
   stat->m_no_good_index_used+= state->m_no_good_index_used;
 
+  if (digest_record != NULL)
+    digest_stat= & digest_record->m_stat;
+
   if (digest_stat != NULL)
   {
     if (flags & STATE_FLAG_TIMED)
@@ -5004,6 +5008,9 @@ static void end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
     case Diagnostics_area::DA_DISABLED:
       break;
   }
+
+  if (digest_record != NULL)
+    release_digest(digest_record);
 }
 
 /**
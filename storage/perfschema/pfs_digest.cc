@@ -41,12 +41,58 @@ PFS_statements_digest_stat *statements_digest_stat_array= NULL;
 static unsigned char *statements_digest_token_array= NULL;
 /** Consumer flag for table EVENTS_STATEMENTS_SUMMARY_BY_DIGEST. */
 bool flag_statements_digest= true;
-/**
-  Current index in Stat array where new record is to be inserted.
-  index 0 is reserved for "all else" case when entire array is full.
+/*
+  Index 0 of the stat array is reserved for the "all else" case, used when
+  no record can be allocated or evicted. The other records are split into
+  shards, each with its own allocation index, so that threads creating new
+  digests do not all contend on the same cache line. A digest is stored in
+  the shard selected by its MD5 hash.
 */
-volatile uint32 PFS_ALIGNED digest_monotonic_index;
-bool digest_full= false;
+
+/** Maximum number of digest shards. */
+#define DIGEST_SHARDS 16
+/** Minimum number of records in a digest shard. */
+#define DIGEST_MIN_SHARD_SIZE 256
+/** Number of records sampled when looking for a record to evict. */
+#define DIGEST_EVICT_SAMPLE 8
+/** Number of samples before giving up on eviction. */
+#define DIGEST_EVICT_ATTEMPTS 4
+
+struct PFS_ALIGNED PFS_digest_shard
+{
+  /** First record of the shard in the stat array. */
+  size_t m_first;
+  /** Number of records in the shard. */
+  size_t m_size;
+  /** Current index in the shard where a new record is to be inserted. */
+  volatile uint32 m_monotonic_index;
+  /** Position where the next eviction sample starts. */
+  volatile uint32 m_evict_index;
+  /** True once every record of the shard has been allocated. */
+  bool m_full;
+};
+
+static PFS_digest_shard digest_shards[DIGEST_SHARDS];
+static uint digest_shard_count= 0;
+
+static void init_digest_shards()
+{
+  size_t records= digest_max - 1;
+  digest_shard_count= (uint) MY_MIN(DIGEST_SHARDS,
+                                    records / DIGEST_MIN_SHARD_SIZE);
+  if (digest_shard_count == 0)
+    digest_shard_count= 1;
+
+  for (uint i= 0; i < digest_shard_count; i++)
+  {
+    PFS_digest_shard *shard= &digest_shards[i];
+    shard->m_first= 1 + records * i / digest_shard_count;
+    shard->m_size= 1 + records * (i + 1) / digest_shard_count - shard->m_first;
+    PFS_atomic::store_u32(& shard->m_monotonic_index, 0);
+    PFS_atomic::store_u32(& shard->m_evict_index, 0);
+    shard->m_full= false;
+  }
+}
 
 LF_HASH digest_hash;
 static bool digest_hash_inited= false;
@@ -63,8 +109,7 @@ int init_digest(const PFS_global_param *param)
   */
   digest_max= param->m_digest_sizing;
   digest_lost= 0;
-  PFS_atomic::store_u32(& digest_monotonic_index, 1);
-  digest_full= false;
+  digest_shard_count= 0;
 
   if (digest_max == 0)
     return 0;
@@ -108,6 +153,8 @@ int init_digest(const PFS_global_param *param)
   /* Set record[0] as allocated. */
   statements_digest_stat_array[0].m_lock.set_allocated();
 
+  init_digest_shards();
+
   return 0;
 }
 
@@ -176,7 +223,68 @@ static LF_PINS* get_digest_hash_pins(PFS_thread *thread)
   return thread->m_digest_hash_pins;
 }
 
-PFS_statement_stat*
+/**
+  Evict the least recently seen digest among a sample of records of a
+  full shard, and return the record, in the dirty state, with its
+  statistics reset.
+  Sampling approximates LRU without keeping a shared list that every
+  statement would have to update.
+  A record is only evicted when no statement holds a reference to it.
+  The victim is made dirty before its reference count is checked, and
+  find_or_create_digest() takes a reference before it checks that the
+  record is still populated, so one of them always sees the other.
+  @return the record to reuse, or NULL if none could be evicted
+*/
+static PFS_statements_digest_stat*
+evict_digest(LF_PINS *pins, PFS_digest_shard *shard)
+{
+  for (uint attempt= 0; attempt < DIGEST_EVICT_ATTEMPTS; attempt++)
+  {
+    const size_t start=
+      PFS_atomic::add_u32(& shard->m_evict_index, DIGEST_EVICT_SAMPLE);
+    const size_t sample= MY_MIN(DIGEST_EVICT_SAMPLE, shard->m_size);
+    PFS_statements_digest_stat *victim= NULL;
+
+    for (size_t i= 0; i < sample; i++)
+    {
+      PFS_statements_digest_stat *pfs=
+        &statements_digest_stat_array[shard->m_first +
+                                      (start + i) % shard->m_size];
+
+      /* A record freed by a failed insert can be taken right away. */
+      if (pfs->m_lock.is_free() && pfs->m_lock.free_to_dirty())
+        return pfs;
+
+      if (pfs->m_lock.is_populated() &&
+          (victim == NULL || pfs->m_last_seen < victim->m_last_seen))
+        victim= pfs;
+    }
+
+    if (victim != NULL && victim->m_lock.try_allocated_to_dirty())
+    {
+      if (PFS_atomic::load_32(& victim->m_refs) != 0)
+      {
+        /* A statement is aggregating to the victim, leave it. */
+        victim->m_lock.dirty_to_allocated();
+        continue;
+      }
+      lf_hash_delete(&digest_hash, pins,
+                     & victim->m_digest_key, sizeof(PFS_digest_key));
+      victim->m_stat.reset();
+      return victim;
+    }
+  }
+  return NULL;
+}
+
+/**
+  Find or create the digest record of a statement.
+  The record is returned with a reference that protects it from eviction,
+  which the caller drops with release_digest() once it has aggregated the
+  statement statistics.
+  @return the digest record, or NULL
+*/
+PFS_statements_digest_stat*
 find_or_create_digest(PFS_thread *thread,
                       const sql_digest_storage *digest_storage,
                       const char *schema_name,
@@ -216,6 +324,8 @@ find_or_create_digest(PFS_thread *thread,
   size_t attempts= 0;
   PFS_statements_digest_stat **entry;
   PFS_statements_digest_stat *pfs= NULL;
+  PFS_digest_shard *shard= &digest_shards[hash_key.m_md5[0] %
+                                          digest_shard_count];
 
   ulonglong now= my_micro_time();
 
@@ -230,89 +340,111 @@ search:
   {
     /* If digest already exists, update stats and return. */
     pfs= *entry;
-    pfs->m_last_seen= now;
     lf_hash_search_unpin(pins);
-    return & pfs->m_stat;
+
+    PFS_atomic::add_32(& pfs->m_refs, 1);
+    if (likely(pfs->m_lock.is_populated() &&
+               memcmp(& pfs->m_digest_key, &hash_key,
+                      sizeof(PFS_digest_key)) == 0))
+    {
+      pfs->m_last_seen= now;
+      return pfs;
+    }
+
+    /* The record was evicted after the lookup. */
+    release_digest(pfs);
+    if (++retry_count > retry_max)
+    {
+      digest_lost++;
+      return NULL;
+    }
+    goto search;
   }
 
   lf_hash_search_unpin(pins);
 
-  if (digest_full)
+  pfs= NULL;
+  if (!shard->m_full)
+  {
+    while (++attempts <= shard->m_size)
+    {
+      safe_index= shard->m_first +
+        PFS_atomic::add_u32(& shard->m_monotonic_index, 1) % shard->m_size;
+
+      /* Add a new record in digest stat array. */
+      if (statements_digest_stat_array[safe_index].m_lock.is_free() &&
+          statements_digest_stat_array[safe_index].m_lock.free_to_dirty())
+      {
+        pfs= &statements_digest_stat_array[safe_index];
+        break;
+      }
+    }
+    if (pfs == NULL)
+    {
+      /* The shard is now full. */
+      shard->m_full= true;
+    }
+  }
+
+  if (pfs == NULL)
+    pfs= evict_digest(pins, shard);
+
+  if (pfs == NULL)
   {
-    /*  digest_stat array is full. Add stat at index 0 and return. */
+    /*  No record could be evicted. Add stat at index 0 and return. */
     pfs= &statements_digest_stat_array[0];
     digest_lost++;
 
     if (pfs->m_first_seen == 0)
       pfs->m_first_seen= now;
     pfs->m_last_seen= now;
-    return & pfs->m_stat;
+    PFS_atomic::add_32(& pfs->m_refs, 1);
+    return pfs;
   }
 
-  while (++attempts <= digest_max)
+  /* Copy digest hash/LF Hash search key. */
+  memcpy(& pfs->m_digest_key, &hash_key, sizeof(PFS_digest_key));
+
+  /*
+    Copy digest storage to statement_digest_stat_array so that it could be
+    used later to generate digest text.
+  */
+  pfs->m_digest_storage.copy(digest_storage);
+
+  pfs->m_first_seen= now;
+  pfs->m_last_seen= now;
+
+  res= lf_hash_insert(&digest_hash, pins, &pfs);
+  if (likely(res == 0))
   {
-    safe_index= PFS_atomic::add_u32(& digest_monotonic_index, 1) % digest_max;
-    if (safe_index == 0)
-    {
-      /* Record [0] is reserved. */
-      safe_index= 1;
-    }
+    PFS_atomic::add_32(& pfs->m_refs, 1);
+    pfs->m_lock.dirty_to_allocated();
+    return pfs;
+  }
 
-    /* Add a new record in digest stat array. */
-    pfs= &statements_digest_stat_array[safe_index];
+  pfs->m_lock.dirty_to_free();
 
-    if (pfs->m_lock.is_free())
+  if (res > 0)
+  {
+    /* Duplicate insert by another thread */
+    if (++retry_count > retry_max)
     {
-      if (pfs->m_lock.free_to_dirty())
-      {
-        /* Copy digest hash/LF Hash search key. */
-        memcpy(& pfs->m_digest_key, &hash_key, sizeof(PFS_digest_key));
-
-        /*
-          Copy digest storage to statement_digest_stat_array so that it could be
-          used later to generate digest text.
-        */
-        pfs->m_digest_storage.copy(digest_storage);
-
-        pfs->m_first_seen= now;
-        pfs->m_last_seen= now;
-
-        res= lf_hash_insert(&digest_hash, pins, &pfs);
-        if (likely(res == 0))
-        {
-          pfs->m_lock.dirty_to_allocated();
-          return & pfs->m_stat;
-        }
-
-        pfs->m_lock.dirty_to_free();
-
-        if (res > 0)
-        {
-          /* Duplicate insert by another thread */
-          if (++retry_count > retry_max)
-          {
-            /* Avoid infinite loops */
-            digest_lost++;
-            return NULL;
-          }
-          goto search;
-        }
-
-        /* OOM in lf_hash_insert */
-        digest_lost++;
-        return NULL;
-      }
+      /* Avoid infinite loops */
+      digest_lost++;
+      return NULL;
     }
+    goto search;
   }
 
-  /* The digest array is now full. */
-  digest_full= true;
-  pfs= &statements_digest_stat_array[0];
+  /* OOM in lf_hash_insert */
+  digest_lost++;
+  return NULL;
+}
 
-  if (pfs->m_first_seen == 0)
-    pfs->m_first_seen= now;
-  pfs->m_last_seen= now;
-  return & pfs->m_stat;
+/** Drop the reference taken by find_or_create_digest(). */
+void release_digest(PFS_statements_digest_stat *pfs)
+{
+  PFS_atomic::add_32(& pfs->m_refs, -1);
 }
 
 void purge_digest(PFS_thread* thread, PFS_digest_key *hash_key)
@@ -376,10 +508,9 @@ void reset_esms_by_digest()
   statements_digest_stat_array[0].m_lock.set_allocated();
 
   /*
-    Reset index which indicates where the next calculated digest information
-    to be inserted in statements_digest_stat_array.
+    Reset the indexes which indicate where the next calculated digest
+    information is to be inserted in statements_digest_stat_array.
   */
-  PFS_atomic::store_u32(& digest_monotonic_index, 1);
-  digest_full= false;
+  init_digest_shards();
 }
 
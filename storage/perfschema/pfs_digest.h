@@ -60,6 +60,12 @@ struct PFS_ALIGNED PFS_statements_digest_stat
   ulonglong m_first_seen;
   ulonglong m_last_seen;
 
+  /**
+    Number of statements aggregating to m_stat right now.
+    A record is only evicted while this is 0.
+  */
+  volatile int32 m_refs;
+
   /** Reset data for this record. */
   void reset_data(unsigned char* token_array, uint length);
   /** Reset data and remove index for this record. */
@@ -71,10 +77,12 @@ void cleanup_digest();
 
 int init_digest_hash(void);
 void cleanup_digest_hash(void);
-PFS_statement_stat* find_or_create_digest(PFS_thread *thread,
-                                          const sql_digest_storage *digest_storage,
-                                          const char *schema_name,
-                                          uint schema_name_length);
+PFS_statements_digest_stat*
+find_or_create_digest(PFS_thread *thread,
+                      const sql_digest_storage *digest_storage,
+                      const char *schema_name,
+                      uint schema_name_length);
+void release_digest(PFS_statements_digest_stat *pfs);
 
 void reset_esms_by_digest();
 
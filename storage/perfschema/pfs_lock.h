@@ -126,6 +126,22 @@ struct pfs_lock
     PFS_atomic::store_u32(&m_version_state, new_val);
   }
 
+  /**
+    Execute an allocated to dirty transition, for a writer that does not
+    own the record, to take the record over.
+    This transition is safe to execute concurrently by multiple writers.
+    Only one writer will succeed to acquire the record.
+    @return true if the operation succeed
+  */
+  bool try_allocated_to_dirty(void)
+  {
+    uint32 copy= m_version_state; /* non volatile copy, and dirty read */
+    uint32 old_val= (copy & VERSION_MASK) + PFS_LOCK_ALLOCATED;
+    uint32 new_val= (copy & VERSION_MASK) + PFS_LOCK_DIRTY;
+
+    return (PFS_atomic::cas_u32(&m_version_state, &old_val, new_val));
+  }
+
   /**
     Execute a dirty to allocated transition.
     This transition should be executed by the writer that owns the record,
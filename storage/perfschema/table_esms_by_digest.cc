@@ -278,7 +278,12 @@ table_esms_by_digest::rnd_pos(const void *pos)
 
 void table_esms_by_digest::make_row(PFS_statements_digest_stat* digest_stat)
 {
+  pfs_lock lock;
   m_row_exists= false;
+
+  /* Protect this reader against the record being evicted and reused. */
+  digest_stat->m_lock.begin_optimistic_lock(&lock);
+
   m_row.m_first_seen= digest_stat->m_first_seen;
   m_row.m_last_seen= digest_stat->m_last_seen;
   m_row.m_digest.make_row(digest_stat);
@@ -289,7 +294,8 @@ void table_esms_by_digest::make_row(PFS_statements_digest_stat* digest_stat)
   time_normalizer *normalizer= time_normalizer::get(statement_timer);
   m_row.m_stat.set(normalizer, & digest_stat->m_stat);
 
-  m_row_exists= true;
+  if (digest_stat->m_lock.end_optimistic_lock(&lock))
+    m_row_exists= true;
 }
 
 int table_esms_by_digest
@@ -432,6 +432,10 @@ static void rocksdb_select_bypass_rejected_query_history_size_update(
     THD *const thd, struct st_mysql_sys_var *const /* unused */,
     void *const var_ptr, const void *const save);
 
+static void rocksdb_select_bypass_plan_cache_size_update(
+    THD *const thd, struct st_mysql_sys_var *const /* unused */,
+    void *const var_ptr, const void *const save);
+
 static void rocksdb_force_flush_memtable_now_stub(
     THD *const thd, struct st_mysql_sys_var *const var, void *const var_ptr,
     const void *const save) {}
@@ -731,6 +735,8 @@ static my_bool rocksdb_select_bypass_log_failed = FALSE;
 static my_bool rocksdb_select_bypass_allow_filters = TRUE;
 static uint32_t rocksdb_select_bypass_rejected_query_history_size = 0;
 static uint32_t rocksdb_select_bypass_debug_row_delay = 0;
+static uint32_t rocksdb_select_bypass_batch_size = 0;
+static uint32_t rocksdb_select_bypass_plan_cache_size = 0;
 static unsigned long long  // NOLINT(runtime/int)
     rocksdb_select_bypass_multiget_min = 0;
 static my_bool rocksdb_skip_locks_if_skip_unique_check = FALSE;
@@ -747,6 +753,8 @@ std::atomic<uint64_t> rocksdb_num_get_for_update_calls(0);
 std::atomic<uint64_t> rocksdb_select_bypass_executed(0);
 std::atomic<uint64_t> rocksdb_select_bypass_rejected(0);
 std::atomic<uint64_t> rocksdb_select_bypass_failed(0);
+std::atomic<uint64_t> rocksdb_select_bypass_plan_cache_hits(0);
+std::atomic<uint64_t> rocksdb_select_bypass_plan_cache_misses(0);
 
 static int rocksdb_trace_block_cache_access(
     THD *const thd MY_ATTRIBUTE((__unused__)),
@@ -2341,6 +2349,22 @@ static MYSQL_SYSVAR_UINT(
     "for each row sent",
     nullptr, nullptr, 0, /* min */ 0, /* max */ INT_MAX, 0);
 
+static MYSQL_SYSVAR_UINT(
+    select_bypass_batch_size, rocksdb_select_bypass_batch_size,
+    PLUGIN_VAR_RQCMDARG,
+    "Number of rows a bypass range query decodes and filters as one block. "
+    "Set to 0 to process one row at a time",
+    nullptr, nullptr, 0, /* min */ 0, /* max */ 65536, 0);
+
+static MYSQL_SYSVAR_UINT(
+    select_bypass_plan_cache_size, rocksdb_select_bypass_plan_cache_size,
+    PLUGIN_VAR_RQCMDARG,
+    "Maximum number of parsed bypass SELECT statements cached by table and "
+    "statement digest. Requires statement digests to be computed. "
+    "Set to 0 to turn off",
+    nullptr, rocksdb_select_bypass_plan_cache_size_update, 0,
+    /* min */ 0, /* max */ 1024 * 1024, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(
     select_bypass_multiget_min, rocksdb_select_bypass_multiget_min,
     PLUGIN_VAR_RQCMDARG,
@@ -2354,6 +2378,13 @@ static MYSQL_THDVAR_LONG(mrr_batch_size, PLUGIN_VAR_RQCMDARG,
                          nullptr, nullptr, /* default */ 100, /* min */ 0,
                          /* max */ ROCKSDB_MAX_MRR_BATCH_SIZE, 0);
 
+static MYSQL_THDVAR_LONG(sk_multiget_batch_size, PLUGIN_VAR_RQCMDARG,
+                         "maximum number of primary key lookups of a "
+                         "non-covering secondary index scan to fetch with one "
+                         "MultiGet call. 0 or 1 means one Get per row",
+                         nullptr, nullptr, /* default */ 0, /* min */ 0,
+                         /* max */ ROCKSDB_MAX_MRR_BATCH_SIZE, 0);
+
 static MYSQL_SYSVAR_BOOL(skip_locks_if_skip_unique_check,
                          rocksdb_skip_locks_if_skip_unique_check,
                          PLUGIN_VAR_RQCMDARG,
@@ -2551,7 +2582,10 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(select_bypass_allow_filters),
     MYSQL_SYSVAR(select_bypass_debug_row_delay),
     MYSQL_SYSVAR(select_bypass_multiget_min),
+    MYSQL_SYSVAR(select_bypass_batch_size),
+    MYSQL_SYSVAR(select_bypass_plan_cache_size),
     MYSQL_SYSVAR(mrr_batch_size),
+    MYSQL_SYSVAR(sk_multiget_batch_size),
     MYSQL_SYSVAR(skip_locks_if_skip_unique_check),
     MYSQL_SYSVAR(alter_column_default_inplace),
     nullptr};
@@ -5151,6 +5185,49 @@ static bool rocksdb_explicit_snapshot(
   return true;
 }
 
+/*
+  Cursor read views let several THDs read through one snapshot, see
+  QUICK_PARALLEL_RANGE_SELECT. A view is an explicit snapshot that is
+  attached to each of the THDs: the one of the session if it has one,
+  or else a new snapshot.
+*/
+static void *rocksdb_create_cursor_view(
+    handlerton *const /* hton */, /*!< in: RocksDB handlerton */
+    THD *const thd)               /*!< in: MySQL thread handle */
+{
+  auto s = std::static_pointer_cast<Rdb_explicit_snapshot>(
+      thd->get_explicit_snapshot());
+  if (!s) {
+    snapshot_info_st ss_info;
+    s = Rdb_explicit_snapshot::create(&ss_info, rdb, rdb->GetSnapshot());
+    if (!s) {
+      return nullptr;
+    }
+  }
+  return new std::shared_ptr<Rdb_explicit_snapshot>(s);
+}
+
+static void rocksdb_set_cursor_view(
+    handlerton *const /* hton */, /*!< in: RocksDB handlerton */
+    THD *const thd,               /*!< in: MySQL thread handle */
+    void *const curview)          /*!< in: view to read through, or NULL */
+{
+  if (curview != nullptr) {
+    thd->set_explicit_snapshot(
+        *static_cast<std::shared_ptr<Rdb_explicit_snapshot> *>(curview));
+  } else {
+    thd->set_explicit_snapshot(nullptr);
+  }
+}
+
+static void rocksdb_close_cursor_view(
+    handlerton *const /* hton */, /*!< in: RocksDB handlerton */
+    THD *const /* thd */,         /*!< in: MySQL thread handle */
+    void *const curview)          /*!< in: view to close */
+{
+  delete static_cast<std::shared_ptr<Rdb_explicit_snapshot> *>(curview);
+}
+
 /*
     Supporting START TRANSACTION WITH CONSISTENT [ROCKSDB] SNAPSHOT
 
@@ -5582,6 +5659,9 @@ static int rocksdb_init_func(void *const p) {
   rocksdb_hton->db_type = DB_TYPE_ROCKSDB;
   rocksdb_hton->show_status = rocksdb_show_status;
   rocksdb_hton->explicit_snapshot = rocksdb_explicit_snapshot;
+  rocksdb_hton->create_cursor_read_view = rocksdb_create_cursor_view;
+  rocksdb_hton->set_cursor_read_view = rocksdb_set_cursor_view;
+  rocksdb_hton->close_cursor_read_view = rocksdb_close_cursor_view;
   rocksdb_hton->start_consistent_snapshot =
       rocksdb_start_tx_and_assign_read_view;
   rocksdb_hton->start_shared_snapshot = rocksdb_start_tx_with_shared_read_view;
@@ -6611,6 +6691,12 @@ ha_rocksdb::ha_rocksdb(my_core::handlerton *const hton,
       mrr_n_elements(0),
       mrr_enabled_keyread(false),
       mrr_used_cpk(false),
+      m_sk_batch_capacity(0),
+      m_sk_batch_size(0),
+      m_sk_batch_pos(0),
+      m_sk_batch_limit(0),
+      m_sk_batch_forward(true),
+      m_sk_batch_match_length(0),
       m_in_rpl_delete_rows(false),
       m_in_rpl_update_rows(false),
       m_force_skip_unique_check(false),
@@ -8829,6 +8915,7 @@ int ha_rocksdb::index_read_map_impl(uchar *const buf, const uchar *const key,
 
   /* By default, we don't need the retrieved records to match the prefix */
   m_sk_match_prefix = nullptr;
+  m_sk_batch_match_length = 0;
   stats.rows_requested++;
 
   if (active_index == table->s->primary_key && find_flag == HA_READ_KEY_EXACT &&
@@ -8908,6 +8995,15 @@ int ha_rocksdb::index_read_map_impl(uchar *const buf, const uchar *const key,
     memcpy(m_sk_match_prefix, m_sk_packed_tuple, packed_size);
   }
 
+  if (find_flag == HA_READ_KEY_EXACT || find_flag == HA_READ_PREFIX_LAST) {
+    /*
+      Without ICP, handler::index_next_same() stops at the end of the lookup
+      tuple, but batched primary key lookups must not read ahead past it.
+    */
+    memcpy(m_sk_match_prefix_buf, m_sk_packed_tuple, packed_size);
+    m_sk_batch_match_length = packed_size;
+  }
+
   int bytes_changed_by_succ = 0;
   if (find_flag == HA_READ_PREFIX_LAST_OR_PREV ||
       find_flag == HA_READ_PREFIX_LAST || find_flag == HA_READ_AFTER_KEY) {
@@ -9436,6 +9532,18 @@ int ha_rocksdb::index_next(uchar *const buf) {
   }
 
   int rc = index_next_with_direction(buf, moves_forward);
+
+  /*
+    Step back one row and forward again, so that a test can change the
+    direction of a scan at every row of it.
+  */
+  DBUG_EXECUTE_IF("rocksdb_index_next_step_back", {
+    if (!rc) {
+      rc = index_next_with_direction(buf, !moves_forward);
+      if (!rc) rc = index_next_with_direction(buf, moves_forward);
+    }
+  });
+
   if (rc == HA_ERR_KEY_NOT_FOUND) rc = HA_ERR_END_OF_FILE;
 
   DBUG_RETURN(rc);
@@ -9473,6 +9581,24 @@ int ha_rocksdb::index_next_with_direction(uchar *const buf, bool move_forward) {
   } else {
     THD *thd = ha_thd();
     for (;;) {
+      if (m_sk_batch_size > 0 && move_forward != m_sk_batch_forward &&
+          (m_sk_batch_pos < m_sk_batch_size || m_skip_scan_it_next_call)) {
+        sk_batch_rewind();
+      }
+      if (m_sk_batch_pos == m_sk_batch_size && sk_batch_usable()) {
+        rc = sk_batch_fill(buf, move_forward);
+        if (rc) {
+          break;
+        }
+      }
+      if (m_sk_batch_pos < m_sk_batch_size) {
+        rc = sk_batch_next(buf);
+        if (rc == HA_ERR_END_OF_FILE) {
+          continue; /* no visible row left in the batch, read the next one */
+        }
+        break;
+      }
+
       DEBUG_SYNC(thd, "rocksdb.check_flags_inwd");
       if (thd && thd->killed) {
         rc = HA_ERR_QUERY_INTERRUPTED;
@@ -9503,6 +9629,224 @@ int ha_rocksdb::index_next_with_direction(uchar *const buf, bool move_forward) {
   DBUG_RETURN(rc);
 }
 
+/*
+  Check if the primary key lookups of the current secondary index scan can be
+  batched: the scan must neither lock rows nor be index-only, and batching
+  must be enabled with rocksdb_sk_multiget_batch_size.
+*/
+bool ha_rocksdb::sk_batch_usable() {
+  if (m_lock_rows != RDB_LOCK_NONE || m_keyread_only) {
+    return false;
+  }
+  return THDVAR(ha_thd(), sk_multiget_batch_size) > 1;
+}
+
+/*
+  Check if the index entry at m_scan_it is still within the lookup tuple and
+  end_range of the scan. With ICP, find_icp_matching_index_rec() has checked
+  both already; without it they are only checked above the handler, once a row
+  has been returned, so the batch must stop at them itself.
+
+  An entry that cannot be compared exactly only ends the batch early or late:
+  the row-at-a-time path and the SQL layer still decide what is returned.
+*/
+bool ha_rocksdb::sk_batch_in_range(const Rdb_key_def &kd,
+                                   const rocksdb::Slice &key,
+                                   const rocksdb::Slice &value,
+                                   uchar *const buf) {
+  if (pushed_idx_cond && pushed_idx_cond_keyno == active_index) {
+    return true;
+  }
+
+  if (m_sk_batch_match_length) {
+    const rocksdb::Slice prefix((const char *)m_sk_match_prefix_buf,
+                                m_sk_batch_match_length);
+    if (!kd.value_matches_prefix(key, prefix)) {
+      return false;
+    }
+  }
+
+  if (end_range) {
+    if (kd.unpack_record(table, buf, &key, &value,
+                         m_converter->get_verify_row_debug_checksums())) {
+      return false;
+    }
+    if (compare_key_icp(end_range) > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+  @brief
+  Read ahead the next entries of the secondary index scan and fetch their rows
+  with one MultiGet call.
+
+  @detail
+  An entry that needs the row-at-a-time path (the end of the index or of the
+  range, an error, or a lookup that is covered by the index) ends the batch.
+  m_scan_it stays on that entry with m_skip_scan_it_next_call set, so that
+  index_next_with_direction() reads it again once the batch has been
+  returned. The batch may be empty, then the caller reads the entry at once.
+
+  @return
+    HA_EXIT_SUCCESS  OK
+    other            HA_ERR error code (can be SE-specific)
+*/
+int ha_rocksdb::sk_batch_fill(uchar *const buf, const bool move_forward) {
+  DBUG_ASSERT(m_sk_batch_pos == m_sk_batch_size);
+
+  THD *thd = ha_thd();
+  const Rdb_key_def &kd = *m_key_descr_arr[active_index];
+  const size_t max_limit = THDVAR(thd, sk_multiget_batch_size);
+
+  /*
+    The first batch of a scan is small and every next one doubles, so that a
+    scan that is ended early (LIMIT, a join that needs one row) does not fetch
+    many rows ahead.
+  */
+  const size_t limit =
+      std::min(std::max(2 * m_sk_batch_limit, size_t(2)), max_limit);
+  m_sk_batch_limit = limit;
+
+  sk_batch_reset();
+  if (m_sk_batch_capacity < max_limit) {
+    m_sk_batch_values.reset(new rocksdb::PinnableSlice[max_limit]);
+    m_sk_batch_rowids.resize(max_limit);
+    m_sk_batch_sk_keys.resize(max_limit);
+    m_sk_batch_keys.resize(max_limit);
+    m_sk_batch_statuses.resize(max_limit);
+    m_sk_batch_capacity = max_limit;
+  }
+
+  size_t n = 0;
+  while (n < limit) {
+    if (thd && thd->killed) {
+      return HA_ERR_QUERY_INTERRUPTED;
+    }
+    if (m_skip_scan_it_next_call) {
+      m_skip_scan_it_next_call = false;
+    } else {
+      rocksdb_smart_next(!move_forward, m_scan_it);
+    }
+
+    if (rocksdb_skip_expired_records(kd, m_scan_it, !move_forward) ||
+        find_icp_matching_index_rec(move_forward, buf) ||
+        !is_valid_iterator(m_scan_it)) {
+      m_skip_scan_it_next_call = true;
+      break;
+    }
+
+    const rocksdb::Slice key = m_scan_it->key();
+    const rocksdb::Slice value = m_scan_it->value();
+    if (!kd.covers_key(key) ||
+        kd.covers_lookup(&value, m_converter->get_lookup_bitmap()) ||
+        !sk_batch_in_range(kd, key, value, buf)) {
+      m_skip_scan_it_next_call = true;
+      break;
+    }
+
+    const uint size =
+        kd.get_primary_key_tuple(table, *m_pk_descr, &key, m_pk_packed_tuple);
+    if (size == RDB_INVALID_KEY_LEN) {
+      m_skip_scan_it_next_call = true;
+      break;
+    }
+
+    m_sk_batch_rowids[n].assign((const char *)m_pk_packed_tuple, size);
+    m_sk_batch_sk_keys[n].assign(key.data(), key.size());
+    m_sk_batch_keys[n] = rocksdb::Slice(m_sk_batch_rowids[n]);
+    n++;
+  }
+
+  if (n == 0) {
+    return HA_EXIT_SUCCESS;
+  }
+
+  Rdb_transaction *const tx = get_or_create_tx(table->in_use);
+  tx->acquire_snapshot(true);
+  tx->multi_get(m_pk_descr->get_cf(), n, m_sk_batch_keys.data(),
+                m_sk_batch_values.get(), m_sk_batch_statuses.data(), false);
+  m_io_perf.record_sk_multiget(n);
+
+  m_sk_batch_size = n;
+  m_sk_batch_forward = move_forward;
+  return HA_EXIT_SUCCESS;
+}
+
+/*
+  Return the next row of the batch filled by sk_batch_fill(). Rows that were
+  not found or have expired are skipped.
+
+  @return
+    HA_EXIT_SUCCESS     OK
+    HA_ERR_END_OF_FILE  No row left in the batch
+    other               HA_ERR error code (can be SE-specific)
+*/
+int ha_rocksdb::sk_batch_next(uchar *const buf) {
+  Rdb_transaction *const tx = get_or_create_tx(table->in_use);
+
+  table->status = STATUS_NOT_FOUND;
+  while (m_sk_batch_pos < m_sk_batch_size) {
+    const size_t i = m_sk_batch_pos++;
+    const rocksdb::Status &s = m_sk_batch_statuses[i];
+
+    stats.rows_requested++;
+    if (s.IsNotFound()) {
+      continue;
+    }
+    if (!s.ok()) {
+      return tx->set_status_error(table->in_use, s, *m_pk_descr, m_tbl_def,
+                                  m_table_handler);
+    }
+
+    m_retrieved_record.Reset();
+    m_retrieved_record.PinSlice(m_sk_batch_values[i], &m_sk_batch_values[i]);
+
+    /* If we found the record, but it's expired, pretend we didn't find it.  */
+    if (m_pk_descr->has_ttl() &&
+        should_hide_ttl_rec(*m_pk_descr, m_retrieved_record,
+                            tx->m_snapshot_timestamp)) {
+      continue;
+    }
+
+    m_last_rowkey.copy(m_sk_batch_rowids[i].data(),
+                       m_sk_batch_rowids[i].size(), &my_charset_bin);
+    const int rc =
+        convert_record_from_storage_format(&m_sk_batch_keys[i], buf);
+    if (!rc) {
+      table->status = 0;
+      stats.rows_read++;
+      stats.rows_index_next++;
+      update_row_stats(ROWS_READ);
+    }
+    return rc;
+  }
+  return HA_ERR_END_OF_FILE;
+}
+
+/*
+  The scan changes direction while the batch still has rows, or after its
+  last row when the batch ended on a look-ahead entry: put m_scan_it back on
+  the last entry that was consumed from the batch.
+*/
+void ha_rocksdb::sk_batch_rewind() {
+  DBUG_ASSERT(m_sk_batch_pos > 0 && m_sk_batch_pos <= m_sk_batch_size);
+
+  m_scan_it->Seek(rocksdb::Slice(m_sk_batch_sk_keys[m_sk_batch_pos - 1]));
+  m_skip_scan_it_next_call = false;
+  sk_batch_reset();
+}
+
+void ha_rocksdb::sk_batch_reset() {
+  for (size_t i = 0; i < m_sk_batch_size; i++) {
+    m_sk_batch_values[i].Reset();
+  }
+  m_sk_batch_size = 0;
+  m_sk_batch_pos = 0;
+}
+
 /**
   @return
     HA_EXIT_SUCCESS  OK
@@ -9514,6 +9858,7 @@ int ha_rocksdb::index_first(uchar *const buf) {
   check_build_decoder();
 
   m_sk_match_prefix = nullptr;
+  m_sk_batch_match_length = 0;
   ha_statistic_increment(&SSV::ha_read_first_count);
   int rc = m_key_descr_arr[active_index]->m_is_reverse_cf
                ? index_last_intern(buf)
@@ -9534,6 +9879,7 @@ int ha_rocksdb::index_last(uchar *const buf) {
   check_build_decoder();
 
   m_sk_match_prefix = nullptr;
+  m_sk_batch_match_length = 0;
   ha_statistic_increment(&SSV::ha_read_last_count);
   int rc = m_key_descr_arr[active_index]->m_is_reverse_cf
                ? index_first_intern(buf)
@@ -10861,6 +11207,9 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
                                      const uint eq_cond_len) {
   DBUG_ASSERT(slice->size() >= eq_cond_len);
 
+  sk_batch_reset();
+  m_sk_batch_limit = 0;
+
   Rdb_transaction *const tx = get_or_create_tx(table->in_use);
 
   bool skip_bloom = true;
@@ -10928,6 +11277,8 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
 }
 
 void ha_rocksdb::release_scan_iterator() {
+  sk_batch_reset();
+
   delete m_scan_it;
   m_scan_it = nullptr;
 
@@ -14371,6 +14722,11 @@ static SHOW_VAR rocksdb_status_vars[] = {
                        &rocksdb_select_bypass_rejected, SHOW_LONGLONG),
     DEF_STATUS_VAR_PTR("select_bypass_failed", &rocksdb_select_bypass_failed,
                        SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("select_bypass_plan_cache_hits",
+                       &rocksdb_select_bypass_plan_cache_hits, SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("select_bypass_plan_cache_misses",
+                       &rocksdb_select_bypass_plan_cache_misses,
+                       SHOW_LONGLONG),
     // the variables generated by SHOW_FUNC are sorted only by prefix (first
     // arg in the tuple below), so make sure it is unique to make sorting
     // deterministic as quick sort is not stable
@@ -15822,6 +16178,16 @@ static void rocksdb_select_bypass_rejected_query_history_size_update(
   }
 }
 
+static void rocksdb_select_bypass_plan_cache_size_update(
+    THD *const /* unused */, struct st_mysql_sys_var *const /* unused */,
+    void *const var_ptr, const void *const save) {
+  *static_cast<uint32_t *>(var_ptr) = *static_cast<const uint32_t *>(save);
+
+  // Plans are only evicted when new ones are added, drop all of them so that
+  // a smaller size or turning the cache off takes effect immediately
+  myrocks::clear_select_bypass_plan_cache();
+}
+
 select_bypass_policy_type get_select_bypass_policy() {
   return static_cast<select_bypass_policy_type>(rocksdb_select_bypass_policy);
 }
@@ -15850,6 +16216,14 @@ uint32_t get_select_bypass_debug_row_delay() {
   return rocksdb_select_bypass_debug_row_delay;
 }
 
+uint32_t get_select_bypass_batch_size() {
+  return rocksdb_select_bypass_batch_size;
+}
+
+uint32_t get_select_bypass_plan_cache_size() {
+  return rocksdb_select_bypass_plan_cache_size;
+}
+
 unsigned long long  // NOLINT(runtime/int)
 get_select_bypass_multiget_min() {
   return rocksdb_select_bypass_multiget_min;
@@ -699,6 +699,31 @@ class ha_rocksdb : public my_core::handler {
   void mrr_free();
   uint mrr_get_length_per_rec();
 
+  // Batched primary key lookups of a non-covering secondary index scan: the
+  // scan reads ahead up to rocksdb_sk_multiget_batch_size index entries and
+  // fetches their rows with one MultiGet call.
+  std::vector<std::string> m_sk_batch_rowids;  // packed PK of each entry
+  std::vector<std::string> m_sk_batch_sk_keys;  // index key of each entry
+  std::vector<rocksdb::Slice> m_sk_batch_keys;
+  std::vector<rocksdb::Status> m_sk_batch_statuses;
+  std::unique_ptr<rocksdb::PinnableSlice[]> m_sk_batch_values;
+  size_t m_sk_batch_capacity;  // Size of m_sk_batch_values
+  size_t m_sk_batch_size;      // Number of entries in the batch
+  size_t m_sk_batch_pos;       // Entry that will be returned next
+  size_t m_sk_batch_limit;     // Size of the last batch of the scan
+  bool m_sk_batch_forward;     // Direction of m_scan_it when filling
+  // Length of the lookup tuple in m_sk_match_prefix_buf the batch must not
+  // read past, 0 when the scan is not a HA_READ_KEY_EXACT lookup
+  uint m_sk_batch_match_length;
+
+  bool sk_batch_usable();
+  bool sk_batch_in_range(const Rdb_key_def &kd, const rocksdb::Slice &key,
+                         const rocksdb::Slice &value, uchar *const buf);
+  int sk_batch_fill(uchar *const buf, const bool move_forward);
+  int sk_batch_next(uchar *const buf);
+  void sk_batch_rewind();
+  void sk_batch_reset();
+
   struct key_def_cf_info {
     std::shared_ptr<rocksdb::ColumnFamilyHandle> cf_handle;
     bool is_reverse_cf;
@@ -1119,6 +1144,10 @@ uint32_t get_select_bypass_rejected_query_history_size();
 
 uint32_t get_select_bypass_debug_row_delay();
 
+uint32_t get_select_bypass_batch_size();
+
+uint32_t get_select_bypass_plan_cache_size();
+
 unsigned long long  // NOLINT(runtime/int)
 get_select_bypass_multiget_min();
 
@@ -1172,5 +1201,7 @@ bool rdb_tx_started(Rdb_transaction *tx);
 extern std::atomic<uint64_t> rocksdb_select_bypass_executed;
 extern std::atomic<uint64_t> rocksdb_select_bypass_rejected;
 extern std::atomic<uint64_t> rocksdb_select_bypass_failed;
+extern std::atomic<uint64_t> rocksdb_select_bypass_plan_cache_hits;
+extern std::atomic<uint64_t> rocksdb_select_bypass_plan_cache_misses;
 
 }  // namespace myrocks
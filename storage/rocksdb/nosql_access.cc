@@ -25,7 +25,9 @@
 #include <deque>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -69,6 +71,52 @@ bool inline is_supported_item_func(Item_func::Functype type) {
   return true;
 }
 
+/* The operator of `const <op> field`, rewritten as `field <op> const` */
+Item_func::Functype inline swap_item_func(Item_func::Functype type) {
+  switch (type) {
+    case Item_func::LT_FUNC:
+      return Item_func::GT_FUNC;
+    case Item_func::LE_FUNC:
+      return Item_func::GE_FUNC;
+    case Item_func::GE_FUNC:
+      return Item_func::LE_FUNC;
+    case Item_func::GT_FUNC:
+      return Item_func::LT_FUNC;
+    default:
+      return type;
+  }
+}
+
+/*
+  Apply `column[i] <op> value` to a block of rows, clearing selected[i] for
+  the rows that don't match. These are plain loops over a column without
+  branches so that the compiler can vectorize them.
+ */
+template <typename T>
+void filter_column(Item_func::Functype op_type, const T *column, T value,
+                   uint count, uchar *selected) {
+  switch (op_type) {
+    case Item_func::EQ_FUNC:
+      for (uint i = 0; i < count; ++i) selected[i] &= (column[i] == value);
+      break;
+    case Item_func::LT_FUNC:
+      for (uint i = 0; i < count; ++i) selected[i] &= (column[i] < value);
+      break;
+    case Item_func::LE_FUNC:
+      for (uint i = 0; i < count; ++i) selected[i] &= (column[i] <= value);
+      break;
+    case Item_func::GE_FUNC:
+      for (uint i = 0; i < count; ++i) selected[i] &= (column[i] >= value);
+      break;
+    case Item_func::GT_FUNC:
+      for (uint i = 0; i < count; ++i) selected[i] &= (column[i] > value);
+      break;
+    default:
+      DBUG_ASSERT(false);
+      break;
+  }
+}
+
 namespace {
 
 /*
@@ -90,6 +138,84 @@ struct sql_cond {
   sql_cond() = default;
 };
 
+/*
+  The parsed shape of a SELECT statement: the index, the SELECT list and the
+  WHERE expressions, with fields referenced by their index in the table and
+  without any of the constants. Statements with the same normalized digest
+  against the same table have the same plan, so repeated queries only need
+  to bind their constants.
+ */
+struct select_plan {
+  struct cond {
+    Item_func::Functype op_type;  // the operator, such as >
+    uint field_index;             // index of the field in the table
+    uint field_arg;               // argument of the function that is the field
+  };
+
+  ulonglong table_def_version;
+  uint index;
+  bool is_order_desc;
+  std::vector<uint> field_list;
+  // One entry for every WHERE expression, including the ones that turn out
+  // to be redundant for a given set of constants
+  std::vector<cond> cond_list;
+};
+
+/*
+  Plans of bypass SELECT statements keyed by table and normalized digest.
+  The map is split into shards with their own mutex so that concurrent point
+  lookups against different statements don't contend on a single lock.
+ */
+class select_plan_cache {
+ public:
+  std::shared_ptr<const select_plan> find(const std::string &key) {
+    auto &shard = get_shard(key);
+    const std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.plans.find(key);
+    if (it == shard.plans.end()) {
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  void insert(const std::string &key, std::shared_ptr<const select_plan> plan,
+              size_t capacity) {
+    const size_t shard_capacity = (capacity + SHARD_COUNT - 1) / SHARD_COUNT;
+    auto &shard = get_shard(key);
+    const std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.plans.size() >= shard_capacity &&
+        shard.plans.find(key) == shard.plans.end()) {
+      // Evict an arbitrary plan. The number of distinct bypass statements is
+      // expected to be small so this should be rare
+      shard.plans.erase(shard.plans.begin());
+    }
+    shard.plans[key] = std::move(plan);
+  }
+
+  void clear() {
+    for (auto &shard : m_shards) {
+      const std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.plans.clear();
+    }
+  }
+
+ private:
+  static const size_t SHARD_COUNT = 16;
+
+  struct plan_shard {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const select_plan>> plans;
+  };
+
+  plan_shard &get_shard(const std::string &key) {
+    return m_shards[std::hash<std::string>()(key) % SHARD_COUNT];
+  }
+
+  std::array<plan_shard, SHARD_COUNT> m_shards;
+};
+
+select_plan_cache bypass_plan_cache;
+
 /*
   Extract necessary information from SELECT statements
  */
@@ -139,12 +265,30 @@ class select_parser {
     }
 
     // @TODO - PROCEDURE
+    const bool use_plan_cache = make_plan_key();
+    if (use_plan_cache) {
+      auto plan = bypass_plan_cache.find(m_plan_key);
+      if (plan != nullptr && !bind_plan(*plan)) {
+        rocksdb_select_bypass_plan_cache_hits++;
+        return parse_limit();
+      }
+
+      // Start over, binding may have failed half way through
+      rocksdb_select_bypass_plan_cache_misses++;
+      m_field_list.clear();
+      m_cond_count = 0;
+    }
+
     // NOTE: These have side effects and their orders are important
     if (parse_index() || parse_items() || parse_order_by() || parse_where() ||
         parse_limit()) {
       return true;
     }
 
+    if (use_plan_cache) {
+      cache_plan();
+    }
+
     return false;
   }
 
@@ -275,7 +419,150 @@ class select_parser {
   // Buffer to store my_snprintf-ed error messages
   char m_error_msg_buf[FN_REFLEN];
 
+  // Key of the statement in the plan cache
+  std::string m_plan_key;
+  // WHERE expressions seen by parse_where, recorded for the plan cache
+  select_plan::cond m_plan_cond_list[MAX_NOSQL_COND_COUNT];
+  uint m_plan_cond_count = 0;
+
  private:
+  // Build the plan cache key out of the table name and the statement digest.
+  // Returns false if the plan cache can't be used for this statement
+  bool make_plan_key() {
+    if (get_select_bypass_plan_cache_size() == 0 ||
+        m_thd->m_digest == nullptr) {
+      return false;
+    }
+
+    // The digest is only computed when the performance schema or the sql_id
+    // needs it, and a truncated digest doesn't identify the statement
+    const sql_digest_storage &digest = m_thd->m_digest->m_digest_storage;
+    if (digest.m_byte_count == 0 || digest.m_full) {
+      return false;
+    }
+
+    // An unqualified table name is not part of the digest
+    const TABLE_SHARE *share = m_table->s;
+    m_plan_key.reserve(share->db.length + share->table_name.length +
+                       digest.m_byte_count + 2);
+    m_plan_key.assign(share->db.str, share->db.length);
+    m_plan_key.push_back('\0');
+    m_plan_key.append(share->table_name.str, share->table_name.length);
+    m_plan_key.push_back('\0');
+    m_plan_key.append(reinterpret_cast<const char *>(digest.m_token_array),
+                      digest.m_byte_count);
+    return true;
+  }
+
+  void cache_plan() {
+    if (m_plan_cond_count > MAX_NOSQL_COND_COUNT) {
+      return;
+    }
+
+    auto plan = std::make_shared<select_plan>();
+    plan->table_def_version = m_table->s->get_table_def_version();
+    plan->index = m_index;
+    plan->is_order_desc = m_is_order_desc;
+    plan->field_list.reserve(m_field_list.size());
+    for (const auto field : m_field_list) {
+      plan->field_list.push_back(field->field_index);
+    }
+    plan->cond_list.assign(m_plan_cond_list,
+                           m_plan_cond_list + m_plan_cond_count);
+
+    bypass_plan_cache.insert(m_plan_key, std::move(plan),
+                             get_select_bypass_plan_cache_size());
+  }
+
+  // Bind the fields and constants of this statement according to a cached
+  // plan. Returns true if the statement doesn't match the plan, in which case
+  // it needs to be parsed from scratch
+  bool bind_plan(const select_plan &plan) {
+    if (plan.table_def_version != m_table->s->get_table_def_version() ||
+        plan.field_list.size() != m_select_lex->item_list.elements) {
+      return true;
+    }
+
+    m_index = plan.index;
+    m_is_order_desc = plan.is_order_desc;
+
+    Item *item;
+    List_iterator_fast<Item> li(m_select_lex->item_list);
+    m_field_list.reserve(DEFAULT_FIELD_LIST_SIZE);
+    for (const uint field_index : plan.field_list) {
+      item = li++;
+      if (item->type() != Item::FIELD_ITEM) {
+        return true;
+      }
+
+      Field *field = m_table->field[field_index];
+      static_cast<Item_field *>(item)->set_field(m_thd, field);
+      m_field_list.push_back(field);
+    }
+
+    Item *where = m_select_lex->where;
+    if (where == nullptr) {
+      return true;
+    }
+
+    if (where->type() == Item::FUNC_ITEM) {
+      return plan.cond_list.size() != 1 ||
+             bind_cond(static_cast<Item_func *>(where), plan.cond_list[0]);
+    }
+
+    if (where->type() != Item::COND_ITEM ||
+        static_cast<Item_cond *>(where)->functype() !=
+            Item_func::COND_AND_FUNC) {
+      return true;
+    }
+
+    List<Item> *and_list = static_cast<Item_cond_and *>(where)->argument_list();
+    if (and_list->elements != plan.cond_list.size()) {
+      return true;
+    }
+
+    List_iterator_fast<Item> wi(*and_list);
+    for (const auto &cond : plan.cond_list) {
+      item = wi++;
+      if (item->type() != Item::FUNC_ITEM ||
+          bind_cond(static_cast<Item_func *>(item), cond)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool bind_cond(Item_func *func, const select_plan::cond &cond) {
+    if (func->functype() != cond.op_type) {
+      return true;
+    }
+
+    const auto args = func->arguments();
+    Item *field_arg = args[cond.field_arg];
+    Item *op_arg = nullptr;
+    if (field_arg->type() != Item::FIELD_ITEM) {
+      return true;
+    }
+
+    // The digest doesn't tell the type of the constants apart
+    if (cond.op_type == Item_func::IN_FUNC) {
+      for (uint i = 1; i < func->argument_count(); ++i) {
+        if (!is_supported_op_arg(args[i])) {
+          return true;
+        }
+      }
+    } else {
+      op_arg = args[1 - cond.field_arg];
+      if (!is_supported_op_arg(op_arg)) {
+        return true;
+      }
+    }
+
+    return add_cond(func, static_cast<Item_field *>(field_arg), op_arg,
+                    m_table->field[cond.field_index]);
+  }
+
   bool parse_index() {
     if (m_table_list->index_hints != nullptr) {
       if (m_table_list->index_hints->elements == 1) {
@@ -484,6 +771,19 @@ class select_parser {
       return true;
     }
 
+    if (m_plan_cond_count < MAX_NOSQL_COND_COUNT) {
+      m_plan_cond_list[m_plan_cond_count] = {
+          type, found->field_index, field_arg == args[0] ? 0u : 1u};
+    }
+    m_plan_cond_count++;
+
+    return add_cond(func, field_arg, op_arg, found);
+  }
+
+  // Add the expression `field_arg <op> op_arg` of func to the condition list
+  bool add_cond(Item_func *func, Item_field *field_arg, Item *op_arg,
+                Field *found) {
+    auto type = func->functype();
     if (found->real_maybe_null()) {
       m_error_msg = "NULL fields not supported";
       return true;
@@ -731,8 +1031,19 @@ class select_exec {
   bool unpack_for_sk(txn_wrapper *txn, const rocksdb::Slice &rkey,
                      const rocksdb::Slice &rvalue);
   bool unpack_for_pk(const rocksdb::Slice &rkey, const rocksdb::Slice &rvalue);
-  bool eval_cond();
+  bool eval_cond(const uint *filter_list, uint filter_count);
   int eval_and_send();
+  int send_if_matched(bool matched);
+  void setup_batch();
+  bool compile_int_filter(const sql_cond &cond);
+  int decode_int_filter_key_parts(const rocksdb::Slice &rkey);
+  bool is_range_end(const rocksdb::Slice &rkey, const rocksdb::Slice &eq_slice,
+                    const rocksdb::Slice &end_key_slice,
+                    const rocksdb::Slice &end_pos_slice);
+  int scan_range_batch(txn_wrapper *txn, bool reverse_seek,
+                       const rocksdb::Slice &eq_slice,
+                       const rocksdb::Slice &end_key_slice,
+                       const rocksdb::Slice &end_pos_slice);
   bool run_pk_point_query(txn_wrapper *txn);
   bool run_sk_point_query(txn_wrapper *txn);
   bool pack_index_tuple(uint key_part_no, Rdb_string_writer *writer,
@@ -775,6 +1086,43 @@ class select_exec {
   uint m_filter_list[MAX_NOSQL_COND_COUNT];
   uint m_filter_count = 0;
 
+  // Filters of the form <integer key field> <op> <integer constant>, which
+  // batch mode decodes straight from the key and evaluates over a column of
+  // values instead of with Item::val_int()
+  struct int_filter {
+    Item_func::Functype op_type;  // field <op> value
+    Field *field;
+    longlong value;
+    bool is_unsigned;
+  };
+  int_filter m_int_filters[MAX_NOSQL_COND_COUNT];
+  uint m_int_filter_count = 0;
+
+  // Key parts of the index up to the last one an integer filter reads, and
+  // whether a filter reads them
+  std::vector<bool> m_int_filter_key_parts;
+
+  // The other filters, evaluated after the full unpack in batch mode
+  uint m_item_filter_list[MAX_NOSQL_COND_COUNT];
+  uint m_item_filter_count = 0;
+
+  // Number of rows a range query decodes and filters as one block, 0 if
+  // rows are processed one at a time
+  uint m_batch_size;
+
+  // Key and value of a row of the block, copied into m_batch_buf
+  struct batch_row {
+    size_t offset;
+    size_t key_size;
+    size_t value_size;
+  };
+
+  // Rows, filter columns and filter results of the block
+  std::string m_batch_buf;
+  std::vector<batch_row> m_batch_rows;
+  std::vector<longlong> m_batch_columns;
+  std::vector<uchar> m_batch_selected;
+
   // All key index tuples we packed during scanning the WHERE clause
   std::vector<key_index_tuple_writer> m_key_index_tuples;
 
@@ -1339,6 +1687,9 @@ bool INLINE_ATTR select_exec::run() {
   // Scan the value and devise a strategy to unpack the values
   scan_value();
 
+  // Decide whether range queries evaluate filters in blocks of rows
+  setup_batch();
+
   // Prepare to send
   if (m_protocol->send_result_set_metadata(
           &m_parser.get_select_lex()->item_list,
@@ -1563,14 +1914,15 @@ bool INLINE_ATTR select_exec::run_sk_point_query(txn_wrapper *txn) {
   to record[0] and is already unpacked.
   This is the slow path as we need to unpack into record[0]
  */
-bool INLINE_ATTR select_exec::eval_cond() {
-  if (unlikely(m_filter_count > 0)) {
+bool INLINE_ATTR select_exec::eval_cond(const uint *filter_list,
+                                        uint filter_count) {
+  if (unlikely(filter_count > 0)) {
     auto where_list = m_parser.get_cond_list();
-    for (uint i = 0; i < m_filter_count; ++i) {
+    for (uint i = 0; i < filter_count; ++i) {
       // Let MySQL evaluate the conditional expression with item pointing to
       // the field record. At least this is better than MySQL where index_key=A
       // are always evaluated even though it is not necessary
-      if (where_list[m_filter_list[i]].cond_item->val_int() == 0) {
+      if (where_list[filter_list[i]].cond_item->val_int() == 0) {
         return false;
       }
     }
@@ -1643,8 +1995,21 @@ bool INLINE_ATTR select_exec::unpack_for_sk(txn_wrapper *txn,
 }
 
 int INLINE_ATTR select_exec::eval_and_send() {
+  return send_if_matched(eval_cond(m_filter_list, m_filter_count));
+}
+
+/*
+  Account an examined row and send it if it matched the filters. The row is
+  in record[0].
+
+  @return
+    0   keep going
+    1   failure
+    -1  LIMIT reached
+ */
+int INLINE_ATTR select_exec::send_if_matched(bool matched) {
   m_examined_rows++;
-  if (eval_cond()) {
+  if (matched) {
     m_row_count++;
     if (m_row_count > m_offset_limit) {
       if (m_debug_row_delay > 0) {
@@ -1667,6 +2032,277 @@ int INLINE_ATTR select_exec::eval_and_send() {
   return 0;
 }
 
+/*
+  Set up batch mode for range queries: the integer key parts that WHERE
+  compares with constants are decoded from the keys of a block of rows and
+  the comparisons evaluated over a column of values for the whole block.
+  Only the rows that pass them are fully unpacked, checked against the
+  remaining filters and sent. Without such a filter there is nothing to
+  save, and rows are processed one at a time.
+ */
+void select_exec::setup_batch() {
+  m_batch_size = get_select_bypass_batch_size();
+  if (m_batch_size <= 1) {
+    m_batch_size = 0;
+    return;
+  }
+
+  auto where_list = m_parser.get_cond_list();
+  for (uint i = 0; i < m_filter_count; ++i) {
+    if (!compile_int_filter(where_list[m_filter_list[i]])) {
+      m_item_filter_list[m_item_filter_count++] = m_filter_list[i];
+    }
+  }
+
+  if (m_int_filter_count == 0) {
+    m_batch_size = 0;
+    return;
+  }
+
+  m_batch_rows.resize(m_batch_size);
+  m_batch_columns.resize(m_batch_size * m_int_filter_count);
+  m_batch_selected.resize(m_batch_size);
+}
+
+/*
+  Add the condition to m_int_filters if it compares an integer key part of
+  the index with an integer constant. Mixed signed/unsigned comparisons with
+  a negative constant are left to Item::val_int().
+ */
+bool select_exec::compile_int_filter(const sql_cond &cond) {
+  if (cond.op_type == Item_func::IN_FUNC ||
+      cond.val_item->type() != Item::INT_ITEM) {
+    return false;
+  }
+
+  switch (cond.field->type()) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+      break;
+    default:
+      return false;
+  }
+
+  // The field has to be decodable from the key alone
+  uint key_part = 0;
+  for (; key_part < m_index_info->actual_key_parts; ++key_part) {
+    if (m_index_info->key_part[key_part].field->field_index ==
+        cond.field->field_index) {
+      break;
+    }
+  }
+  if (key_part == m_index_info->actual_key_parts ||
+      m_key_def->get_pack_info(key_part)->m_unpack_func == nullptr) {
+    return false;
+  }
+
+  const bool is_unsigned = cond.field->flags & UNSIGNED_FLAG;
+  const longlong value = cond.val_item->val_int();
+  if (is_unsigned != static_cast<bool>(cond.val_item->unsigned_flag) &&
+      value < 0) {
+    return false;
+  }
+
+  // parse_cond() accepts both `field <op> const` and `const <op> field`
+  auto func = static_cast<Item_func *>(cond.cond_item);
+  Item_func::Functype op_type = cond.op_type;
+  if (func->arguments()[0]->type() != Item::FIELD_ITEM) {
+    op_type = swap_item_func(op_type);
+  }
+
+  if (key_part >= m_int_filter_key_parts.size()) {
+    m_int_filter_key_parts.resize(key_part + 1, false);
+  }
+  m_int_filter_key_parts[key_part] = true;
+
+  m_int_filters[m_int_filter_count++] = {op_type, cond.field, value,
+                                         is_unsigned};
+  return true;
+}
+
+/*
+  Decode the key parts read by m_int_filters from the key into record[0],
+  skipping over the key parts before them. The rest of the row is left
+  alone.
+
+  @return
+    HA_EXIT_SUCCESS  OK
+    -1               one of the key parts is NULL, so the row cannot match
+    other            HA_ERR error code
+ */
+int INLINE_ATTR
+select_exec::decode_int_filter_key_parts(const rocksdb::Slice &rkey) {
+  Rdb_string_reader reader(&rkey);
+  if (unlikely(!reader.read(Rdb_key_def::INDEX_NUMBER_SIZE))) {
+    return HA_ERR_ROCKSDB_CORRUPT_DATA;
+  }
+
+  for (uint i = 0; i < m_int_filter_key_parts.size(); ++i) {
+    if (!m_int_filter_key_parts[i]) {
+      if (m_key_def->read_memcmp_key_part(m_table, &reader, i) > 0) {
+        return HA_ERR_ROCKSDB_CORRUPT_DATA;
+      }
+      continue;
+    }
+
+    Rdb_field_packing *fpi = m_key_def->get_pack_info(i);
+    if (fpi->m_field_maybe_null) {
+      const char *nullp = reader.read(1);
+      if (unlikely(nullp == nullptr || (*nullp != 0 && *nullp != 1))) {
+        return HA_ERR_ROCKSDB_CORRUPT_DATA;
+      }
+      if (*nullp == 0) {
+        return -1;
+      }
+    }
+
+    // Integers are restored from the key image alone, without unpack_info
+    if (unlikely((fpi->m_unpack_func)(
+                     fpi, m_table->record[0] + fpi->m_field_offset, &reader,
+                     nullptr) != UNPACK_SUCCESS)) {
+      return HA_ERR_ROCKSDB_CORRUPT_DATA;
+    }
+  }
+
+  return HA_EXIT_SUCCESS;
+}
+
+/*
+  Whether rkey is past the end of the current range
+ */
+bool inline select_exec::is_range_end(const rocksdb::Slice &rkey,
+                                      const rocksdb::Slice &eq_slice,
+                                      const rocksdb::Slice &end_key_slice,
+                                      const rocksdb::Slice &end_pos_slice) {
+  if (end_key_slice.empty()) {
+    // No end - we stop when prefix no longer matches
+    return !rkey.starts_with(eq_slice);
+  }
+
+  // Range query (start, end)
+  // NOTE: To simplify the algorithm we always use non-inclusive
+  // check (> or <) and let the end slice handle the boundary
+  int diff = rkey.compare(end_pos_slice);
+  if (m_parser.is_order_desc()) {
+    return diff < 0;
+  }
+  return diff > 0;
+}
+
+/*
+  Batch mode version of the scan loop in run_range_query
+
+  @return
+    0   end of range
+    1   failure
+    -1  LIMIT reached
+ */
+int INLINE_ATTR select_exec::scan_range_batch(
+    txn_wrapper *txn, bool reverse_seek, const rocksdb::Slice &eq_slice,
+    const rocksdb::Slice &end_key_slice, const rocksdb::Slice &end_pos_slice) {
+  while (true) {
+    if (unlikely(handle_killed())) {
+      return 1;
+    }
+
+    // Don't read rows past LIMIT if all of them would match
+    DBUG_ASSERT(m_select_limit > m_row_count);
+    const uint limit = static_cast<uint>(
+        std::min<uint64_t>(m_batch_size, m_select_limit - m_row_count));
+
+    // Read the block: only the integer filter columns are decoded, and the
+    // key and value are copied as is for the full unpack of the rows that
+    // pass them
+    uint count = 0;
+    bool range_end = false;
+    m_batch_buf.clear();
+    for (; count < limit; ++count) {
+      if (unlikely(!is_valid_iterator(m_scan_it.get()))) {
+        range_end = true;
+        break;
+      }
+
+      const rocksdb::Slice rkey = m_scan_it->key();
+      if (is_range_end(rkey, eq_slice, end_key_slice, end_pos_slice)) {
+        range_end = true;
+        break;
+      }
+
+      int rc = decode_int_filter_key_parts(rkey);
+      if (unlikely(rc > 0)) {
+        m_handler->print_error(rc, 0);
+        return 1;
+      }
+
+      const bool is_null = (rc < 0);
+      m_batch_selected[count] = !is_null;
+      for (uint i = 0; i < m_int_filter_count; ++i) {
+        m_batch_columns[i * m_batch_size + count] =
+            is_null ? 0 : m_int_filters[i].field->val_int();
+      }
+
+      if (!is_null) {
+        const rocksdb::Slice rvalue = m_scan_it->value();
+        m_batch_rows[count] = {m_batch_buf.size(), rkey.size(),
+                               rvalue.size()};
+        m_batch_buf.append(rkey.data(), rkey.size());
+        m_batch_buf.append(rvalue.data(), rvalue.size());
+      }
+
+      rocksdb_smart_next(reverse_seek, m_scan_it.get());
+    }
+
+    // Evaluate the integer filters a column at a time
+    for (uint i = 0; i < m_int_filter_count; ++i) {
+      const int_filter &filter = m_int_filters[i];
+      const longlong *column = &m_batch_columns[i * m_batch_size];
+      if (filter.is_unsigned) {
+        filter_column(filter.op_type,
+                      reinterpret_cast<const ulonglong *>(column),
+                      static_cast<ulonglong>(filter.value), count,
+                      m_batch_selected.data());
+      } else {
+        filter_column(filter.op_type, column, filter.value, count,
+                      m_batch_selected.data());
+      }
+    }
+
+    // Unpack the rows that passed, check the other filters and send them
+    for (uint i = 0; i < count; ++i) {
+      bool matched = m_batch_selected[i];
+      if (matched) {
+        const batch_row &row = m_batch_rows[i];
+        const rocksdb::Slice rkey(m_batch_buf.data() + row.offset,
+                                  row.key_size);
+        const rocksdb::Slice rvalue(rkey.data() + row.key_size,
+                                    row.value_size);
+        if (m_index_is_pk) {
+          if (unlikely(unpack_for_pk(rkey, rvalue))) {
+            return 1;
+          }
+        } else {
+          if (unlikely(unpack_for_sk(txn, rkey, rvalue))) {
+            return 1;
+          }
+        }
+        matched = eval_cond(m_item_filter_list, m_item_filter_count);
+      }
+
+      int ret = send_if_matched(matched);
+      if (ret != 0) {
+        return ret;
+      }
+    }
+
+    if (range_end) {
+      return 0;
+    }
+  }
+}
+
 bool INLINE_ATTR select_exec::run_range_query(txn_wrapper *txn) {
   // Determine seek direction - forward (Seek) or reverse (SeekForPrev)
   bool reverse_seek = m_key_def->m_is_reverse_cf ^ m_parser.is_order_desc();
@@ -1796,6 +2432,19 @@ bool INLINE_ATTR select_exec::run_range_query(txn_wrapper *txn) {
 
     rocksdb_smart_seek(reverse_seek, m_scan_it.get(), initial_pos_slice);
 
+    if (m_batch_size > 0) {
+      int ret = scan_range_batch(txn, reverse_seek, eq_slice, end_key_slice,
+                                 end_pos_slice);
+      if (unlikely(ret > 0)) {
+        // failure
+        return true;
+      } else if (unlikely(ret < 0)) {
+        // no more items
+        return false;
+      }
+      continue;
+    }
+
     // Make sure the slice is alive as we'll point into the slice during
     // unpacking
     while (true) {
@@ -1808,25 +2457,8 @@ bool INLINE_ATTR select_exec::run_range_query(txn_wrapper *txn) {
       }
 
       const rocksdb::Slice rkey = m_scan_it->key();
-      if (end_key_slice.empty()) {
-        // No end - we stop when prefix no longer matches
-        if (!rkey.starts_with(eq_slice)) {
-          break;
-        }
-      } else {
-        // Range query (start, end)
-        // NOTE: To simplify the algorithm we always use non-inclusive
-        // check (> or <) and let the end slice handle the boundary
-        int diff = rkey.compare(end_pos_slice);
-        if (m_parser.is_order_desc()) {
-          if (diff < 0) {
-            break;
-          }
-        } else {
-          if (diff > 0) {
-            break;
-          }
-        }
+      if (is_range_end(rkey, eq_slice, end_key_slice, end_pos_slice)) {
+        break;
       }
 
       // TODO: We could skip unpacking if m_filter_count=0 and we are
@@ -1928,6 +2560,8 @@ bool handle_unsupported_bypass(THD *thd, const char *error_msg) {
   }
 }
 
+void clear_select_bypass_plan_cache() { bypass_plan_cache.clear(); }
+
 bool rocksdb_handle_single_table_select(THD *thd, SELECT_LEX *select_lex) {
   // Checks for hint and policy
   if (!is_bypass_on(select_lex)) {
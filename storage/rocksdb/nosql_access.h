@@ -44,6 +44,8 @@ namespace myrocks {
 
 bool rocksdb_handle_single_table_select(THD *thd, st_select_lex *select_lex);
 
+void clear_select_bypass_plan_cache();
+
 extern std::deque<REJECTED_ITEM> rejected_bypass_queries;
 extern std::mutex rejected_bypass_query_lock;
 
@@ -93,7 +93,9 @@ std::string rdb_pc_stat_types[] = {
     "IO_WRITE_NANOS",
     "IO_READ_NANOS",
     "IO_RANGE_SYNC_NANOS",
-    "IO_LOGGER_NANOS"};
+    "IO_LOGGER_NANOS",
+    "SK_MULTIGET_BATCH_COUNT",
+    "SK_MULTIGET_KEY_COUNT"};
 
 #define IO_PERF_RECORD(_field_)                                       \
   do {                                                                \
@@ -274,4 +276,18 @@ void Rdb_io_perf::end_and_record(const uint32_t perf_context_level) {
   }
 }
 
+/*
+  Account one MultiGet call of a batched secondary index scan. These counters
+  are not part of the RocksDB perf context, so they are recorded regardless of
+  the perf context level.
+*/
+void Rdb_io_perf::record_sk_multiget(const uint64_t keys) {
+  if (m_atomic_counters) {
+    m_atomic_counters->m_value[PC_SK_MULTIGET_BATCH_COUNT]++;
+    m_atomic_counters->m_value[PC_SK_MULTIGET_KEY_COUNT] += keys;
+  }
+  rdb_global_perf_counters.m_value[PC_SK_MULTIGET_BATCH_COUNT]++;
+  rdb_global_perf_counters.m_value[PC_SK_MULTIGET_KEY_COUNT] += keys;
+}
+
 }  // namespace myrocks
@@ -85,6 +85,9 @@ enum {
   PC_IO_READ_NANOS,
   PC_IO_RANGE_SYNC_NANOS,
   PC_IO_LOGGER_NANOS,
+  // Maintained by MyRocks itself rather than harvested from RocksDB
+  PC_SK_MULTIGET_BATCH_COUNT,
+  PC_SK_MULTIGET_KEY_COUNT,
   PC_MAX_IDX
 };
 
@@ -154,6 +157,7 @@ class Rdb_io_perf {
   void update_bytes_written(const uint32_t perf_context_level,
                             ulonglong bytes_written);
   void end_and_record(const uint32_t perf_context_level);
+  void record_sk_multiget(const uint64_t keys);
 
   explicit Rdb_io_perf()
       : m_atomic_counters(nullptr),
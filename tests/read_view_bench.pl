@@ -0,0 +1,266 @@
+#!/usr/bin/perl -w
+
+# Copyright (c) 2016, Facebook, Inc.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; version 2 of the License.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+
+#
+# Read/write OLTP microbenchmark for InnoDB read view creation.
+#
+# Every client runs sysbench-style transactions against a set of InnoDB
+# tables: point selects, a range select, index and non-index updates and
+# a delete/insert pair. Each statement of an autocommit or READ COMMITTED
+# transaction opens a read view, while every commit changes the set of
+# active transactions, so this exercises read view creation concurrently
+# with transaction start and commit.
+#
+# The test is run once for every value of --threads and the throughput is
+# reported per run, e.g.:
+#
+#   read_view_bench.pl --threads=1,16,64,128 --time=60
+#
+# Use --read-only to run the select part only, and --isolation to change
+# the transaction isolation level of the clients.
+
+##################### Standard benchmark inits ##############################
+
+use DBI;
+use Getopt::Long;
+use Time::HiRes qw(time);
+
+package main;
+
+$opt_host=$opt_user=$opt_password=$opt_socket=""; $opt_db="test";
+$opt_threads="1,8,16,32,64,128";
+$opt_tables=8;
+$opt_table_size=100000;
+$opt_time=30;
+$opt_point_selects=10;
+$opt_isolation="REPEATABLE-READ";
+$opt_read_only=$opt_skip_create=$opt_help=0;
+
+GetOptions("host=s","db=s","user=s","password=s","socket=s","threads=s",
+           "tables=i","table-size=i","time=i","point-selects=i",
+           "isolation=s","read-only","skip-create","help") || usage();
+usage() if ($opt_help);
+
+$dsn="DBI:mysql:$opt_db:$opt_host";
+$dsn.=";mysql_socket=$opt_socket" if ($opt_socket);
+
+@thread_counts= split(/,/, $opt_threads);
+
+$|= 1;				# Autoflush
+
+prepare_tables() if (!$opt_skip_create);
+
+print "Read view benchmark: $opt_tables tables of $opt_table_size rows, " .
+  ($opt_read_only ? "read-only" : "read/write") .
+  ", $opt_isolation, $opt_time seconds per run\n\n";
+printf("%8s %12s %12s %10s\n", "threads", "trx/s", "queries/s", "errors");
+
+foreach $threads (@thread_counts)
+{
+  run_test($threads);
+}
+
+exit(0);
+
+
+sub usage
+{
+  print <<EOF;
+$0 [options]
+
+  --host=#, --socket=#, --user=#, --password=#, --db=#
+                        Connection parameters (database: $opt_db)
+  --threads=#,#,...     Number of client connections of each run
+                        ($opt_threads)
+  --tables=#            Number of tables ($opt_tables)
+  --table-size=#        Number of rows per table ($opt_table_size)
+  --time=#              Duration of each run in seconds ($opt_time)
+  --point-selects=#     Point selects per transaction ($opt_point_selects)
+  --isolation=#         Transaction isolation level ($opt_isolation)
+  --read-only           Only run the selects
+  --skip-create         Reuse the tables of an earlier run
+EOF
+  exit(1);
+}
+
+
+sub connect_db
+{
+  my $dbh= DBI->connect($dsn, $opt_user, $opt_password,
+                        { PrintError => 0, AutoCommit => 1 })
+    || die $DBI::errstr;
+  return $dbh;
+}
+
+
+sub prepare_tables
+{
+  my ($dbh, $table, $id, @values);
+
+  $dbh= connect_db();
+  for ($table=1 ; $table <= $opt_tables ; $table++)
+  {
+    print "Creating table sbtest$table\n";
+    $dbh->do("drop table if exists sbtest$table");
+    $dbh->do("create table sbtest$table (" .
+             " id int unsigned not null auto_increment," .
+             " k int unsigned not null default 0," .
+             " c char(120) not null default ''," .
+             " pad char(60) not null default ''," .
+             " primary key (id), key k (k)) engine=InnoDB")
+      || die $DBI::errstr;
+
+    for ($id=1 ; $id <= $opt_table_size ; $id++)
+    {
+      push(@values, "($id," . int(rand($opt_table_size)) . ",'" .
+           random_string(119) . "','" . random_string(59) . "')");
+      if (@values == 1000 || $id == $opt_table_size)
+      {
+        $dbh->do("insert into sbtest$table (id,k,c,pad) values " .
+                 join(",", @values)) || die $DBI::errstr;
+        @values= ();
+      }
+    }
+  }
+  $dbh->disconnect;
+}
+
+
+sub random_string
+{
+  my ($length)= @_;
+  my $str= "";
+  $str.= chr(ord('a') + int(rand(26))) while (length($str) < $length);
+  return $str;
+}
+
+
+#
+# Fork the clients of one run and sum up their results.
+#
+
+sub run_test
+{
+  my ($threads)= @_;
+  my ($i, $pid, $trx, $queries, $errors, %pipes);
+
+  for ($i=0 ; $i < $threads ; $i++)
+  {
+    my ($reader, $writer);
+    pipe($reader, $writer) || die "pipe: $!";
+    if (($pid= fork()) == 0)
+    {
+      close($reader);
+      srand($$ ^ time());
+      my @result= client();
+      print $writer join(" ", @result), "\n";
+      close($writer);
+      exit(0);
+    }
+    die "fork: $!" if (!defined($pid));
+    close($writer);
+    $pipes{$pid}= $reader;
+  }
+
+  $trx= $queries= $errors= 0;
+  foreach $pid (keys %pipes)
+  {
+    my $reader= $pipes{$pid};
+    my $line= <$reader>;
+    close($reader);
+    waitpid($pid, 0);
+    if (!defined($line))
+    {
+      $errors++;
+      next;
+    }
+    my ($t, $q, $e)= split(/ /, $line);
+    $trx+= $t; $queries+= $q; $errors+= $e;
+  }
+
+  printf("%8d %12.2f %12.2f %10d\n", $threads,
+         $trx / $opt_time, $queries / $opt_time, $errors);
+}
+
+
+#
+# One client: run transactions until the time is up.
+# Returns the number of transactions, queries and errors.
+#
+
+sub client
+{
+  my ($dbh, $end, $trx, $queries, $errors, $table, $id, $i);
+
+  $dbh= connect_db();
+  $dbh->do("set session transaction isolation level " .
+           join(" ", split(/-/, $opt_isolation)))
+    || die $DBI::errstr;
+
+  $trx= $queries= $errors= 0;
+  $end= time() + $opt_time;
+
+  while (time() < $end)
+  {
+    my $ok= 1;
+    $table= 1 + int(rand($opt_tables));
+
+    $ok&&= $dbh->do("begin");
+    for ($i=0 ; $ok && $i < $opt_point_selects ; $i++)
+    {
+      $id= 1 + int(rand($opt_table_size));
+      $ok&&= $dbh->selectall_arrayref("select c from sbtest$table " .
+                                      "where id=$id");
+      $queries++;
+    }
+
+    $id= 1 + int(rand($opt_table_size - 100));
+    $ok&&= $dbh->selectall_arrayref("select c from sbtest$table " .
+                                    "where id between $id and " .
+                                    ($id + 99));
+    $queries++;
+
+    if (!$opt_read_only)
+    {
+      $id= 1 + int(rand($opt_table_size));
+      $ok&&= $dbh->do("update sbtest$table set k=k+1 where id=$id");
+      $id= 1 + int(rand($opt_table_size));
+      $ok&&= $dbh->do("update sbtest$table set c='" . random_string(119) .
+                      "' where id=$id");
+      $id= 1 + int(rand($opt_table_size));
+      $ok&&= $dbh->do("delete from sbtest$table where id=$id");
+      $ok&&= $dbh->do("insert into sbtest$table (id,k,c,pad) values " .
+                      "($id," . int(rand($opt_table_size)) . ",'" .
+                      random_string(119) . "','" . random_string(59) .
+                      "')");
+      $queries+= 4;
+    }
+
+    if ($ok && $dbh->do("commit"))
+    {
+      $trx++;
+    }
+    else
+    {
+      # Deadlocks and lock wait timeouts are expected with many clients
+      $dbh->do("rollback");
+      $errors++;
+    }
+  }
+  $dbh->disconnect;
+  return ($trx, $queries, $errors);
+}
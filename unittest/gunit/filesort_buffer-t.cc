@@ -16,9 +16,13 @@
 // First include (the generated) my_config.h, to get correct platform defines.
 #include "my_config.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "filesort_utils.h"
+#include "myisampack.h"
+#include "sql_sort.h"
 #include "table.h"
 
 namespace filesort_buffer_unittest {
@@ -26,6 +30,16 @@ namespace filesort_buffer_unittest {
 class FileSortBufferTest : public ::testing::Test
 {
 protected:
+  static void SetUpTestCase()
+  {
+    filesort_workers_init();
+  }
+
+  static void TearDownTestCase()
+  {
+    filesort_workers_free();
+  }
+
   virtual void TearDown()
   {
     fs_info.free_sort_buffer();
@@ -86,4 +100,81 @@ TEST_F(FileSortBufferTest, AssignmentOperator)
 }
 
 
+/*
+  Sort a buffer big enough to be split among several threads,
+  and verify that the keys end up in order.
+*/
+TEST_F(FileSortBufferTest, ParallelSort)
+{
+  const uint num_records= 100000;
+  Sort_param param;
+  param.sort_length= sizeof(uint32);
+  param.max_sort_threads= 4;
+
+  fs_info.alloc_sort_buffer(num_records, param.sort_length);
+  for (uint ix= 0; ix < num_records; ++ix)
+  {
+    // A permutation of 0..num_records-1, stored big-endian.
+    const uint32 val= (ix * 7919U) % num_records;
+    uchar *ptr= fs_info.get_record_buffer(ix);
+    mi_int4store(ptr, val);
+  }
+
+  EXPECT_EQ(4U, fs_info.sort_buffer(&param, num_records));
+
+  uchar **keys= fs_info.get_sort_keys();
+  for (uint ix= 0; ix < num_records; ++ix)
+  {
+    EXPECT_EQ(ix, static_cast<uint>(mi_uint4korr(keys[ix])));
+  }
+}
+
+
+class Key_compare
+{
+public:
+  Key_compare(size_t length) : m_length(length) {}
+  bool operator()(const uchar *s1, const uchar *s2) const
+  {
+    return memcmp(s1, s2, m_length) < 0;
+  }
+private:
+  size_t m_length;
+};
+
+/*
+  Sort keys longer than the 8 byte prefix, with many duplicates,
+  and verify that they are ordered and that equal keys keep their order.
+*/
+TEST_F(FileSortBufferTest, RadixSort)
+{
+  const uint num_records= 20000;
+  const uint key_length= 12;
+  Sort_param param;
+  param.sort_length= key_length;
+  param.max_sort_threads= 1;
+  param.use_radix_sort= true;
+
+  fs_info.alloc_sort_buffer(num_records, param.sort_length);
+  for (uint ix= 0; ix < num_records; ++ix)
+  {
+    // 1000 distinct prefixes, 7 distinct suffixes.
+    uchar *ptr= fs_info.get_record_buffer(ix);
+    mi_int4store(ptr, (ix * 7919U) % 1000);
+    memset(ptr + 4, 'a', 4);
+    mi_int4store(ptr + 8, ix % 7);
+  }
+  uchar **keys= fs_info.get_sort_keys();
+  std::vector<uchar*> expected(keys, keys + num_records);
+
+  EXPECT_EQ(1U, fs_info.sort_buffer(&param, num_records));
+
+  std::stable_sort(expected.begin(), expected.end(),
+                   Key_compare(key_length));
+  for (uint ix= 0; ix < num_records; ++ix)
+  {
+    EXPECT_EQ(expected[ix], keys[ix]);
+  }
+}
+
 }  // namespace
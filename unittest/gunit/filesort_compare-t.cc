@@ -33,6 +33,9 @@ namespace filesort_compare_unittest {
   radixsort -        requires extra memory: array of n pointers,
                      seems to be quite fast on intel *when it is appliccable*:
                      if (size <= 20 && items >= 1000 && items < 100000)
+  prefix_radix_sort- requires extra memory: two arrays of n pointers and
+                     n 8-byte key prefixes, MSD radix sort on the prefixes,
+                     std::stable_sort of keys with equal prefixes
   std::sort -        requires no extra memory,
                      typically implemented with introsort/insertion sort
   std::stable_sort - requires extra memory: array of n pointers,
@@ -323,6 +326,15 @@ TEST_F(FileSortCompareTest, RadixSort)
   }
 }
 
+TEST_F(FileSortCompareTest, PrefixRadixSort)
+{
+  for (int ix= 0; ix < num_iterations; ++ix)
+  {
+    std::vector<uchar*> keys(sort_keys, sort_keys + num_records);
+    EXPECT_FALSE(prefix_radix_sort(&keys[0], num_records, record_size));
+  }
+}
+
 TEST_F(FileSortCompareTest, MyQsort)
 {
   size_t size= record_size;